@@ -4,6 +4,12 @@
 #include "MapLoader/MapLoader.h"
 #include "MapLoader/TMJMap.h"
 #include "Renderer/TextRenderer.h"
+#include "Renderer/GlyphPrewarmer.h"
+#include "Renderer/ParticleSystem.h"
+#include "Renderer/MapChunkCache.h"
+#include "UI/Minimap.h"
+#include "UI/UiAtlas.h"
+#include "UI/Widget.h"
 #include "Input/InputManager.h"
 #include "Utils/Logger.h"
 #include <filesystem>
@@ -25,6 +31,12 @@
 #include <nlohmann/json.hpp>
 #include <fstream>
 #include "QuizGame/LessonTrigger.h"
+#include "Jobs/JobSystem.h"
+#include "Utils/MemoryTracker.h"
+#include "Utils/Arena.h"
+#include <charconv>
+#include <string_view>
+#include <type_traits>
 
 // Global variables for Achievement System 
 static std::string g_achievementText = "";
@@ -146,6 +158,8 @@ static bool detectShopTrigger(const Character& character, const TMJMap* map, Sho
 
 // show the full-map modal (blocking) 
 static void showFullMapModal(Renderer& renderer, const std::shared_ptr<TMJMap>& tmjMap, const ConfigManager& configManager) {
+    // Modal windows create GL resources on this thread; hold the render thread meanwhile
+    Renderer::RenderThreadPause pause(renderer);
     auto dm = sf::VideoMode::getDesktopMode();
     sf::RenderWindow mapWin(dm, sf::String("Full Map"), sf::State::Windowed); 
     mapWin.setFramerateLimit(60);
@@ -185,26 +199,20 @@ static void showFullMapModal(Renderer& renderer, const std::shared_ptr<TMJMap>&
     sf::Vector2i prevDragPixel{0,0};
 
     sf::View view = fullView;
+    InputManager& inputManager = InputManager::getInstance();
 
     while (mapWin.isOpen()) {
-        // event polling
+        // event polling; keys go through the input manager so their releases are seen
         std::optional<sf::Event> evOpt = mapWin.pollEvent();
         while (evOpt.has_value()) {
             sf::Event& ev = evOpt.value();
+            inputManager.handleEvent(ev, InputManager::Clock::now());
             
             // window closing event 
             if (auto closed = ev.getIf<sf::Event::Closed>()) {
                 mapWin.close(); 
                 break; 
             }
-            
-            // keyboard pressing events
-            if (auto keyPressed = ev.getIf<sf::Event::KeyPressed>()) {
-                if (keyPressed->code == sf::Keyboard::Key::Escape) {
-                    mapWin.close(); 
-                    break; 
-                }
-            }
 
             // mouse wheel events
             if (auto mouseWheel = ev.getIf<sf::Event::MouseWheelScrolled>()) {
@@ -252,6 +260,13 @@ static void showFullMapModal(Renderer& renderer, const std::shared_ptr<TMJMap>&
 
         if (!mapWin.isOpen()) break;
 
+        inputManager.update();
+        if (const auto inputAt = inputManager.getFrameInputTime()) renderer.noteInput(*inputAt);
+        if (inputManager.consumeAction(InputAction::Cancel)) {
+            mapWin.close();
+            break;
+        }
+
         mapWin.clear(sf::Color::Black);
         for (const auto& s : tmjMap->getTiles()) mapWin.draw(s);
         for (const auto& a : tmjMap->getEntranceAreas()) {
@@ -265,12 +280,13 @@ static void showFullMapModal(Renderer& renderer, const std::shared_ptr<TMJMap>&
             tr.renderTextObjects(tmjMap->getTextObjects(), mapWin);
         }
 
-        mapWin.display();
+        renderer.presentModal(mapWin);
     }
 }
 
 // show the schedule image in a blocking modal window
 static void showScheduleModal(Renderer& renderer, const ConfigManager& configManager) {
+    Renderer::RenderThreadPause pause(renderer);
     auto dm = sf::VideoMode::getDesktopMode();
     sf::RenderWindow schedWin(dm, sf::String("Schedule"), sf::State::Windowed);
     schedWin.setFramerateLimit(60);
@@ -295,20 +311,16 @@ static void showScheduleModal(Renderer& renderer, const ConfigManager& configMan
     float displayH = texH * scale;
     schedSprite.setPosition(sf::Vector2f((winW - displayW) * 0.5f, (winH - displayH) * 0.5f));
 
+    InputManager& inputManager = InputManager::getInstance();
     while (schedWin.isOpen()) {
         std::optional<sf::Event> evOpt = schedWin.pollEvent();
         while (evOpt.has_value()) {
             sf::Event& ev = evOpt.value();
+            inputManager.handleEvent(ev, InputManager::Clock::now());
             if (auto closed = ev.getIf<sf::Event::Closed>()) {
                 schedWin.close();
                 break;
             }
-            if (auto key = ev.getIf<sf::Event::KeyPressed>()) {
-                if (key->code == sf::Keyboard::Key::Escape) {
-                    schedWin.close();
-                    break;
-                }
-            }
             if (auto mouse = ev.getIf<sf::Event::MouseButtonPressed>()) {
                 schedWin.close();
                 break;
@@ -316,9 +328,109 @@ static void showScheduleModal(Renderer& renderer, const ConfigManager& configMan
             evOpt = schedWin.pollEvent();
         }
         if (!schedWin.isOpen()) break;
+        inputManager.update();
+        if (const auto inputAt = inputManager.getFrameInputTime()) renderer.noteInput(*inputAt);
+        if (inputManager.consumeAction(InputAction::Cancel) || inputManager.consumeAction(InputAction::Confirm)) {
+            schedWin.close();
+            break;
+        }
         schedWin.clear(sf::Color::Black);
         schedWin.draw(schedSprite);
-        schedWin.display();
+        renderer.presentModal(schedWin);
+    }
+}
+
+// Append one part of a scratch string: integers are formatted in place with
+// std::to_chars, everything else is viewed as text.
+template <typename Part>
+static void appendScratchPart(std::pmr::string& out, const Part& part) {
+    if constexpr (std::is_integral_v<Part>) {
+        char digits[24];
+        const auto result = std::to_chars(digits, digits + sizeof(digits), part);
+        out.append(digits, result.ptr);
+    } else {
+        out.append(std::string_view(part));
+    }
+}
+
+// Upper bound of a part's length, for the single reservation
+template <typename Part>
+static size_t scratchPartSize(const Part& part) {
+    if constexpr (std::is_integral_v<Part>) {
+        return 20;
+    } else {
+        return std::string_view(part).size();
+    }
+}
+
+// Concatenate parts (text or integers) into a string backed by the frame's
+// scratch arena; the only heap copy left is the one sf::Text keeps.
+template <typename... Parts>
+static std::pmr::string scratchString(Arena& frameArena, const Parts&... parts) {
+    std::pmr::string out(&frameArena);
+    out.reserve((scratchPartSize(parts) + ... + 0));
+    (appendScratchPart(out, parts), ...);
+    return out;
+}
+
+// Memory report in the top-left corner (toggled with F3).
+static void drawMemoryOverlay(Renderer& renderer, const sf::Font& font, Arena& frameArena) {
+    std::pmr::string report(&frameArena);
+    for (const auto& line : MemoryTracker::getInstance().reportLines()) {
+        report += line;
+        report += '\n';
+    }
+    report += frameArena.describe();
+
+    sf::Text text(font, report.c_str(), 14);
+    text.setFillColor(sf::Color::White);
+    text.setPosition(sf::Vector2f(12.f, 12.f));
+
+    const sf::FloatRect bounds = text.getGlobalBounds();
+    sf::RectangleShape bg(bounds.size + sf::Vector2f(16.f, 16.f));
+    bg.setPosition(bounds.position - sf::Vector2f(8.f, 8.f));
+    bg.setFillColor(sf::Color(0, 0, 0, 170));
+
+    renderer.submitUi(bg);
+    renderer.submitUi(text);
+}
+
+// Collect the faces and data-driven strings of every text the game loop can show.
+// Fixed UI strings in this file are ASCII, which the prewarmer always covers.
+static void collectGameGlyphs(
+    GlyphPrewarmer& glyphs,
+    const Renderer& renderer,
+    const TaskManager& taskManager,
+    const LessonTrigger& lessonTrigger,
+    unsigned int dialogFontSize
+) {
+    renderer.addGlyphFaces(glyphs);
+
+    // Dialog title/options and modal prompts (the dialog starts at 24 until initialized)
+    glyphs.addFace(dialogFontSize);
+    glyphs.addFace(24);
+
+    // HUD texts: size and outline as drawn in runApp
+    glyphs.addFace(16, sf::Text::Regular, 1.f);   // Resting / Eating
+    glyphs.addFace(24, sf::Text::Regular, 2.f);   // Time
+    glyphs.addFace(14, sf::Text::Regular, 1.f);   // Energy
+    glyphs.addFace(20, sf::Text::Regular, 2.f);   // Points
+    glyphs.addFace(20, sf::Text::Regular, 1.f);   // Tasks header
+    glyphs.addFace(18, sf::Text::Regular, 1.f);   // Task lines
+    glyphs.addFace(30, sf::Text::Regular, 2.f);   // Faint message, achievements
+    glyphs.addFace(36, sf::Text::Regular, 3.f);   // Expelled message
+    glyphs.addFace(28);                           // Game Over button
+    glyphs.addFace(22, sf::Text::Regular, 2.f);   // Hints
+
+    for (const auto& task : taskManager.getTasks()) {
+        glyphs.addText(task.description);
+        glyphs.addText(task.achievementName);
+    }
+    for (const auto& [weekday, day] : lessonTrigger.getSchedules()) {
+        for (const auto& slot : day.slots) {
+            glyphs.addText(slot.course);
+            glyphs.addText(slot.location);
+        }
     }
 }
 
@@ -335,6 +447,8 @@ static bool tryEnterTarget(
     fs::path targetPath(entrance.target);
     fs::path resolved = targetPath.is_absolute() ? targetPath : fs::path(mapLoader.getMapDirectory()) / targetPath;
     std::string resolvedStr = resolved.generic_string();
+    // The old map's textures may still be referenced by a published frame
+    Renderer::RenderThreadPause pause(renderer);
     auto newMap = mapLoader.loadTMJMap(resolvedStr);
     if (!newMap) {
         Logger::error("Failed to load target map: " + resolvedStr);
@@ -706,6 +820,8 @@ FinalResult calculateFinalResult(int totalPoints) {
 bool isFinalResultShown = false;     // whether show the result panel
 
 bool showFinalResultScreen(Renderer& renderer, char grade, int starCount, const std::string& resultText) {
+    // Draws on the game window directly, so the render thread must hand it over
+    Renderer::RenderThreadPause pause(renderer);
     sf::RenderWindow& window = renderer.getWindow();
     sf::Font font;
     if (!font.openFromFile("fonts/arial.ttf")) {
@@ -713,97 +829,85 @@ bool showFinalResultScreen(Renderer& renderer, char grade, int starCount, const
         return true;
     }
 
-    // Background loading, scaling, centering
-    sf::Texture bgTexture;
-    if (!bgTexture.loadFromFile("textures/dialog_bg.png")) {
-        Logger::error("Failed to load dialog_bg.png");
+    // Dialog art packed on one atlas page (same borders as DialogSystem)
+    UiAtlas atlas;
+    if (!atlas.add("dialog_bg", "textures/dialog/dialog_bg.png", 24, 24, 24, 24) ||
+        !atlas.add("dialog_btn", "textures/dialog/btn.png", 22, 10, 22, 10) || !atlas.build()) {
+        Logger::error("Failed to load the dialog textures for final result");
         return true;
     }
-    sf::Sprite bgSprite(bgTexture);
-    const float PANEL_SCALE_RATIO = 0.7f; 
-    sf::Vector2u windowSize = window.getSize();
-    sf::Vector2u bgTexSize = bgTexture.getSize();
-    float scaleX = (windowSize.x * PANEL_SCALE_RATIO) / bgTexSize.x;
-    float scaleY = (windowSize.y * PANEL_SCALE_RATIO) / bgTexSize.y;
-    float finalScale = std::min(scaleX, scaleY);
-    bgSprite.setScale(sf::Vector2f(finalScale, finalScale));
-    sf::FloatRect bgBounds = bgSprite.getGlobalBounds();
-    float bgX = (windowSize.x - bgBounds.size.x) / 2.0f;  
-    float bgY = (windowSize.y - bgBounds.size.y) / 2.0f; 
-    bgSprite.setPosition(sf::Vector2f(bgX, bgY));
+    const NineSlice& bgPanel = *atlas.find("dialog_bg");
 
-    // texts of results
-    sf::Text gradeText(font, "", 36);
-    std::string article = (grade == 'A') ? "an" : "a";
-    gradeText.setString("You got " + article + " " + std::string(1, grade) + " in the game!");
-    gradeText.setFillColor(sf::Color::White);
-    gradeText.setCharacterSize(36);
-    sf::FloatRect gradeBounds = gradeText.getLocalBounds();
-    gradeText.setOrigin(sf::Vector2f(gradeBounds.size.x / 2, gradeBounds.size.y / 2));
-    gradeText.setPosition(sf::Vector2f(
-        windowSize.x / 2.0f,          
-        bgY + bgBounds.size.y * 0.25f 
-    ));
-
-    // texts of health condition
-    sf::Text healthText(font, resultText, 28);
-    healthText.setFillColor(sf::Color(255, 215, 0));
-    healthText.setCharacterSize(28);
-    sf::FloatRect healthBounds = healthText.getLocalBounds();
-    healthText.setOrigin(sf::Vector2f(healthBounds.size.x / 2, healthBounds.size.y / 2));
-    healthText.setPosition(sf::Vector2f(
-        windowSize.x / 2.0f,
-        bgY + bgBounds.size.y * 0.35f
-    ));
-
-    // show stars
-    const float starSize = 50.f;
     sf::Texture starYTexture, starGTexture;
     if (!starYTexture.loadFromFile("textures/star_y.png") || !starGTexture.loadFromFile("textures/star_g.png")) {
         Logger::error("Failed to load star textures");
         return true;
     }
+
+    // Panel: 70% of the window's shorter fit, centered by the root. Rows are
+    // placed at fixed fractions of the panel's height through the margins.
+    const float PANEL_SCALE_RATIO = 0.7f; 
+    const sf::Vector2u windowSize = window.getSize();
+    const sf::Vector2f bgTexSize = bgPanel.getSize();
+    const float finalScale = std::min((windowSize.x * PANEL_SCALE_RATIO) / bgTexSize.x,
+                                      (windowSize.y * PANEL_SCALE_RATIO) / bgTexSize.y);
+    const sf::Vector2f panelSize = bgTexSize * finalScale;
+
+    const float starSize = 50.f;
+    const float starGap = 20.f;
+    const float btnWidth = 180.f;
+
+    bool shouldExit = false;
+    bool isRunning = true;
+
+    WidgetTree ui;
+    ui.setViewport(windowSize);
+
+    auto& panel = ui.getRoot().addChild<PanelWidget>(bgPanel);
+    panel.setWidthFraction(PANEL_SCALE_RATIO, finalScale, finalScale);
+    panel.setPadding(panelSize.y * 0.2f, 0.f);
+
+    // texts of results
+    auto& gradeText = panel.addChild<LabelWidget>(font, 36);
+    const std::string article = (grade == 'A') ? "an" : "a";
+    gradeText.setString("You got " + article + " " + std::string(1, grade) + " in the game!");
+    gradeText.setMarginBottom(panelSize.y * 0.05f);
+
+    // texts of health condition
+    auto& healthText = panel.addChild<LabelWidget>(font, 28);
+    healthText.setString(resultText);
+    healthText.setColor(sf::Color(255, 215, 0));
+    healthText.setMarginBottom(panelSize.y * 0.1f);
+
+    // Row reserved for the stars; the sprites are placed on its rect
+    auto& starRow = panel.addChild<BoxWidget>(
+        sf::Vector2f(starSize * 5 + starGap * 4, starSize), sf::Color::Transparent);
+    starRow.setMarginBottom(std::max(0.f, panelSize.y * 0.2f - starSize));
+
+    auto& exitBtn = panel.addChild<ButtonWidget>(*atlas.find("dialog_btn"), font, 24);
+    exitBtn.setWidthFraction(btnWidth / panelSize.x, 0.1f, 10.f);
+    exitBtn.getLabel().setString("Exit");
+    exitBtn.getLabel().setColor(sf::Color::Black);
+    exitBtn.setOnClick([&] {
+        shouldExit = true;
+        isRunning = false;
+    });
+
+    ui.update();
     std::vector<sf::Sprite> stars;
-    float starStartX = (windowSize.x - (starSize * 5 + 20.f * 4)) / 2;
-    float starY = bgY + bgBounds.size.y * 0.5f;
     for (int i = 0; i < 5; ++i) {
         sf::Sprite star(i < starCount ? starYTexture : starGTexture);
         star.setScale(sf::Vector2f(
             starSize / starYTexture.getSize().x, 
             starSize / starYTexture.getSize().y
         ));
-        star.setPosition(sf::Vector2f(
-            starStartX + i * (starSize + 20.f), 
-            starY
-        ));
+        star.setPosition(starRow.getRect().position + sf::Vector2f(i * (starSize + starGap), 0.f));
         stars.push_back(star);
     }
 
-    // Button layout, interaction
-    const float btnWidth = 180.f;
-    const float btnHeight = 60.f;
-    sf::RectangleShape exitBtn(sf::Vector2f(btnWidth, btnHeight));
-    exitBtn.setFillColor(sf::Color(139, 69, 19));
-    exitBtn.setOutlineColor(sf::Color(80, 40, 10));
-    exitBtn.setOutlineThickness(2.f);
-    float btnX = (windowSize.x - btnWidth) / 2;
-    float btnY = bgY + bgBounds.size.y * 0.7f;
-    exitBtn.setPosition(sf::Vector2f(btnX, btnY));
-
-    sf::Text exitText(font, "Exit", 24);
-    exitText.setFillColor(sf::Color::White);
-    sf::FloatRect exitTextBounds = exitText.getLocalBounds();
-    exitText.setOrigin(sf::Vector2f(exitTextBounds.size.x / 2, exitTextBounds.size.y / 2));
-    exitText.setPosition(sf::Vector2f(
-        exitBtn.getPosition().x + btnWidth / 2,
-        exitBtn.getPosition().y + btnHeight / 2
-    ));
-
     // Event polling
     sf::View originalView = window.getView();
     window.setView(window.getDefaultView());
-    bool shouldExit = false;
-    bool isRunning = true;
 
     while (window.isOpen() && isRunning) {
         std::optional<sf::Event> event;
@@ -813,36 +917,23 @@ bool showFinalResultScreen(Renderer& renderer, char grade, int starCount, const
                 isRunning = false;
                 shouldExit = true;
             }
+            // Hover tint and clicks go through the tree's hit rects
+            if (const auto* moved = event->getIf<sf::Event::MouseMoved>()) {
+                ui.updateHover(window.mapPixelToCoords(moved->position));
+            }
             if (const auto* mouseEvent = event->getIf<sf::Event::MouseButtonPressed>()) {
                 if (mouseEvent->button == sf::Mouse::Button::Left) {
-                    sf::Vector2f mousePos = window.mapPixelToCoords(
-                        sf::Vector2i(mouseEvent->position.x, mouseEvent->position.y)
-                    );
-                    if (exitBtn.getGlobalBounds().contains(mousePos)) {
-                        shouldExit = true;
-                        isRunning = false;
+                    if (Widget* hit = ui.hitTest(window.mapPixelToCoords(mouseEvent->position))) {
+                        hit->getOnClick()();
                     }
                 }
             }
         }
 
-        // Mouse hover effect
-        sf::Vector2i mousePixelPos = sf::Mouse::getPosition(window);
-        sf::Vector2f mouseWorldPos = window.mapPixelToCoords(mousePixelPos);
-        if (exitBtn.getGlobalBounds().contains(mouseWorldPos)) {
-            exitBtn.setFillColor(sf::Color(150, 80, 30));
-        } else {
-            exitBtn.setFillColor(sf::Color(139, 69, 19));
-        }
-
         // render
         window.clear(sf::Color(40, 40, 40));
-        window.draw(bgSprite);
-        window.draw(gradeText);
-        window.draw(healthText);
+        ui.draw(window);
         for (const auto& star : stars) window.draw(star);
-        window.draw(exitBtn);
-        window.draw(exitText);
         window.display();
     }
 
@@ -859,12 +950,6 @@ struct ProfessorResponseState {
     std::string selectedText;
 };
 
-// Struct to store clickable task areas for the Event Loop
-struct TaskHitbox {
-    sf::FloatRect bounds;
-    std::string detailText;
-};
-
 struct SettlementData {
     char grade;
     int finalStarCount;
@@ -1079,16 +1164,124 @@ AppResult runApp(
     bool hasSuppressedEntrance = false;
     sf::FloatRect suppressedEntranceRect;
 
-    // Vector to store hitboxes of tasks drawn in the previous frame
-    std::vector<TaskHitbox> activeTaskHitboxes;
-
     // Unstuck State 
     sf::Vector2f lastFramePos = character.getPosition();
     float stuckTimer = 0.0f;
 
+    // Let the renderer pace the loop and, with performance.renderThread, draw on a
+    // dedicated thread. The guard stops both on every way out of runApp, before
+    // the fonts and textures that recorded frames reference are destroyed.
+    struct RenderThreadGuard {
+        Renderer& renderer;
+        std::vector<const sf::Font*> fonts;
+        ~RenderThreadGuard() {
+            renderer.stopFramePacing();
+            for (const sf::Font* font : fonts) renderer.unregisterFont(*font);
+        }
+    } renderThreadGuard{renderer, {&modalFont, &dialogSys.getFont()}};
+    for (const sf::Font* font : renderThreadGuard.fonts) {
+        renderer.registerFont(*font, configManager.getRenderConfig().text.fontPath);
+    }
+    renderer.startFramePacing();
+    if (configManager.getAppConfig().performance.renderThread && !renderer.startRenderThread()) {
+        Logger::warn("Render thread unavailable, drawing on the main thread");
+    }
+
+    // Rasterize every glyph up front so new dialogs, hints and labels don't hitch
+    // on first appearance; map switches add the new map's labels.
+    GlyphPrewarmer glyphs;
+    collectGameGlyphs(glyphs, renderer, taskManager, lessonTrigger,
+                      configManager.getRenderConfig().text.fontSize);
+    glyphs.addTextObjects(tmjMap->getTextObjects(), TextRenderer::LabelOutline);
+    renderer.prewarmGlyphs(glyphs);
+    MemoryTracker::getInstance().logReport("game started on " + mapLoader.getCurrentMapPath());
+    bool showMemoryOverlay = false;
+
+    // HUD: a top-left column of time, energy, points and tasks, built once. The
+    // values are pushed every frame; only a change touches a text or the layout.
+    auto addHudLabel = [&modalFont](Widget& parent, unsigned int size, sf::Color color, float outline) -> LabelWidget& {
+        auto& label = parent.addChild<LabelWidget>(modalFont, size);
+        label.setColor(color);
+        if (outline > 0.f) label.setOutline(sf::Color::Black, outline);
+        return label;
+    };
+
+    WidgetTree hudUi(WidgetLayout::ColumnLeft);
+    hudUi.getRoot().setPadding(20.f, 20.f);
+    hudUi.getRoot().setSpacing(10.f);
+    LabelWidget& timeLabel = addHudLabel(hudUi.getRoot(), 24, sf::Color::White, 2.f);
+    auto& energyBar = hudUi.getRoot().addChild<BoxWidget>(sf::Vector2f(200.f, 20.f), sf::Color(50, 50, 50));
+    energyBar.setOutline(sf::Color::White, 2.f);
+    LabelWidget& energyLabel = addHudLabel(energyBar, 14, sf::Color::White, 1.f);
+    LabelWidget& pointsLabel = addHudLabel(hudUi.getRoot(), 20, sf::Color::Cyan, 2.f);
+    addHudLabel(hudUi.getRoot(), 20, sf::Color::Cyan, 1.f).setString("Tasks:");
+    auto& taskList = hudUi.getRoot().addChild<Widget>(WidgetLayout::ColumnLeft);
+    taskList.setPadding(0.f, 5.f);
+    taskList.setSpacing(7.f);
+    std::vector<LabelWidget*> taskLabels;   // One per task, clickable for its details
+
+    // Screen overlays (fainting, expulsion, achievements), each centered and
+    // shown only while its state lasts
+    WidgetTree overlayUi;
+    auto& blackOverlay = overlayUi.getRoot().addChild<BoxWidget>(sf::Vector2f(), sf::Color::Black);
+    LabelWidget& faintLabel = addHudLabel(overlayUi.getRoot(), 30, sf::Color::Red, 2.f);
+    faintLabel.setString("Character passed out due to lack of energy!");
+    auto& expelDim = overlayUi.getRoot().addChild<BoxWidget>(sf::Vector2f(), sf::Color(0, 0, 0, 200));
+    auto& expelPanel = overlayUi.getRoot().addChild<Widget>();
+    LabelWidget& expelLabel = addHudLabel(expelPanel, 36, sf::Color::Red, 3.f);
+    expelLabel.setString("Unfortunately, you have fainted too many times\nand have been expelled. Please go home!");
+    expelLabel.setMarginBottom(40.f);
+    auto& gameOverBtn = expelPanel.addChild<BoxWidget>(sf::Vector2f(200.f, 60.f), sf::Color(50, 50, 50));
+    gameOverBtn.setHoverColor(sf::Color(100, 100, 100));
+    gameOverBtn.setOutline(sf::Color::White, 2.f);
+    addHudLabel(gameOverBtn, 28, sf::Color::White, 0.f).setString("Game Over");
+    gameOverBtn.setOnClick([&] {
+        result = AppResult::QuitGame;
+        renderer.quit();
+    });
+    auto& achievementStrip = overlayUi.getRoot().addChild<BoxWidget>(sf::Vector2f(), sf::Color(0, 0, 0, 150));
+    LabelWidget& achievementLabel = addHudLabel(achievementStrip, 30, sf::Color::Yellow, 2.f);
+
+    // Hint toast: a bar sized to its text, 60 px above the bottom of the screen
+    WidgetTree toastUi(WidgetLayout::Bottom);
+    auto& hintBox = toastUi.getRoot().addChild<BoxWidget>(sf::Vector2f(), sf::Color(0, 0, 0, 170));
+    hintBox.setFitContent(sf::Vector2f(24.f, 14.f));
+    hintBox.setOutline(sf::Color(255, 255, 255, 60), 2.f);
+    hintBox.setMarginBottom(60.f);
+    LabelWidget& hintLabel = addHudLabel(hintBox, 22, sf::Color::White, 2.f);
+
+    // Scratch memory for the HUD strings built every frame, dropped at the next frame
+    Arena frameArena("frame scratch", 16 * 1024);
+
+    // Weather and ambient particles, reloaded whenever another map is entered
+    ParticleSystem particles;
+    std::weak_ptr<const TMJMap> particleMap;
+
+    // Time not yet given to tile animations and particles (the quality governor
+    // may skip their update on some frames; see QualitySettings::animationStride)
+    float animationDt = 0.f;
+    unsigned animationFrame = 0;
+
+    // Minimap baked once per map; its markers follow the entrances and the lesson target
+    Minimap minimap;
+    std::weak_ptr<const TMJMap> minimapMap;
+    std::string minimapEntrancePath;   // cachedEntranceMapPath the markers were built from
+    std::string minimapTarget;         // Building highlighted on the minimap
+    int minimapTargetMinute = -1;
+
+    // Downsampled chunk textures drawn instead of the tiles when zoomed out
+    const auto& mapDisplay = configManager.getAppConfig().mapDisplay;
+    MapChunkCache chunkCache;
+    std::weak_ptr<const TMJMap> chunkCacheMap;
+
     // main loop
     sf::Clock clock;
     while (renderer.isRunning()) {
+        frameArena.reset();
+
+        // Run work that worker jobs handed back to the main (GL) thread
+        JobSystem::getInstance().runMainThreadJobs();
+
         // Execute the dialog callback safely when the new frame begins
         if (dialogSys.hasPendingCallback()) {
             Logger::info("Executing pending dialog callback...");
@@ -1363,10 +1556,14 @@ AppResult runApp(
                             
                             // load LG_campus_map
                             std::string campusMapPath = mapLoader.getMapDirectory() + "LG_campus_map.tmj";
+                            Renderer::RenderThreadPause pause(renderer);
                             auto campusMap = mapLoader.loadTMJMap(campusMapPath);
                             if (campusMap) {
                                 tmjMap = campusMap;
+                                glyphs.addTextObjects(tmjMap->getTextObjects(), TextRenderer::LabelOutline);
+                                renderer.prewarmGlyphs(glyphs);
                                 Logger::info("Switched to LG_campus_map successfully");
+                                MemoryTracker::getInstance().logReport("respawned on LG_campus_map");
                             } else {
                                 Logger::error("Failed to load LG_campus_map, using current map");
                             }
@@ -1472,10 +1669,13 @@ AppResult runApp(
         }
         // =================================
 
-        // Unified event handling (polling only once)
+        // Unified event handling (polling only once). Every event goes through
+        // the input manager first; while a dialog owns the input, key presses
+        // only update the key state and trigger no game action.
         std::optional<sf::Event> eventOpt;
         while ((eventOpt = renderer.pollEvent()).has_value()) {
             sf::Event& event = eventOpt.value();
+            inputManager.handleEvent(event, renderer.getLastEventTime(), !dialogSys.isActive());
 
             // Prioritize handling of dialog box events
             if (dialogSys.isActive()) {
@@ -1490,32 +1690,24 @@ AppResult runApp(
                 break;
             }
 
+            if (const auto* moved = event.getIf<sf::Event::MouseMoved>()) {
+                const sf::Vector2f mouseUiPos(moved->position);
+                hudUi.updateHover(mouseUiPos);
+                overlayUi.updateHover(mouseUiPos);
+            }
+
 
             // Full-screen map button
             if (event.is<sf::Event::MouseButtonPressed>()) {
                 auto mb = event.getIf<sf::Event::MouseButtonPressed>();
                 if (mb && mb->button == sf::Mouse::Button::Left) {
                     sf::Vector2i mpos = mb->position;
-                    
-                    // check whether clicked the Game Over button
-                    if (isExpelled) {
-                        sf::Vector2u windowSize = renderer.getWindow().getSize();
-                        float uiWidth = static_cast<float>(windowSize.x);
-                        float uiHeight = static_cast<float>(windowSize.y);
-                        
-                        // Game Over button position: Bottom of the center of the screen
-                        float btnX = uiWidth / 2.0f - 100.f;
-                        float btnY = uiHeight / 2.0f + 40.f;
-                        float btnW = 200.f;
-                        float btnH = 60.f;
-                        
-                        // Check whether the mouse click is within the range of the button.
-                        if (mpos.x >= static_cast<int>(btnX) && mpos.x <= static_cast<int>(btnX + btnW) &&
-                            mpos.y >= static_cast<int>(btnY) && mpos.y <= static_cast<int>(btnY + btnH)) {
-                            result = AppResult::QuitGame;
-                            renderer.quit();
-                            break;
-                        }
+                    const sf::Vector2f mouseUiPos(mpos);
+
+                    // Overlay buttons (Game Over while expelled) sit above everything
+                    if (Widget* hit = overlayUi.hitTest(mouseUiPos)) {
+                        hit->getOnClick()();
+                        if (!renderer.isRunning()) break;
                     }
                     
                     // Check Schedule Button (to the left of Map)
@@ -1527,32 +1719,30 @@ AppResult runApp(
                         showFullMapModal(renderer, tmjMap, configManager);
                     }
                     //  Check Task Clicks
-                    else {
-                        sf::Vector2f mouseUiPos(static_cast<float>(mpos.x), static_cast<float>(mpos.y));
-                        for (const auto& hit : activeTaskHitboxes) {
-                            if (hit.bounds.contains(mouseUiPos)) {
-                                Logger::info("Clicked Task. Showing details.");
-                                // Show detail dialog using existing system
-                                dialogSys.setDialog(
-                                    "Task Details",
-                                    { hit.detailText, "Close" },
-                                    [](const std::string&){}
-                                );
-                                renderer.setModalActive(true);
-                                break; 
-                            }
-                        }
+                    else if (Widget* hit = hudUi.hitTest(mouseUiPos)) {
+                        hit->getOnClick()();
                     }
                 }
             }
         }
 
-        // update the input
+        // update the input; this frame is the first to show the reaction to it
         inputManager.update();
+        if (const auto inputAt = inputManager.getFrameInputTime()) renderer.noteInput(*inputAt);
+        if (inputManager.consumeAction(InputAction::ToggleMemoryOverlay)) showMemoryOverlay = !showMemoryOverlay;
+
+        // Camera zoom: wheel notches, or steady steps while a zoom key is held
+        if (!dialogSys.isActive()) {
+            constexpr float KeyZoomStepsPerSecond = 6.f;
+            float zoomSteps = inputManager.getWheelDelta();
+            if (inputManager.isActionDown(InputAction::ZoomIn)) zoomSteps += KeyZoomStepsPerSecond * deltaTime;
+            if (inputManager.isActionDown(InputAction::ZoomOut)) zoomSteps -= KeyZoomStepsPerSecond * deltaTime;
+            renderer.zoomBy(zoomSteps);
+        }
 
         // E key detection
         // === Block interactions if Fainted ===
-        if (!isFainted && !waitingForEntranceConfirmation && !dialogSys.isActive() && inputManager.isKeyJustPressed(sf::Keyboard::Key::E)) {
+        if (!isFainted && !waitingForEntranceConfirmation && !dialogSys.isActive() && inputManager.consumeAction(InputAction::Interact)) {
             Logger::debug("E key pressed - checking for interaction");
             if (!gameState.isEating) {
                 // detect counter interaction
@@ -1775,8 +1965,9 @@ AppResult runApp(
                 Logger::info("Game Triggered: " + detectedTrigger.name + " | type = " + detectedTrigger.gameType);
 
                 if (detectedTrigger.gameType == "bookstore_puzzle") {
+                    Renderer::RenderThreadPause pause(renderer);
                     QuizGame quizGame;
-                    quizGame.run();
+                    quizGame.run(&renderer);
                     handleTaskCompletion(taskManager, "bookstore_quiz");
 
                 } else if (detectedTrigger.gameType == "classroom_quiz") {
@@ -1792,13 +1983,15 @@ AppResult runApp(
 
                     // Present the prompt text and render
                     std::string hint;
+                    Renderer::RenderThreadPause pause(renderer);
                     auto r = lessonTrigger.tryTrigger(
                         weekday,
                         lastEntranceBuilding,   // detect the building name using entrance
                         minutesNow,
                         quizJsonPath,
                         taskManager,
-                        &hint                   // let LessonTrigger provide specific reasons
+                        &hint,                  // let LessonTrigger provide specific reasons
+                        &renderer
                     );
 
                     Logger::info(std::string("[Classroom] tryTrigger result=") +
@@ -1895,7 +2088,7 @@ AppResult runApp(
             sf::Vector2f moveInput = inputManager.getMoveInput();
             // Sprint Feature (Z Key) 
             float speedMultiplier = 1.0f;
-            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Z)) {
+            if (inputManager.isActionDown(InputAction::Sprint)) {
                 speedMultiplier = 3.0f; // Walk 3x faster
                 // Removed Sprint Task call here
             }
@@ -2021,13 +2214,13 @@ AppResult runApp(
         // Entrance confirmation
         if (waitingForEntranceConfirmation) {
             // If expelled, press Enter to exit the game.
-            if (isExpelled && inputManager.isKeyJustPressed(sf::Keyboard::Key::Enter)) {
+            if (isExpelled && inputManager.isActionJustPressed(InputAction::Confirm)) {
                 result = AppResult::QuitGame;
                 renderer.quit();
                 break;
             }
             
-            if (inputManager.isKeyJustPressed(sf::Keyboard::Key::Enter)) {
+            if (inputManager.consumeAction(InputAction::Confirm)) {
                 std::string fromKey = mapLoader.getCurrentMapPath();
                 if (!fromKey.empty()) {
                     // Compute an offset spawn position one tile away from the entrance area
@@ -2079,6 +2272,10 @@ AppResult runApp(
                 if (!ok) {
                     waitingForEntranceConfirmation = false;
                 } else {
+                    glyphs.addTextObjects(tmjMap->getTextObjects(), TextRenderer::LabelOutline);
+                    renderer.prewarmGlyphs(glyphs);
+                    MemoryTracker::getInstance().logReport("entered " + pendingEntrance.target);
+                    Logger::info(frameArena.describe());
                     sf::Vector2f pos = character.getPosition();
                     for (const auto& a : tmjMap->getEntranceAreas()) {
                         sf::FloatRect r(sf::Vector2f(a.x, a.y), sf::Vector2f(a.width, a.height));
@@ -2091,7 +2288,7 @@ AppResult runApp(
                     renderer.setModalActive(false);
                     waitingForEntranceConfirmation = false;
                 }
-            } else if (inputManager.isKeyJustPressed(sf::Keyboard::Key::Escape)) {
+            } else if (inputManager.consumeAction(InputAction::Cancel)) {
                 // Close the reminder dialog box
                 if (showFaintReminder) {
                     showFaintReminder = false;
@@ -2117,6 +2314,7 @@ AppResult runApp(
             SettlementData data = calculateSettlementData(taskManager.getPoints(), faintCount);
             bool shouldExit = showFinalResultScreen(renderer, data.grade, data.finalStarCount, data.resultText);
             if (shouldExit) {
+                Logger::info(frameArena.describe());
                 return AppResult::QuitGame;
             }
         }
@@ -2127,19 +2325,77 @@ AppResult runApp(
         }
 
         // =update camera
+        renderer.updateZoom(deltaTime);
         renderer.updateCamera(character.getPosition(),
                               tmjMap->getWorldPixelWidth(),
                               tmjMap->getWorldPixelHeight());
 
+        if (particleMap.lock() != tmjMap) {
+            particles.loadFromMap(*tmjMap);
+            particleMap = tmjMap;
+        }
+        const sf::View& camera = renderer.getCurrentView();
+        const sf::FloatRect cameraRect(camera.getCenter() - camera.getSize() / 2.f, camera.getSize());
+
+        // Under load, animated tiles and particles are updated every other frame
+        // with the time of both, so they keep their speed at half the work
+        animationDt += deltaTime;
+        const unsigned animationStride = static_cast<unsigned>(std::max(1, renderer.getQuality().animationStride));
+        if (++animationFrame % animationStride == 0) {
+            tmjMap->updateAnimations(animationDt);
+            particles.update(animationDt, cameraRect);
+            animationDt = 0.f;
+        }
+
+        if (chunkCacheMap.lock() != tmjMap) {
+            if (!TMJMap::isHeadless() && mapDisplay.minZoom < mapDisplay.chunkZoom) {
+                chunkCache.build(*tmjMap, mapDisplay.chunkZoom, renderer);
+            }
+            chunkCacheMap = tmjMap;
+        }
+        if (minimapMap.lock() != tmjMap) {
+            minimap.rebuild(*tmjMap, renderer);
+            minimapMap = tmjMap;
+            minimapEntrancePath.clear();
+        }
+        // The lesson target only changes with the clock (or a finished quiz), checked once per game minute
+        if (minutesNow != minimapTargetMinute || cachedEntranceMapPath != minimapEntrancePath) {
+            minimapTargetMinute = minutesNow;
+            std::string target = lessonTrigger.targetBuilding(weekdayStringFrom(timeManager), minutesNow);
+            if (target != minimapTarget || cachedEntranceMapPath != minimapEntrancePath) {
+                minimapTarget = std::move(target);
+                minimapEntrancePath = cachedEntranceMapPath;
+
+                std::vector<sf::FloatRect> doors;
+                std::vector<sf::FloatRect> highlighted;
+                doors.reserve(entranceZones.size());
+                for (const auto& zone : entranceZones) {
+                    doors.push_back(zone.rect);
+                    if (!minimapTarget.empty() && LessonTrigger::sameBuilding(zone.building, minimapTarget)) {
+                        highlighted.push_back(zone.rect);
+                    }
+                }
+                minimap.setMarkers(doors, highlighted);
+            }
+        }
+
         // render
         renderer.clear();
-        mapLoader.render(&renderer);
-        renderer.renderTextObjects(tmjMap->getTextObjects());
-        renderer.renderEntranceAreas(tmjMap->getEntranceAreas());
-        renderer.renderGameTriggerAreas(tmjMap->getGameTriggers());
+        renderer.beginWorldPass();
+        // Zoomed out, a quad per visible chunk replaces the tiles (animated tiles hold
+        // their first frame there) and the labels are hidden
+        const float zoom = renderer.getZoom();
+        if (zoom < mapDisplay.chunkZoom && !chunkCache.empty()) {
+            chunkCache.render(renderer, cameraRect);
+        } else {
+            mapLoader.render(&renderer);
+        }
+        if (zoom >= mapDisplay.labelZoom) {
+            renderer.renderTextObjects(tmjMap->getTextObjects());
+        }
+        renderer.renderTriggerOverlays(*tmjMap);
         renderer.renderChefs(tmjMap->getChefs());
         renderer.renderProfessors(tmjMap->getProfessors());  
-        renderer.renderShopTriggerAreas(tmjMap->getShopTriggers()); 
 
         
         // adjustment information of professor's position
@@ -2153,7 +2409,8 @@ AppResult runApp(
             showProfessorDebug = false; // only show once
         }
         
-        renderer.drawSprite(character.getSprite());
+        renderer.submitSprite(character.getSprite(), DrawLayer::Actors, character.getFeetPoint().y);
+        particles.render(renderer, cameraRect);
 
         // render the text "resting"
         if (character.getIsResting()) {
@@ -2171,275 +2428,10 @@ AppResult runApp(
             textBounds.position.y + textBounds.size.y / 2
         ));
     
-        renderer.getWindow().draw(restingText);
+        renderer.submitDrawable(restingText, DrawLayer::Labels);
     }
-    // ==============================================
-    // FIXED: UI & OVERLAY RENDER (SCREEN SPACE)
-        // 1. Save the current Game Camera (View)
-        sf::View gameView = renderer.getWindow().getView();
-        
-        // 2. Switch to UI Camera (Default Window Coordinates)
-        // This ensures the UI and Night Overlay don't move with the player!
-        renderer.getWindow().setView(renderer.getWindow().getDefaultView());
-        
-        // Get actual window size for UI calculations
-        sf::Vector2u windowSize = renderer.getWindow().getSize();
-        float uiWidth = static_cast<float>(windowSize.x);
-        float uiHeight = static_cast<float>(windowSize.y);
-
-        // --- A. DAY/NIGHT OVERLAY ---
-        float brightness = timeManager.getDaylightFactor(); 
-        if (brightness < 1.0f) {
-            // Make a rectangle that covers the WHOLE screen
-            sf::RectangleShape nightOverlay(sf::Vector2f(uiWidth, uiHeight));
-            nightOverlay.setPosition(sf::Vector2f(0.f, 0.f));
-            
-            // Calculate Alpha: Brightness 1.0 -> Alpha 0. Brightness 0.3 -> Alpha ~180
-            int alpha = static_cast<int>((1.0f - brightness) * 255); 
-            
-            // Dark Blue-ish tint
-            nightOverlay.setFillColor(sf::Color(0, 0, 40, alpha)); 
-            renderer.getWindow().draw(nightOverlay);
-        }
-
-        // --- B. TIME TEXT ---
-        sf::Text timeText(modalFont, "Time: " + timeManager.getFormattedTime(), 24);
-        // Position at top-left of SCREEN, not map
-        timeText.setPosition(sf::Vector2f(20.f, 20.f)); 
-        timeText.setFillColor(sf::Color::White);
-        timeText.setOutlineColor(sf::Color::Black);
-        timeText.setOutlineThickness(2);
-        renderer.getWindow().draw(timeText);
-
-        // --- C. ENERGY BAR ---
-        sf::RectangleShape energyBarBg(sf::Vector2f(200.f, 20.f));
-        energyBarBg.setPosition(sf::Vector2f(20.f, 60.f));
-        energyBarBg.setFillColor(sf::Color(50, 50, 50));
-        energyBarBg.setOutlineThickness(2);
-        energyBarBg.setOutlineColor(sf::Color::White);
-        
-        float energyPct = taskManager.getEnergy() / 100.0f;
-        sf::RectangleShape energyBarFg(sf::Vector2f(200.f * energyPct, 20.f));
-        energyBarFg.setPosition(sf::Vector2f(20.f, 60.f));
-        energyBarFg.setFillColor(sf::Color::Yellow);
-
-        renderer.getWindow().draw(energyBarBg);
-        renderer.getWindow().draw(energyBarFg);
-
-        // === Numerical Display on Energy Bar ===
-        sf::Text energyNumText(modalFont, "Energy: " + std::to_string(taskManager.getEnergy()) + "/" + std::to_string(taskManager.getMaxEnergy()), 14);
-        energyNumText.setFillColor(sf::Color::White);
-        energyNumText.setOutlineColor(sf::Color::Black);
-        energyNumText.setOutlineThickness(1);
-        sf::FloatRect enBounds = energyNumText.getLocalBounds();
-        energyNumText.setOrigin(sf::Vector2f(enBounds.position.x + enBounds.size.x/2.0f, enBounds.position.y + enBounds.size.y/2.0f));
-        energyNumText.setPosition(sf::Vector2f(20.f + 100.f, 60.f + 10.f)); // Center of bar
-        renderer.getWindow().draw(energyNumText);
-
-        // === REPLACED EXP BAR WITH POINTS TEXT ===
-        sf::Text expNumText(modalFont, "Points: " + std::to_string(taskManager.getPoints()), 20);
-        expNumText.setFillColor(sf::Color::Cyan); // Cyan for points
-        expNumText.setOutlineColor(sf::Color::Black);
-        expNumText.setOutlineThickness(2);
-        expNumText.setPosition(sf::Vector2f(20.f, 90.f)); // Position where EXP bar used to be
-        renderer.getWindow().draw(expNumText);
-        // ===============================================
-
-        // --- D. TASK LIST ---
-        float taskY = 120.f;
-        sf::Text taskHeader(modalFont, "Tasks:", 20);
-        taskHeader.setPosition(sf::Vector2f(20.f, taskY));
-        taskHeader.setFillColor(sf::Color::Cyan);
-        taskHeader.setOutlineColor(sf::Color::Black);
-        taskHeader.setOutlineThickness(1);
-        renderer.getWindow().draw(taskHeader);
-        
-        taskY += 30.f;
-        activeTaskHitboxes.clear(); // Reset hitboxes for this frame
-        for (const auto& t : taskManager.getTasks()) {
-            // === REMOVED "isCompleted" check so tasks always show ===
-            sf::Text taskText(modalFont, "- " + t.description, 18);
-            taskText.setPosition(sf::Vector2f(25.f, taskY));
-            
-            // Highlight if mouse is hovering
-            sf::Vector2i mpos = sf::Mouse::getPosition(renderer.getWindow());
-            sf::FloatRect bounds = taskText.getGlobalBounds();
-            
-            if (bounds.contains(sf::Vector2f(static_cast<float>(mpos.x), static_cast<float>(mpos.y)))) {
-                taskText.setFillColor(sf::Color::Yellow);
-            } else {
-                taskText.setFillColor(sf::Color::White);
-            }
-
-            taskText.setOutlineColor(sf::Color::Black);
-            taskText.setOutlineThickness(1);
-            renderer.getWindow().draw(taskText);
-            
-            // Store hitbox for click detection in next frame
-            activeTaskHitboxes.push_back({bounds, t.detailedInstruction});
-
-            taskY += 25.f;
-        }
-        
-        // --- E. FAINTED TEXT ---
-        if (isFainted && !isBlackScreen) {
-            sf::Text faintText(modalFont, "Character passed out due to lack of energy!", 30);
-            faintText.setFillColor(sf::Color::Red);
-            faintText.setOutlineColor(sf::Color::Black);
-            faintText.setOutlineThickness(2);
-            
-            // Center on screen
-            sf::FloatRect bounds = faintText.getLocalBounds();
-            faintText.setOrigin(sf::Vector2f(bounds.size.x / 2.0f, bounds.size.y / 2.0f));
-            faintText.setPosition(sf::Vector2f(uiWidth / 2.0f, uiHeight / 2.0f));
-            
-            renderer.getWindow().draw(faintText);
-        }
-        
-        // --- F. BLACK SCREEN ---
-        if (isBlackScreen) {
-            // Draw a full-screen black overlay layer
-            sf::RectangleShape blackOverlay(sf::Vector2f(uiWidth, uiHeight));
-            blackOverlay.setPosition(sf::Vector2f(0.f, 0.f));
-            blackOverlay.setFillColor(sf::Color::Black);
-            renderer.getWindow().draw(blackOverlay);
-        }
-        
-        // --- G. EXPULSION MESSAGE ---
-        if (isExpelled) {
-            // Draw a translucent background
-            sf::RectangleShape expelBg(sf::Vector2f(uiWidth, uiHeight));
-            expelBg.setPosition(sf::Vector2f(0.f, 0.f));
-            expelBg.setFillColor(sf::Color(0, 0, 0, 200));
-            renderer.getWindow().draw(expelBg);
-            
-            // Display the message of expulsion
-            sf::Text expelText(modalFont, "Unfortunately, you have fainted too many times\nand have been expelled. Please go home!", 36);
-            expelText.setFillColor(sf::Color::Red);
-            expelText.setOutlineColor(sf::Color::Black);
-            expelText.setOutlineThickness(3);
-            
-            sf::FloatRect expelBounds = expelText.getLocalBounds();
-            expelText.setOrigin(sf::Vector2f(expelBounds.size.x / 2.0f, expelBounds.size.y / 2.0f));
-            expelText.setPosition(sf::Vector2f(uiWidth / 2.0f, uiHeight / 2.0f - 60.0f));
-            renderer.getWindow().draw(expelText);
-            
-            // display Game Over button
-            sf::RectangleShape gameOverBtn(sf::Vector2f(200.f, 60.f));
-            gameOverBtn.setPosition(sf::Vector2f(uiWidth / 2.0f - 100.f, uiHeight / 2.0f + 40.f));
-            
-            // Check if the cursor is on the button
-            sf::Vector2i mousePos = sf::Mouse::getPosition(renderer.getWindow());
-            sf::Vector2f mouseWorldPos = renderer.getWindow().mapPixelToCoords(mousePos);
-            if (gameOverBtn.getGlobalBounds().contains(mouseWorldPos)) {
-                gameOverBtn.setFillColor(sf::Color(100, 100, 100));
-            } else {
-                gameOverBtn.setFillColor(sf::Color(50, 50, 50));
-            }
-            gameOverBtn.setOutlineThickness(2);
-            gameOverBtn.setOutlineColor(sf::Color::White);
-            renderer.getWindow().draw(gameOverBtn);
-            
-            // texts on the button
-            sf::Text btnText(modalFont, "Game Over", 28);
-            btnText.setFillColor(sf::Color::White);
-            sf::FloatRect btnBounds = btnText.getLocalBounds();
-            btnText.setOrigin(sf::Vector2f(btnBounds.size.x / 2.0f, btnBounds.size.y / 2.0f));
-            btnText.setPosition(sf::Vector2f(uiWidth / 2.0f, uiHeight / 2.0f + 70.f));
-            renderer.getWindow().draw(btnText);
-        }
-        
-        // --- H. FAINT REMINDER ---
-        if (showFaintReminder && !isExpelled) {
-            const auto& respawnPoint = tmjMap->getRespawnPoint();
-            std::string reminderText = "You have fainted " + std::to_string(faintCount) + 
-                                     " times. Exceeding " + std::to_string(respawnPoint.maxCount) + 
-                                     " times will result in expulsion!";
-            
-            renderer.renderModalPrompt(reminderText, modalFont, 24, std::nullopt);
-        }
-        // =======================
-
-        // === Achievement Popup ===
-        if (g_achievementTimer > 0.0f) {
-            sf::RectangleShape popBg(sf::Vector2f(uiWidth, 60.f));
-            popBg.setPosition(sf::Vector2f(0.f, uiHeight / 2.0f - 30.f));
-            popBg.setFillColor(sf::Color(0, 0, 0, 150)); // Semi-transparent black strip
-            renderer.getWindow().draw(popBg);
-
-            sf::Text achText(modalFont, g_achievementText, 30);
-            achText.setFillColor(sf::Color::Yellow);
-            achText.setOutlineColor(sf::Color::Black);
-            achText.setOutlineThickness(2);
-            sf::FloatRect ab = achText.getLocalBounds();
-            achText.setOrigin(sf::Vector2f(ab.position.x + ab.size.x/2.0f, ab.position.y + ab.size.y/2.0f));
-            achText.setPosition(sf::Vector2f(uiWidth/2.0f, uiHeight/2.0f));
-            renderer.getWindow().draw(achText);
-        }
-
-        // --- HINT TOAST  ---
-        if (g_hintTimer > 0.f && !g_hintText.empty()) {
-            // Select screen size
-            sf::Vector2u _sz = renderer.getWindow().getSize();
-            float uiWidth  = static_cast<float>(_sz.x);
-            float uiHeight = static_cast<float>(_sz.y);
-
-            const float PADDING_X = 24.f;
-            const float PADDING_Y = 14.f;
-
-            sf::Text hintText(modalFont, g_hintText, 22);
-            hintText.setFillColor(sf::Color::White);
-            hintText.setOutlineColor(sf::Color::Black);
-            hintText.setOutlineThickness(2.f);
-
-            // Text bounding box
-            sf::FloatRect tb = hintText.getLocalBounds();
-            float boxW = tb.size.x + PADDING_X * 2.f;
-            float boxH = tb.size.y + PADDING_Y * 2.f;
-
-            // Centered at the bottom of the screen, 60 pixels away from the bottom
-            float boxX = (uiWidth  - boxW) * 0.5f;
-            float boxY = (uiHeight - boxH) - 60.f;
-
-            // Translucent background bar
-            sf::RectangleShape bg(sf::Vector2f(boxW, boxH));
-            bg.setPosition(sf::Vector2f(boxX, boxY));
-            bg.setFillColor(sf::Color(0, 0, 0, 170));
-            bg.setOutlineThickness(2.f);
-            bg.setOutlineColor(sf::Color(255, 255, 255, 60));
-
-            // Text position: Subtract localBounds.position to avoid baseline offset
-            hintText.setPosition(sf::Vector2f(
-                boxX + PADDING_X - tb.position.x,
-                boxY + PADDING_Y - tb.position.y
-            ));
-
-            renderer.getWindow().draw(bg);
-            renderer.getWindow().draw(hintText);
-        }
-
-        
-        // 3. Restore the Game Camera (So the next frame renders the map correctly)
-        renderer.getWindow().setView(gameView);
-        
-        // ==========================================================
-
-        // Draw schedule button (left) and map button (right)
-        renderer.drawScheduleButton();
-        renderer.drawMapButton();
-
-        if (waitingForEntranceConfirmation) {
-            std::string prompt = "Do you want to enter " + pendingEntrance.name + "?  Enter=Yes  Esc=No";
-            renderer.renderModalPrompt(prompt, modalFont, configManager.getRenderConfig().text.fontSize, std::nullopt);
-        }
-
-        if (dialogSys.isActive()) {
-            dialogSys.render(renderer.getWindow());
-            if (!dialogSys.isActive()) {
-                renderer.setModalActive(false);
-            }
-        }
 
+        // Food on the table and the "Eating..." label live in world space
         if (gameState.isEating && !gameState.selectedFood.empty() && !gameState.currentTable.empty()) {
             const auto& tables = tmjMap->getTables();
             auto tableIt = std::find_if(tables.begin(), tables.end(),
@@ -2470,14 +2462,14 @@ AppResult runApp(
                     // SFML 3 Fix: Use Vector2f
                     foodSprite.setPosition(foodPos);
                     foodSprite.setScale(sf::Vector2f(0.5f, 0.5f));
-                    renderer.getWindow().draw(foodSprite);
+                    renderer.submitDrawable(foodSprite, DrawLayer::Effects);
                 } else {
                     sf::RectangleShape placeholder(sf::Vector2f(32, 32));
                     placeholder.setOrigin(sf::Vector2f(16.0f, 16.0f));
                     // SFML 3 Fix: Use Vector2f
                     placeholder.setPosition(foodPos);
                     placeholder.setFillColor(sf::Color::Red);
-                    renderer.getWindow().draw(placeholder);
+                    renderer.submitDrawable(placeholder, DrawLayer::Effects);
                 }
 
                 sf::Text eatingText(modalFont, "Eating...", 16);
@@ -2495,12 +2487,122 @@ AppResult runApp(
                     textBounds.position.y + textBounds.size.y / 2
                 ));
                 
-                renderer.getWindow().draw(eatingText);
+                renderer.submitDrawable(eatingText, DrawLayer::Effects);
             }
         }
 
+        // --- A. DAY/NIGHT LIGHTING ---
+        // Part of the world pass: lamps baked into the map's lightmap stay lit
+        float brightness = timeManager.getDaylightFactor(); 
+        if (brightness < 1.0f) {
+            // Calculate Alpha: Brightness 1.0 -> Alpha 0. Brightness 0.3 -> Alpha ~180
+            int alpha = static_cast<int>((1.0f - brightness) * 255); 
+            
+            // Dark Blue-ish night, or a flat tint on maps without lamps
+            renderer.renderNightLighting(*tmjMap, sf::Color(0, 0, 40, static_cast<uint8_t>(alpha)));
+        }
+
+        // Upscale the native-resolution world to the window before any UI
+        renderer.endWorldPass();
+
+    // ==============================================
+    // FIXED: UI & OVERLAY RENDER (SCREEN SPACE)
+        // Everything below is submitted to the screen-space UI queue, which is
+        // drawn with the default view so the HUD doesn't move with the player.
+        sf::Vector2u windowSize = renderer.getWindowSize();
+        float uiWidth = static_cast<float>(windowSize.x);
+        float uiHeight = static_cast<float>(windowSize.y);
+
+        // --- B-D. HUD: time, energy, points, tasks ---
+        hudUi.setViewport(windowSize);
+        timeLabel.setString(scratchString(frameArena, "Time: ", timeManager.getFormattedTime()));
+        energyBar.setMeter(taskManager.getEnergy() / 100.0f, sf::Color::Yellow);
+        energyLabel.setString(scratchString(frameArena, "Energy: ", taskManager.getEnergy(), "/", taskManager.getMaxEnergy()));
+        pointsLabel.setString(scratchString(frameArena, "Points: ", taskManager.getPoints()));
+
+        const auto& tasks = taskManager.getTasks();
+        if (taskLabels.size() > tasks.size()) {
+            taskList.truncateChildren(tasks.size());
+            taskLabels.resize(tasks.size());
+        }
+        while (taskLabels.size() < tasks.size()) {
+            const size_t index = taskLabels.size();
+            LabelWidget& label = addHudLabel(taskList, 18, sf::Color::White, 1.f);
+            label.setHoverColor(sf::Color::Yellow);
+            label.setOnClick([&, index] {
+                if (index >= taskManager.getTasks().size()) return;
+                Logger::info("Clicked Task. Showing details.");
+                // Show detail dialog using existing system
+                dialogSys.setDialog(
+                    "Task Details",
+                    { taskManager.getTasks()[index].detailedInstruction, "Close" },
+                    [](const std::string&){}
+                );
+                renderer.setModalActive(true);
+            });
+            taskLabels.push_back(&label);
+        }
+        // === REMOVED "isCompleted" check so tasks always show ===
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            taskLabels[i]->setString(scratchString(frameArena, "- ", tasks[i].description));
+        }
+        hudUi.render(renderer);
+
+        // --- E-G. FAINTED TEXT, BLACK SCREEN, EXPULSION MESSAGE ---
+        overlayUi.setViewport(windowSize);
+        faintLabel.setVisible(isFainted && !isBlackScreen);
+        blackOverlay.setVisible(isBlackScreen);
+        blackOverlay.setSize(sf::Vector2f(uiWidth, uiHeight));
+        expelDim.setVisible(isExpelled);
+        expelDim.setSize(sf::Vector2f(uiWidth, uiHeight));
+        expelPanel.setVisible(isExpelled);
+
+        // === Achievement Popup: semi-transparent black strip ===
+        achievementStrip.setVisible(g_achievementTimer > 0.0f);
+        achievementStrip.setSize(sf::Vector2f(uiWidth, 60.f));
+        achievementLabel.setString(g_achievementText);
+        overlayUi.render(renderer);
+        
+        // --- H. FAINT REMINDER ---
+        if (showFaintReminder && !isExpelled) {
+            const auto& respawnPoint = tmjMap->getRespawnPoint();
+            std::string reminderText = "You have fainted " + std::to_string(faintCount) + 
+                                     " times. Exceeding " + std::to_string(respawnPoint.maxCount) + 
+                                     " times will result in expulsion!";
+            
+            renderer.renderModalPrompt(reminderText, modalFont, 24, std::nullopt);
+        }
+        // =======================
+
+        // --- HINT TOAST  ---
+        toastUi.setViewport(windowSize);
+        hintBox.setVisible(g_hintTimer > 0.f && !g_hintText.empty());
+        hintLabel.setString(g_hintText);
+        toastUi.render(renderer);
+
+        minimap.render(renderer, character.getPosition());
+
+        // Draw schedule button (left) and map button (right)
+        renderer.drawScheduleButton();
+        renderer.drawMapButton();
+
+        if (waitingForEntranceConfirmation) {
+            std::string prompt = "Do you want to enter " + pendingEntrance.name + "?  Enter=Yes  Esc=No";
+            renderer.renderModalPrompt(prompt, modalFont, configManager.getRenderConfig().text.fontSize, std::nullopt);
+        }
+
+        if (dialogSys.isActive()) {
+            dialogSys.render(renderer);
+            if (!dialogSys.isActive()) {
+                renderer.setModalActive(false);
+            }
+        }
+
+        if (showMemoryOverlay) drawMemoryOverlay(renderer, modalFont, frameArena);
+
         renderer.present();
     }
+    Logger::info(frameArena.describe());
     return AppResult::QuitGame;
 }
 
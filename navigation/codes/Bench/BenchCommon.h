@@ -0,0 +1,145 @@
+// BenchCommon.h
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+ * File: BenchCommon.h
+ * Description: Small timing and reporting helpers shared by the benchmark executables.
+ *
+ * The benchmarks are run from the navigation/ directory (like the game) so that
+ * maps/, tiles/, fonts/ and config/ resolve the same way.
+ */
+namespace bench {
+
+/*
+ * Class: Stopwatch
+ * Description: Monotonic wall-clock timer reporting milliseconds.
+ */
+class Stopwatch {
+public:
+    Stopwatch() : start(std::chrono::steady_clock::now()) {}
+
+    void restart() { start = std::chrono::steady_clock::now(); }
+
+    double elapsedMs() const {
+        return std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start
+        ).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point start;
+};
+
+/*
+ * Class: QuietStdout
+ * Description: Discards std::cout (Logger info/warn) while it is alive.
+ */
+class QuietStdout {
+public:
+    QuietStdout() : saved(std::cout.rdbuf(sink.rdbuf())) {}
+    ~QuietStdout() { std::cout.rdbuf(saved); }
+
+private:
+    std::ostringstream sink;
+    std::streambuf* saved;
+};
+
+/**
+ * @brief Summarize samples as count/min/mean/p50/p95/max.
+ *
+ * @param samples Samples (copied, then sorted).
+ * @return nlohmann::json Summary object; empty samples give count 0 only.
+ */
+inline nlohmann::json summarize(std::vector<double> samples) {
+    nlohmann::json out;
+    out["count"] = samples.size();
+    if (samples.empty()) return out;
+
+    std::sort(samples.begin(), samples.end());
+    double sum = 0.0;
+    for (double s : samples) sum += s;
+    auto percentile = [&](double p) {
+        const size_t i = static_cast<size_t>(p * static_cast<double>(samples.size() - 1) + 0.5);
+        return samples[std::min(i, samples.size() - 1)];
+    };
+
+    out["min"] = samples.front();
+    out["mean"] = sum / static_cast<double>(samples.size());
+    out["p50"] = percentile(0.50);
+    out["p95"] = percentile(0.95);
+    out["max"] = samples.back();
+    return out;
+}
+
+/**
+ * @brief Time a callable repeatedly and summarize nanoseconds per operation.
+ *
+ * The callable runs once to warm up and calibrate, then in batches of roughly
+ * 10 ms until minMs has elapsed and at least minBatches batches were taken.
+ * Each batch contributes one ns/op sample. The callable returns a value that is
+ * accumulated into a sink so the work cannot be optimized away.
+ *
+ * @param fn Callable doing opsPerCall operations per invocation; returns size_t.
+ * @param opsPerCall Operations done by one call (e.g. queries in a point set).
+ * @param minMs Minimum total measuring time in milliseconds.
+ * @param minBatches Minimum number of batches (samples).
+ * @return nlohmann::json {"iterations", "opsPerCall", "nsPerOp": summary}.
+ */
+template <typename Fn>
+nlohmann::json measure(Fn&& fn, size_t opsPerCall, double minMs = 200.0, size_t minBatches = 5) {
+    static volatile uint64_t sink = 0;
+    opsPerCall = std::max<size_t>(opsPerCall, 1);
+
+    Stopwatch calibrate;
+    sink = sink + fn();
+    const double oneCallMs = std::max(calibrate.elapsedMs(), 1e-6);
+    const size_t callsPerBatch = std::max<size_t>(1, static_cast<size_t>(10.0 / oneCallMs));
+
+    std::vector<double> nsPerOp;
+    size_t iterations = 0;
+    Stopwatch total;
+    while (nsPerOp.size() < minBatches || total.elapsedMs() < minMs) {
+        Stopwatch batch;
+        for (size_t i = 0; i < callsPerBatch; ++i) sink = sink + fn();
+        const double ms = batch.elapsedMs();
+        nsPerOp.push_back(ms * 1e6 / static_cast<double>(callsPerBatch * opsPerCall));
+        iterations += callsPerBatch;
+    }
+
+    nlohmann::json out;
+    out["iterations"] = iterations;
+    out["opsPerCall"] = opsPerCall;
+    out["nsPerOp"] = summarize(std::move(nsPerOp));
+    return out;
+}
+
+/**
+ * @brief List the TMJ maps in a directory, sorted by file name.
+ *
+ * @param dir Directory to scan.
+ * @return std::vector<std::filesystem::path> Map file paths.
+ */
+inline std::vector<std::filesystem::path> listMaps(const std::string& dir) {
+    std::vector<std::filesystem::path> maps;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".tmj") {
+            maps.push_back(entry.path());
+        }
+    }
+    std::sort(maps.begin(), maps.end());
+    return maps;
+}
+
+} // namespace bench
@@ -0,0 +1,409 @@
+// MapBudget.cpp
+#include "Bench/BenchCommon.h"
+#include "Config/ConfigManager.h"
+#include "MapLoader/TMJMap.h"
+#include "Utils/Logger.h"
+#include <SFML/Graphics.hpp>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/*
+ * File: MapBudget.cpp
+ * Description: Reports the runtime cost of a TMJ map and checks it against budgets.
+ *
+ * The map is loaded through TMJMap::loadFromFile (headless, so no display is
+ * needed) and measured the way the game uses it:
+ *   - tiles per tile layer (after occlusion culling);
+ *   - tileset sheet bytes and how much of each sheet the map uses;
+ *   - distinct textures and estimated draw calls per view-sized region;
+ *   - NotWalkable shapes and polygon vertices;
+ *   - label glyphs (total and distinct glyph/size pairs for the atlas);
+ *   - the load time of each loader phase.
+ *
+ * A view is mapDisplay.tilesWidth x tilesHeight tiles from app_config.json,
+ * like the game camera. The draw call estimate follows the world pass: tiles
+ * are batched per tile layer and texture, every label is its own draw call and
+ * all trigger overlays share one.
+ *
+ * Usage (from navigation/):
+ *   map_budget MAP.tmj [--budgets FILE] [--report FILE]
+ *
+ * Exit code: 0 if every budget holds, 1 if one is exceeded, 2 on setup errors.
+ *
+ * Notes:
+ *   - Budgets come from config/map_budgets.json; keys missing there are not checked.
+ */
+
+namespace {
+    using json = nlohmann::json;
+
+    struct Options {
+        std::string mapPath;
+        std::string budgetsPath = "config/map_budgets.json";
+        std::string reportPath;
+    };
+
+    bool parseArgs(int argc, char** argv, Options& opt) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg.rfind("--", 0) != 0) {
+                if (!opt.mapPath.empty()) {
+                    Logger::error("Only one map can be analyzed at a time");
+                    return false;
+                }
+                opt.mapPath = arg;
+                continue;
+            }
+            if (i + 1 >= argc) {
+                Logger::error("Missing value for " + arg);
+                return false;
+            }
+            const std::string value = argv[++i];
+
+            if (arg == "--budgets") opt.budgetsPath = value;
+            else if (arg == "--report") opt.reportPath = value;
+            else {
+                Logger::error("Unknown argument: " + arg);
+                return false;
+            }
+        }
+        if (opt.mapPath.empty()) {
+            Logger::error("Usage: map_budget MAP.tmj [--budgets FILE] [--report FILE]");
+            return false;
+        }
+        return true;
+    }
+
+    std::string formatBytes(double bytes) {
+        char buffer[32];
+        if (bytes >= 1024.0 * 1024.0) std::snprintf(buffer, sizeof(buffer), "%.1f MB", bytes / (1024.0 * 1024.0));
+        else std::snprintf(buffer, sizeof(buffer), "%.1f KB", bytes / 1024.0);
+        return buffer;
+    }
+
+    // Index of the tileset whose texture a sprite references, or -1.
+    int tilesetOf(const TMJMap& map, const sf::Sprite& sprite) {
+        const auto& tilesets = map.getTilesets();
+        for (size_t i = 0; i < tilesets.size(); ++i) {
+            if (&tilesets[i].texture == &sprite.getTexture()) return static_cast<int>(i);
+        }
+        return -1;
+    }
+
+    json analyzeLayers(const TMJMap& map) {
+        const auto& names = map.getTileLayerNames();
+        std::vector<size_t> counts(names.size(), 0);
+        for (uint16_t layer : map.getTileLayers()) {
+            if (layer >= counts.size()) counts.resize(layer + 1, 0);
+            ++counts[layer];
+        }
+
+        json layers = json::array();
+        std::cout << "Tiles: " << map.getTiles().size() << std::endl;
+        for (size_t i = 0; i < counts.size(); ++i) {
+            const std::string name = i < names.size() ? names[i] : "";
+            std::cout << "  layer " << i << " '" << name << "': " << counts[i] << std::endl;
+            layers.push_back({{"index", i}, {"name", name}, {"tiles", counts[i]}});
+        }
+        return layers;
+    }
+
+    json analyzeTilesets(const TMJMap& map, size_t& totalBytes) {
+        const auto& tilesets = map.getTilesets();
+        std::vector<std::set<int>> used(tilesets.size());
+        for (const auto& sprite : map.getTiles()) {
+            const int index = tilesetOf(map, sprite);
+            if (index < 0) continue;
+            const TilesetInfo& ts = tilesets[static_cast<size_t>(index)];
+            const int stepX = ts.tileWidth + ts.spacing;
+            const int stepY = ts.tileHeight + ts.spacing;
+            if (stepX <= 0 || stepY <= 0 || ts.columns <= 0) continue;
+            const sf::IntRect rect = sprite.getTextureRect();
+            const int col = (rect.position.x - ts.margin) / stepX;
+            const int row = (rect.position.y - ts.margin) / stepY;
+            used[static_cast<size_t>(index)].insert(row * ts.columns + col);
+        }
+
+        json out = json::array();
+        totalBytes = 0;
+        std::cout << "Tilesets:" << std::endl;
+        for (size_t i = 0; i < tilesets.size(); ++i) {
+            const TilesetInfo& ts = tilesets[i];
+            const sf::Vector2u size = ts.image.getSize();
+            const size_t bytes = static_cast<size_t>(size.x) * size.y * 4;
+            totalBytes += bytes;
+
+            // Share of the sheet's pixels covered by tiles the map draws
+            const double sheetArea = static_cast<double>(size.x) * size.y;
+            const double usedArea = static_cast<double>(used[i].size()) * ts.tileWidth * ts.tileHeight;
+            const double utilisation = sheetArea > 0.0 ? usedArea / sheetArea : 0.0;
+
+            std::cout << "  " << ts.name << ": " << size.x << "x" << size.y << ", " << formatBytes(static_cast<double>(bytes))
+                      << ", " << used[i].size() << "/" << ts.tileCount << " tiles used, "
+                      << static_cast<int>(std::lround(utilisation * 100.0)) << "% of the sheet" << std::endl;
+            out.push_back({
+                {"name", ts.name}, {"width", size.x}, {"height", size.y}, {"bytes", bytes},
+                {"tileCount", ts.tileCount}, {"tilesUsed", used[i].size()}, {"utilisation", utilisation}
+            });
+        }
+        std::cout << "  total: " << formatBytes(static_cast<double>(totalBytes)) << std::endl;
+        return out;
+    }
+
+    /*
+     * Class: ViewStats
+     * Description: Per-region textures and draw calls over a grid of view-sized regions.
+     */
+    struct ViewStats {
+        size_t regions = 0;
+        size_t maxTextures = 0;
+        double meanTextures = 0.0;
+        size_t maxDrawCalls = 0;
+        double meanDrawCalls = 0.0;
+        sf::Vector2f worstDrawCallsAt;   // Top-left corner of the most expensive region
+    };
+
+    ViewStats analyzeViews(const TMJMap& map, sf::Vector2f viewSize) {
+        const float worldW = static_cast<float>(map.getWorldPixelWidth());
+        const float worldH = static_cast<float>(map.getWorldPixelHeight());
+        viewSize.x = std::clamp(viewSize.x, 1.f, std::max(worldW, 1.f));
+        viewSize.y = std::clamp(viewSize.y, 1.f, std::max(worldH, 1.f));
+        const int cols = std::max(1, static_cast<int>(std::ceil(worldW / viewSize.x)));
+        const int rows = std::max(1, static_cast<int>(std::ceil(worldH / viewSize.y)));
+        const size_t regionCount = static_cast<size_t>(cols) * static_cast<size_t>(rows);
+
+        // Calls every region a rect overlaps
+        auto forRegions = [&](const sf::FloatRect& r, auto&& fn) {
+            const int c0 = std::clamp(static_cast<int>(r.position.x / viewSize.x), 0, cols - 1);
+            const int r0 = std::clamp(static_cast<int>(r.position.y / viewSize.y), 0, rows - 1);
+            const int c1 = std::clamp(static_cast<int>((r.position.x + r.size.x) / viewSize.x), 0, cols - 1);
+            const int r1 = std::clamp(static_cast<int>((r.position.y + r.size.y) / viewSize.y), 0, rows - 1);
+            for (int y = r0; y <= r1; ++y) {
+                for (int x = c0; x <= c1; ++x) fn(static_cast<size_t>(y) * static_cast<size_t>(cols) + static_cast<size_t>(x));
+            }
+        };
+
+        // Tile batches per region: (layer, tileset) keys; consecutive tiles mostly repeat the last key
+        std::vector<std::vector<uint32_t>> batches(regionCount);
+        const auto& tiles = map.getTiles();
+        const auto& layers = map.getTileLayers();
+        for (size_t i = 0; i < tiles.size(); ++i) {
+            const int tileset = tilesetOf(map, tiles[i]);
+            const uint32_t layer = i < layers.size() ? layers[i] : 0;
+            const uint32_t key = (layer << 16) | static_cast<uint32_t>(tileset + 1);
+            forRegions(tiles[i].getGlobalBounds(), [&](size_t region) {
+                auto& keys = batches[region];
+                if (keys.empty() || keys.back() != key) keys.push_back(key);
+            });
+        }
+
+        std::vector<size_t> labels(regionCount, 0);
+        for (const auto& t : map.getTextObjects()) {
+            forRegions(sf::FloatRect({t.x, t.y}, {t.width, t.height}), [&](size_t region) { ++labels[region]; });
+        }
+
+        std::vector<uint8_t> overlays(regionCount, 0);
+        auto markOverlay = [&](const sf::FloatRect& r) {
+            forRegions(r, [&](size_t region) { overlays[region] = 1; });
+        };
+        for (const auto& e : map.getEntranceAreas()) markOverlay(sf::FloatRect({e.x, e.y}, {e.width, e.height}));
+        for (const auto& g : map.getGameTriggers()) markOverlay(sf::FloatRect({g.x, g.y}, {g.width, g.height}));
+        for (const auto& s : map.getShopTriggers()) markOverlay(s.rect);
+
+        ViewStats stats;
+        stats.regions = regionCount;
+        double textureSum = 0.0;
+        double drawCallSum = 0.0;
+        for (size_t region = 0; region < regionCount; ++region) {
+            auto& keys = batches[region];
+            std::sort(keys.begin(), keys.end());
+            keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+            std::set<uint32_t> textures;
+            for (uint32_t key : keys) textures.insert(key & 0xFFFF);
+
+            const size_t drawCalls = keys.size() + labels[region] + overlays[region];
+            textureSum += static_cast<double>(textures.size());
+            drawCallSum += static_cast<double>(drawCalls);
+            stats.maxTextures = std::max(stats.maxTextures, textures.size());
+            if (drawCalls > stats.maxDrawCalls) {
+                stats.maxDrawCalls = drawCalls;
+                stats.worstDrawCallsAt = sf::Vector2f(
+                    static_cast<float>(region % static_cast<size_t>(cols)) * viewSize.x,
+                    static_cast<float>(region / static_cast<size_t>(cols)) * viewSize.y
+                );
+            }
+        }
+        stats.meanTextures = textureSum / static_cast<double>(regionCount);
+        stats.meanDrawCalls = drawCallSum / static_cast<double>(regionCount);
+
+        std::cout << "Views (" << viewSize.x << "x" << viewSize.y << " px, " << regionCount << " regions):" << std::endl;
+        std::cout << "  textures per view: max " << stats.maxTextures << ", mean " << stats.meanTextures << std::endl;
+        std::cout << "  draw calls per view: max " << stats.maxDrawCalls << " at (" << stats.worstDrawCallsAt.x
+                  << ", " << stats.worstDrawCallsAt.y << "), mean " << stats.meanDrawCalls << std::endl;
+        return stats;
+    }
+
+    json analyzeCollision(const TMJMap& map, size_t& shapes, size_t& vertices) {
+        const size_t rects = map.getNotWalkRects().size();
+        const size_t polys = map.getNotWalkPolys().size();
+        size_t polyVertices = 0;
+        for (const auto& poly : map.getNotWalkPolys()) polyVertices += poly.points.size();
+
+        shapes = rects + polys;
+        vertices = rects * 4 + polyVertices;
+        std::cout << "Collision: " << rects << " rects, " << polys << " polygons with "
+                  << polyVertices << " vertices (" << vertices << " vertices in total)" << std::endl;
+        return {{"rects", rects}, {"polygons", polys}, {"polygonVertices", polyVertices}, {"vertices", vertices}};
+    }
+
+    json analyzeLabels(const TMJMap& map, size_t& glyphs) {
+        std::set<std::tuple<uint32_t, unsigned int, bool>> distinct;   // Code point, size, bold
+        size_t longest = 0;
+        glyphs = 0;
+        for (const auto& t : map.getTextObjects()) {
+            const sf::String text = sf::String::fromUtf8(t.text.begin(), t.text.end());
+            size_t count = 0;
+            for (const char32_t c : text) {
+                if (c == U' ' || c == U'\t' || c == U'\n') continue;
+                ++count;
+                distinct.emplace(static_cast<uint32_t>(c), t.fontSize, t.bold);
+            }
+            glyphs += count;
+            longest = std::max(longest, count);
+        }
+
+        std::cout << "Labels: " << map.getTextObjects().size() << " with " << glyphs << " glyphs ("
+                  << distinct.size() << " distinct glyph/size pairs, longest " << longest << ")" << std::endl;
+        return {{"labels", map.getTextObjects().size()}, {"glyphs", glyphs},
+                {"distinctGlyphs", distinct.size()}, {"longestLabel", longest}};
+    }
+
+    json reportTimings(const MapLoadTimings& t) {
+        std::cout << "Load: " << t.totalMs << " ms (parse " << t.parseMs << ", tilesets " << t.tilesetsMs
+                  << ", objects " << t.objectsMs << ", tile layers " << t.tileLayersMs << ", collision "
+                  << t.collisionMs << ", culling " << t.cullingMs << ", lighting " << t.lightingMs << ")" << std::endl;
+        return {
+            {"totalMs", t.totalMs}, {"parseMs", t.parseMs}, {"tilesetsMs", t.tilesetsMs},
+            {"objectsMs", t.objectsMs}, {"tileLayersMs", t.tileLayersMs},
+            {"collisionMs", t.collisionMs}, {"cullingMs", t.cullingMs}, {"lightingMs", t.lightingMs}
+        };
+    }
+
+    // Compares each measured value with its budget; returns true if any is exceeded.
+    bool checkBudgets(const json& budgets, const std::vector<std::pair<std::string, double>>& measured, json& report) {
+        bool exceeded = false;
+        json results = json::array();
+        for (const auto& [key, value] : measured) {
+            if (!budgets.contains(key) || !budgets[key].is_number()) continue;
+            const double limit = budgets[key].get<double>();
+            const bool over = value > limit;
+            exceeded = exceeded || over;
+            results.push_back({{"budget", key}, {"limit", limit}, {"value", value}, {"exceeded", over}});
+            if (over) {
+                std::cout << "OVER BUDGET " << key << ": " << value << " > " << limit << std::endl;
+            }
+        }
+        report["budgets"] = results;
+        return exceeded;
+    }
+}
+
+
+/**
+ * @brief Map budget analyzer entry point.
+ *
+ * @return int 0 within budget, 1 if a budget is exceeded, 2 on setup/load errors.
+ */
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) return 2;
+
+    auto& configManager = ConfigManager::getInstance();
+    if (!configManager.loadAllConfigs()) {
+        Logger::error("map_budget: failed to load configurations");
+        return 2;
+    }
+
+    json budgets = json::object();
+    {
+        std::ifstream in(opt.budgetsPath);
+        try {
+            in >> budgets;
+        } catch (const std::exception& ex) {
+            Logger::error("map_budget: cannot read budgets " + opt.budgetsPath + ": " + ex.what());
+            return 2;
+        }
+    }
+
+    TMJMap::setHeadless(true);
+    TMJMap map;
+    bool loaded = false;
+    {
+        bench::QuietStdout quiet;
+        loaded = map.loadFromFile(opt.mapPath);
+    }
+    if (!loaded) {
+        Logger::error("map_budget: failed to load " + opt.mapPath);
+        return 2;
+    }
+
+    const auto& mapDisplay = configManager.getAppConfig().mapDisplay;
+    const sf::Vector2f viewSize(
+        static_cast<float>(mapDisplay.tilesWidth * map.getTileWidth()),
+        static_cast<float>(mapDisplay.tilesHeight * map.getTileHeight())
+    );
+
+    std::cout << opt.mapPath << ": " << map.getMapWidthTiles() << "x" << map.getMapHeightTiles() << " tiles of "
+              << map.getTileWidth() << "x" << map.getTileHeight() << " px" << std::endl;
+
+    json report;
+    report["map"] = opt.mapPath;
+    report["layers"] = analyzeLayers(map);
+
+    size_t textureBytes = 0;
+    report["tilesets"] = analyzeTilesets(map, textureBytes);
+
+    const ViewStats views = analyzeViews(map, viewSize);
+    report["views"] = {
+        {"width", viewSize.x}, {"height", viewSize.y}, {"regions", views.regions},
+        {"maxTextures", views.maxTextures}, {"meanTextures", views.meanTextures},
+        {"maxDrawCalls", views.maxDrawCalls}, {"meanDrawCalls", views.meanDrawCalls}
+    };
+
+    size_t shapes = 0, vertices = 0, glyphs = 0;
+    report["collision"] = analyzeCollision(map, shapes, vertices);
+    report["labels"] = analyzeLabels(map, glyphs);
+    report["load"] = reportTimings(map.getLoadTimings());
+
+    const bool exceeded = checkBudgets(budgets, {
+        {"maxTiles", static_cast<double>(map.getTiles().size())},
+        {"maxTextureBytes", static_cast<double>(textureBytes)},
+        {"maxTexturesPerView", static_cast<double>(views.maxTextures)},
+        {"maxDrawCallsPerView", static_cast<double>(views.maxDrawCalls)},
+        {"maxCollisionShapes", static_cast<double>(shapes)},
+        {"maxCollisionVertices", static_cast<double>(vertices)},
+        {"maxLabelGlyphs", static_cast<double>(glyphs)},
+        {"maxLoadMs", map.getLoadTimings().totalMs}
+    }, report);
+
+    if (!opt.reportPath.empty()) {
+        std::ofstream out(opt.reportPath);
+        if (!out) {
+            Logger::error("map_budget: cannot write " + opt.reportPath);
+            return 2;
+        }
+        out << report.dump(2) << std::endl;
+    }
+
+    std::cout << (exceeded ? "Budget exceeded" : "Within budget") << std::endl;
+    return exceeded ? 1 : 0;
+}
@@ -0,0 +1,391 @@
+// MicroBench.cpp
+#include "Bench/BenchCommon.h"
+#include "Config/ConfigManager.h"
+#include "Jobs/JobSystem.h"
+#include "Manager/TaskManager.h"
+#include "MapLoader/TMJMap.h"
+#include "QuizGame/LessonTrigger.h"
+#include "QuizGame/QuizGame.h"
+#include "Renderer/ParticleSystem.h"
+#include "Renderer/TextRenderer.h"
+#include "Utils/Logger.h"
+#include <SFML/Graphics.hpp>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+ * File: MicroBench.cpp
+ * Description: Micro-benchmarks for the loader, collision, text, particle and quiz hot paths.
+ *
+ * Every benchmark runs against the real assets under maps/, tiles/, fonts/ and
+ * config/ (run from navigation/). Results are written as JSON; with --baseline
+ * the p50 ns/op of each benchmark is compared against a saved report.
+ *
+ * Usage (from navigation/):
+ *   micro_bench [--maps DIR] [--out FILE] [--baseline FILE] [--threshold FRACTION]
+ *               [--min-ms MS] [--filter SUBSTRING] [--workers N]
+ *
+ * Exit code: 0 on success, 1 if a benchmark regressed past the threshold,
+ *            2 on setup errors.
+ *
+ * Notes:
+ *   - Maps are loaded in TMJMap headless mode and extrusion is timed without the
+ *     GPU upload, so the suite runs on machines without a display.
+ *   - tryTrigger is driven with a building that is never scheduled, which covers
+ *     the schedule lookup and hint paths without opening the quiz window.
+ *   - The particle stress case keeps 100k immortal particles alive in one pool
+ *     and times the update and the view-culled vertex build separately.
+ */
+
+namespace {
+    using json = nlohmann::json;
+
+    struct Options {
+        std::string mapsDir = "maps/";
+        std::string outPath = "micro_bench.json";
+        std::string baselinePath;
+        std::string filter;
+        double threshold = 0.10;   // Allowed p50 slowdown before a result counts as regressed
+        double minMs = 200.0;
+        int workers = 0;           // Job system workers; 0 keeps loads single-threaded
+    };
+
+    bool parseArgs(int argc, char** argv, Options& opt) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (i + 1 >= argc) {
+                Logger::error("Missing value for " + arg);
+                return false;
+            }
+            const std::string value = argv[++i];
+
+            if (arg == "--maps") opt.mapsDir = value;
+            else if (arg == "--out") opt.outPath = value;
+            else if (arg == "--baseline") opt.baselinePath = value;
+            else if (arg == "--threshold") opt.threshold = std::atof(value.c_str());
+            else if (arg == "--min-ms") opt.minMs = std::atof(value.c_str());
+            else if (arg == "--filter") opt.filter = value;
+            else if (arg == "--workers") opt.workers = std::atoi(value.c_str());
+            else {
+                Logger::error("Unknown argument: " + arg);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /*
+     * Class: Suite
+     * Description: Runs named benchmarks (honouring --filter) and collects results.
+     */
+    class Suite {
+    public:
+        explicit Suite(const Options& opt) : opt(opt) {}
+
+        template <typename Fn>
+        void run(const std::string& name, size_t opsPerCall, Fn&& fn) {
+            if (!opt.filter.empty() && name.find(opt.filter) == std::string::npos) return;
+
+            json result;
+            {
+                bench::QuietStdout quiet;
+                result = bench::measure(std::forward<Fn>(fn), opsPerCall, opt.minMs);
+            }
+            result["name"] = name;
+            std::cout << name << ": " << result["nsPerOp"]["p50"].get<double>() << " ns/op (p50)" << std::endl;
+            results.push_back(std::move(result));
+        }
+
+        json results = json::array();
+
+    private:
+        const Options& opt;
+    };
+
+    // Deterministic point sets over the map's world rectangle.
+    std::vector<sf::Vector2f> randomPoints(const TMJMap& map, size_t count, uint32_t seed) {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<float> dx(0.f, static_cast<float>(map.getWorldPixelWidth()));
+        std::uniform_real_distribution<float> dy(0.f, static_cast<float>(map.getWorldPixelHeight()));
+        std::vector<sf::Vector2f> points(count);
+        for (auto& p : points) p = sf::Vector2f(dx(gen), dy(gen));
+        return points;
+    }
+
+    // A walking path: small steps that change direction now and then, like the player.
+    std::vector<sf::Vector2f> trajectoryPoints(const TMJMap& map, size_t count, uint32_t seed) {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<float> turn(-0.6f, 0.6f);
+        const float w = static_cast<float>(map.getWorldPixelWidth());
+        const float h = static_cast<float>(map.getWorldPixelHeight());
+        sf::Vector2f p(w * 0.5f, h * 0.5f);
+        float heading = 0.f;
+        std::vector<sf::Vector2f> points(count);
+        for (auto& out : points) {
+            heading += turn(gen);
+            p.x = std::clamp(p.x + 2.f * std::cos(heading), 0.f, w - 1.f);
+            p.y = std::clamp(p.y + 2.f * std::sin(heading), 0.f, h - 1.f);
+            out = p;
+        }
+        return points;
+    }
+
+    void benchMap(Suite& suite, const std::filesystem::path& path, const std::string& fontPath,
+                  std::set<std::string>& extrudedSheets) {
+        const std::string name = path.stem().string();
+
+        suite.run("load/" + name, 1, [&]() {
+            TMJMap map;
+            map.loadFromFile(path.string());
+            return map.getTiles().size();
+        });
+
+        TMJMap map;
+        {
+            bench::QuietStdout quiet;
+            if (!map.loadFromFile(path.string())) {
+                Logger::error("micro_bench: failed to load " + path.string());
+                return;
+            }
+        }
+
+        for (const auto& ts : map.getTilesets()) {
+            if (ts.imagePath.empty() || !extrudedSheets.insert(ts.imagePath).second) continue;
+            auto src = std::make_shared<sf::Image>();
+            if (!src->loadFromFile(ts.imagePath)) continue;
+            const int columns = ts.columns > 0 ? ts.columns : static_cast<int>(src->getSize().x) / std::max(ts.origTileW, 1);
+            suite.run("extrude/" + ts.name, 1, [&, src, columns]() {
+                sf::Image out;
+                TMJMap::makeExtrudedImage(*src, ts.origTileW, ts.origTileH, columns,
+                                          ts.origSpacing, ts.origMargin, 1, out);
+                return static_cast<size_t>(out.getSize().x);
+            });
+        }
+
+        const auto random = randomPoints(map, 4096, 1234u);
+        suite.run("feetBlockedAt/random/" + name, random.size(), [&]() {
+            size_t blocked = 0;
+            for (const auto& p : random) blocked += map.feetBlockedAt(p) ? 1 : 0;
+            return blocked;
+        });
+
+        const auto walk = trajectoryPoints(map, 4096, 4321u);
+        suite.run("feetBlockedAt/trajectory/" + name, walk.size(), [&]() {
+            size_t blocked = 0;
+            for (const auto& p : walk) blocked += map.feetBlockedAt(p) ? 1 : 0;
+            return blocked;
+        });
+
+        int maxGid = 1;
+        for (const auto& ts : map.getTilesets()) maxGid = std::max(maxGid, ts.firstGid + ts.tileCount - 1);
+        std::vector<int> gids(4096);
+        std::mt19937 gen(99u);
+        std::uniform_int_distribution<int> gidDist(1, maxGid);
+        for (auto& g : gids) g = gidDist(gen);
+        const TMJMap& constMap = map;
+        suite.run("findTilesetForGid/" + name, gids.size(), [&]() {
+            size_t found = 0;
+            for (int g : gids) found += constMap.findTilesetForGid(g) ? 1 : 0;
+            return found;
+        });
+
+        const auto& labels = map.getTextObjects();
+        if (!labels.empty()) {
+            TextRenderer textRenderer;
+            textRenderer.setApproximateMetrics(true);
+            bool fontOk = false;
+            {
+                bench::QuietStdout quiet;
+                fontOk = textRenderer.initialize(fontPath);
+            }
+            if (fontOk) {
+                std::vector<sf::Text> texts;
+                suite.run("textLabels/" + name, labels.size(), [&]() {
+                    texts.clear();
+                    textRenderer.buildTexts(labels, texts);
+                    return texts.size();
+                });
+            }
+        }
+    }
+
+    // Compare p50 ns/op with a saved report; returns true if anything regressed.
+    bool compareWithBaseline(json& report, const json& baseline, double threshold) {
+        std::map<std::string, double> base;
+        if (baseline.contains("results")) {
+            for (const auto& r : baseline["results"]) {
+                if (r.contains("name") && r.contains("nsPerOp") && r["nsPerOp"].contains("p50")) {
+                    base[r["name"].get<std::string>()] = r["nsPerOp"]["p50"].get<double>();
+                }
+            }
+        }
+
+        bool regressed = false;
+        json comparison = json::array();
+        for (const auto& r : report["results"]) {
+            const std::string name = r["name"].get<std::string>();
+            const double now = r["nsPerOp"]["p50"].get<double>();
+            json c;
+            c["name"] = name;
+            c["p50"] = now;
+
+            auto it = base.find(name);
+            if (it == base.end() || it->second <= 0.0) {
+                c["status"] = "new";
+            } else {
+                const double ratio = now / it->second;
+                c["baselineP50"] = it->second;
+                c["ratio"] = ratio;
+                if (ratio > 1.0 + threshold) {
+                    c["status"] = "regressed";
+                    regressed = true;
+                } else if (ratio < 1.0 - threshold) {
+                    c["status"] = "improved";
+                } else {
+                    c["status"] = "unchanged";
+                }
+                std::cout << name << ": x" << ratio << " vs baseline (" << c["status"].get<std::string>() << ")" << std::endl;
+            }
+            comparison.push_back(c);
+        }
+        report["baseline"] = {{"threshold", threshold}, {"comparison", comparison}};
+        return regressed;
+    }
+
+    // 100k particles spread over a large world; only the ones in a 1920x1080 view become vertices.
+    void benchParticles(Suite& suite) {
+        constexpr size_t Count = 100000;
+
+        ParticleStyle style = ParticleStyle::preset(ParticleEffect::Leaves);
+        style.lifeMin = style.lifeMax = 1.0e6f;   // Nobody expires, so every frame sees all of them
+        ParticlePool pool(style, Count);
+        std::mt19937 gen(7);
+        pool.spawn(sf::FloatRect({0.f, 0.f}, {8192.f, 8192.f}), Count, gen);
+
+        suite.run("particles/update/100k", Count, [&]() {
+            pool.update(1.f / 60.f);
+            return pool.size();
+        });
+
+        const sf::FloatRect view({3136.f, 3556.f}, {1920.f, 1080.f});
+        suite.run("particles/vertices/100k", Count, [&]() {
+            return pool.buildVertices(view);
+        });
+
+        const sf::FloatRect everything({-4096.f, -4096.f}, {16384.f, 16384.f});
+        suite.run("particles/vertices/100k-all-visible", Count, [&]() {
+            return pool.buildVertices(everything);
+        });
+    }
+}
+
+
+/**
+ * @brief Micro-benchmark entry point.
+ *
+ * @return int 0 on success, 1 on a regression against the baseline, 2 on setup errors.
+ */
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) return 2;
+
+    auto& configManager = ConfigManager::getInstance();
+    if (!configManager.loadAllConfigs()) {
+        Logger::error("micro_bench: failed to load configurations");
+        return 2;
+    }
+    const std::string fontPath = configManager.getRenderConfig().text.fontPath;
+
+    const auto maps = bench::listMaps(opt.mapsDir);
+    if (maps.empty()) {
+        Logger::error("micro_bench: no .tmj maps in " + opt.mapsDir);
+        return 2;
+    }
+
+    TMJMap::setHeadless(true);
+    JobSystem::getInstance().initialize(opt.workers);
+    Suite suite(opt);
+    std::set<std::string> extrudedSheets;
+    for (const auto& path : maps) {
+        benchMap(suite, path, fontPath, extrudedSheets);
+    }
+
+    benchParticles(suite);
+
+    LessonTrigger lessons;
+    if (lessons.loadSchedule("config/quiz/course_schedule.json")) {
+        const std::vector<std::string> weekdays = {"Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Sun"};
+        TaskManager taskManager;
+        suite.run("lessonTrigger/tryTrigger", weekdays.size() * 288, [&]() {
+            size_t hintChars = 0;
+            std::string hint;
+            for (const auto& day : weekdays) {
+                for (int minute = 0; minute < 24 * 60; minute += 5) {
+                    hint.clear();
+                    lessons.tryTrigger(day, "__bench_unscheduled_building__", minute,
+                                       "config/quiz/classroom_basic.json", taskManager, &hint);
+                    hintChars += hint.size();
+                }
+            }
+            return hintChars;
+        });
+    }
+
+    // Force the first category so every iteration parses the same questions
+    std::string category;
+    {
+        std::ifstream ifs("config/quiz/classroom_basic.json");
+        json quiz;
+        try {
+            ifs >> quiz;
+            if (quiz.contains("categories") && quiz["categories"].is_object() && !quiz["categories"].empty()) {
+                category = quiz["categories"].begin().key();
+            }
+        } catch (const std::exception& ex) {
+            Logger::warn(std::string("micro_bench: cannot read quiz bank: ") + ex.what());
+        }
+    }
+    suite.run("quiz/loadQuestionBank", 1, [&]() {
+        return static_cast<size_t>(std::max(0, QuizGame::loadQuestionBank("config/quiz/classroom_basic.json", category)));
+    });
+
+    json report;
+    report["benchmark"] = "micro";
+    report["minMs"] = opt.minMs;
+    report["workers"] = JobSystem::getInstance().getWorkerCount();
+    report["results"] = suite.results;
+
+    bool regressed = false;
+    if (!opt.baselinePath.empty()) {
+        std::ifstream in(opt.baselinePath);
+        json baseline;
+        try {
+            in >> baseline;
+        } catch (const std::exception& ex) {
+            Logger::error("micro_bench: cannot read baseline " + opt.baselinePath + ": " + ex.what());
+            return 2;
+        }
+        regressed = compareWithBaseline(report, baseline, opt.threshold);
+    }
+
+    std::ofstream out(opt.outPath);
+    if (!out) {
+        Logger::error("micro_bench: cannot write " + opt.outPath);
+        return 2;
+    }
+    out << report.dump(2) << std::endl;
+    Logger::info("micro_bench: results written to " + opt.outPath);
+
+    return regressed ? 1 : 0;
+}
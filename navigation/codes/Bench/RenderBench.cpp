@@ -0,0 +1,321 @@
+// RenderBench.cpp
+#include "Bench/BenchCommon.h"
+#include "Config/ConfigManager.h"
+#include "MapLoader/TMJMap.h"
+#include "Renderer/Renderer.h"
+#include "Renderer/SoftwareRenderBackend.h"
+#include "Utils/Logger.h"
+#include <SFML/Graphics.hpp>
+#include <nlohmann/json.hpp>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*
+ * File: RenderBench.cpp
+ * Description: Headless golden-image render benchmark over every campus map.
+ *
+ * For each .tmj file in maps/ the benchmark loads the map without a GPU, flies
+ * the camera along a fixed Lissajous path and renders every frame through the
+ * normal world pass into the software backend. It records CPU frame times (command building
+ * and rasterization separately), draw calls and texture binds, captures frames
+ * at checkpoints and compares them against golden PNGs.
+ *
+ * Usage (from navigation/):
+ *   render_bench [--maps DIR] [--golden DIR] [--report FILE] [--artifacts DIR]
+ *                [--frames N] [--checkpoints N] [--size WxH]
+ *                [--channel-tolerance N] [--max-mismatch FRACTION] [--update-golden]
+ *
+ * Exit code: 0 when all checkpoints match (or goldens were written),
+ *            1 on a golden mismatch or a missing golden, 2 on setup or load errors.
+ */
+
+namespace {
+    using json = nlohmann::json;
+
+    struct Options {
+        std::string mapsDir = "maps/";
+        std::string goldenDir = "bench/golden/";
+        std::string reportPath = "render_bench.json";
+        std::string artifactsDir;
+        int frames = 240;
+        int checkpoints = 4;
+        sf::Vector2u frameSize{640u, 480u};
+        int channelTolerance = 8;       // Max per-channel difference still counted as equal
+        double maxMismatch = 0.001;     // Max fraction of differing pixels per checkpoint
+        bool updateGolden = false;
+    };
+
+    bool parseArgs(int argc, char** argv, Options& opt) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    Logger::error("Missing value for " + arg);
+                    std::exit(2);
+                }
+                return argv[++i];
+            };
+
+            if (arg == "--maps") opt.mapsDir = value();
+            else if (arg == "--golden") opt.goldenDir = value();
+            else if (arg == "--report") opt.reportPath = value();
+            else if (arg == "--artifacts") opt.artifactsDir = value();
+            else if (arg == "--frames") opt.frames = std::max(1, std::atoi(value().c_str()));
+            else if (arg == "--checkpoints") opt.checkpoints = std::max(0, std::atoi(value().c_str()));
+            else if (arg == "--channel-tolerance") opt.channelTolerance = std::atoi(value().c_str());
+            else if (arg == "--max-mismatch") opt.maxMismatch = std::atof(value().c_str());
+            else if (arg == "--update-golden") opt.updateGolden = true;
+            else if (arg == "--size") {
+                const std::string s = value();
+                const size_t x = s.find('x');
+                if (x == std::string::npos) {
+                    Logger::error("--size expects WxH, got " + s);
+                    return false;
+                }
+                opt.frameSize = sf::Vector2u(
+                    static_cast<unsigned>(std::atoi(s.substr(0, x).c_str())),
+                    static_cast<unsigned>(std::atoi(s.substr(x + 1).c_str()))
+                );
+            } else {
+                Logger::error("Unknown argument: " + arg);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Camera center for frame i of n: a Lissajous figure covering most of the map.
+    sf::Vector2f cameraAt(int i, int n, float mapW, float mapH) {
+        const float t = static_cast<float>(i) / static_cast<float>(n);
+        const float twoPi = 6.2831853f;
+        return sf::Vector2f(
+            mapW * (0.5f + 0.4f * std::sin(twoPi * t)),
+            mapH * (0.5f + 0.4f * std::sin(2.f * twoPi * t + 1.5707963f))
+        );
+    }
+
+    // Compare a frame against a golden image; fills "mismatchedPixels", "maxChannelDelta".
+    bool matchesGolden(const sf::Image& frame, const sf::Image& golden, const Options& opt, json& result) {
+        if (frame.getSize() != golden.getSize()) {
+            result["error"] = "size mismatch";
+            return false;
+        }
+
+        const uint8_t* a = frame.getPixelsPtr();
+        const uint8_t* b = golden.getPixelsPtr();
+        const size_t count = static_cast<size_t>(frame.getSize().x) * frame.getSize().y;
+        size_t mismatched = 0;
+        int maxDelta = 0;
+        for (size_t p = 0; p < count; ++p) {
+            int pixelDelta = 0;
+            for (size_t c = 0; c < 4; ++c) {
+                pixelDelta = std::max(pixelDelta, std::abs(int(a[p * 4 + c]) - int(b[p * 4 + c])));
+            }
+            maxDelta = std::max(maxDelta, pixelDelta);
+            if (pixelDelta > opt.channelTolerance) ++mismatched;
+        }
+
+        const double fraction = count ? static_cast<double>(mismatched) / static_cast<double>(count) : 0.0;
+        result["mismatchedPixels"] = mismatched;
+        result["mismatchFraction"] = fraction;
+        result["maxChannelDelta"] = maxDelta;
+        return fraction <= opt.maxMismatch;
+    }
+
+    // Render one map along the camera path; returns false on a golden mismatch.
+    bool benchMap(
+        const std::filesystem::path& mapPath,
+        Renderer& renderer,
+        const Options& opt,
+        json& report,
+        bool& loadFailed
+    ) {
+        const std::string name = mapPath.stem().string();
+        json entry;
+        entry["map"] = name;
+
+        TMJMap map;
+        bench::Stopwatch loadTimer;
+        if (!map.loadFromFile(mapPath.string())) {
+            Logger::error("render_bench: failed to load " + mapPath.string());
+            entry["error"] = "load failed";
+            report["maps"].push_back(entry);
+            loadFailed = true;
+            return true;
+        }
+        entry["loadMs"] = loadTimer.elapsedMs();
+        entry["tiles"] = map.getTiles().size();
+        renderer.registerMapTextures(map);
+
+        const float mapW = static_cast<float>(map.getWorldPixelWidth());
+        const float mapH = static_cast<float>(map.getWorldPixelHeight());
+        SoftwareRenderBackend& backend = *renderer.getSoftwareBackend();
+
+        std::vector<int> checkpointFrames;
+        for (int k = 0; k < opt.checkpoints; ++k) {
+            checkpointFrames.push_back(static_cast<int>(
+                (static_cast<double>(k) + 0.5) * opt.frames / opt.checkpoints
+            ));
+        }
+
+        std::vector<double> frameMs, buildMs, rasterMs;
+        std::vector<double> drawCalls, textureBinds, vertices, pixels;
+        bool allMatch = true;
+        json checkpoints = json::array();
+
+        // updateCamera shrinks the view on small maps; start every map from the full frame
+        const sf::Vector2f frameSize(static_cast<float>(opt.frameSize.x), static_cast<float>(opt.frameSize.y));
+        renderer.setView(sf::View(frameSize * 0.5f, frameSize));
+
+        for (int i = 0; i < opt.frames; ++i) {
+            renderer.updateCamera(cameraAt(i, opt.frames, mapW, mapH),
+                                  map.getWorldPixelWidth(), map.getWorldPixelHeight());
+            backend.resetStats();
+
+            bench::Stopwatch frameTimer;
+            renderer.beginWorldPass();
+            renderer.renderMapTiles(map);
+            renderer.renderTextObjects(map.getTextObjects());
+            renderer.renderTriggerOverlays(map);
+            renderer.renderChefs(map.getChefs());
+            renderer.renderProfessors(map.getProfessors());
+            const double built = frameTimer.elapsedMs();
+            renderer.endWorldPass();
+            const double total = frameTimer.elapsedMs();
+
+            frameMs.push_back(total);
+            buildMs.push_back(built);
+            rasterMs.push_back(total - built);
+            const DrawStats& stats = renderer.getFrameStats();
+            drawCalls.push_back(static_cast<double>(stats.drawCalls));
+            textureBinds.push_back(static_cast<double>(stats.textureBinds));
+            vertices.push_back(static_cast<double>(stats.vertices));
+            pixels.push_back(static_cast<double>(backend.getStats().pixelsShaded));
+
+            if (std::find(checkpointFrames.begin(), checkpointFrames.end(), i) == checkpointFrames.end()) {
+                continue;
+            }
+
+            const std::string shot = name + "_" + std::to_string(i) + ".png";
+            const std::filesystem::path goldenPath = std::filesystem::path(opt.goldenDir) / shot;
+            const sf::Image frame = backend.toImage();
+            json cp;
+            cp["frame"] = i;
+            cp["golden"] = goldenPath.generic_string();
+
+            if (opt.updateGolden) {
+                std::filesystem::create_directories(opt.goldenDir);
+                cp["status"] = frame.saveToFile(goldenPath) ? "written" : "write failed";
+            } else {
+                sf::Image golden;
+                if (!std::filesystem::exists(goldenPath) || !golden.loadFromFile(goldenPath)) {
+                    // Nothing to compare against is a failure, not a pass; `make golden` writes it
+                    cp["status"] = "missing";
+                    allMatch = false;
+                    Logger::error("render_bench: missing golden " + goldenPath.generic_string());
+                } else if (matchesGolden(frame, golden, opt, cp)) {
+                    cp["status"] = "match";
+                } else {
+                    cp["status"] = "mismatch";
+                    allMatch = false;
+                    if (!opt.artifactsDir.empty()) {
+                        std::filesystem::create_directories(opt.artifactsDir);
+                        const auto actual = std::filesystem::path(opt.artifactsDir) / shot;
+                        if (frame.saveToFile(actual)) cp["actual"] = actual.generic_string();
+                    }
+                }
+            }
+            checkpoints.push_back(cp);
+        }
+
+        entry["frameMs"] = bench::summarize(frameMs);
+        entry["buildMs"] = bench::summarize(buildMs);
+        entry["rasterMs"] = bench::summarize(rasterMs);
+        entry["drawCalls"] = bench::summarize(drawCalls);
+        entry["textureBinds"] = bench::summarize(textureBinds);
+        entry["vertices"] = bench::summarize(vertices);
+        entry["pixelsShaded"] = bench::summarize(pixels);
+        entry["checkpoints"] = checkpoints;
+        report["maps"].push_back(entry);
+
+        Logger::info("render_bench: " + name + " mean " +
+                     std::to_string(entry["frameMs"]["mean"].get<double>()) + " ms/frame, " +
+                     std::to_string(entry["drawCalls"]["mean"].get<double>()) + " draw calls");
+        return allMatch;
+    }
+}
+
+
+/**
+ * @brief Benchmark entry point.
+ *
+ * @return int 0 on success, 1 on a golden mismatch or missing golden, 2 on setup/load errors.
+ */
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) return 2;
+
+    auto& configManager = ConfigManager::getInstance();
+    if (!configManager.loadAllConfigs()) {
+        Logger::error("render_bench: failed to load configurations");
+        return 2;
+    }
+
+    TMJMap::setHeadless(true);
+    Renderer renderer;
+    if (!renderer.initializeHeadless(configManager.getAppConfig(), configManager.getRenderConfig(), opt.frameSize)) {
+        return 2;
+    }
+    renderer.initializeChefTexture();
+    renderer.initializeProfessorTexture();
+
+    const auto maps = bench::listMaps(opt.mapsDir);
+    if (maps.empty()) {
+        Logger::error("render_bench: no .tmj maps in " + opt.mapsDir);
+        return 2;
+    }
+
+    json report;
+    report["benchmark"] = "render";
+    report["backend"] = "software";
+    report["frameSize"] = {opt.frameSize.x, opt.frameSize.y};
+    report["framesPerMap"] = opt.frames;
+    report["channelTolerance"] = opt.channelTolerance;
+    report["maxMismatch"] = opt.maxMismatch;
+    report["maps"] = json::array();
+
+    bool allMatch = true;
+    bool loadFailed = false;
+    for (const auto& mapPath : maps) {
+        allMatch = benchMap(mapPath, renderer, opt, report, loadFailed) && allMatch;
+    }
+    report["passed"] = allMatch && !loadFailed;
+
+    size_t missing = 0;
+    for (const auto& entry : report["maps"]) {
+        for (const auto& cp : entry["checkpoints"]) {
+            if (cp.value("status", "") == "missing") ++missing;
+        }
+    }
+    report["missingGoldens"] = missing;
+    if (missing > 0) {
+        Logger::error("render_bench: " + std::to_string(missing) + " golden images missing in " + opt.goldenDir +
+                      "; run `make golden` from navigation/ on a build with SFML and commit them");
+    }
+
+    std::ofstream out(opt.reportPath);
+    if (!out) {
+        Logger::error("render_bench: cannot write report " + opt.reportPath);
+        return 2;
+    }
+    out << report.dump(2) << std::endl;
+    Logger::info("render_bench: report written to " + opt.reportPath);
+
+    if (loadFailed) return 2;
+    return allMatch ? 0 : 1;
+}
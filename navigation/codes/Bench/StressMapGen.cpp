@@ -0,0 +1,435 @@
+// StressMapGen.cpp
+#include "Utils/Logger.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+/*
+ * File: StressMapGen.cpp
+ * Description: Writes large synthetic TMJ maps for scaling tests of the loader,
+ *              renderer, collision and trigger code.
+ *
+ * The tilesets, tile size and tile mix are taken from a reference map (by
+ * default maps/lower_campus_map.tmj): every generated tile is a GID that the
+ * reference map actually uses, drawn with the same frequency, so the stress
+ * map has the same share of opaque and colliding tiles. The first tile layer
+ * is filled completely, every further layer is filled with the given density.
+ *
+ * On top come object layers named like the ones the game parses: NotWalkable
+ * rects and polygons, entrances targeting the reference map's targets,
+ * building labels, game and shop triggers, lamps for the night lightmap, and
+ * a protagonist spawn in the middle of the map.
+ *
+ * Usage (from navigation/):
+ *   stress_map_gen [--width TILES] [--height TILES] [--layers N] [--density FRACTION]
+ *                  [--rects N] [--polygons N] [--entrances N] [--labels N]
+ *                  [--triggers N] [--lights N] [--seed N] [--reference FILE] [--out FILE]
+ *
+ * The benchmarks take the output directory with --maps, e.g.
+ *   stress_map_gen --out maps/stress/stress_2000.tmj
+ *   micro_bench --maps maps/stress/
+ *
+ * Exit code: 0 on success, 2 on bad arguments or an unreadable reference map.
+ *
+ * Notes:
+ *   - The same seed and options always produce the same file.
+ *   - Tile data is streamed to the file, so 2000x2000 maps with several
+ *     layers don't need the whole document in memory.
+ */
+
+namespace {
+    using json = nlohmann::json;
+
+    struct Options {
+        int width = 2000;            // Tiles
+        int height = 2000;
+        int layers = 4;              // Tile layers; the first one is always full
+        double density = 0.35;       // Share of non-empty cells in the other layers
+        int rects = 4000;            // NotWalkable rectangles
+        int polygons = 1000;         // NotWalkable polygons
+        int entrances = 2000;
+        int labels = 3000;
+        int triggers = 2000;         // Split between game and shop triggers
+        int lights = 2000;
+        uint32_t seed = 1;
+        std::string referencePath = "maps/lower_campus_map.tmj";
+        std::string outPath;         // Default: maps/stress/stress_<width>x<height>.tmj
+    };
+
+    bool parseArgs(int argc, char** argv, Options& opt) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (i + 1 >= argc) {
+                Logger::error("Missing value for " + arg);
+                return false;
+            }
+            const std::string value = argv[++i];
+
+            if (arg == "--width") opt.width = std::atoi(value.c_str());
+            else if (arg == "--height") opt.height = std::atoi(value.c_str());
+            else if (arg == "--layers") opt.layers = std::atoi(value.c_str());
+            else if (arg == "--density") opt.density = std::atof(value.c_str());
+            else if (arg == "--rects") opt.rects = std::atoi(value.c_str());
+            else if (arg == "--polygons") opt.polygons = std::atoi(value.c_str());
+            else if (arg == "--entrances") opt.entrances = std::atoi(value.c_str());
+            else if (arg == "--labels") opt.labels = std::atoi(value.c_str());
+            else if (arg == "--triggers") opt.triggers = std::atoi(value.c_str());
+            else if (arg == "--lights") opt.lights = std::atoi(value.c_str());
+            else if (arg == "--seed") opt.seed = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+            else if (arg == "--reference") opt.referencePath = value;
+            else if (arg == "--out") opt.outPath = value;
+            else {
+                Logger::error("Unknown argument: " + arg);
+                return false;
+            }
+        }
+
+        if (opt.width <= 0 || opt.height <= 0 || opt.layers <= 0) {
+            Logger::error("Width, height and layers must be positive");
+            return false;
+        }
+        if (opt.rects < 0 || opt.polygons < 0 || opt.entrances < 0 || opt.labels < 0 || opt.triggers < 0 ||
+            opt.lights < 0) {
+            Logger::error("Object counts must not be negative");
+            return false;
+        }
+        opt.density = std::clamp(opt.density, 0.0, 1.0);
+        if (opt.outPath.empty()) {
+            opt.outPath = "maps/stress/stress_" + std::to_string(opt.width) + "x" +
+                          std::to_string(opt.height) + ".tmj";
+        }
+        return true;
+    }
+
+    /*
+     * Class: Reference
+     * Description: What the generated map borrows from the reference map.
+     */
+    struct Reference {
+        int tileWidth = 16;
+        int tileHeight = 16;
+        json tilesets = json::array();        // Embedded tilesets, image paths rewritten
+        std::vector<int> groundGids;          // GIDs of the first tile layer, with repeats
+        std::vector<int> overlayGids;         // GIDs of the other tile layers, with repeats
+        std::vector<std::string> targets;     // Entrance targets
+    };
+
+    void collectGids(const json& layer, std::vector<int>& ground, std::vector<int>& overlay, bool& seenFirst) {
+        const std::string type = layer.value("type", "");
+        if (type == "group" && layer.contains("layers") && layer["layers"].is_array()) {
+            for (const auto& sub : layer["layers"]) collectGids(sub, ground, overlay, seenFirst);
+            return;
+        }
+        if (type != "tilelayer" || !layer.contains("data") || !layer["data"].is_array()) return;
+
+        std::vector<int>& into = seenFirst ? overlay : ground;
+        seenFirst = true;
+        for (const auto& cell : layer["data"]) {
+            if (cell.is_number_integer() && cell.get<int>() > 0) into.push_back(cell.get<int>());
+        }
+    }
+
+    bool loadReference(const Options& opt, Reference& ref) {
+        namespace fs = std::filesystem;
+
+        std::ifstream in(opt.referencePath);
+        json map;
+        try {
+            in >> map;
+        } catch (const std::exception& ex) {
+            Logger::error("Cannot read reference map " + opt.referencePath + ": " + ex.what());
+            return false;
+        }
+
+        ref.tileWidth = map.value("tilewidth", 16);
+        ref.tileHeight = map.value("tileheight", 16);
+
+        // Image paths are relative to the map file; re-anchor them at the output file
+        const fs::path referenceDir = fs::absolute(opt.referencePath).parent_path();
+        const fs::path outDir = fs::absolute(opt.outPath).parent_path();
+        for (const auto& ts : map.value("tilesets", json::array())) {
+            if (!ts.contains("image") || !ts["image"].is_string()) continue;   // External .tsx: not loadable
+            json copy = ts;
+            const fs::path image = (referenceDir / ts["image"].get<std::string>()).lexically_normal();
+            copy["image"] = image.lexically_relative(outDir).generic_string();
+            ref.tilesets.push_back(std::move(copy));
+        }
+        if (ref.tilesets.empty()) {
+            Logger::error("Reference map has no embedded tilesets: " + opt.referencePath);
+            return false;
+        }
+
+        // Keep only GIDs of the copied tilesets
+        auto known = [&](int gid) {
+            for (const auto& ts : ref.tilesets) {
+                const int first = ts.value("firstgid", 1);
+                if (gid >= first && gid < first + ts.value("tilecount", 0)) return true;
+            }
+            return false;
+        };
+
+        bool seenFirst = false;
+        for (const auto& layer : map.value("layers", json::array())) {
+            collectGids(layer, ref.groundGids, ref.overlayGids, seenFirst);
+
+            if (layer.value("type", "") != "objectgroup") continue;
+            for (const auto& obj : layer.value("objects", json::array())) {
+                for (const auto& p : obj.value("properties", json::array())) {
+                    if (p.value("name", "") == "target" && p.contains("value") && p["value"].is_string()) {
+                        ref.targets.push_back(p["value"].get<std::string>());
+                    }
+                }
+            }
+        }
+
+        ref.groundGids.erase(std::remove_if(ref.groundGids.begin(), ref.groundGids.end(),
+                                            [&](int gid) { return !known(gid); }), ref.groundGids.end());
+        ref.overlayGids.erase(std::remove_if(ref.overlayGids.begin(), ref.overlayGids.end(),
+                                             [&](int gid) { return !known(gid); }), ref.overlayGids.end());
+        if (ref.groundGids.empty()) {
+            Logger::error("Reference map has no tiles from its embedded tilesets");
+            return false;
+        }
+        if (ref.overlayGids.empty()) ref.overlayGids = ref.groundGids;
+
+        std::sort(ref.targets.begin(), ref.targets.end());
+        ref.targets.erase(std::unique(ref.targets.begin(), ref.targets.end()), ref.targets.end());
+        if (ref.targets.empty()) ref.targets.push_back("library.tmj");
+        return true;
+    }
+
+    /*
+     * Class: ObjectFactory
+     * Description: Random TMJ objects inside the world rectangle, with unique ids.
+     */
+    class ObjectFactory {
+    public:
+        ObjectFactory(std::mt19937& gen, float worldW, float worldH) : gen(gen), worldW(worldW), worldH(worldH) {}
+
+        json rect(const std::string& name, const std::string& type, float minSize, float maxSize) {
+            std::uniform_real_distribution<float> size(minSize, maxSize);
+            const float w = size(gen);
+            const float h = size(gen);
+            json obj = base(name, type, w, h);
+            obj["width"] = w;
+            obj["height"] = h;
+            return obj;
+        }
+
+        // Star-shaped polygon: sorted angles with random radii never self-intersect
+        json polygon(float minRadius, float maxRadius) {
+            std::uniform_int_distribution<int> corners(4, 10);
+            std::uniform_real_distribution<float> angle(0.f, 6.2831853f);
+            std::uniform_real_distribution<float> radius(minRadius, maxRadius);
+
+            std::vector<float> angles(static_cast<size_t>(corners(gen)));
+            for (float& a : angles) a = angle(gen);
+            std::sort(angles.begin(), angles.end());
+
+            json obj = base("", "", maxRadius * 2.f, maxRadius * 2.f);
+            obj["x"] = obj["x"].get<float>() + maxRadius;
+            obj["y"] = obj["y"].get<float>() + maxRadius;
+            obj["width"] = 0;
+            obj["height"] = 0;
+            json points = json::array();
+            for (float a : angles) {
+                const float r = radius(gen);
+                points.push_back({{"x", r * std::cos(a)}, {"y", r * std::sin(a)}});
+            }
+            obj["polygon"] = std::move(points);
+            return obj;
+        }
+
+        json point(const std::string& name, const std::string& type, float x, float y, float w, float h) {
+            json obj = base(name, type, w, h);
+            obj["x"] = x;
+            obj["y"] = y;
+            obj["width"] = w;
+            obj["height"] = h;
+            return obj;
+        }
+
+        int nextId() const { return id; }
+
+    private:
+        json base(const std::string& name, const std::string& type, float w, float h) {
+            std::uniform_real_distribution<float> x(0.f, std::max(1.f, worldW - w));
+            std::uniform_real_distribution<float> y(0.f, std::max(1.f, worldH - h));
+            return {
+                {"id", id++}, {"name", name}, {"type", type}, {"rotation", 0},
+                {"visible", true}, {"x", x(gen)}, {"y", y(gen)}
+            };
+        }
+
+        std::mt19937& gen;
+        float worldW;
+        float worldH;
+        int id = 1;
+    };
+
+    json objectLayer(int id, const std::string& name, json objects) {
+        return {
+            {"id", id}, {"name", name}, {"type", "objectgroup"}, {"draworder", "topdown"},
+            {"opacity", 1}, {"visible", true}, {"x", 0}, {"y", 0}, {"objects", std::move(objects)}
+        };
+    }
+
+    json property(const std::string& name, const std::string& value) {
+        return {{"name", name}, {"type", "string"}, {"value", value}};
+    }
+
+    // Header of a tile layer; the data array is streamed after it.
+    json tileLayerHeader(int id, const std::string& name, const Options& opt) {
+        return {
+            {"id", id}, {"name", name}, {"type", "tilelayer"}, {"opacity", 1}, {"visible", true},
+            {"x", 0}, {"y", 0}, {"width", opt.width}, {"height", opt.height}
+        };
+    }
+
+    void writeTileLayer(std::ostream& out, const json& header, const std::vector<int>& gids,
+                        double density, const Options& opt, std::mt19937& gen) {
+        std::string head = header.dump();
+        head.pop_back();   // Reopen the object to append the data array
+        out << head << ",\"data\":[";
+
+        std::uniform_int_distribution<size_t> pick(0, gids.size() - 1);
+        std::bernoulli_distribution filled(density);
+        const size_t cells = static_cast<size_t>(opt.width) * static_cast<size_t>(opt.height);
+        for (size_t i = 0; i < cells; ++i) {
+            if (i > 0) out << ',';
+            out << (filled(gen) ? gids[pick(gen)] : 0);
+        }
+        out << "]}";
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) return 2;
+
+    Reference ref;
+    if (!loadReference(opt, ref)) return 2;
+
+    std::error_code ec;
+    const std::filesystem::path outPath(opt.outPath);
+    if (outPath.has_parent_path()) std::filesystem::create_directories(outPath.parent_path(), ec);
+    std::ofstream out(opt.outPath, std::ios::binary);
+    if (!out) {
+        Logger::error("Cannot write " + opt.outPath);
+        return 2;
+    }
+
+    std::mt19937 gen(opt.seed);
+    const float worldW = static_cast<float>(opt.width * ref.tileWidth);
+    const float worldH = static_cast<float>(opt.height * ref.tileHeight);
+    ObjectFactory factory(gen, worldW, worldH);
+    int layerId = 1;
+
+    // Object layers (generated first so the object ids are known for the header)
+    json objectLayers = json::array();
+    {
+        json blocked = json::array();
+        for (int i = 0; i < opt.rects; ++i) blocked.push_back(factory.rect("", "", 8.f, 6.f * ref.tileWidth));
+        for (int i = 0; i < opt.polygons; ++i) blocked.push_back(factory.polygon(ref.tileWidth * 1.f, ref.tileWidth * 5.f));
+
+        json entrances = json::array();
+        std::uniform_int_distribution<size_t> target(0, ref.targets.size() - 1);
+        for (int i = 0; i < opt.entrances; ++i) {
+            json obj = factory.rect("E" + std::to_string(i), "entrance", 24.f, 44.f);
+            const std::string building = "B" + std::to_string(i);
+            obj["properties"] = json::array({property("building", building), property("target", ref.targets[target(gen)])});
+            entrances.push_back(std::move(obj));
+        }
+
+        json labels = json::array();
+        for (int i = 0; i < opt.labels; ++i) {
+            json obj = factory.rect("name_" + std::to_string(i), "label_name", 16.f, 80.f);
+            obj["height"] = 16;
+            obj["text"] = {{"text", "Building " + std::to_string(i)}, {"halign", "center"},
+                           {"valign", "center"}, {"wrap", true}};
+            labels.push_back(std::move(obj));
+        }
+
+        json games = json::array();
+        json shops = json::array();
+        for (int i = 0; i < opt.triggers; ++i) {
+            if (i % 2 == 0) {
+                json obj = factory.rect("game_" + std::to_string(i), "game_trigger", 30.f, 40.f);
+                obj["properties"] = json::array({property("gameType", "stress_test")});
+                games.push_back(std::move(obj));
+            } else {
+                shops.push_back(factory.rect("shop_" + std::to_string(i), "convenience", 30.f, 40.f));
+            }
+        }
+
+        json lights = json::array();
+        std::uniform_real_distribution<float> lightRadius(3.f * ref.tileWidth, 10.f * ref.tileWidth);
+        for (int i = 0; i < opt.lights; ++i) {
+            json obj = factory.rect("lamp_" + std::to_string(i), "light", 0.f, 0.f);
+            obj["point"] = true;
+            obj["properties"] = json::array({
+                {{"name", "radius"}, {"type", "float"}, {"value", lightRadius(gen)}},
+                {{"name", "color"}, {"type", "color"}, {"value", "#ffffd696"}}
+            });
+            lights.push_back(std::move(obj));
+        }
+
+        json npcs = json::array({
+            factory.point("protagonist", "Character", worldW * 0.5f, worldH * 0.5f, 30.f, 30.f)
+        });
+
+        const int firstObjectLayer = opt.layers + 1;
+        objectLayers.push_back(objectLayer(firstObjectLayer + 0, "NotWalkable", std::move(blocked)));
+        objectLayers.push_back(objectLayer(firstObjectLayer + 1, "entrance", std::move(entrances)));
+        objectLayers.push_back(objectLayer(firstObjectLayer + 2, "building_names", std::move(labels)));
+        objectLayers.push_back(objectLayer(firstObjectLayer + 3, "game_triggers", std::move(games)));
+        objectLayers.push_back(objectLayer(firstObjectLayer + 4, "convenience_triggers", std::move(shops)));
+        objectLayers.push_back(objectLayer(firstObjectLayer + 5, "npc", std::move(npcs)));
+        objectLayers.push_back(objectLayer(firstObjectLayer + 6, "lights", std::move(lights)));
+    }
+
+    json header = {
+        {"type", "map"}, {"version", "1.10"}, {"tiledversion", "1.11.2"},
+        {"orientation", "orthogonal"}, {"renderorder", "right-down"}, {"infinite", false},
+        {"compressionlevel", -1},
+        {"width", opt.width}, {"height", opt.height},
+        {"tilewidth", ref.tileWidth}, {"tileheight", ref.tileHeight},
+        {"nextlayerid", opt.layers + 1 + static_cast<int>(objectLayers.size())},
+        {"nextobjectid", factory.nextId()},
+        {"tilesets", ref.tilesets}
+    };
+
+    std::string head = header.dump();
+    head.pop_back();
+    out << head << ",\"layers\":[";
+
+    for (int layer = 0; layer < opt.layers; ++layer) {
+        if (layer > 0) out << ',';
+        const bool ground = layer == 0;
+        writeTileLayer(out, tileLayerHeader(layerId++, ground ? "ground" : "layer_" + std::to_string(layer), opt),
+                       ground ? ref.groundGids : ref.overlayGids, ground ? 1.0 : opt.density, opt, gen);
+    }
+    for (const auto& layer : objectLayers) out << ',' << layer.dump();
+    out << "]}";
+
+    out.close();
+    if (!out) {
+        Logger::error("Failed while writing " + opt.outPath);
+        return 2;
+    }
+
+    Logger::info("Wrote " + opt.outPath + ": " + std::to_string(opt.width) + "x" + std::to_string(opt.height) +
+                 " tiles, " + std::to_string(opt.layers) + " tile layers, " +
+                 std::to_string(opt.rects + opt.polygons) + " NotWalkable shapes, " +
+                 std::to_string(opt.entrances) + " entrances, " + std::to_string(opt.labels) + " labels, " +
+                 std::to_string(opt.triggers) + " triggers, " + std::to_string(opt.lights) + " lights");
+    return 0;
+}
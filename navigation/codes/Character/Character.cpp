@@ -95,6 +95,8 @@ bool Character::loadTexture() {
         return false;
     }
     texture->setSmooth(false);
+    textureMemory.set(MemoryTracker::textureBytes(*texture));
+    MemoryTracker::getInstance().countUpload(textureMemory.getBytes());
     return true;
 }
 
@@ -5,6 +5,7 @@
 #include <SFML/Graphics.hpp>
 #include <memory>
 #include "CharacterConfig.h"
+#include "Utils/MemoryTracker.h"
 
 /*
  * File: Character.h
@@ -156,6 +157,7 @@ private:
 private:
     std::unique_ptr<sf::Sprite> sprite;
     std::unique_ptr<sf::Texture> texture;
+    MemoryCharge textureMemory{"global", MemoryTag::Characters, MemoryKind::Gpu};
     CharacterConfig config;
     
     // Animation state
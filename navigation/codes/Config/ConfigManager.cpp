@@ -262,6 +262,14 @@ void ConfigManager::jsonToAppConfig(const json& j, AppConfig& config) {
         if (performance.contains("targetFPS")) config.performance.targetFPS = performance["targetFPS"];
         if (performance.contains("vsync")) config.performance.vsync = performance["vsync"];
         if (performance.contains("textureFilter")) config.performance.textureFilter = performance["textureFilter"];
+        if (performance.contains("lowResWorld")) config.performance.lowResWorld = performance["lowResWorld"];
+        if (performance.contains("integerUpscale")) config.performance.integerUpscale = performance["integerUpscale"];
+        if (performance.contains("workerThreads")) config.performance.workerThreads = performance["workerThreads"];
+        if (performance.contains("renderThread")) config.performance.renderThread = performance["renderThread"];
+        if (performance.contains("pacing")) config.performance.pacing = performance["pacing"];
+        if (performance.contains("idleThrottle")) config.performance.idleThrottle = performance["idleThrottle"];
+        if (performance.contains("idleFPS")) config.performance.idleFPS = performance["idleFPS"];
+        if (performance.contains("qualityGovernor")) config.performance.qualityGovernor = performance["qualityGovernor"];
     }
 
     // Parse map display settings
@@ -282,6 +290,12 @@ void ConfigManager::jsonToAppConfig(const json& j, AppConfig& config) {
         if (mapDisplay.contains("maxZoom") && mapDisplay["maxZoom"].is_number()) {
             config.mapDisplay.maxZoom = mapDisplay["maxZoom"];
         }
+        if (mapDisplay.contains("chunkZoom") && mapDisplay["chunkZoom"].is_number()) {
+            config.mapDisplay.chunkZoom = mapDisplay["chunkZoom"];
+        }
+        if (mapDisplay.contains("labelZoom") && mapDisplay["labelZoom"].is_number()) {
+            config.mapDisplay.labelZoom = mapDisplay["labelZoom"];
+        }
     }
 
     // Parse UI settings (map button)
@@ -363,7 +377,15 @@ void ConfigManager::appConfigToJson(const AppConfig& config, json& j) {
     j["performance"] = {
         {"targetFPS", config.performance.targetFPS},
         {"vsync", config.performance.vsync},
-        {"textureFilter", config.performance.textureFilter}
+        {"textureFilter", config.performance.textureFilter},
+        {"lowResWorld", config.performance.lowResWorld},
+        {"integerUpscale", config.performance.integerUpscale},
+        {"workerThreads", config.performance.workerThreads},
+        {"renderThread", config.performance.renderThread},
+        {"pacing", config.performance.pacing},
+        {"idleThrottle", config.performance.idleThrottle},
+        {"idleFPS", config.performance.idleFPS},
+        {"qualityGovernor", config.performance.qualityGovernor}
     };
 
     // Add map display settings
@@ -372,6 +394,8 @@ void ConfigManager::appConfigToJson(const AppConfig& config, json& j) {
     j["mapDisplay"]["defaultZoom"] = config.mapDisplay.defaultZoom;
     j["mapDisplay"]["minZoom"] = config.mapDisplay.minZoom;
     j["mapDisplay"]["maxZoom"] = config.mapDisplay.maxZoom;
+    j["mapDisplay"]["chunkZoom"] = config.mapDisplay.chunkZoom;
+    j["mapDisplay"]["labelZoom"] = config.mapDisplay.labelZoom;
 
     // Add UI settings (map button)
     j["ui"]["mapButton"] = {
@@ -78,6 +78,14 @@ struct AppConfig {
         int targetFPS = 60;
         bool vsync = true;
         int textureFilter = 1;
+        bool lowResWorld = true;     // Draw the world at native pixel-art resolution, then upscale
+        bool integerUpscale = false; // Restrict the world upscale to whole multiples (letterboxed)
+        int workerThreads = -1;      // Job system workers; -1 = hardware threads - 1, 0 = single-threaded
+        bool renderThread = true;    // Draw gameplay frames on a separate thread from published snapshots
+        std::string pacing = "adaptive"; // "limiter", "vsync" or "adaptive"; vsync=false forces "limiter"
+        bool idleThrottle = true;    // Skip redrawing unchanged frames and tick at idleFPS while idle or unfocused
+        int idleFPS = 10;            // Loop rate while idle (values below 10 are raised to 10)
+        bool qualityGovernor = true; // Drop optional rendering costs while frames exceed the targetFPS budget
     } performance;
 
     /**
@@ -89,6 +97,8 @@ struct AppConfig {
         float defaultZoom = 1.0f; // Default zoom level
         float minZoom = 0.5f;     // Minimum zoom level
         float maxZoom = 3.0f;     // Maximum zoom level
+        float chunkZoom = 0.8f;   // Below this zoom the map is drawn from baked chunk textures, without props
+        float labelZoom = 0.7f;   // Below this zoom building labels are hidden
     } mapDisplay;
     
     /**
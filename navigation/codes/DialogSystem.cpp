@@ -5,74 +5,8 @@
 #include <iostream>
 #include <sstream>
 #include "Utils/Logger.h"
-
-/**
- * @brief Wrap text to fit within specified maximum width.
- * 
- * @param str Input text string.
- * @param font Font used for text rendering.
- * @param characterSize Font character size.
- * @param maxWidth Maximum allowed width in pixels.
- * @return std::string Wrapped text string.
- */
-static std::string wrapText(
-    const std::string& str,
-    const sf::Font& font,
-    unsigned int characterSize,
-    float maxWidth
-) {
-    sf::Text measure(font, "", characterSize);
-    float spaceWidth = measure.getFont().getGlyph(' ', characterSize, false).advance;
-
-    std::string result;
-    std::string word;
-    float lineWidth = 0.f;
-
-    auto wordWidthCalc = [&](const std::string& w)->float {
-        float ww = 0.f;
-        for (unsigned char ch : w) {
-            ww += measure.getFont().getGlyph(ch, characterSize, false).advance;
-        }
-        return ww;
-    };
-
-    for (size_t i = 0; i < str.size(); ++i) {
-        char c = str[i];
-        if (c == ' ' || c == '\n') {
-            if (!word.empty()) {
-                float w = wordWidthCalc(word);
-                if (lineWidth > 0.f && lineWidth + w > maxWidth) {
-                    result.push_back('\n');
-                    lineWidth = 0.f;
-                } else if (lineWidth > 0.f) {
-                    result.push_back(' ');
-                    lineWidth += spaceWidth;
-                }
-                result += word;
-                lineWidth += w;
-                word.clear();
-            }
-            if (c == '\n') {
-                result.push_back('\n');
-                lineWidth = 0.f;
-            }
-        } else {
-            word.push_back(c);
-        }
-    }
-
-    if (!word.empty()) {
-        float w = wordWidthCalc(word);
-        if (lineWidth > 0.f && lineWidth + w > maxWidth) {
-            result.push_back('\n');
-        } else if (lineWidth > 0.f) {
-            result.push_back(' ');
-        }
-        result += word;
-    }
-
-    return result;
-}
+#include "Renderer/Renderer.h"
+#include "Input/InputManager.h"
 
 /**
  * @brief Initialize dialog system with textures and fonts.
@@ -90,104 +24,62 @@ void DialogSystem::initialize(const std::string& bgPath,
     m_fontSize = fontSize;
     m_font = font; 
 
-    // Load background texture + create texture-aware Sprite
-    if (!m_bgTexture.loadFromFile(bgPath)) {
+    // Load background and button onto one atlas page so a dialog's panels
+    // draw with a single call. Borders cover the rounded corners.
+    if (!m_atlas.add("dialog_bg", bgPath, 24, 24, 24, 24)) {
         throw std::runtime_error("Failed to load dialog bg: " + bgPath);
     }
-
-    m_dialogBgSprite = std::make_unique<sf::Sprite>(m_bgTexture);
-    m_dialogSize = sf::Vector2f(m_bgTexture.getSize().x, m_bgTexture.getSize().y);
-    
-    // Load button texture + create texture-aware Sprite
-    if (!m_btnTexture.loadFromFile(btnPath)) {
+    if (!m_atlas.add("dialog_btn", btnPath, 22, 10, 22, 10)) {
         throw std::runtime_error("Failed to load dialog btn: " + btnPath);
     }
-    m_btnSprite = std::make_unique<sf::Sprite>(m_btnTexture);
-    m_btnTex = m_btnTexture;
-    m_btnSize = sf::Vector2f(m_btnTexture.getSize().x, m_btnTexture.getSize().y);
-    
-    m_dialogTitle.setFont(m_font);
-    m_dialogTitle.setCharacterSize(m_fontSize);
-    m_dialogTitle.setFillColor(sf::Color::White);
-    m_dialogTitle.setLineSpacing(1.2f); 
-}
-
-/**
- * @brief Calculate centered position for dialog (legacy method).
- * 
- * @param window Render window reference.
- * @return sf::Vector2f Centered dialog position.
- */
-sf::Vector2f DialogSystem::getCenteredPosition(const sf::RenderWindow& window) {
-    if (!m_dialogBgSprite) return {0, 0}; 
+    if (!m_atlas.build()) {
+        throw std::runtime_error("Failed to pack dialog textures");
+    }
 
-    sf::Vector2u windowSize = window.getSize();
-    float windowW = static_cast<float>(windowSize.x);
-    float windowH = static_cast<float>(windowSize.y);
-    
-    float scaleFactor = windowW * 0.6f / m_dialogSize.x;
-    m_dialogBgSprite->setScale(sf::Vector2f(scaleFactor, scaleFactor)); 
-    
-    sf::Vector2f scaledDialogSize = sf::Vector2f(
-        m_dialogSize.x * scaleFactor,
-        m_dialogSize.y * scaleFactor
-    );
-    
-    float posX = (windowW - scaledDialogSize.x) / 2.0f;
-    float posY = (windowH - scaledDialogSize.y) / 2.0f;
-    
-    return sf::Vector2f(posX, posY);
+    // Background: 50% of the window width (scale 0.3..1), centered by the root.
+    // Title centered near the top, buttons stacked below it.
+    m_ui.getRoot().truncateChildren(0);
+    m_buttons.clear();
+    m_visibleButtons = 0;
+
+    // The panel grows with long option lists instead of letting buttons spill out.
+    m_panel = &m_ui.getRoot().addChild<PanelWidget>(*m_atlas.find("dialog_bg"));
+    m_panel->setWidthFraction(0.5f, 0.3f, 1.0f);
+    m_panel->setGrowToContent(true);
+    m_panel->setPadding(20.f, 0.f);
+    m_panel->setSpacing(15.f);
+
+    m_title = &m_panel->addChild<LabelWidget>(m_font, m_fontSize);
+    m_title->setColor(sf::Color::White);
+    m_title->setLineSpacing(1.2f);
+    m_title->setWrapping(true, 30.f);
+    m_title->setMarginBottom(5.f);
 }
 
 /**
- * @brief Calculate centered position for dialog (improved method).
+ * @brief Show a title and one button per option, reusing existing button widgets.
  * 
- * @param window Render window reference.
- * @return sf::Vector2f Centered dialog position.
+ * @param title Dialog title text.
+ * @param options List of option strings.
  */
-sf::Vector2f DialogSystem::getDialogCenterPosition(const sf::RenderWindow& window) {
-    if (!m_dialogBgSprite || m_bgTexture.getSize().x == 0) {
-        std::cerr << "Dialog sprite/texture not initialized!" << std::endl;
-        return {0, 0};
-    }
+void DialogSystem::setOptions(const std::string& title, const std::vector<std::string>& options) {
+    if (!m_panel) return;
 
-    // Get default view dimensions (full screen)
-    sf::Vector2u windowSize = window.getSize();
-    float windowW = static_cast<float>(windowSize.x);
-    float windowH = static_cast<float>(windowSize.y);
+    m_title->setString(title);
 
-    // Force scaling: dialog width = 50% of window width 
-    float targetWidth = windowW * 0.5f;
-    sf::Vector2u texSize = m_bgTexture.getSize();
-    float originalW = static_cast<float>(texSize.x);
-    float originalH = static_cast<float>(texSize.y);
-    float scaleFactor = targetWidth / originalW;
-
-    scaleFactor = std::max(0.3f, std::min(scaleFactor, 1.0f));
-
-    // Apply scaling
-    m_dialogBgSprite->setScale(sf::Vector2f(scaleFactor, scaleFactor));
-
-    // Calculate absolute centering (window center - dialog center)
-    sf::FloatRect scaledBounds = m_dialogBgSprite->getGlobalBounds();
-    float posX = (windowW - scaledBounds.size.x) / 2.0f;
-    float posY = (windowH - scaledBounds.size.y) / 2.0f;
-
-    return {posX, posY};
-}
-
-/**
- * @brief Get dialog background size.
- * 
- * @return sf::Vector2f Dialog background size (scaled).
- */
-sf::Vector2f DialogSystem::getDialogBgSize() const {
-    if (!m_dialogBgSprite) {
-        return {450, 300}; 
+    while (m_buttons.size() < options.size()) {
+        ButtonWidget& btn = m_panel->addChild<ButtonWidget>(*m_atlas.find("dialog_btn"), m_font, m_fontSize);
+        btn.setWidthFraction(0.7f, 0.5f, 1.0f);
+        btn.getLabel().setColor(sf::Color::Black);
+        m_buttons.push_back(&btn);
     }
-
-    const sf::FloatRect bgBounds = m_dialogBgSprite->getGlobalBounds();
-    return {bgBounds.size.x, bgBounds.size.y};
+    for (size_t i = 0; i < m_buttons.size(); ++i) {
+        const bool used = i < options.size();
+        m_buttons[i]->setVisible(used);
+        if (used) m_buttons[i]->getLabel().setString(options[i]);
+        else m_buttons[i]->setOnClick(nullptr);
+    }
+    m_visibleButtons = options.size();
 }
 
 /**
@@ -204,34 +96,17 @@ void DialogSystem::setDialogWithIndex(const std::string& title,
     m_optionCallback = selectCallback;
     m_simpleCallback = nullptr;  
     m_useIndexCallback = true;   
-    m_buttons.clear();
 
-    m_dialogTitle.setFont(m_font);
-    m_dialogTitle.setCharacterSize(m_fontSize);
-    m_dialogTitle.setFillColor(sf::Color::White);
-    m_dialogTitle.setLineSpacing(1.2f);
-    m_dialogTitle.setString(title);
+    setOptions(title, options);
 
-    // Create buttons - using index-based callback
-    for (size_t i = 0; i < options.size(); ++i) {
-        const auto& option = options[i];
-        Button btn(m_font, m_fontSize);
-        btn.text = option;
-        
-        // Index-based callback: pass option index and text
-        btn.callback = [selectCallback, i, option]() {
+    // Index-based callback: pass option index and text
+    for (size_t i = 0; i < m_visibleButtons; ++i) {
+        const std::string option = options[i];
+        m_buttons[i]->setOnClick([selectCallback, i, option]() {
             if (selectCallback) {
                 selectCallback(static_cast<int>(i), option);
             }
-        };
-
-        btn.textObj.setFont(m_font);
-        btn.textObj.setCharacterSize(m_fontSize);
-        btn.textObj.setString(option);
-        btn.textObj.setFillColor(sf::Color::Black);
-
-        btn.sprite = std::make_unique<sf::Sprite>(m_btnTex);
-        m_buttons.push_back(std::move(btn));
+        });
     }
 }
 
@@ -249,106 +124,17 @@ void DialogSystem::setDialog(const std::string& title,
     m_simpleCallback = selectCallback; 
     m_optionCallback = nullptr; 
     m_useIndexCallback = false;  
-    m_buttons.clear();
-
-    if (!m_dialogBgSprite) return; 
-
-    sf::Vector2f dummyWindowSize(1200, 800); 
-    float targetWidth = dummyWindowSize.x * 0.5f;
-    float scaleFactor = targetWidth / static_cast<float>(m_bgTexture.getSize().x);
-    scaleFactor = std::max(0.3f, std::min(scaleFactor, 1.0f));
-    m_dialogBgSprite->setScale(sf::Vector2f(scaleFactor, scaleFactor));
-    
-    sf::Vector2f centeredPos(
-        (dummyWindowSize.x - m_dialogBgSprite->getGlobalBounds().size.x) / 2,
-        (dummyWindowSize.y - m_dialogBgSprite->getGlobalBounds().size.y) / 2
-    );
-    m_dialogBgSprite->setPosition(centeredPos);
-
-    // Set title
-    m_dialogTitle.setFont(m_font);
-    m_dialogTitle.setString(title);
-    m_dialogTitle.setCharacterSize(m_fontSize);
-    m_dialogTitle.setFillColor(sf::Color::White);
-    m_dialogTitle.setLineSpacing(1.2f);
 
-    // Get background position and dimensions
-    sf::Vector2f dialogPos = m_dialogBgSprite->getPosition();
-    sf::Vector2f bgSize = getDialogBgSize();
+    setOptions(title, dishOptions);
 
-    // Create dish buttons
-    for (const auto& dish : dishOptions) {
-        Button btn(m_font, m_fontSize);
-        btn.text = dish;
-        
-        // Simple callback: only pass text
-        btn.callback = [this, dish]() {
+    // Simple callback: only pass text
+    for (size_t i = 0; i < m_visibleButtons; ++i) {
+        const std::string dish = dishOptions[i];
+        m_buttons[i]->setOnClick([this, dish]() {
             if (m_simpleCallback) {
                 m_simpleCallback(dish);
             }
-        };
-
-        // Set button text
-        btn.textObj.setFont(m_font);
-        btn.textObj.setCharacterSize(m_fontSize);
-        btn.textObj.setString(dish);
-        btn.textObj.setFillColor(sf::Color::Black);
-        
-        // Create button Sprite
-        btn.sprite = std::make_unique<sf::Sprite>(m_btnTex);
-        
-        m_buttons.push_back(std::move(btn));
-    }
-
-    // Layout buttons
-    layoutButtons();
-}
-
-/**
- * @brief Layout buttons based on dialog position and title.
- */
-void DialogSystem::layoutButtons() {
-    if (m_buttons.empty() || !m_dialogBgSprite) return;
-
-    sf::Vector2f dialogPos = m_dialogBgSprite->getPosition();
-    sf::Vector2f bgSize = getDialogBgSize();
-
-    float btnSpacing = 15.0f;
-    float btnWidthRatio = 0.7f;
-    float btnTopOffset = 80.0f; 
-    
-    if (!m_dialogTitle.getString().isEmpty()) {
-        sf::FloatRect titleGlobal = m_dialogTitle.getGlobalBounds();
-        float titleBottom = titleGlobal.position.y + titleGlobal.size.y;
-        btnTopOffset = (titleBottom - dialogPos.y) + 20.0f; 
-    }
-
-    for (size_t i = 0; i < m_buttons.size(); ++i) {
-        Button& btn = m_buttons[i];
-        if (!btn.sprite) continue;
-
-        float targetBtnWidth = bgSize.x * btnWidthRatio;
-        sf::Vector2u btnTexSize = m_btnTexture.getSize();
-        float btnScale = targetBtnWidth / static_cast<float>(btnTexSize.x);
-        btnScale = std::clamp(btnScale, 0.5f, 1.0f);
-        btn.sprite->setScale(sf::Vector2f(btnScale, btnScale));
-
-        sf::FloatRect btnBounds = btn.sprite->getGlobalBounds();
-        float btnX = dialogPos.x + (bgSize.x - btnBounds.size.x) / 2.0f;
-        float btnY = dialogPos.y + btnTopOffset + i * (btnBounds.size.y + btnSpacing);
-
-        btn.sprite->setPosition(sf::Vector2f(btnX, btnY));
-        btn.bounds = btn.sprite->getGlobalBounds();
-
-        sf::FloatRect textBounds = btn.textObj.getLocalBounds();
-        btn.textObj.setOrigin(sf::Vector2f(
-            textBounds.position.x + textBounds.size.x / 2.0f,
-            textBounds.position.y + textBounds.size.y / 2.0f
-        ));
-        btn.textObj.setPosition(sf::Vector2f(
-            btnX + btnBounds.size.x / 2.0f,
-            btnY + btnBounds.size.y / 2.0f
-        ));
+        });
     }
 }
 
@@ -365,36 +151,22 @@ void DialogSystem::handleEvent(const sf::Event& event, const sf::RenderWindow& w
     if (event.is<sf::Event::MouseButtonPressed>()) {
         const auto& mouseEvent = *event.getIf<sf::Event::MouseButtonPressed>();
         if (mouseEvent.button == sf::Mouse::Button::Left) {
-            // Get raw mouse pixel coordinates
+            // Convert raw mouse pixels to window default view coordinates 
             sf::Vector2i mousePixelPos(mouseEvent.position.x, mouseEvent.position.y);
-            // Convert to window default view coordinates 
             sf::Vector2f mouseWorldPos = window.mapPixelToCoords(mousePixelPos, window.getDefaultView());
-            
-            std::function<void()> pendingCallback = nullptr;
-
-            // Iterate buttons to detect clicks
-            for (auto& btn : m_buttons) {
-                if (!btn.sprite) continue;
-                if (btn.bounds.contains(mouseWorldPos)) {
-                    if (btn.callback)
-                        pendingCallback = btn.callback;
-
-                    m_isActive = false;
-                    break;
-                }
-            }
 
-            if (pendingCallback) {
-                m_buttons.clear();          
-                m_pendingCallback = pendingCallback;  
+            // Hit-test the flattened button rects of the widget tree
+            if (Widget* hit = m_ui.hitTest(mouseWorldPos)) {
+                m_pendingCallback = hit->getOnClick();
+                m_isActive = false;
             }
         }
     }
 
-    // Handle ESC key to close
+    // Handle the Cancel key (ESC) to close
     if (event.is<sf::Event::KeyPressed>()) {
         const auto& keyEvent = *event.getIf<sf::Event::KeyPressed>();
-        if (keyEvent.code == sf::Keyboard::Key::Escape) {
+        if (InputManager::getInstance().actionOf(keyEvent.code) == InputAction::Cancel) {
             m_isActive = false;
         }
     }
@@ -403,15 +175,7 @@ void DialogSystem::handleEvent(const sf::Event& event, const sf::RenderWindow& w
         const auto& mouseMoveEvent = *event.getIf<sf::Event::MouseMoved>();
         sf::Vector2i mousePixelPos(mouseMoveEvent.position.x, mouseMoveEvent.position.y);
         sf::Vector2f mouseWorldPos = window.mapPixelToCoords(mousePixelPos, window.getDefaultView());
-        
-        for (auto& btn : m_buttons) {
-            if (!btn.sprite) continue;
-            if (btn.bounds.contains(mouseWorldPos)) {
-                btn.sprite->setColor(sf::Color(220, 220, 220)); 
-            } else {
-                btn.sprite->setColor(sf::Color::White); 
-            }
-        }
+        m_ui.updateHover(mouseWorldPos);
     }
 }
 
@@ -436,59 +200,24 @@ std::function<void()> DialogSystem::consumePendingCallback() {
 }
 
 /**
- * @brief Close dialog and clear all resources.
+ * @brief Close dialog and drop its callbacks (the widgets are kept for reuse).
  */
 void DialogSystem::close() {
     m_isActive = false;
-    m_buttons.clear();
+    setOptions("", {});
     m_simpleCallback = nullptr;
     m_optionCallback = nullptr;
     m_pendingCallback = nullptr;  
 }
 
 /**
- * @brief Render dialog to window.
+ * @brief Submit dialog to the renderer's screen-space pass.
  * 
- * @param window Render window reference.
+ * @param renderer Renderer reference.
  */
-void DialogSystem::render(sf::RenderWindow& window) {
-    if (!m_isActive || !m_dialogBgSprite) return;
-    sf::View originalView = window.getView(); 
-    window.setView(window.getDefaultView()); 
-
-    sf::Vector2f centeredPos = getDialogCenterPosition(window);
-    m_dialogBgSprite->setPosition(centeredPos);
-    
-    sf::Vector2f bgSize = getDialogBgSize();
-    
-    float padding = 30.f;
-    float maxTextWidth = bgSize.x - padding * 2.0f;
-    std::string currentTitle = m_dialogTitle.getString().toAnsiString();
-    std::string wrappedTitle = wrapText(currentTitle, m_font, m_fontSize, maxTextWidth);
-    m_dialogTitle.setString(wrappedTitle);
-    
-    sf::FloatRect titleBounds = m_dialogTitle.getLocalBounds();
-    
-    m_dialogTitle.setPosition(sf::Vector2f(
-        centeredPos.x + bgSize.x / 2.0f,  
-        centeredPos.y + 30.0f           
-    ));
-    
-    m_dialogTitle.setOrigin(sf::Vector2f(
-        titleBounds.size.x / 2.0f + titleBounds.position.x,
-        titleBounds.size.y / 2.0f + titleBounds.position.y
-    ));
-
-    layoutButtons();
-
-    window.draw(*m_dialogBgSprite);
-    window.draw(m_dialogTitle);
-    for (const auto& btn : m_buttons) {
-        if (btn.sprite) {
-            window.draw(*btn.sprite);
-        }
-        window.draw(btn.textObj);
-    }
+void DialogSystem::render(Renderer& renderer) {
+    if (!m_isActive || !m_panel) return;
 
-    window.setView(originalView);
+    m_ui.setViewport(renderer.getWindowSize());
+    m_ui.render(renderer);
 }
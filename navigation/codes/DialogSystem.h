@@ -3,42 +3,13 @@
 #include <vector>
 #include <string>
 #include <functional>
+#include "UI/UiAtlas.h"
+#include "UI/Widget.h"
+
+class Renderer;
 
 class DialogSystem {
 public:
-    /**
-     * @struct Button
-     * @brief Dialog button structure containing visual elements and callback.
-     */
-    struct Button {
-        std::string text;
-        std::function<void()> callback;
-        std::unique_ptr<sf::Sprite> sprite;
-        sf::Text textObj;
-        sf::FloatRect bounds;
-        bool isHovered = false;
-
-        /**
-         * @brief Construct a button with font and size.
-         * 
-         * SFML 3.0 requires explicit construction of Sprite/Text (no default constructors).
-         * 
-         * @param font Font for button text.
-         * @param fontSize Font size for button text.
-         */
-        Button(const sf::Font& font, unsigned int fontSize)
-            : textObj(font, "", fontSize)
-        {}
-
-        // Disable copy (unique_ptr is not copyable)
-        Button(const Button&) = delete;
-        Button& operator=(const Button&) = delete;
-
-        // Enable move operations
-        Button(Button&&) = default;
-        Button& operator=(Button&&) = default;
-    };
-
     // Legacy callback type (for cafeteria)
     using SimpleCallback = std::function<void(const std::string& optionText)>;
     
@@ -52,12 +23,7 @@ public:
      * @param fontSize Default font size for dialog text.
      */
     DialogSystem(const sf::Font& font, unsigned int fontSize)
-        : m_font(font), m_fontSize(fontSize),
-          m_dialogTitle(font, "", fontSize),
-          m_textObject(font, "", fontSize),
-          m_bgSprite(nullptr),    
-          m_btnSprite(nullptr),
-          m_dialogBgSprite(nullptr)
+        : m_font(font), m_fontSize(fontSize)
     {}
 
 
@@ -105,11 +71,16 @@ public:
     void handleEvent(const sf::Event& event, const sf::RenderWindow& window);
 
     /**
-     * @brief Render dialog and buttons.
+     * @brief Submit dialog and buttons to the renderer's screen-space pass.
      * 
-     * @param window Render window to draw to.
+     * The widget tree only re-lays out after the content or the window size
+     * changed; otherwise the cached geometry is submitted as is.
+     * 
+     * @param renderer Renderer to submit to (works with and without the render thread).
      */
-    void render(sf::RenderWindow& window);
+    void render(Renderer& renderer);
+
+    const sf::Font& getFont() const { return m_font; }
 
     // State control methods
     /**
@@ -130,7 +101,7 @@ public:
      * @return true if dialog system is initialized, false otherwise.
      */
     bool isInitialized() const { 
-        return m_dialogBgSprite != nullptr && m_bgTexture.getSize().x > 0; 
+        return m_panel != nullptr; 
     }
 
     /**
@@ -148,10 +119,7 @@ public:
     std::function<void()> consumePendingCallback();
 
 private:
-    sf::Vector2f getCenteredPosition(const sf::RenderWindow& window); 
-    sf::Vector2f getDialogCenterPosition(const sf::RenderWindow& window); 
-    sf::Vector2f getDialogBgSize() const; 
-    void layoutButtons(); 
+    void setOptions(const std::string& title, const std::vector<std::string>& options);
 
 
     bool m_isActive = false;
@@ -160,22 +128,16 @@ private:
     SimpleCallback m_simpleCallback;  
     OptionCallback m_optionCallback; 
     bool m_useIndexCallback = false;  
-    std::function<void(const std::string&)> m_selectCallback;
-
-    sf::Texture m_bgTexture;
-    std::unique_ptr<sf::Sprite> m_bgSprite;
-    sf::Vector2f m_dialogSize;
-    std::unique_ptr<sf::Sprite> m_dialogBgSprite;
 
-    sf::Texture m_btnTexture;
-    std::unique_ptr<sf::Sprite> m_btnSprite;    
-    sf::Vector2f m_btnSize;
-    sf::Texture m_btnTex;
+    UiAtlas m_atlas;   // Background and button regions, sharing a page
 
-    sf::Text m_dialogTitle;       
-    sf::Text m_textObject;       
-    std::vector<sf::Text> m_optionTexts; 
+    // Retained UI: background panel holding the title and one button per option.
+    // Buttons are reused across dialogs; surplus ones are hidden.
+    WidgetTree m_ui;
+    PanelWidget* m_panel = nullptr;
+    LabelWidget* m_title = nullptr;
+    std::vector<ButtonWidget*> m_buttons;
+    size_t m_visibleButtons = 0;
 
-    std::vector<Button> m_buttons;
     std::function<void()> m_pendingCallback;
 };
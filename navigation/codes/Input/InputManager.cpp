@@ -4,11 +4,11 @@
 
 /*
  * File: InputManager.cpp
- * Description: Implementation of a lightweight input sampling singleton.
+ * Description: Implementation of the event-fed, action-mapped input singleton.
  *
- * The InputManager polls sf::Keyboard state each frame and stores boolean
- * vectors for current and previous frames. It provides helpers for movement
- * input (WASD/arrow) and for detecting just-pressed key events.
+ * Key state comes from KeyPressed/KeyReleased events; presses are latched
+ * until update() so short taps are never lost between two frames. Actions
+ * are looked up in a key binding table filled with the default controls.
  */
 
 InputManager& InputManager::getInstance() {
@@ -17,68 +17,157 @@ InputManager& InputManager::getInstance() {
 }
 
 /**
- * Sample the current keyboard state and store a copy of the previous frame.
+ * Installs the default controls (the ones shown on the controls screen).
+ */
+InputManager::InputManager() {
+    bind(sf::Keyboard::Key::A, InputAction::MoveLeft);
+    bind(sf::Keyboard::Key::Left, InputAction::MoveLeft);
+    bind(sf::Keyboard::Key::D, InputAction::MoveRight);
+    bind(sf::Keyboard::Key::Right, InputAction::MoveRight);
+    bind(sf::Keyboard::Key::W, InputAction::MoveUp);
+    bind(sf::Keyboard::Key::Up, InputAction::MoveUp);
+    bind(sf::Keyboard::Key::S, InputAction::MoveDown);
+    bind(sf::Keyboard::Key::Down, InputAction::MoveDown);
+    bind(sf::Keyboard::Key::Z, InputAction::Sprint);
+    bind(sf::Keyboard::Key::E, InputAction::Interact);
+    bind(sf::Keyboard::Key::Enter, InputAction::Confirm);
+    bind(sf::Keyboard::Key::Escape, InputAction::Cancel);
+    bind(sf::Keyboard::Key::F3, InputAction::ToggleMemoryOverlay);
+    bind(sf::Keyboard::Key::Equal, InputAction::ZoomIn);
+    bind(sf::Keyboard::Key::Add, InputAction::ZoomIn);
+    bind(sf::Keyboard::Key::Hyphen, InputAction::ZoomOut);
+    bind(sf::Keyboard::Key::Subtract, InputAction::ZoomOut);
+}
+
+namespace {
+    size_t keyIndex(sf::Keyboard::Key key) {
+        return static_cast<size_t>(static_cast<int>(key));   // Unknown (-1) wraps out of range
+    }
+}
+
+void InputManager::bind(sf::Keyboard::Key key, InputAction action) {
+    const size_t index = keyIndex(key);
+    if (index < KeyCount && action != InputAction::Count) bindings[index] = action;
+}
+
+void InputManager::unbind(sf::Keyboard::Key key) {
+    const size_t index = keyIndex(key);
+    if (index < KeyCount) bindings[index].reset();
+}
+
+std::optional<InputAction> InputManager::actionOf(sf::Keyboard::Key key) const {
+    const size_t index = keyIndex(key);
+    return index < KeyCount ? bindings[index] : std::nullopt;
+}
+
+/**
+ * Records key presses, releases and wheel notches; focus loss releases every
+ * key since the matching KeyReleased events go to whichever window has the focus.
+ */
+void InputManager::handleEvent(const sf::Event& event, Clock::time_point receivedAt, bool toGame) {
+    if (event.is<sf::Event::FocusLost>()) {
+        releaseAll();
+        return;
+    }
+
+    if (const auto* pressed = event.getIf<sf::Event::KeyPressed>()) {
+        const size_t index = keyIndex(pressed->code);
+        if (index >= KeyCount) return;
+
+        // OS key repeat sends KeyPressed again while held; only the first counts
+        const bool repeat = keysDown[index];
+        keysDown[index] = true;
+        if (repeat || !toGame) return;
+
+        keysPressedSinceUpdate[index] = true;
+        if (const auto action = bindings[index]) {
+            actionsPressedSinceUpdate[static_cast<size_t>(*action)] = true;
+            if (!pendingInputAt || receivedAt < *pendingInputAt) pendingInputAt = receivedAt;
+        }
+        return;
+    }
+
+    if (const auto* released = event.getIf<sf::Event::KeyReleased>()) {
+        const size_t index = keyIndex(released->code);
+        if (index < KeyCount) keysDown[index] = false;
+        return;
+    }
+
+    if (const auto* wheel = event.getIf<sf::Event::MouseWheelScrolled>()) {
+        if (toGame && wheel->wheel == sf::Mouse::Wheel::Vertical) {
+            wheelSinceUpdate += wheel->delta;
+            if (!pendingInputAt || receivedAt < *pendingInputAt) pendingInputAt = receivedAt;
+        }
+    }
+}
+
+/**
+ * Turns the presses latched since the previous call into this frame's
+ * "just pressed" state.
  *
  * This function should be called once per frame before querying input.
  */
 void InputManager::update() {
-    // Save previous frame
-    previousKeys = currentKeys;
-
-    // Update current frame by sampling all SFML keys.
-    currentKeys.clear();
-    for (int key = 0; key < static_cast<int>(sf::Keyboard::KeyCount); ++key) {
-        currentKeys.push_back(
-            sf::Keyboard::isKeyPressed(
-                static_cast<sf::Keyboard::Key>(key)
-            )
-        );
-    }
+    keysJustPressed = keysPressedSinceUpdate;
+    keysPressedSinceUpdate.fill(false);
+    actionsJustPressed = actionsPressedSinceUpdate;
+    actionsPressedSinceUpdate.fill(false);
+    frameWheel = wheelSinceUpdate;
+    wheelSinceUpdate = 0.f;
+
+    frameInputAt = pendingInputAt;
+    pendingInputAt.reset();
+}
+
+void InputManager::releaseAll() {
+    keysDown.fill(false);
 }
 
 /**
- * Returns a normalized movement vector based on common keys.
- * Left/A -> -X, Right/D -> +X, Up/W -> -Y, Down/S -> +Y.
+ * Returns a movement vector from the move actions.
+ * MoveLeft -> -X, MoveRight -> +X, MoveUp -> -Y, MoveDown -> +Y.
  */
 sf::Vector2f InputManager::getMoveInput() const {
     sf::Vector2f input(0.0f, 0.0f);
 
-    if (isKeyPressed(sf::Keyboard::Key::Left) || isKeyPressed(sf::Keyboard::Key::A)) {
-        input.x -= 1.0f;
-    }
-    if (isKeyPressed(sf::Keyboard::Key::Right) || isKeyPressed(sf::Keyboard::Key::D)) {
-        input.x += 1.0f;
-    }
-    if (isKeyPressed(sf::Keyboard::Key::Up) || isKeyPressed(sf::Keyboard::Key::W)) {
-        input.y -= 1.0f;
-    }
-    if (isKeyPressed(sf::Keyboard::Key::Down) || isKeyPressed(sf::Keyboard::Key::S)) {
-        input.y += 1.0f;
-    }
+    if (isActionDown(InputAction::MoveLeft)) input.x -= 1.0f;
+    if (isActionDown(InputAction::MoveRight)) input.x += 1.0f;
+    if (isActionDown(InputAction::MoveUp)) input.y -= 1.0f;
+    if (isActionDown(InputAction::MoveDown)) input.y += 1.0f;
 
     return input;
 }
 
+bool InputManager::isActionDown(InputAction action) const {
+    for (size_t key = 0; key < KeyCount; ++key) {
+        if (keysDown[key] && bindings[key] == action) return true;
+    }
+    return false;
+}
+
+bool InputManager::isActionJustPressed(InputAction action) const {
+    const size_t index = static_cast<size_t>(action);
+    return index < ActionCount && actionsJustPressed[index];
+}
+
+bool InputManager::consumeAction(InputAction action) {
+    if (!isActionJustPressed(action)) return false;
+    actionsJustPressed[static_cast<size_t>(action)] = false;
+    return true;
+}
+
 /**
  * Safely query whether a key is currently pressed.
  */
 bool InputManager::isKeyPressed(sf::Keyboard::Key key) const {
-    int index = static_cast<int>(key);
-    if (index >= 0 && index < static_cast<int>(currentKeys.size())) {
-        return currentKeys[index];
-    }
-    return false;
+    const size_t index = keyIndex(key);
+    return index < KeyCount && keysDown[index];
 }
 
 /**
- * Returns true if the key transitioned from up->down between the previous
- * and current frame.
+ * Returns true if the key was pressed (outside the UI) since the previous frame.
  */
 bool InputManager::isKeyJustPressed(sf::Keyboard::Key key) const {
-    int index = static_cast<int>(key);
-    if (index >= 0 && index < static_cast<int>(currentKeys.size()) &&
-        index < static_cast<int>(previousKeys.size())) {
-        return currentKeys[index] && !previousKeys[index];
-    }
-    return false;
-}
\ No newline at end of file
+    const size_t index = keyIndex(key);
+    return index < KeyCount && keysJustPressed[index];
+}
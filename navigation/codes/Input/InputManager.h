@@ -3,44 +3,156 @@
 
 #include <SFML/Window.hpp>
 #include <SFML/Graphics.hpp>
+#include <array>
+#include <chrono>
+#include <optional>
 
 /*
  * File: InputManager.h
- * Description: Singleton that samples keyboard state and translates it into game input.
+ * Description: Singleton that turns window events into game actions.
  *
- * The InputManager polls SFML keyboard state each frame and stores the current
- * and previous states of all keys. It provides helpers to query movement input
- * vectors and detect key-press events (just-pressed).
+ * The game loop hands every event it polls to handleEvent() before anything
+ * else sees it; this is the single place where key presses become actions.
+ * Keys are mapped to actions (WASD and arrows move, E interacts, Enter
+ * confirms, ...), so game code asks for "Interact" instead of a key, and
+ * one binding table decides what a key does.
+ *
+ * Key state is kept from KeyPressed/KeyReleased events rather than polled,
+ * so a tap shorter than one frame is still seen as a press. Presses that
+ * arrive while the UI owns the input (a dialog is open) update the key state
+ * but never trigger a game action, so one key press can't be handled twice.
+ *
+ * Every event carries the time it was taken from the OS queue. The oldest
+ * action event a frame consumed is handed to the renderer, which measures
+ * how long it took until that frame was on screen.
+ */
+
+/**
+ * @enum InputAction
+ * @brief Game actions keys are bound to.
  */
+enum class InputAction {
+    MoveLeft,
+    MoveRight,
+    MoveUp,
+    MoveDown,
+    Sprint,
+    Interact,
+    Confirm,
+    Cancel,
+    ToggleMemoryOverlay,
+    ZoomIn,
+    ZoomOut,
+    Count
+};
+
 class InputManager {
 public:
+    using Clock = std::chrono::steady_clock;
+
     static InputManager& getInstance();
-    
+
+    /**
+     * @brief Feed one window event (called for every polled event).
+     *
+     * @param event Event from the window.
+     * @param receivedAt Time the event was taken from the OS queue.
+     * @param toGame false while the UI owns the input; key state still updates
+     *               but no action is triggered.
+     */
+    void handleEvent(const sf::Event& event, Clock::time_point receivedAt, bool toGame = true);
+
     /**
-     * @brief Update input state for the current frame.
+     * @brief Start a new frame: presses received since the last call become "just pressed".
+     *
+     * Call once per frame after all events were handled, before querying input.
      */
     void update();
-    
+
+    /**
+     * @brief Forget all held keys (focus loss, a nested window took the events).
+     */
+    void releaseAll();
+
+    /**
+     * @brief Bind a key to an action (a key triggers at most one action).
+     */
+    void bind(sf::Keyboard::Key key, InputAction action);
+
+    /**
+     * @brief Remove a key's binding.
+     */
+    void unbind(sf::Keyboard::Key key);
+
+    /**
+     * @brief Action a key is bound to (for UI code reading raw events).
+     */
+    std::optional<InputAction> actionOf(sf::Keyboard::Key key) const;
+
     /**
-     * @brief Get movement input vector (e.g. WASD / arrow keys).
+     * @brief Get movement input vector from the move actions.
      */
     sf::Vector2f getMoveInput() const;
-    
+
+    /**
+     * @brief Check whether any key bound to an action is held.
+     */
+    bool isActionDown(InputAction action) const;
+
+    /**
+     * @brief Check whether an action was pressed since the previous frame.
+     */
+    bool isActionJustPressed(InputAction action) const;
+
+    /**
+     * @brief Like isActionJustPressed, but only the first caller of a frame gets true.
+     */
+    bool consumeAction(InputAction action);
+
     /**
      * @brief Check whether a key is currently pressed.
      */
     bool isKeyPressed(sf::Keyboard::Key key) const;
-    
+
     /**
      * @brief Check whether a key was just pressed this frame (transition up->down).
      */
     bool isKeyJustPressed(sf::Keyboard::Key key) const;
 
+    /**
+     * @brief Vertical mouse wheel notches scrolled since the previous frame (positive = up).
+     */
+    float getWheelDelta() const { return frameWheel; }
+
+    /**
+     * @brief Receive time of the oldest action event the current frame consumed.
+     *
+     * @return Time to measure input latency from, or nothing if no action event arrived.
+     */
+    std::optional<Clock::time_point> getFrameInputTime() const { return frameInputAt; }
+
 private:
-    InputManager() = default;
-    
-    // Key state for the current frame
-    std::vector<bool> currentKeys;
-    // Key state for the previous frame
-    std::vector<bool> previousKeys;
-};
\ No newline at end of file
+    InputManager();
+
+    static constexpr size_t KeyCount = static_cast<size_t>(sf::Keyboard::KeyCount);
+    static constexpr size_t ActionCount = static_cast<size_t>(InputAction::Count);
+
+    // Binding table: key -> action
+    std::array<std::optional<InputAction>, KeyCount> bindings{};
+
+    // Key state, kept from events
+    std::array<bool, KeyCount> keysDown{};
+    std::array<bool, KeyCount> keysPressedSinceUpdate{};
+    std::array<bool, KeyCount> keysJustPressed{};
+
+    // Action state of the current frame
+    std::array<bool, ActionCount> actionsPressedSinceUpdate{};
+    std::array<bool, ActionCount> actionsJustPressed{};
+
+    // Vertical wheel notches, latched like the presses
+    float wheelSinceUpdate = 0.f;
+    float frameWheel = 0.f;
+
+    std::optional<Clock::time_point> pendingInputAt;   // Oldest action event since the last update
+    std::optional<Clock::time_point> frameInputAt;     // The same, for the current frame
+};
@@ -0,0 +1,486 @@
+// JobSystem.cpp
+#include "Jobs/JobSystem.h"
+#include "Utils/Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <string>
+
+/*
+ * File: JobSystem.cpp
+ * Description: Implementation of the work-stealing job system.
+ */
+
+namespace {
+    // Index of the worker running on this thread, -1 for threads outside the pool.
+    thread_local int tlsWorkerIndex = -1;
+
+    uint64_t nowNs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()
+        ).count());
+    }
+}
+
+
+/**
+ * @brief Add a job to the graph.
+ *
+ * @param fn Work to execute.
+ * @return JobGraph::NodeId Identifier of the new node.
+ */
+JobGraph::NodeId JobGraph::add(std::function<void()> fn) {
+    auto node = std::make_unique<Node>();
+    node->fn = std::move(fn);
+    nodes.push_back(std::move(node));
+    return nodes.size() - 1;
+}
+
+
+/**
+ * @brief Add a dependency edge between two nodes.
+ *
+ * @param before Node that must complete first.
+ * @param after Node that waits for it.
+ */
+void JobGraph::precede(NodeId before, NodeId after) {
+    if (before >= nodes.size() || after >= nodes.size() || before == after) {
+        Logger::error("JobGraph: invalid edge " + std::to_string(before) + " -> " + std::to_string(after));
+        return;
+    }
+    nodes[before]->successors.push_back(after);
+    nodes[after]->dependencies++;
+}
+
+
+/**
+ * @brief Get the process-wide job system.
+ *
+ * @return JobSystem& Singleton instance.
+ */
+JobSystem& JobSystem::getInstance() {
+    static JobSystem instance;
+    return instance;
+}
+
+JobSystem::JobSystem() : mainThreadId(std::this_thread::get_id()) {}
+
+JobSystem::~JobSystem() {
+    shutdown();
+}
+
+
+/**
+ * @brief Start the worker threads.
+ *
+ * @param workerCount Number of workers; negative uses hardware threads - 1.
+ */
+void JobSystem::initialize(int workerCount) {
+    shutdown();
+
+    mainThreadId = std::this_thread::get_id();
+
+    size_t count = 0;
+    if (workerCount < 0) {
+        const unsigned hw = std::thread::hardware_concurrency();
+        count = hw > 1 ? static_cast<size_t>(hw - 1) : 0;
+    } else {
+        count = static_cast<size_t>(workerCount);
+    }
+
+    stopping.store(false);
+    workers.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    for (size_t i = 0; i < count; ++i) {
+        workers[i]->thread = std::thread(&JobSystem::workerLoop, this, static_cast<int>(i));
+    }
+
+    Logger::info("Job system started with " + std::to_string(count) + " worker thread(s)");
+}
+
+
+/**
+ * @brief Finish queued jobs, stop the workers and log their utilisation.
+ */
+void JobSystem::shutdown() {
+    if (workers.empty()) return;
+
+    // Let outstanding jobs (and counters waiting on them) finish first
+    while (tryRunOne(-1)) {}
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping.store(true);
+    }
+    wakeCondition.notify_all();
+    for (auto& worker : workers) {
+        if (worker->thread.joinable()) worker->thread.join();
+    }
+
+    const auto stats = getWorkerStats();
+    for (size_t i = 0; i < stats.size(); ++i) {
+        Logger::info(
+            "Job worker " + std::to_string(i) + ": " +
+            std::to_string(stats[i].jobsExecuted) + " jobs (" +
+            std::to_string(stats[i].jobsStolen) + " stolen), " +
+            std::to_string(static_cast<int>(stats[i].utilisation * 100.0 + 0.5)) + "% busy"
+        );
+    }
+
+    workers.clear();
+    queuedJobs.store(0);
+}
+
+
+/**
+ * @brief Queue a job on the pool (or run it inline without workers).
+ *
+ * @param job Work to execute.
+ * @param counter Optional counter tracking completion.
+ */
+void JobSystem::submit(std::function<void()> job, JobCounter* counter) {
+    if (counter) counter->pending.fetch_add(1, std::memory_order_relaxed);
+    push(Job{std::move(job), counter});
+}
+
+
+/**
+ * @brief Hand a job to a worker deque and wake a sleeping worker.
+ *
+ * Workers push to their own deque; other threads spread jobs round-robin.
+ *
+ * @param job Job to queue (its counter is already incremented).
+ */
+void JobSystem::push(Job job) {
+    if (workers.empty()) {
+        execute(job);
+        return;
+    }
+
+    const size_t target = tlsWorkerIndex >= 0
+        ? static_cast<size_t>(tlsWorkerIndex)
+        : nextWorker.fetch_add(1, std::memory_order_relaxed) % workers.size();
+    {
+        // Count before publishing: a thief may pop the job as soon as it is in
+        // the deque, and its decrement must never run ahead of this increment
+        // (the counter is unsigned). Taking the sleep lock orders the increment
+        // with a worker's predicate check.
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queuedJobs.fetch_add(1, std::memory_order_release);
+    }
+    {
+        std::lock_guard<std::mutex> lock(workers[target]->mutex);
+        workers[target]->jobs.push_back(std::move(job));
+    }
+    wakeCondition.notify_one();
+}
+
+
+/**
+ * @brief Take a job: own deque (newest first), then steal the oldest from others.
+ *
+ * @param self Worker index of the calling thread, -1 outside the pool.
+ * @param out Receives the job.
+ * @param stolen Set when the job came from another worker's deque.
+ * @return true if a job was taken.
+ */
+bool JobSystem::popJob(int self, Job& out, bool& stolen) {
+    if (queuedJobs.load(std::memory_order_acquire) == 0) return false;
+
+    if (self >= 0) {
+        Worker& own = *workers[static_cast<size_t>(self)];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            out = std::move(own.jobs.back());
+            own.jobs.pop_back();
+            queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            stolen = false;
+            return true;
+        }
+    }
+
+    const size_t count = workers.size();
+    const size_t start = self >= 0 ? static_cast<size_t>(self) + 1 : 0;
+    for (size_t k = 0; k < count; ++k) {
+        const size_t victim = (start + k) % count;
+        if (static_cast<int>(victim) == self) continue;
+        Worker& other = *workers[victim];
+        std::lock_guard<std::mutex> lock(other.mutex);
+        if (!other.jobs.empty()) {
+            out = std::move(other.jobs.front());
+            other.jobs.pop_front();
+            queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            stolen = self >= 0;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+/**
+ * @brief Run one queued job on the calling thread, if any.
+ *
+ * @param self Worker index of the calling thread, -1 outside the pool.
+ * @return true if a job was executed.
+ */
+bool JobSystem::tryRunOne(int self) {
+    Job job;
+    bool stolen = false;
+    if (!popJob(self, job, stolen)) return false;
+
+    if (self >= 0) {
+        Worker& worker = *workers[static_cast<size_t>(self)];
+        const uint64_t start = nowNs();
+        execute(job);
+        worker.busyNs.fetch_add(nowNs() - start, std::memory_order_relaxed);
+        worker.jobsExecuted.fetch_add(1, std::memory_order_relaxed);
+        if (stolen) worker.jobsStolen.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        execute(job);
+    }
+    return true;
+}
+
+
+/**
+ * @brief Run a job and signal its counter; exceptions are logged, not propagated.
+ *
+ * @param job Job to execute.
+ */
+void JobSystem::execute(Job& job) {
+    try {
+        if (job.fn) job.fn();
+    } catch (const std::exception& ex) {
+        Logger::error(std::string("Job threw an exception: ") + ex.what());
+    } catch (...) {
+        Logger::error("Job threw an unknown exception");
+    }
+    if (job.counter) job.counter->pending.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+
+/**
+ * @brief Worker thread body: run jobs, steal when empty, sleep when nothing is queued.
+ *
+ * @param index Index of this worker.
+ */
+void JobSystem::workerLoop(int index) {
+    tlsWorkerIndex = index;
+    Worker& self = *workers[static_cast<size_t>(index)];
+
+    while (true) {
+        if (tryRunOne(index)) continue;
+
+        const uint64_t idleStart = nowNs();
+        {
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wakeCondition.wait(lock, [this]() {
+                return stopping.load() || queuedJobs.load(std::memory_order_acquire) > 0;
+            });
+        }
+        self.idleNs.fetch_add(nowNs() - idleStart, std::memory_order_relaxed);
+
+        if (stopping.load() && queuedJobs.load(std::memory_order_acquire) == 0) break;
+    }
+
+    tlsWorkerIndex = -1;
+}
+
+
+/**
+ * @brief Help execute jobs until the counter reaches zero.
+ *
+ * @param counter Counter to wait on.
+ */
+void JobSystem::wait(JobCounter& counter) {
+    const bool onMain = isMainThread();
+    while (!counter.isDone()) {
+        if (tryRunOne(tlsWorkerIndex)) continue;
+        if (onMain && runMainThreadJobs(1) > 0) continue;
+        std::this_thread::yield();
+    }
+}
+
+
+/**
+ * @brief Run body over [begin, end) in chunks spread across the pool.
+ *
+ * @param begin First index.
+ * @param end One past the last index.
+ * @param grain Minimum chunk size.
+ * @param body Chunk callback.
+ */
+void JobSystem::parallelFor(
+    size_t begin,
+    size_t end,
+    size_t grain,
+    const std::function<void(size_t, size_t)>& body
+) {
+    if (end <= begin) return;
+    const size_t total = end - begin;
+    grain = std::max<size_t>(grain, 1);
+
+    if (workers.empty() || total <= grain) {
+        body(begin, end);
+        return;
+    }
+
+    // A few chunks per thread keeps stealing effective without flooding the deques
+    const size_t maxChunks = (workers.size() + 1) * 4;
+    const size_t chunk = std::max(grain, (total + maxChunks - 1) / maxChunks);
+
+    JobCounter counter;
+    for (size_t lo = begin; lo < end; lo += chunk) {
+        const size_t hi = std::min(end, lo + chunk);
+        submit([&body, lo, hi]() { body(lo, hi); }, &counter);
+    }
+    wait(counter);
+}
+
+
+/**
+ * @brief Execute a graph node and release successors whose dependencies are met.
+ *
+ * @param graph Graph being run.
+ * @param id Node to execute.
+ * @param counter Counter covering every node of the graph.
+ */
+void JobSystem::runGraphNode(JobGraph& graph, JobGraph::NodeId id, JobCounter* counter) {
+    JobGraph::Node& node = *graph.nodes[id];
+
+    // Successors are released even if the node fails, otherwise run() would never return
+    Job body{node.fn, nullptr};
+    execute(body);
+
+    for (JobGraph::NodeId next : node.successors) {
+        if (graph.nodes[next]->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            push(Job{[this, &graph, next, counter]() { runGraphNode(graph, next, counter); }, counter});
+        }
+    }
+}
+
+
+/**
+ * @brief Run a job graph to completion.
+ *
+ * @param graph Graph to execute.
+ * @return true on success, false if the graph has a cycle.
+ */
+bool JobSystem::run(JobGraph& graph) {
+    if (graph.nodes.empty()) return true;
+
+    // Kahn's algorithm: refuse graphs whose nodes could never become ready
+    std::vector<int> indegree(graph.nodes.size());
+    std::vector<JobGraph::NodeId> ready;
+    for (size_t i = 0; i < graph.nodes.size(); ++i) {
+        indegree[i] = graph.nodes[i]->dependencies;
+        if (indegree[i] == 0) ready.push_back(i);
+    }
+    size_t visited = 0;
+    for (size_t r = 0; r < ready.size(); ++r, ++visited) {
+        for (JobGraph::NodeId next : graph.nodes[ready[r]]->successors) {
+            if (--indegree[next] == 0) ready.push_back(next);
+        }
+    }
+    if (visited != graph.nodes.size()) {
+        Logger::error("JobGraph contains a cycle; not running it");
+        return false;
+    }
+
+    JobCounter counter;
+    counter.pending.store(graph.nodes.size(), std::memory_order_relaxed);
+    for (auto& node : graph.nodes) {
+        node->remaining.store(node->dependencies, std::memory_order_relaxed);
+    }
+    for (size_t i = 0; i < graph.nodes.size(); ++i) {
+        if (graph.nodes[i]->dependencies == 0) {
+            push(Job{[this, &graph, i, &counter]() { runGraphNode(graph, i, &counter); }, &counter});
+        }
+    }
+    wait(counter);
+    return true;
+}
+
+
+/**
+ * @brief Queue work for the main thread.
+ *
+ * @param job Work to execute.
+ * @param counter Optional counter tracking completion.
+ */
+void JobSystem::postToMainThread(std::function<void()> job, JobCounter* counter) {
+    if (counter) counter->pending.fetch_add(1, std::memory_order_relaxed);
+    if (isMainThread() && workers.empty()) {
+        Job inlineJob{std::move(job), counter};
+        execute(inlineJob);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mainMutex);
+    mainJobs.push_back(Job{std::move(job), counter});
+}
+
+
+/**
+ * @brief Execute queued main-thread jobs.
+ *
+ * @param maxJobs Upper bound on jobs run by this call.
+ * @return size_t Number of jobs executed.
+ */
+size_t JobSystem::runMainThreadJobs(size_t maxJobs) {
+    if (!isMainThread()) {
+        Logger::error("runMainThreadJobs called off the main thread");
+        return 0;
+    }
+
+    size_t executed = 0;
+    while (executed < maxJobs) {
+        Job job;
+        {
+            std::lock_guard<std::mutex> lock(mainMutex);
+            if (mainJobs.empty()) break;
+            job = std::move(mainJobs.front());
+            mainJobs.pop_front();
+        }
+        execute(job);
+        ++executed;
+    }
+    return executed;
+}
+
+
+/**
+ * @brief Snapshot of every worker's utilisation counters.
+ *
+ * @return std::vector<JobWorkerStats> One entry per worker.
+ */
+std::vector<JobWorkerStats> JobSystem::getWorkerStats() const {
+    std::vector<JobWorkerStats> out;
+    out.reserve(workers.size());
+    for (const auto& worker : workers) {
+        JobWorkerStats s;
+        s.jobsExecuted = static_cast<size_t>(worker->jobsExecuted.load(std::memory_order_relaxed));
+        s.jobsStolen = static_cast<size_t>(worker->jobsStolen.load(std::memory_order_relaxed));
+        s.busyMs = static_cast<double>(worker->busyNs.load(std::memory_order_relaxed)) / 1e6;
+        s.idleMs = static_cast<double>(worker->idleNs.load(std::memory_order_relaxed)) / 1e6;
+        const double total = s.busyMs + s.idleMs;
+        s.utilisation = total > 0.0 ? s.busyMs / total : 0.0;
+        out.push_back(s);
+    }
+    return out;
+}
+
+
+/**
+ * @brief Zero every worker's counters.
+ */
+void JobSystem::resetStats() {
+    for (auto& worker : workers) {
+        worker->jobsExecuted.store(0, std::memory_order_relaxed);
+        worker->jobsStolen.store(0, std::memory_order_relaxed);
+        worker->busyNs.store(0, std::memory_order_relaxed);
+        worker->idleNs.store(0, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,243 @@
+// JobSystem.h
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * File: JobSystem.h
+ * Description: Work-stealing thread pool with counters, task graphs and parallel-for.
+ *
+ * Each worker owns a deque: it pushes and pops its own jobs at the back and
+ * steals from the front of other workers' deques when it runs dry. Jobs
+ * submitted from outside the pool are spread round-robin across the workers.
+ * A thread waiting on a JobCounter keeps executing queued jobs instead of
+ * blocking, so jobs may themselves submit and wait without deadlocking.
+ *
+ * Work that must run on the thread owning the OpenGL context (texture uploads,
+ * window calls) is posted to a separate main-thread queue, drained by the game
+ * loop through runMainThreadJobs (and while the main thread waits on a counter).
+ *
+ * Notes:
+ *   - With zero workers (the default until initialize is called) every job runs
+ *     inline on the submitting thread, so tools and benchmarks behave exactly as
+ *     single-threaded code.
+ *   - Jobs must not touch SFML graphics resources other than sf::Image.
+ */
+
+/**
+ * @struct JobWorkerStats
+ * @brief Utilisation counters of one worker thread since the last resetStats.
+ */
+struct JobWorkerStats {
+    size_t jobsExecuted = 0;    ///< Jobs run by this worker
+    size_t jobsStolen = 0;      ///< Of those, jobs taken from another worker's deque
+    double busyMs = 0.0;        ///< Time spent running jobs
+    double idleMs = 0.0;        ///< Time spent looking for or waiting on work
+    double utilisation = 0.0;   ///< busyMs / (busyMs + idleMs)
+};
+
+/**
+ * @class JobCounter
+ * @brief Number of outstanding jobs of a batch; JobSystem::wait blocks until it reaches zero.
+ */
+class JobCounter {
+public:
+    bool isDone() const { return pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    std::atomic<size_t> pending{0};
+};
+
+/**
+ * @class JobGraph
+ * @brief Set of jobs with "runs before" edges, executed by JobSystem::run.
+ *
+ * A node becomes ready once all of its predecessors have finished. A graph can
+ * be run several times; it must not be modified while running.
+ */
+class JobGraph {
+public:
+    using NodeId = size_t;
+
+    /**
+     * @brief Add a job to the graph.
+     *
+     * @param fn Work to execute.
+     * @return NodeId Identifier used with precede().
+     */
+    NodeId add(std::function<void()> fn);
+
+    /**
+     * @brief Require that `before` finishes before `after` starts.
+     *
+     * @param before Node that must complete first.
+     * @param after Node that depends on it.
+     */
+    void precede(NodeId before, NodeId after);
+
+    size_t size() const { return nodes.size(); }
+
+private:
+    friend class JobSystem;
+
+    struct Node {
+        std::function<void()> fn;
+        std::vector<NodeId> successors;
+        int dependencies = 0;
+        std::atomic<int> remaining{0};
+    };
+
+    // Nodes are heap-allocated because std::atomic is neither copyable nor movable.
+    std::vector<std::unique_ptr<Node>> nodes;
+};
+
+class JobSystem {
+public:
+    /**
+     * @brief Get the process-wide job system.
+     *
+     * @return JobSystem& Singleton instance.
+     */
+    static JobSystem& getInstance();
+
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    /**
+     * @brief Start the worker threads; the calling thread becomes the main thread.
+     *
+     * Calling it again restarts the pool with the new worker count.
+     *
+     * @param workerCount Number of workers; negative uses hardware threads - 1,
+     *                    zero runs every job inline.
+     */
+    void initialize(int workerCount = -1);
+
+    /**
+     * @brief Finish queued jobs, stop the workers and log their utilisation.
+     */
+    void shutdown();
+
+    size_t getWorkerCount() const { return workers.size(); }
+
+    /**
+     * @brief Queue a job on the pool.
+     *
+     * @param job Work to execute.
+     * @param counter Optional counter incremented now and decremented when the job ends.
+     */
+    void submit(std::function<void()> job, JobCounter* counter = nullptr);
+
+    /**
+     * @brief Run queued jobs on the calling thread until the counter reaches zero.
+     *
+     * On the main thread, main-thread jobs are drained while waiting as well.
+     *
+     * @param counter Counter to wait on.
+     */
+    void wait(JobCounter& counter);
+
+    /**
+     * @brief Split [begin, end) into chunks of at least `grain` items and run them in parallel.
+     *
+     * Returns once every chunk has finished; the caller executes chunks too.
+     *
+     * @param begin First index.
+     * @param end One past the last index.
+     * @param grain Minimum number of items per chunk.
+     * @param body Called as body(chunkBegin, chunkEnd) for each chunk.
+     */
+    void parallelFor(
+        size_t begin,
+        size_t end,
+        size_t grain,
+        const std::function<void(size_t, size_t)>& body
+    );
+
+    /**
+     * @brief Run a job graph and wait for all of its nodes.
+     *
+     * @param graph Graph to execute.
+     * @return true on success, false if the graph contains a cycle (nothing is run).
+     */
+    bool run(JobGraph& graph);
+
+    /**
+     * @brief Queue work that must run on the main thread (e.g. OpenGL uploads).
+     *
+     * @param job Work to execute during the next runMainThreadJobs.
+     * @param counter Optional counter incremented now and decremented when the job ends.
+     */
+    void postToMainThread(std::function<void()> job, JobCounter* counter = nullptr);
+
+    /**
+     * @brief Execute queued main-thread jobs; call once per frame from the main thread.
+     *
+     * @param maxJobs Upper bound on the number of jobs run by this call.
+     * @return size_t Number of jobs executed.
+     */
+    size_t runMainThreadJobs(size_t maxJobs = std::numeric_limits<size_t>::max());
+
+    bool isMainThread() const { return std::this_thread::get_id() == mainThreadId; }
+
+    /**
+     * @brief Snapshot of every worker's counters.
+     *
+     * @return std::vector<JobWorkerStats> One entry per worker.
+     */
+    std::vector<JobWorkerStats> getWorkerStats() const;
+
+    void resetStats();
+
+private:
+    struct Job {
+        std::function<void()> fn;
+        JobCounter* counter = nullptr;
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+        std::thread thread;
+
+        std::atomic<uint64_t> jobsExecuted{0};
+        std::atomic<uint64_t> jobsStolen{0};
+        std::atomic<uint64_t> busyNs{0};
+        std::atomic<uint64_t> idleNs{0};
+    };
+
+    JobSystem();
+
+    void push(Job job);
+    bool tryRunOne(int self);
+    bool popJob(int self, Job& out, bool& stolen);
+    static void execute(Job& job);
+    void workerLoop(int index);
+    void runGraphNode(JobGraph& graph, JobGraph::NodeId id, JobCounter* counter);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<size_t> nextWorker{0};
+    std::atomic<size_t> queuedJobs{0};   // Counted before a push publishes the job, so never below the deques' total
+    std::atomic<bool> stopping{false};
+
+    // Sleeping workers wait here when every deque is empty.
+    std::mutex sleepMutex;
+    std::condition_variable wakeCondition;
+
+    std::mutex mainMutex;
+    std::deque<Job> mainJobs;
+    std::thread::id mainThreadId;
+};
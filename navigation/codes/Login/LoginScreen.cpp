@@ -1,11 +1,17 @@
 #include "LoginScreen.h"
 #include "Renderer/Renderer.h"
 #include "MapGuideScreen.h"
+#include "UI/NineSlice.h"
+#include "UI/Widget.h"
 
 
 #include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <functional>
 #include <optional>
 #include <iostream>
+#include <string>
+#include <utility>
 
 // Show Home -> Intro -> Controls on the same window.
 // Return true  -> go into the actual game
@@ -49,15 +55,14 @@ bool runLoginScreen(Renderer& renderer)
         sf::Vector2i{100, 100}     // size in the spritesheet
     };
 
-    sf::Sprite bgPanel(uiTexture, BG_PANEL_RECT);
+    // Nine-slice: the riveted frame keeps its shape at any window size
+    const NineSlice bgPanel = NineSlice::uniform(uiTexture, BG_PANEL_RECT, 10);
+    const sf::FloatRect bgRect{sf::Vector2f{0.f, 0.f}, sf::Vector2f{winW, winH}};
+    const float bgBorderScale = std::max(1.f, winH / 240.f);
 
-    const float bgW = static_cast<float>(BG_PANEL_RECT.size.x);
-    const float bgH = static_cast<float>(BG_PANEL_RECT.size.y);
-
-    const float bgScaleX = winW / bgW;
-    const float bgScaleY = winH / bgH;
-    bgPanel.setScale(sf::Vector2f{bgScaleX, bgScaleY});
-    bgPanel.setPosition(sf::Vector2f{0.f, 0.f});
+    // The background is shared by every page and drawn before the page's widgets
+    UiBatch background;
+    background.add(bgPanel, bgRect, sf::Color::White, bgBorderScale);
 
     const sf::Color deepBrown(150, 100, 60);
 
@@ -74,111 +79,58 @@ bool runLoginScreen(Renderer& renderer)
     const unsigned int buttonSize       = static_cast<unsigned int>(winH * 0.04f);
     const unsigned int controlsTextSize = static_cast<unsigned int>(winH * 0.035f);
 
-    const float gameTitleY = winH * 0.18f;
-    const float homeTitleY = winH * 0.40f;
-
-    // 5. Game title
-    sf::Text gameTitle(font);
-    gameTitle.setString("Daily Life in CUHKSZ");
-    gameTitle.setCharacterSize(gameTitleSize);
-    gameTitle.setFillColor(sf::Color::White);
-    {
-        sf::FloatRect b = gameTitle.getLocalBounds();
-        gameTitle.setOrigin(sf::Vector2f{
-            b.position.x + b.size.x / 2.f,
-            b.position.y + b.size.y / 2.f
-        });
-        gameTitle.setPosition(sf::Vector2f{winW * 0.5f, gameTitleY});
-    }
-
-    // 6. "Home" title
-    sf::Text homeTitle(font);
-    homeTitle.setString("Home");
-    homeTitle.setCharacterSize(pageTitleSize);
-    homeTitle.setFillColor(sf::Color::White);
-    {
-        sf::FloatRect b = homeTitle.getLocalBounds();
-        homeTitle.setOrigin(sf::Vector2f{
-            b.position.x + b.size.x / 2.f,
-            b.position.y + b.size.y / 2.f
-        });
-        homeTitle.setPosition(sf::Vector2f{winW * 0.5f, homeTitleY});
-    }
-
-    // 7. Buttons on Home screen
+    // 5. Home and Intro pages: one widget tree, a column per page
     const sf::IntRect BUTTON_KHAKI_RECT{
         sf::Vector2i{2, 240},
         sf::Vector2i{188, 40}
     };
+    const NineSlice buttonPanel = NineSlice::uniform(uiTexture, BUTTON_KHAKI_RECT, 8);
+    const float buttonH = static_cast<float>(BUTTON_KHAKI_RECT.size.y)
+                        * winW * 0.25f / static_cast<float>(BUTTON_KHAKI_RECT.size.x);
 
-    sf::Sprite enterButtonSprite(uiTexture, BUTTON_KHAKI_RECT);
-    sf::Sprite exitButtonSprite(uiTexture,  BUTTON_KHAKI_RECT);
-
-    const float baseButtonW = static_cast<float>(BUTTON_KHAKI_RECT.size.x);
-    const float baseButtonH = static_cast<float>(BUTTON_KHAKI_RECT.size.y);
-
-    const float targetButtonWidth = winW * 0.25f;
-    const float buttonScaleX      = targetButtonWidth / baseButtonW;
-    const float buttonScaleY      = buttonScaleX * 1.3f;
-
-    enterButtonSprite.setScale(sf::Vector2f{buttonScaleX, buttonScaleY});
-    exitButtonSprite.setScale(sf::Vector2f{buttonScaleX, buttonScaleY});
-
-    enterButtonSprite.setOrigin(sf::Vector2f{baseButtonW / 2.f, baseButtonH / 2.f});
-    exitButtonSprite.setOrigin(sf::Vector2f{baseButtonW / 2.f, baseButtonH / 2.f});
-
-    const float centerX      = winW * 0.5f;
-    const float enterButtonY = winH * 0.55f;
-    const float exitButtonY  = winH * 0.70f;
+    enum class ScreenState { Home, Intro, Controls };
+    ScreenState screen = ScreenState::Home;
+    bool wantStartGame = false;
+    bool wantExit = false;
 
-    enterButtonSprite.setPosition(sf::Vector2f{centerX, enterButtonY});
-    exitButtonSprite.setPosition(sf::Vector2f{centerX, exitButtonY});
+    WidgetTree pages;
+    pages.setViewport(winSize);
 
-    sf::Text enterText(font);
-    enterText.setString("Enter");
-    enterText.setCharacterSize(buttonSize);
-    enterText.setFillColor(sf::Color::White);
-    {
-        sf::FloatRect b = enterText.getLocalBounds();
-        enterText.setOrigin(sf::Vector2f{
-            b.position.x + b.size.x / 2.f,
-            b.position.y + b.size.y / 2.f
-        });
-        enterText.setPosition(enterButtonSprite.getPosition());
-    }
+    auto addTitle = [&](Widget& page, const std::string& text, unsigned int size, float marginBottom) {
+        auto& title = page.addChild<LabelWidget>(font, size);
+        title.setString(text);
+        title.setMarginBottom(marginBottom);
+    };
 
-    sf::Text exitText(font);
-    exitText.setString("Exit");
-    exitText.setCharacterSize(buttonSize);
-    exitText.setFillColor(sf::Color::White);
-    {
-        sf::FloatRect b = exitText.getLocalBounds();
-        exitText.setOrigin(sf::Vector2f{
-            b.position.x + b.size.x / 2.f,
-            b.position.y + b.size.y / 2.f
-        });
-        exitText.setPosition(exitButtonSprite.getPosition());
-    }
+    auto addButton = [&](Widget& page, const std::string& text, float marginBottom, std::function<void()> onClick) {
+        auto& button = page.addChild<ButtonWidget>(buttonPanel, font, buttonSize);
+        button.setWidthFraction(0.25f, 0.1f, 100.f);
+        button.getLabel().setString(text);
+        button.setMarginBottom(marginBottom);
+        button.setOnClick(std::move(onClick));
+    };
 
-    // 8. Intro text page
-    sf::Text introText(font);
-    introText.setString(
+    // Home: title, page title, Enter and Exit
+    auto& homePage = pages.getRoot().addChild<Widget>();
+    addTitle(homePage, "Daily Life in CUHKSZ", gameTitleSize, winH * 0.15f);
+    addTitle(homePage, "Home", pageTitleSize, winH * 0.10f);
+    addButton(homePage, "Enter", std::max(0.f, winH * 0.15f - buttonH), [&] { screen = ScreenState::Intro; });
+    addButton(homePage, "Exit", 0.f, [&] { wantExit = true; });
+
+    // Intro: title over the background text
+    auto& introPage = pages.getRoot().addChild<Widget>();
+    addTitle(introPage, "Daily Life in CUHKSZ", gameTitleSize, winH * 0.12f);
+    addTitle(introPage,
         "Background Introduction\n\n"
         "- You are a new student at CUHKSZ.\n"
         "- You are going to spend 7 days here.\n"
         "- Talk to NPCs and complete tasks.\n"
         "- Explore the campus at your wish.\n\n"
-        "[Press Enter to continue...]"
-    );
-    introText.setCharacterSize(buttonSize);
-    introText.setFillColor(sf::Color::White);
-    {
-        sf::FloatRect b = introText.getLocalBounds();
-        introText.setOrigin(sf::Vector2f{b.size.x / 2.f, b.size.y / 2.f});
-        introText.setPosition(sf::Vector2f{winW * 0.5f, winH * 0.5f});
-    }
+        "[Press Enter to continue...]",
+        buttonSize, 0.f);
+    introPage.setVisible(false);
 
-    // 9. Controls page: icons and labels
+    // 6. Controls page: icons and labels
 
     // Title for controls page
     sf::Text controlsTitle(font);
@@ -372,12 +324,7 @@ bool runLoginScreen(Renderer& renderer)
     }
 
 
-    // 10. Screen state machine: Home -> Intro -> Controls
-    enum class ScreenState { Home, Intro, Controls };
-    ScreenState screen = ScreenState::Home;
-    bool wantStartGame = false;
-
-    // 11. Main loop
+    // 7. Main loop
     while (window.isOpen() && !wantStartGame) {
         while (const std::optional event = window.pollEvent()) {
             if (event->is<sf::Event::Closed>()) {
@@ -385,21 +332,15 @@ bool runLoginScreen(Renderer& renderer)
                 return false;
             }
 
-            // Mouse click for buttons on Home screen
+            // Buttons of the visible page (hidden pages have no hit rects)
+            if (const auto* mouseMoved = event->getIf<sf::Event::MouseMoved>()) {
+                pages.updateHover(sf::Vector2f(mouseMoved->position));
+            }
+
             if (const auto* mouseButton = event->getIf<sf::Event::MouseButtonPressed>()) {
                 if (mouseButton->button == sf::Mouse::Button::Left) {
-                    sf::Vector2f mousePos(
-                        static_cast<float>(mouseButton->position.x),
-                        static_cast<float>(mouseButton->position.y)
-                    );
-
-                    if (screen == ScreenState::Home) {
-                        if (enterButtonSprite.getGlobalBounds().contains(mousePos)) {
-                            screen = ScreenState::Intro; // Home -> Intro
-                        } else if (exitButtonSprite.getGlobalBounds().contains(mousePos)) {
-                            window.close();
-                            return false;
-                        }
+                    if (Widget* hit = pages.hitTest(sf::Vector2f(mouseButton->position))) {
+                        hit->getOnClick()();
                     }
                 }
             }
@@ -418,23 +359,22 @@ bool runLoginScreen(Renderer& renderer)
             }
         }
 
+        if (wantExit) {
+            window.close();
+            return false;
+        }
+
+        // Only the current page is visible; the tree relayouts when this changes
+        homePage.setVisible(screen == ScreenState::Home);
+        introPage.setVisible(screen == ScreenState::Intro);
+
         // Draw current screen
         window.clear(deepBrown);
-        window.draw(bgPanel);
-
-        if (screen == ScreenState::Home) {
-            window.draw(gameTitle);
-            window.draw(homeTitle);
-            window.draw(enterButtonSprite);
-            window.draw(exitButtonSprite);
-            window.draw(enterText);
-            window.draw(exitText);
-        }
-        else if (screen == ScreenState::Intro) {
-            window.draw(gameTitle);
-            window.draw(introText);
+        background.draw(window);
+        if (screen != ScreenState::Controls) {
+            pages.draw(window);
         }
-        else { // ScreenState::Controls
+        else {
             window.draw(controlsTitle);
 
             // Movement
@@ -1,7 +1,10 @@
 #include "MapGuideScreen.h"
 #include "Renderer/Renderer.h"
+#include "UI/NineSlice.h"
+#include "UI/Widget.h"
 
 #include <SFML/Graphics.hpp>
+#include <algorithm>
 #include <optional>
 #include <iostream>
 #include <vector>
@@ -41,8 +44,6 @@ bool runMapGuideScreen(Renderer& renderer)
         return true;
     }
 
-    sf::Sprite dialogSprite(dialogTexture);
-
     // Base size from the texture itself
     const auto dlgSize   = dialogTexture.getSize();
     const float baseDlgW = static_cast<float>(dlgSize.x);
@@ -51,18 +52,10 @@ bool runMapGuideScreen(Renderer& renderer)
     // Scale dialog to take about 55% of the window width
     const float dialogTargetW = winW * 0.55f;
     const float dialogScale   = dialogTargetW / baseDlgW;
-    dialogSprite.setScale(sf::Vector2f{dialogScale, dialogScale});
 
     const float dialogPixW = baseDlgW * dialogScale;
     const float dialogPixH = baseDlgH * dialogScale;
 
-    // Place the dialog near the bottom center
-    dialogSprite.setPosition(sf::Vector2f{
-        (winW - dialogPixW) * 0.5f,
-        winH * 0.60f
-    });
-
-
     // 3. Font
     sf::Font font;
     if (!font.openFromFile("fonts/arial.ttf")) {
@@ -72,6 +65,27 @@ bool runMapGuideScreen(Renderer& renderer)
 
     const unsigned int textSize = 24;
 
+    // Dialog near the bottom center: a column padded down to 60% of the window
+    // holds the nine-slice panel, whose label is updated per hint. Clicking the
+    // dialog moves to the next hint like Enter does.
+    std::size_t current = 0;
+    bool advance = false;
+
+    WidgetTree dialogTree;
+    dialogTree.setViewport(winSize);
+
+    auto& dialogColumn = dialogTree.getRoot().addChild<Widget>();
+    dialogColumn.setPadding(winH * 0.60f, 0.f);
+
+    auto& dialogPanel = dialogColumn.addChild<PanelWidget>(
+        NineSlice::uniform(dialogTexture, sf::IntRect{{0, 0}, sf::Vector2i(dlgSize)}, 12));
+    dialogPanel.setWidthFraction(0.55f, dialogScale, dialogScale);
+    dialogPanel.setPadding(dialogPixH * 0.10f, dialogPixW * 0.06f);   // ~10% / ~6% of the panel
+    dialogPanel.setMarginBottom(std::max(0.f, winH * 0.40f - dialogPixH));
+    dialogPanel.setOnClick([&] { advance = true; });
+
+    auto& hintLabel = dialogPanel.addChild<LabelWidget>(font, textSize);
+
         
     // 4. UI hint data (normalized coords + text)
     struct UiHint {
@@ -163,10 +177,6 @@ bool runMapGuideScreen(Renderer& renderer)
         "[This is the last hint, press Enter to start the game...]\n"
     });
 
-    std::size_t current = 0;
-
-
-
     // 5. Main loop: A/Left prev, D/Right next, Enter to finish
     while (window.isOpen()) {
         // Events
@@ -183,15 +193,27 @@ bool runMapGuideScreen(Renderer& renderer)
                 }
 
                 if (keyPressed->code == sf::Keyboard::Key::Enter) {
-                    // Enter always moves forward; on last hint it finishes
-                    if (current + 1 < hints.size()) {
-                        ++current;
-                    } else {
-                        return true; // finished all hints, enter the game
+                    advance = true;
+                }
+            }
+
+            if (const auto* mouseButton = event->getIf<sf::Event::MouseButtonPressed>()) {
+                if (mouseButton->button == sf::Mouse::Button::Left) {
+                    if (Widget* hit = dialogTree.hitTest(sf::Vector2f(mouseButton->position))) {
+                        hit->getOnClick()();
                     }
                 }
             }
+        }
 
+        // Enter or a click always moves forward; on the last hint it finishes
+        if (advance) {
+            advance = false;
+            if (current + 1 < hints.size()) {
+                ++current;
+            } else {
+                return true; // finished all hints, enter the game
+            }
         }
 
         // Draw
@@ -216,34 +238,9 @@ bool runMapGuideScreen(Renderer& renderer)
             highlight.setOutlineThickness(3.f);
             window.draw(highlight);
 
-            // Dialog panel + text
-            window.draw(dialogSprite);
-
-            sf::Text text(font);
-            text.setString(h.text);
-            text.setCharacterSize(textSize);
-            text.setFillColor(sf::Color::White);
-
-            sf::FloatRect tb = text.getLocalBounds();
-
-            // Use top-left as origin (not center)
-            text.setOrigin(sf::Vector2f{
-                tb.position.x,
-                tb.position.y
-            });
-
-            const sf::Vector2f dialogPos = dialogSprite.getPosition();
-
-            // Padding inside the dialog panel
-            const float padX = dialogPixW * 0.06f;  // ~6% of panel width
-            const float padY = dialogPixH * 0.10f;  // ~10% of panel height
-
-            text.setPosition(sf::Vector2f{
-                dialogPos.x + padX,
-                dialogPos.y + padY
-            });
-
-            window.draw(text);
+            // Dialog panel + text (relaid out only when the hint changes)
+            hintLabel.setString(h.text);
+            dialogTree.draw(window);
         }
 
         // Do not draw HUD buttons on the tutorial/map-guide overlay window.
@@ -0,0 +1,159 @@
+// Lightmap.cpp
+#include "MapLoader/Lightmap.h"
+#include "Utils/Logger.h"
+#include "Utils/MemoryTracker.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+
+/*
+ * File: Lightmap.cpp
+ * Description: CPU bake of lamp falloff into per-chunk shade textures.
+ */
+
+namespace {
+    /**
+     * @brief Falloff of a lamp at a squared distance, 1 at the center and 0 at the radius.
+     *
+     * (1 - d^2/r^2)^2 is smooth at both ends, so pools have no visible rim.
+     */
+    float falloff(float distanceSq, float radiusSq) {
+        const float t = 1.f - distanceSq / radiusSq;
+        return t * t;
+    }
+}
+
+
+size_t Lightmap::bakeImages(const std::vector<LightSource>& lights, sf::Vector2i worldSize) {
+    if (lights.empty() || worldSize.x <= 0 || worldSize.y <= 0) return 0;
+
+    columns = (worldSize.x + ChunkPixels - 1) / ChunkPixels;
+    rows = (worldSize.y + ChunkPixels - 1) / ChunkPixels;
+    chunks.resize(static_cast<size_t>(columns) * static_cast<size_t>(rows));
+    for (int row = 0; row < rows; ++row) {
+        for (int col = 0; col < columns; ++col) {
+            const float left = static_cast<float>(col * ChunkPixels);
+            const float top = static_cast<float>(row * ChunkPixels);
+            Chunk& chunk = chunks[static_cast<size_t>(row) * static_cast<size_t>(columns) + static_cast<size_t>(col)];
+            chunk.bounds = sf::FloatRect({left, top},
+                {std::min(static_cast<float>(ChunkPixels), static_cast<float>(worldSize.x) - left),
+                 std::min(static_cast<float>(ChunkPixels), static_cast<float>(worldSize.y) - top)});
+        }
+    }
+
+    // Accumulated light (rgb, 1 = full) per texel of every chunk a lamp reaches
+    const size_t texelsPerChunk = static_cast<size_t>(ChunkTexels) * ChunkTexels;
+    std::unordered_map<size_t, std::vector<float>> lit;
+
+    for (const auto& light : lights) {
+        if (light.radius <= 0.f || light.intensity <= 0.f) continue;
+        const float radiusSq = light.radius * light.radius;
+        const float r = light.intensity * light.color.r / 255.f;
+        const float g = light.intensity * light.color.g / 255.f;
+        const float b = light.intensity * light.color.b / 255.f;
+
+        const int c0 = std::max(0, static_cast<int>(std::floor((light.position.x - light.radius) / ChunkPixels)));
+        const int c1 = std::min(columns - 1, static_cast<int>(std::floor((light.position.x + light.radius) / ChunkPixels)));
+        const int r0 = std::max(0, static_cast<int>(std::floor((light.position.y - light.radius) / ChunkPixels)));
+        const int r1 = std::min(rows - 1, static_cast<int>(std::floor((light.position.y + light.radius) / ChunkPixels)));
+
+        for (int row = r0; row <= r1; ++row) {
+            for (int col = c0; col <= c1; ++col) {
+                const size_t index = static_cast<size_t>(row) * static_cast<size_t>(columns) + static_cast<size_t>(col);
+                std::vector<float>* texels = nullptr;
+
+                // Texels of this chunk whose centers may lie inside the radius
+                const float originX = static_cast<float>(col * ChunkPixels);
+                const float originY = static_cast<float>(row * ChunkPixels);
+                const int tx0 = std::clamp(static_cast<int>(std::floor((light.position.x - light.radius - originX) / TexelPixels)), 0, ChunkTexels - 1);
+                const int tx1 = std::clamp(static_cast<int>(std::floor((light.position.x + light.radius - originX) / TexelPixels)), 0, ChunkTexels - 1);
+                const int ty0 = std::clamp(static_cast<int>(std::floor((light.position.y - light.radius - originY) / TexelPixels)), 0, ChunkTexels - 1);
+                const int ty1 = std::clamp(static_cast<int>(std::floor((light.position.y + light.radius - originY) / TexelPixels)), 0, ChunkTexels - 1);
+
+                for (int ty = ty0; ty <= ty1; ++ty) {
+                    const float dy = originY + (ty + 0.5f) * TexelPixels - light.position.y;
+                    for (int tx = tx0; tx <= tx1; ++tx) {
+                        const float dx = originX + (tx + 0.5f) * TexelPixels - light.position.x;
+                        const float distanceSq = dx * dx + dy * dy;
+                        if (distanceSq >= radiusSq) continue;
+
+                        if (!texels) {
+                            texels = &lit[index];
+                            if (texels->empty()) texels->assign(texelsPerChunk * 3, 0.f);
+                        }
+                        const float f = falloff(distanceSq, radiusSq);
+                        float* texel = texels->data() + (static_cast<size_t>(ty) * ChunkTexels + static_cast<size_t>(tx)) * 3;
+                        texel[0] += f * r;
+                        texel[1] += f * g;
+                        texel[2] += f * b;
+                    }
+                }
+            }
+        }
+    }
+
+    // Turn the light into shade images
+    images.resize(lit.size());
+    int next = 0;
+    for (auto& [index, texels] : lit) {
+        sf::Image image(sf::Vector2u(ChunkTexels, ChunkTexels), sf::Color::White);
+        for (unsigned ty = 0; ty < static_cast<unsigned>(ChunkTexels); ++ty) {
+            for (unsigned tx = 0; tx < static_cast<unsigned>(ChunkTexels); ++tx) {
+                const float* texel = texels.data() + (static_cast<size_t>(ty) * ChunkTexels + tx) * 3;
+                auto shade = [](float light) {
+                    return static_cast<uint8_t>(std::lround(255.f * (1.f - std::min(light, 1.f))));
+                };
+                image.setPixel({tx, ty}, sf::Color(shade(texel[0]), shade(texel[1]), shade(texel[2])));
+            }
+        }
+        images[static_cast<size_t>(next)] = std::move(image);
+        chunks[index].texture = next++;
+    }
+
+    Logger::info("Lightmap: baked " + std::to_string(lights.size()) + " lights into " +
+                 std::to_string(images.size()) + " of " + std::to_string(chunks.size()) + " chunks");
+    return images.size();
+}
+
+
+void Lightmap::upload(bool keepImages) {
+    textures.resize(images.size());
+    if (keepImages) return;
+
+    for (size_t i = 0; i < images.size(); ++i) {
+        sf::Texture& texture = textures[i];
+        if (texture.loadFromImage(images[i])) {
+            texture.setSmooth(true);
+            MemoryTracker::getInstance().countUpload(MemoryTracker::textureBytes(texture));
+        } else {
+            Logger::warn("Lightmap: failed to upload chunk texture");
+        }
+    }
+    images.clear();
+    images.shrink_to_fit();
+}
+
+
+void Lightmap::clear() {
+    columns = 0;
+    rows = 0;
+    chunks.clear();
+    textures.clear();
+    images.clear();
+}
+
+
+size_t Lightmap::getCpuBytes() const {
+    size_t bytes = MemoryTracker::vectorBytes(chunks) + MemoryTracker::vectorBytes(textures) +
+                   MemoryTracker::vectorBytes(images);
+    for (const auto& image : images) bytes += MemoryTracker::imageBytes(image);
+    return bytes;
+}
+
+
+size_t Lightmap::getGpuBytes() const {
+    size_t bytes = 0;
+    for (const auto& texture : textures) bytes += MemoryTracker::textureBytes(texture);
+    return bytes;
+}
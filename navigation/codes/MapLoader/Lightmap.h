@@ -0,0 +1,108 @@
+// Lightmap.h
+#pragma once
+
+#include "MapObjects.h"
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <vector>
+
+/*
+ * File: Lightmap.h
+ * Description: Night lighting baked from a map's lamps into low-resolution chunk textures.
+ *
+ * The world is split into square chunks of ChunkPixels. At load, every lamp adds
+ * its falloff to the texels it reaches (one texel per TexelPixels world pixels),
+ * and each chunk a lamp reaches gets a small texture holding the shade left per
+ * texel: 255 where the night is untouched, 0 where the lamps fully light it.
+ *
+ * At night the renderer draws one quad per visible chunk with DrawBlend::Darken,
+ * the vertex color scaling the shade by the current darkness, so the night costs
+ * the same whether the map has one lamp or a thousand.
+ *
+ * Notes:
+ *   - Chunks no lamp reaches get no texture; they are drawn untextured and batch
+ *     into a single draw call.
+ *   - Textures are smoothed, so the coarse texels blend into soft light pools.
+ *   - In headless mode only the images are kept (see TMJMap::setHeadless); the
+ *     textures are placeholders the software backend resolves to the images.
+ *   - Baking is split so the CPU part can run as a job: bakeImages touches no
+ *     GPU resource, upload must run on the thread owning the OpenGL context.
+ */
+
+class Lightmap {
+public:
+    static constexpr int ChunkPixels = 512;   ///< World pixels per chunk side
+    static constexpr int TexelPixels = 8;     ///< World pixels per lightmap texel
+    static constexpr int ChunkTexels = ChunkPixels / TexelPixels;
+
+    /**
+     * @struct Chunk
+     * @brief One square of the lightmap grid.
+     */
+    struct Chunk {
+        sf::FloatRect bounds;   ///< World rectangle covered (clipped to the map)
+        int texture = -1;       ///< Index into the chunk textures, or -1 if no lamp reaches it
+    };
+
+    /**
+     * @brief Bake the lights of a map into chunk images (CPU only, safe on a job thread).
+     *
+     * The lightmap must have been cleared first (clear() releases textures).
+     *
+     * @param lights Lamps to bake.
+     * @param worldSize Map size in pixels.
+     * @return Number of chunks that received an image.
+     */
+    size_t bakeImages(const std::vector<LightSource>& lights, sf::Vector2i worldSize);
+
+    /**
+     * @brief Turn the baked images into chunk textures (main thread).
+     *
+     * @param keepImages true to keep CPU images only (headless), false to upload
+     *                   textures and drop the images.
+     */
+    void upload(bool keepImages);
+
+    /**
+     * @brief Drop all chunks and textures.
+     */
+    void clear();
+
+    /**
+     * @brief Whether the map had no lamps (the plain night overlay is used instead).
+     */
+    bool empty() const { return textures.empty(); }
+
+    int getColumns() const { return columns; }
+    int getRows() const { return rows; }
+
+    const Chunk& getChunk(int column, int row) const {
+        return chunks[static_cast<size_t>(row) * static_cast<size_t>(columns) + static_cast<size_t>(column)];
+    }
+
+    const sf::Texture& getTexture(int index) const { return textures[static_cast<size_t>(index)]; }
+
+    /**
+     * @brief CPU image of a chunk texture (headless bakes only; uploads drop the images).
+     */
+    const sf::Image& getImage(int index) const { return images[static_cast<size_t>(index)]; }
+
+    size_t getTextureCount() const { return textures.size(); }
+
+    /**
+     * @brief Bytes held on the CPU (chunk grid and headless images).
+     */
+    size_t getCpuBytes() const;
+
+    /**
+     * @brief Bytes held by uploaded chunk textures.
+     */
+    size_t getGpuBytes() const;
+
+private:
+    int columns = 0;
+    int rows = 0;
+    std::vector<Chunk> chunks;
+    std::vector<sf::Texture> textures;
+    std::vector<sf::Image> images;
+};
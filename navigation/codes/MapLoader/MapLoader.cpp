@@ -171,10 +171,8 @@ void MapLoader::render(Renderer* renderer) {
             std::to_string(currentTMJMap->getTiles().size())
         );
 
-        // Render all tiles from TMJMap
-        for (const auto& tile : currentTMJMap->getTiles()) {
-            renderer->drawSprite(tile);
-        }
+        // Submit the TMJMap geometry; the Tiled layer index keeps stacking order
+        renderer->renderMapTiles(*currentTMJMap);
 
         Logger::debug(
             "Finished rendering " + 
@@ -256,3 +256,35 @@ struct RespawnPoint {
     
     RespawnPoint() : maxCount(3) {} // Default 3 times
 };
+
+/*
+ * Struct: EffectArea
+ * Description: Particle emitter placed on an "effects" object layer.
+ *
+ * Fields:
+ *   effect - Effect name ("rain", "leaves", "steam").
+ *   rect   - Area particles spawn in (world pixels).
+ *   rate   - Spawns per second over the whole area; 0 uses the effect's default density.
+ */
+struct EffectArea {
+    std::string effect;
+    sf::FloatRect rect;
+    float rate = 0.f;
+};
+
+/*
+ * Struct: LightSource
+ * Description: A lamp placed on a "lights" object layer; baked into the night lightmap.
+ *
+ * Fields:
+ *   position  - Center of the light in world pixels.
+ *   radius    - Distance at which the light has faded out, in pixels.
+ *   color     - Light color (alpha ignored).
+ *   intensity - Brightness at the center; 1 fully cancels the night tint.
+ */
+struct LightSource {
+    sf::Vector2f position;
+    float radius = 96.f;
+    sf::Color color = sf::Color(255, 214, 150);
+    float intensity = 1.f;
+};
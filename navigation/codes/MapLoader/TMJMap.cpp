@@ -2,6 +2,9 @@
 #include "TMJMap.h"
 #include "Utils/Logger.h"
 #include "Utils/StringUtils.h"
+#include "Jobs/JobSystem.h"
+#include "Utils/MemoryTracker.h"
+#include "Utils/Arena.h"
 #include <fstream>
 #include <filesystem>
 #include <nlohmann/json.hpp>
@@ -9,9 +12,15 @@
 #include <vector>
 #include <string>
 #include <sstream>
+#include <algorithm>
+#include <limits>
+#include <functional>
+#include <utility>
+#include <chrono>
+#include <unordered_map>
 
 // Alias for json library.
-using json = nlohmann::json;
+using json = MapJson;
 
 /*
  * File: TMJMap.cpp
@@ -29,8 +38,12 @@ using json = nlohmann::json;
  * Notes:
  *   - Uses std::filesystem to resolve relative tileset image paths.
  *   - Textures are stored inside TilesetInfo.texture and must remain alive while sprites reference them.
+ *   - Headless loads keep TilesetInfo.image instead and never create GPU textures.
+ *   - Tileset sheets are decoded and extruded on the job system; uploads stay on the loading thread.
  */
 
+bool TMJMap::headless = false;
+
 /**
  * @brief Split a comma-separated dishes string into individual dish names.
  * 
@@ -64,8 +77,9 @@ std::vector<std::string> splitDishesString(const std::string& str) {
     return dishes;
 }
 
-// Convert a string to lowercase in-place.
-static std::string toLower(std::string s) {
+// Lowercase copy of a string (std::string or a JSON string from the load arena).
+static std::string toLower(std::string_view text) {
+    std::string s(text);
     for (char& c : s)
         c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
     return s;
@@ -97,6 +111,184 @@ static bool pointInPolygon(const sf::Vector2f& p, const std::vector<sf::Vector2f
     return inside;
 }
 
+// Mark each tile of a tileset as opaque when all of its pixels have alpha 255.
+// Uses the original (non-extruded) image so spacing/margin match the TMJ data.
+static void classifyOpaqueTiles(const sf::Image& src, TilesetInfo& ts) {
+    ts.opaqueTiles.assign(static_cast<size_t>(std::max(0, ts.tileCount)), 0);
+    if (ts.columns <= 0 || ts.origTileW <= 0 || ts.origTileH <= 0) return;
+
+    const sf::Vector2u isz = src.getSize();
+    const std::uint8_t* px = src.getPixelsPtr();
+    if (!px) return;
+
+    size_t opaqueCount = 0;
+    for (int id = 0; id < ts.tileCount; ++id) {
+        const int sx = ts.origMargin + (id % ts.columns) * (ts.origTileW + ts.origSpacing);
+        const int sy = ts.origMargin + (id / ts.columns) * (ts.origTileH + ts.origSpacing);
+        if (sx + ts.origTileW > static_cast<int>(isz.x) || sy + ts.origTileH > static_cast<int>(isz.y)) continue;
+
+        bool opaque = true;
+        for (int y = 0; y < ts.origTileH && opaque; ++y) {
+            const std::uint8_t* row = px + (static_cast<size_t>(sy + y) * isz.x + static_cast<size_t>(sx)) * 4;
+            for (int x = 0; x < ts.origTileW; ++x) {
+                if (row[x * 4 + 3] != 255) { opaque = false; break; }
+            }
+        }
+        if (opaque) {
+            ts.opaqueTiles[static_cast<size_t>(id)] = 1;
+            ++opaqueCount;
+        }
+    }
+
+    Logger::info("Tileset '" + ts.name + "': " + std::to_string(opaqueCount) + "/" +
+                 std::to_string(ts.tileCount) + " tiles fully opaque");
+}
+
+// Approximate heap size of a parsed JSON document: one value per node, plus
+// string payloads, object keys and the tree node of each object member.
+static size_t estimateJsonBytes(const json& value) {
+    size_t bytes = sizeof(json);
+    if (value.is_string()) {
+        bytes += MemoryTracker::stringBytes(value.get_ref<const ArenaString&>());
+    } else if (value.is_object()) {
+        for (auto it = value.begin(); it != value.end(); ++it) {
+            bytes += 4 * sizeof(void*) + sizeof(ArenaString) + MemoryTracker::stringBytes(it.key());
+            bytes += estimateJsonBytes(it.value());
+        }
+    } else if (value.is_array()) {
+        for (const auto& element : value) bytes += estimateJsonBytes(element);
+    }
+    return bytes;
+}
+
+// Memory for transient parse data: the load arena while one is current, else the heap.
+static std::pmr::memory_resource* scratchResource() {
+    if (Arena* arena = Arena::current()) return arena;
+    return std::pmr::get_default_resource();
+}
+
+// Read tile animations ("tiles[].animation") of a tileset. Frames pointing
+// outside the tileset drop the whole animation.
+static void parseTileAnimations(const json& tsj, TilesetInfo& ts) {
+    if (!tsj.contains("tiles") || !tsj["tiles"].is_array()) return;
+
+    for (const auto& tile : tsj["tiles"]) {
+        if (!tile.is_object() || !tile.contains("id") || !tile["id"].is_number_integer()) continue;
+        if (!tile.contains("animation") || !tile["animation"].is_array()) continue;
+
+        std::vector<TileAnimationFrame> frames;
+        bool valid = true;
+        for (const auto& f : tile["animation"]) {
+            TileAnimationFrame frame;
+            frame.localId = f.value("tileid", -1);
+            frame.durationMs = std::max(1.f, f.value("duration", 100.f));
+            if (frame.localId < 0 || (ts.tileCount > 0 && frame.localId >= ts.tileCount)) {
+                valid = false;
+                break;
+            }
+            frames.push_back(frame);
+        }
+        if (valid && frames.size() > 1) ts.animations[tile["id"].get<int>()] = std::move(frames);
+    }
+
+    if (!ts.animations.empty()) {
+        Logger::info("Tileset '" + ts.name + "': " + std::to_string(ts.animations.size()) + " animated tiles");
+    }
+}
+
+// Texture rect of a tile in a (possibly extruded) tileset sheet.
+static sf::IntRect tileRect(const TilesetInfo& ts, int localId) {
+    const int tu = localId % ts.columns;
+    const int tv = localId / ts.columns;
+    return sf::IntRect(
+        {ts.margin + tu * (ts.tileWidth + ts.spacing), ts.margin + tv * (ts.tileHeight + ts.spacing)},
+        {ts.tileWidth, ts.tileHeight}
+    );
+}
+
+// Milliseconds since start; restarts the clock for the next phase.
+static double lapMs(std::chrono::steady_clock::time_point& start) {
+    const auto now = std::chrono::steady_clock::now();
+    const double ms = std::chrono::duration<double, std::milli>(now - start).count();
+    start = now;
+    return ms;
+}
+
+// Total drawn tile area divided by the world area (1.0 = every pixel drawn once).
+static float computeOverdraw(const std::vector<sf::Sprite>& sprites, float worldArea) {
+    if (worldArea <= 0.f) return 0.f;
+    double drawn = 0.0;
+    for (const auto& spr : sprites) {
+        const sf::FloatRect b = spr.getGlobalBounds();
+        drawn += static_cast<double>(b.size.x) * static_cast<double>(b.size.y);
+    }
+    return static_cast<float>(drawn / worldArea);
+}
+
+// Read per-tile collision shapes ("tiles[].objectgroup.objects") of a tileset.
+// Rectangles go to collisionRects (merged into cells when they cover the tile);
+// polygons, and ellipses approximated by 12-gons, go to collisionPolys.
+static void parseTileCollision(const json& tsj, TilesetInfo& ts) {
+    if (!tsj.contains("tiles") || !tsj["tiles"].is_array()) return;
+
+    constexpr int EllipseSegments = 12;
+    constexpr float Pi = 3.14159265f;
+
+    for (const auto& tile : tsj["tiles"]) {
+        if (!tile.is_object() || !tile.contains("id") || !tile["id"].is_number_integer()) continue;
+        if (!tile.contains("objectgroup") || !tile["objectgroup"].is_object()) continue;
+        const auto& og = tile["objectgroup"];
+        if (!og.contains("objects") || !og["objects"].is_array()) continue;
+
+        const int localId = tile["id"].get<int>();
+        std::vector<sf::FloatRect> rects;
+        std::vector<std::vector<sf::Vector2f>> polys;
+
+        for (const auto& obj : og["objects"]) {
+            if (!obj.is_object()) continue;
+            float ox = obj.value("x", 0.f);
+            float oy = obj.value("y", 0.f);
+
+            if (obj.contains("polygon") && obj["polygon"].is_array()) {
+                std::vector<sf::Vector2f> points;
+                points.reserve(obj["polygon"].size());
+                for (const auto& pt : obj["polygon"]) {
+                    if (!pt.is_object()) continue;
+                    points.emplace_back(ox + pt.value("x", 0.f), oy + pt.value("y", 0.f));
+                }
+                if (points.size() >= 3) polys.push_back(std::move(points));
+                continue;
+            }
+
+            float ow = obj.value("width", 0.f);
+            float oh = obj.value("height", 0.f);
+            if (ow <= 0.f || oh <= 0.f) continue;
+
+            if (obj.value("ellipse", false)) {
+                const sf::Vector2f center{ox + ow * 0.5f, oy + oh * 0.5f};
+                std::vector<sf::Vector2f> points;
+                points.reserve(EllipseSegments);
+                for (int k = 0; k < EllipseSegments; ++k) {
+                    const float a = 2.f * Pi * static_cast<float>(k) / EllipseSegments;
+                    points.emplace_back(center.x + std::cos(a) * ow * 0.5f, center.y + std::sin(a) * oh * 0.5f);
+                }
+                polys.push_back(std::move(points));
+            } else {
+                rects.emplace_back(sf::Vector2f{ox, oy}, sf::Vector2f{ow, oh});
+            }
+        }
+
+        if (!rects.empty()) ts.collisionRects[localId] = std::move(rects);
+        if (!polys.empty()) ts.collisionPolys[localId] = std::move(polys);
+    }
+
+    if (!ts.collisionRects.empty() || !ts.collisionPolys.empty()) {
+        Logger::info("Tileset '" + ts.name + "' has collision rects on " +
+                     std::to_string(ts.collisionRects.size()) + " tiles, polygons on " +
+                     std::to_string(ts.collisionPolys.size()) + " tiles");
+    }
+}
+
 
 /**
  * @brief Load a TMJ map from a JSON file and initialize internal data.
@@ -114,6 +306,8 @@ bool TMJMap::loadFromFile(
     int extrude
 ) {
     cleanup();
+    const auto loadStart = std::chrono::steady_clock::now();
+    auto phase = loadStart;
     
     std::ifstream in(filepath);
     if (!in) {
@@ -121,6 +315,12 @@ bool TMJMap::loadFromFile(
         return false;
     }
 
+    // The document and all other transient parse data live in one arena that
+    // is freed in one go when this function returns. Declared before the
+    // document so the document is destroyed while the arena is still current.
+    Arena loadArena("map load", 256 * 1024);
+    ArenaScope arenaScope(loadArena);
+
     json j;
     try { 
         in >> j; 
@@ -128,10 +328,28 @@ bool TMJMap::loadFromFile(
         Logger::error("JSON parse failed for file: " + filepath);
         return false;
     }
+    loadTimings.parseMs = lapMs(phase);
 
     namespace fs = std::filesystem;
     fs::path tmjPath(filepath);
     fs::path tmjDir = tmjPath.parent_path();
+    memoryScope = tmjPath.stem().string();
+
+    // The document lives until this function returns; only its peak is kept
+    MemoryCharge jsonCharge(memoryScope, MemoryTag::MapJson, MemoryKind::Cpu);
+    jsonCharge.set(estimateJsonBytes(j));
+
+    auto parse = [&]() {
+        const bool ok = parseMapData(j, tmjDir.string(), extrude);
+        loadTimings.totalMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - loadStart).count();
+        Logger::info(loadArena.describe());
+        return ok;
+    };
+
+    if (headless) {
+        return parse();
+    }
 
     // Add debug test sprites to the map:
     // Create a red test sprite placed at the map center
@@ -164,7 +382,7 @@ bool TMJMap::loadFromFile(
         Logger::info("Added BLUE test tile at top-left (100, 100)");
     }
 
-    return parseMapData(j, tmjDir.string(), extrude);
+    return parse();
 }
 
 
@@ -196,16 +414,38 @@ bool TMJMap::parseMapData(
     tileWidth = j["tilewidth"];
     tileHeight = j["tileheight"];
 
+    auto phase = std::chrono::steady_clock::now();
+
     // Load tilesets
     if (j.contains("tilesets") && j["tilesets"].is_array()) {
         if (!loadTilesets(j["tilesets"], baseDir, extrude)) {
             return false;
         }
     }
+    loadTimings.tilesetsMs = lapMs(phase);
+
+    // Cells fully covered by a tile collision shape; merged into rects after all layers.
+    std::pmr::memory_resource* scratch = scratchResource();
+    std::pmr::vector<uint8_t> solidCells(
+        static_cast<size_t>(std::max(0, mapWidthTiles * mapHeightTiles)), 0, scratch
+    );
+    size_t partialTileRects = 0;
+    size_t tilePolys = 0;          // Polygon and ellipse tile shapes added to notWalkPolys
+
+    // Per-tile cell index / occluder flag, parallel to tiles (entries added before parsing stay -1).
+    std::pmr::vector<int> tileCells(tiles.size(), -1, scratch);
+    std::pmr::vector<uint8_t> tileOccludes(tiles.size(), 0, scratch);
+
+    // Animation index per tile (-1: static), and the animation of each (tileset, local id)
+    std::pmr::vector<int> tileAnimations(tiles.size(), -1, scratch);
+    std::pmr::unordered_map<uint64_t, int> animationIndex(scratch);
+    tileLayers.assign(tiles.size(), 0);
+    uint16_t tileLayerIndex = 0;
 
     // Parse layers and objects
     if (j.contains("layers") && j["layers"].is_array()) {
         parseObjectLayers(j["layers"]);
+        loadTimings.objectsMs = lapMs(phase);
         
         // Recursive layer processing for tile layers
         std::function<void(const json&, float, float, float)> processLayer;
@@ -244,16 +484,22 @@ bool TMJMap::parseMapData(
             bool visible = L.value("visible", true);
             if (!visible) return;
 
+            const uint16_t layerIndex = tileLayerIndex++;
+            tileLayerNames.emplace_back(L.value("name", ""));
+
             int lw = L.value("width", mapWidthTiles);
             int lh = L.value("height", mapHeightTiles);
 
             if (!L.contains("data") || !L["data"].is_array()) return;
 
-            std::vector<int> data;
-            try { 
-                data = L["data"].get<std::vector<int>>(); 
-            } catch (...) {
-                return;
+            // Copied into the arena; a layer with non-numeric or missing cells is skipped
+            const json& cells = L["data"];
+            if (lw <= 0 || lh <= 0 || cells.size() < static_cast<size_t>(lw) * static_cast<size_t>(lh)) return;
+            std::pmr::vector<int> data(scratch);
+            data.reserve(cells.size());
+            for (const auto& cell : cells) {
+                if (!cell.is_number()) return;
+                data.push_back(cell.get<int>());
             }
 
             for (int y = 0; y < lh; ++y) {
@@ -262,22 +508,17 @@ bool TMJMap::parseMapData(
                     if (gid == 0) continue;
 
                     TilesetInfo* ts = findTilesetForGid(gid);
-                    if (!ts || ts->texture.getSize().x == 0) continue;
+                    if (!ts) continue;
+                    if (ts->texture.getSize().x == 0 && ts->image.getSize().x == 0) continue;
 
                     int localId = gid - ts->firstGid;
                     if (localId < 0 || localId >= ts->tileCount) continue;
 
-                    const int tu = localId % ts->columns;
-                    const int tv = localId / ts->columns;
-                    const int sx = ts->margin + tu * (ts->tileWidth + ts->spacing);
-                    const int sy = ts->margin + tv * (ts->tileHeight + ts->spacing);
-
-                    sf::IntRect rect({
-                        {sx, sy}, 
-                        {ts->tileWidth, ts->tileHeight}
-                    });
+                    const sf::IntRect rect = tileRect(*ts, localId);
                     sf::Sprite spr(ts->texture, rect);
 
+#ifdef DEBUG
+                    // Built only in debug builds: these strings were the bulk of the per-tile heap traffic
                     Logger::debug(
                         "Sprite created - TextureRect: (" + 
                         std::to_string(rect.position.x) + "," + std::to_string(rect.position.y) + 
@@ -285,6 +526,7 @@ bool TMJMap::parseMapData(
                         " Position: (" + std::to_string(spr.getPosition().x) + "," + 
                         std::to_string(spr.getPosition().y) + ")"
                     );
+#endif
 
                     spr.setPosition(sf::Vector2f{
                         offx + static_cast<float>(x * tileWidth),
@@ -299,13 +541,170 @@ bool TMJMap::parseMapData(
                     }
 
                     tiles.push_back(spr);
+                    tileLayers.push_back(layerIndex);
+
+                    // Only unshifted, map-sized tiles take part in occlusion culling
+                    // (tileWidth/tileHeight include the extruded border, so compare the source size)
+                    const bool cellAligned = offx == 0.f && offy == 0.f &&
+                        x < mapWidthTiles && y < mapHeightTiles &&
+                        ts->origTileW == tileWidth && ts->origTileH == tileHeight;
+                    // Animated tiles never occlude: their other frames may be transparent
+                    int animation = -1;
+                    if (!ts->animations.empty() && ts->animations.count(localId)) {
+                        const size_t tilesetIndex = static_cast<size_t>(ts - tilesets.data());
+                        const uint64_t key = (static_cast<uint64_t>(tilesetIndex) << 32) | static_cast<uint32_t>(localId);
+                        auto found = animationIndex.find(key);
+                        if (found == animationIndex.end()) {
+                            AnimatedTile anim;
+                            anim.tileset = tilesetIndex;
+                            anim.frames = ts->animations.at(localId);
+                            for (const auto& frame : anim.frames) anim.cycleMs += frame.durationMs;
+                            found = animationIndex.emplace(key, static_cast<int>(animatedTiles.size())).first;
+                            animatedTiles.push_back(std::move(anim));
+                        }
+                        animation = found->second;
+                    }
+                    tileAnimations.push_back(animation);
+
+                    tileCells.push_back(cellAligned ? x + y * mapWidthTiles : -1);
+                    tileOccludes.push_back(
+                        cellAligned && opacity >= 1.f && animation < 0 &&
+                        static_cast<size_t>(localId) < ts->opaqueTiles.size() &&
+                        ts->opaqueTiles[static_cast<size_t>(localId)] ? 1 : 0
+                    );
+
+                    // Tile collision shapes from tileset metadata
+                    const float cellX = offx + static_cast<float>(x * tileWidth);
+                    const float cellY = offy + static_cast<float>(y * tileHeight);
+
+                    auto polyShapes = ts->collisionPolys.find(localId);
+                    if (polyShapes != ts->collisionPolys.end()) {
+                        for (const auto& local : polyShapes->second) {
+                            BlockPoly poly;
+                            poly.points.reserve(local.size());
+                            float minx = std::numeric_limits<float>::max();
+                            float miny = std::numeric_limits<float>::max();
+                            float maxx = std::numeric_limits<float>::lowest();
+                            float maxy = std::numeric_limits<float>::lowest();
+                            for (const auto& p : local) {
+                                const float px = cellX + p.x;
+                                const float py = cellY + p.y;
+                                poly.points.emplace_back(px, py);
+                                minx = std::min(minx, px); miny = std::min(miny, py);
+                                maxx = std::max(maxx, px); maxy = std::max(maxy, py);
+                            }
+                            poly.bounds = sf::FloatRect(sf::Vector2f{minx, miny},
+                                                        sf::Vector2f{maxx - minx, maxy - miny});
+                            notWalkPolys.push_back(std::move(poly));
+                            ++tilePolys;
+                        }
+                    }
+
+                    auto shapes = ts->collisionRects.find(localId);
+                    if (shapes == ts->collisionRects.end()) continue;
+
+                    const bool onGrid = offx == 0.f && offy == 0.f &&
+                                        x < mapWidthTiles && y < mapHeightTiles;
+
+                    for (const auto& r : shapes->second) {
+                        const bool fullCell = r.position.x <= 0.f && r.position.y <= 0.f &&
+                            r.position.x + r.size.x >= static_cast<float>(tileWidth) &&
+                            r.position.y + r.size.y >= static_cast<float>(tileHeight);
+                        if (fullCell && onGrid) {
+                            solidCells[static_cast<size_t>(x + y * mapWidthTiles)] = 1;
+                        } else {
+                            notWalkRects.emplace_back(
+                                sf::Vector2f{cellX + r.position.x, cellY + r.position.y},
+                                r.size
+                            );
+                            ++partialTileRects;
+                        }
+                    }
                 }
             }
         };
 
         for (const auto& L : j["layers"]) processLayer(L, 0.f, 0.f, 1.f);
+        loadTimings.tileLayersMs = lapMs(phase);
     }
 
+    // Collision (merge, then index), culling (then the map geometry) and the lightmap
+    // bake touch disjoint data, so they run as one job graph; each node times itself
+    auto timed = [](double& ms, const auto& work) {
+        auto start = std::chrono::steady_clock::now();
+        work();
+        ms += lapMs(start);
+    };
+
+    size_t mergedRects = 0;
+    size_t culled = 0;
+    size_t animatedCells = 0;
+    float overdrawBefore = 0.f;
+    float overdrawAfter = 0.f;
+    const float worldArea = static_cast<float>(getWorldPixelWidth()) * static_cast<float>(getWorldPixelHeight());
+
+    JobGraph graph;
+    const auto mergeNode = graph.add([&]() {
+        timed(loadTimings.collisionMs, [&]() { mergedRects = mergeSolidCells(solidCells); });
+    });
+    const auto indexNode = graph.add([&]() {
+        timed(loadTimings.collisionMs, [&]() { buildCollisionIndex(); });
+    });
+    graph.precede(mergeNode, indexNode);
+
+    const auto cullNode = graph.add([&]() {
+        timed(loadTimings.cullingMs, [&]() {
+            overdrawBefore = computeOverdraw(tiles, worldArea);
+            culled = cullOccludedTiles(tileCells, tileOccludes, tileAnimations);
+            overdrawAfter = computeOverdraw(tiles, worldArea);
+        });
+    });
+    const auto geometryNode = graph.add([&]() {
+        timed(loadTimings.cullingMs, [&]() {
+            // Hook the surviving tiles to their animations; the sprites (chunk bake, minimap)
+            // keep the first frame, later frames only reach the map geometry
+            for (size_t i = 0; i < tileAnimations.size(); ++i) {
+                if (tileAnimations[i] >= 0) {
+                    animatedTiles[static_cast<size_t>(tileAnimations[i])].tiles.push_back(static_cast<uint32_t>(i));
+                }
+            }
+            animatedTiles.erase(std::remove_if(animatedTiles.begin(), animatedTiles.end(),
+                                               [](const AnimatedTile& anim) { return anim.tiles.empty(); }),
+                                animatedTiles.end());
+            for (const auto& anim : animatedTiles) {
+                const sf::IntRect first = tileRect(tilesets[anim.tileset], anim.frames.front().localId);
+                for (uint32_t i : anim.tiles) tiles[i].setTextureRect(first);
+                animatedCells += anim.tiles.size();
+            }
+            buildTileGeometry();
+        });
+    });
+    graph.precede(cullNode, geometryNode);
+
+    graph.add([&]() {
+        timed(loadTimings.lightingMs, [&]() {
+            lightmap.bakeImages(lights, {getWorldPixelWidth(), getWorldPixelHeight()});
+        });
+    });
+
+    JobSystem::getInstance().run(graph);
+    timed(loadTimings.lightingMs, [&]() { lightmap.upload(headless); });
+
+    if (mergedRects > 0 || partialTileRects > 0 || tilePolys > 0) {
+        Logger::info("Tile collision: " + std::to_string(mergedRects) + " merged rects, " +
+                     std::to_string(partialTileRects) + " partial tile rects, " +
+                     std::to_string(tilePolys) + " tile polygons");
+    }
+    if (!animatedTiles.empty()) {
+        Logger::info("Tile animations: " + std::to_string(animatedTiles.size()) + " animated tiles on " +
+                     std::to_string(animatedCells) + " cells");
+    }
+    Logger::info("Occlusion culling removed " + std::to_string(culled) + " hidden tiles, overdraw " +
+                 std::to_string(overdrawBefore) + "x -> " + std::to_string(overdrawAfter) + "x");
+
+    triggerRevision = nextTriggerRevision();
+    accountMemory();
+
     Logger::info("TMJMap loaded: " + std::to_string(mapWidthTiles) + "x" + 
                  std::to_string(mapHeightTiles) + ", tiles: " + 
                  std::to_string(tiles.size()) + ", text objects: " + 
@@ -329,7 +728,7 @@ void TMJMap::parseObjectLayers(const json& layers) {
         if (!L.contains("type") || !L["type"].is_string() || L["type"] != "objectgroup") continue;
         if (!L.contains("objects") || !L["objects"].is_array()) continue;
 
-        std::string layerName = L.value("name", "objectgroup");
+        std::string layerName(L.value("name", "objectgroup"));
         std::string lnameLower = toLower(layerName);
 
         // 1) protagonist spawn points
@@ -414,7 +813,7 @@ void TMJMap::parseObjectLayers(const json& layers) {
             if (obj.contains("properties") && obj["properties"].is_array()) {
                 for (const auto& p : obj["properties"]) {
                     if (!p.is_object()) continue;
-                    std::string pname = p.value("name", "");
+                    const auto pname = p.value("name", "");
                     if (pname == "target" && p.contains("value") && p["value"].is_string()) {
                         a.target = p["value"].get<std::string>();
                     } else if (pname == "targetX" && p.contains("value") && p["value"].is_number()) {
@@ -543,7 +942,7 @@ void TMJMap::parseObjectLayers(const json& layers) {
             if (obj.contains("properties") && obj["properties"].is_array()) {
                 for (const auto& p : obj["properties"]) {
                     if (!p.is_object()) continue;
-                    std::string pname = p.value("name", "");
+                    const auto pname = p.value("name", "");
                     if (pname == "course" && p.contains("value") && p["value"].is_string()) {
                         prof.course = p["value"].get<std::string>();
                     } else if (pname == "dialogType" && p.contains("value") && p["value"].is_string()) {
@@ -587,7 +986,7 @@ void TMJMap::parseObjectLayers(const json& layers) {
                 if (obj.contains("properties") && obj["properties"].is_array()) {
                     for (const auto& prop : obj["properties"]) {
                         if (!prop.is_object()) continue;
-                        std::string pname = prop.value("name", "");
+                        const auto pname = prop.value("name", "");
                         if (pname == "gameType") {
                             trigger.gameType = prop.value("value", "");
                         } else if (pname == "questionSet") {
@@ -628,7 +1027,7 @@ void TMJMap::parseObjectLayers(const json& layers) {
                 if (obj.contains("properties") && obj["properties"].is_array()) {
                     for (const auto& p : obj["properties"]) {
                         if (!p.is_object()) continue;
-                        std::string pname = p.value("name", "");
+                        const auto pname = p.value("name", "");
                         if (pname == "dishes" && p.contains("value") && p["value"].is_string()) {
                             std::string dishesStr = p["value"].get<std::string>();
                             io.options = splitDishesString(dishesStr);
@@ -666,7 +1065,7 @@ void TMJMap::parseObjectLayers(const json& layers) {
                 if (obj.contains("properties") && obj["properties"].is_array()) {
                     for (const auto& p : obj["properties"]) {
                         if (!p.is_object()) continue;
-                        std::string pname = p.value("name", "");
+                        const auto pname = p.value("name", "");
                         if (pname == "type") {
                             shop.type = p.value("value", "convenience");
                         }
@@ -719,7 +1118,7 @@ void TMJMap::parseObjectLayers(const json& layers) {
                     if (obj.contains("properties") && obj["properties"].is_array()) {
                         for (const auto& p : obj["properties"]) {
                             if (!p.is_object()) continue;
-                            std::string pname = p.value("name", "");
+                            const auto pname = p.value("name", "");
                             if (pname == "count" && p.contains("value") && p["value"].is_number()) {
                                 respawnPoint.maxCount = p["value"].get<int>();
                             }
@@ -751,9 +1150,9 @@ void TMJMap::parseObjectLayers(const json& layers) {
                 }
                 
                 
-                std::string objClass = obj.value("class", "");
-                std::string objName = obj.value("name", "");
-                std::string objType = obj.value("type", "");
+                std::string objClass(obj.value("class", ""));
+                std::string objName(obj.value("name", ""));
+                std::string objType(obj.value("type", ""));
                 Logger::debug("===== parse object =====");
                 Logger::debug("objClass: " + objClass);
                 Logger::debug("objName: " + objName);
@@ -781,8 +1180,8 @@ void TMJMap::parseObjectLayers(const json& layers) {
                         Logger::debug("[Food] " + objName + " detacted properties:");
                         for (const auto& p : obj["properties"]) {
                             if (!p.is_object()) continue;
-                            std::string pname = p.value("name", "");
-                            Logger::info("[Food] retreive property: " + pname); 
+                            const auto pname = p.value("name", "");
+                            Logger::info("[Food] retreive property: " + std::string(pname)); 
 
                             if (pname == "tableName" && p.contains("value") && p["value"].is_string()) {
                                 foodAnchor.tableName = p["value"].get<std::string>();
@@ -814,7 +1213,7 @@ void TMJMap::parseObjectLayers(const json& layers) {
                     if (obj.contains("properties") && obj["properties"].is_array()) {
                         for (const auto& p : obj["properties"]) {
                             if (!p.is_object()) continue;
-                            std::string pname = p.value("name", "");
+                            const auto pname = p.value("name", "");
                             if (pname == "seatX" && p.contains("value") && p["value"].is_number()) {
                                 table.seatPosition.x = p["value"].get<float>();
                             } else if (pname == "seatY" && p.contains("value") && p["value"].is_number()) {
@@ -835,7 +1234,7 @@ void TMJMap::parseObjectLayers(const json& layers) {
         if (lnameLower == "lawn") { 
             for (const auto& obj : L["objects"]) {
                 if (!obj.is_object()) continue;
-                std::string objName = obj.value("name", "");
+                std::string objName(obj.value("name", ""));
                 if (toLower(objName) != "lawn") continue; 
 
                 float x = obj.value("x", 0.f);
@@ -849,6 +1248,77 @@ void TMJMap::parseObjectLayers(const json& layers) {
                             ") size " + std::to_string(w) + "x" + std::to_string(h));
             }
         }
+
+        // 13) Parse light sources (lamps baked into the night lightmap)
+        if (lnameLower == "lights" || lnameLower == "lamps") {
+            for (const auto& obj : L["objects"]) {
+                if (!obj.is_object()) continue;
+
+                LightSource light;
+                float x = obj.value("x", 0.f);
+                float y = obj.value("y", 0.f);
+                float w = obj.value("width", 0.f);
+                float h = obj.value("height", 0.f);
+                light.position = sf::Vector2f(x + w * 0.5f, y + h * 0.5f);
+                if (w > 0.f || h > 0.f) light.radius = std::max(w, h) * 0.5f;
+
+                if (obj.contains("properties") && obj["properties"].is_array()) {
+                    for (const auto& p : obj["properties"]) {
+                        if (!p.is_object() || !p.contains("value")) continue;
+                        std::string pname = toLower(p.value("name", ""));
+                        const auto& value = p["value"];
+                        if (pname == "radius" && value.is_number()) {
+                            light.radius = value.get<float>();
+                        } else if (pname == "intensity" && value.is_number()) {
+                            light.intensity = value.get<float>();
+                        } else if (pname == "color" && value.is_string()) {
+                            // Tiled writes colors as #AARRGGBB (or #RRGGBB)
+                            std::string colorStr = value.get<std::string>();
+                            if (colorStr.length() == 9) colorStr.erase(1, 2);
+                            if (colorStr.length() == 7 && colorStr[0] == '#') {
+                                try {
+                                    int r = std::stoi(colorStr.substr(1,2), nullptr, 16);
+                                    int g = std::stoi(colorStr.substr(3,2), nullptr, 16);
+                                    int b = std::stoi(colorStr.substr(5,2), nullptr, 16);
+                                    light.color = sf::Color(r,g,b);
+                                } catch (...) {}
+                            }
+                        }
+                    }
+                }
+
+                if (light.radius > 0.f && light.intensity > 0.f) lights.push_back(light);
+            }
+            Logger::info("Parsed " + std::to_string(lights.size()) + " light sources");
+        }
+
+        // 14) Parse particle effect areas (rain, leaves, steam)
+        if (lnameLower == "effects" || lnameLower == "particles") {
+            for (const auto& obj : L["objects"]) {
+                if (!obj.is_object()) continue;
+
+                EffectArea area;
+                area.effect = obj.value("type", "");
+                if (area.effect.empty()) area.effect = obj.value("class", "");
+                area.rect = sf::FloatRect({obj.value("x", 0.f), obj.value("y", 0.f)},
+                                          {obj.value("width", 0.f), obj.value("height", 0.f)});
+
+                if (obj.contains("properties") && obj["properties"].is_array()) {
+                    for (const auto& p : obj["properties"]) {
+                        if (!p.is_object() || !p.contains("value")) continue;
+                        std::string pname = toLower(p.value("name", ""));
+                        if (pname == "effect" && p["value"].is_string()) {
+                            area.effect = p["value"].get<std::string>();
+                        } else if (pname == "rate" && p["value"].is_number()) {
+                            area.rate = p["value"].get<float>();
+                        }
+                    }
+                }
+
+                if (!area.effect.empty()) effectAreas.push_back(std::move(area));
+            }
+            Logger::info("Parsed " + std::to_string(effectAreas.size()) + " effect areas");
+        }
     }
 }
 
@@ -859,6 +1329,9 @@ void TMJMap::parseObjectLayers(const json& layers) {
  * computes columns/rows, and optionally creates an extruded texture to
  * avoid sampling artifacts at tile borders.
  *
+ * Decoding, opacity classification and extrusion run on the job system, one
+ * job per tileset; the GPU uploads happen afterwards on the calling thread.
+ *
  * @param tilesetsData JSON array of tileset descriptors.
  * @param baseDir Base directory for resolving tileset image paths.
  * @param extrude Extrusion pixel count to add around tiles when building textures.
@@ -869,22 +1342,34 @@ bool TMJMap::loadTilesets(
     const std::string& baseDir, 
     int extrude
 ) {
-    for (const auto& tsj : tilesetsData) {
+    // CPU-side result of decoding one tileset sheet
+    struct SheetJob {
         TilesetInfo ts;
+        sf::Image pixels;       // Extruded sheet, or the raw sheet if extrusion failed
+        bool hasImage = false;
+        bool decoded = false;
+        bool extruded = false;
+    };
+
+    std::vector<SheetJob> sheets;
+    sheets.reserve(tilesetsData.size());
+
+    for (const auto& tsj : tilesetsData) {
+        SheetJob sheet;
+        TilesetInfo& ts = sheet.ts;
 
         ts.firstGid = tsj.value("firstgid", 1);
         ts.name = tsj.value("name", "tileset");
 
-        std::string relImagePath = tsj.value("image", "");
+        std::string relImagePath(tsj.value("image", ""));
 
         if (relImagePath.empty()) {
             Logger::warn("Tileset '" + ts.name + "' has no embedded image");
-            tilesets.push_back(ts);
+            sheets.push_back(std::move(sheet));
             continue;
         }
 
-        std::string imagePath = baseDir + "/" + relImagePath;
-        ts.imagePath = imagePath;
+        ts.imagePath = baseDir + "/" + relImagePath;
 
         ts.origTileW = tsj.value("tilewidth", tileWidth);
         ts.origTileH = tsj.value("tileheight", tileHeight);
@@ -893,54 +1378,87 @@ bool TMJMap::loadTilesets(
         ts.columns = tsj.value("columns", 0);
         ts.tileCount = tsj.value("tilecount", 0);
 
-        sf::Texture original;
+        parseTileCollision(tsj, ts);
+        parseTileAnimations(tsj, ts);
 
-        if (!original.loadFromFile(imagePath)) {
-            Logger::error("Failed to load tileset image: " + imagePath);
-            tilesets.push_back(ts);
-            continue;
+        sheet.hasImage = true;
+        sheets.push_back(std::move(sheet));
+    }
+
+    // Decode on the CPU in parallel; sheets are uploaded once, after extrusion
+    JobSystem::getInstance().parallelFor(0, sheets.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            SheetJob& sheet = sheets[i];
+            TilesetInfo& ts = sheet.ts;
+            if (!sheet.hasImage) continue;
+
+            sf::Image src;
+            if (!src.loadFromFile(ts.imagePath)) continue;
+            sheet.decoded = true;
+
+            if (ts.columns == 0) {
+                auto size = src.getSize();
+                ts.columns = static_cast<int>(size.x) / ts.origTileW;
+            }
+            if (ts.tileCount == 0) {
+                auto size = src.getSize();
+                int rows = static_cast<int>(size.y) / ts.origTileH;
+                ts.tileCount = ts.columns * rows;
+            }
+
+            classifyOpaqueTiles(src, ts);
+
+            sheet.extruded = makeExtrudedImage(
+                src, 
+                ts.origTileW, 
+                ts.origTileH, 
+                ts.columns, 
+                ts.origSpacing, 
+                ts.origMargin, 
+                extrude, 
+                sheet.pixels
+            );
+            if (!sheet.extruded) sheet.pixels = std::move(src);
         }
+    });
 
-        if (ts.columns == 0) {
-            auto size = original.getSize();
-            ts.columns = static_cast<int>(size.x) / ts.origTileW;
+    for (auto& sheet : sheets) {
+        TilesetInfo& ts = sheet.ts;
+
+        if (sheet.hasImage && !sheet.decoded) {
+            Logger::error("Failed to load tileset image: " + ts.imagePath);
+        }
+        if (!sheet.decoded) {
+            tilesets.push_back(std::move(ts));
+            continue;
         }
-        if (ts.tileCount == 0) {
-            auto size = original.getSize();
-            int rows = static_cast<int>(size.y) / ts.origTileH;
-            ts.tileCount = ts.columns * rows;
+
+        if (headless) {
+            ts.image = std::move(sheet.pixels);
+        } else if (!ts.texture.loadFromImage(sheet.pixels)) {
+            Logger::error("Failed to upload tileset image: " + ts.imagePath);
+            tilesets.push_back(std::move(ts));
+            continue;
+        } else {
+            MemoryTracker::getInstance().countUpload(MemoryTracker::textureBytes(ts.texture));
         }
 
-        sf::Image src = original.copyToImage();
-        sf::Texture extruded;
-
-        if (makeExtrudedTexture(
-            src, 
-            ts.origTileW, 
-            ts.origTileH, 
-            ts.columns, 
-            ts.origSpacing, 
-            ts.origMargin, 
-            extrude, 
-            extruded
-        )) {
-            ts.texture = std::move(extruded);
+        if (sheet.extruded) {
             ts.tileWidth = ts.origTileW + 2 * extrude;
             ts.tileHeight = ts.origTileH + 2 * extrude;
             ts.spacing = 0;
             ts.margin = 0;
         } else {
-            ts.texture = std::move(original);
             ts.tileWidth = ts.origTileW;
             ts.tileHeight = ts.origTileH;
             ts.spacing = ts.origSpacing;
             ts.margin = ts.origMargin;
         }
 
-        tilesets.push_back(ts);
+        tilesets.push_back(std::move(ts));
         Logger::info(
-            "Loaded tileset: " + ts.name + 
-            " (" + std::to_string(ts.tileCount) + " tiles)"
+            "Loaded tileset: " + tilesets.back().name + 
+            " (" + std::to_string(tilesets.back().tileCount) + " tiles)"
         );
     }
     
@@ -949,10 +1467,9 @@ bool TMJMap::loadTilesets(
 
 
 /**
- * @brief Create an extruded texture image from a tileset source image.
+ * @brief Create an extruded texture from a tileset source image.
  *
- * The function copies tile pixels into a destination image and duplicates
- * edge pixels into the extrusion border so textured quads avoid bleeding.
+ * Builds the extruded sheet with makeExtrudedImage and uploads it.
  *
  * @param src Source image containing the tileset.
  * @param srcTileW Original tile width in pixels.
@@ -973,6 +1490,54 @@ bool TMJMap::makeExtrudedTexture(
     int margin, 
     int extrude, 
     sf::Texture& outTex
+) {
+    sf::Image dst;
+    if (!makeExtrudedImage(src, srcTileW, srcTileH, columns, spacing, margin, extrude, dst)) {
+        return false;
+    }
+
+    if (!outTex.loadFromImage(dst)) {
+        Logger::error("Failed to load extruded texture from image");
+        return false;
+    }
+    
+    outTex.setSmooth(false);
+
+    Logger::debug(
+        "Texture created - Size: " + 
+        std::to_string(outTex.getSize().x) + "x" + 
+        std::to_string(outTex.getSize().y)
+    );
+    
+    return true;
+}
+
+
+/**
+ * @brief Build an extruded tileset image from a tileset source image.
+ *
+ * The function copies tile pixels into a destination image and duplicates
+ * edge pixels into the extrusion border so textured quads avoid bleeding.
+ *
+ * @param src Source image containing the tileset.
+ * @param srcTileW Original tile width in pixels.
+ * @param srcTileH Original tile height in pixels.
+ * @param columns Number of tile columns in the source image.
+ * @param spacing Pixel spacing between tiles in the source.
+ * @param margin Pixel margin around tiles in the source.
+ * @param extrude Number of pixels to extrude around each tile.
+ * @param outImage Output image receiving the extruded sheet.
+ * @return true if the extruded image was created successfully.
+ */
+bool TMJMap::makeExtrudedImage(
+    const sf::Image& src, 
+    int srcTileW, 
+    int srcTileH,
+    int columns, 
+    int spacing, 
+    int margin, 
+    int extrude, 
+    sf::Image& outImage
 ) {
     if (srcTileW <= 0 || srcTileH <= 0 || columns <= 0) {
         Logger::error("Invalid tile dimensions or columns");
@@ -1140,19 +1705,7 @@ bool TMJMap::makeExtrudedTexture(
 
     Logger::debug("Processed " + std::to_string(tilesProcessed) + " tiles for extrusion");
 
-    if (!outTex.loadFromImage(dst)) {
-        Logger::error("Failed to load extruded texture from image");
-        return false;
-    }
-    
-    outTex.setSmooth(false);
-
-    Logger::debug(
-        "Texture created - Size: " + 
-        std::to_string(outTex.getSize().x) + "x" + 
-        std::to_string(outTex.getSize().y)
-    );
-    
+    outImage = std::move(dst);
     return true;
 }
 
@@ -1167,7 +1720,11 @@ bool TMJMap::makeExtrudedTexture(
  * @return Pointer to matching TilesetInfo or nullptr if not found.
  */
 TilesetInfo* TMJMap::findTilesetForGid(int gid) {
-    TilesetInfo* result = nullptr;
+    return const_cast<TilesetInfo*>(std::as_const(*this).findTilesetForGid(gid));
+}
+
+const TilesetInfo* TMJMap::findTilesetForGid(int gid) const {
+    const TilesetInfo* result = nullptr;
 
     for (auto& ts : tilesets) {
         if (gid >= ts.firstGid && gid < ts.firstGid + ts.tileCount) {
@@ -1179,12 +1736,24 @@ TilesetInfo* TMJMap::findTilesetForGid(int gid) {
     return result;
 }
 
+/**
+ * @brief Produce a new process-wide unique trigger revision stamp.
+ *
+ * @return uint64_t Next revision value (never 0).
+ */
+uint64_t TMJMap::nextTriggerRevision() {
+    static uint64_t counter = 0;
+    return ++counter;
+}
+
 /**
  * @brief Clean up all resources associated with the loaded map.
  */
 void TMJMap::cleanup() {
     tilesets.clear();
     tiles.clear();
+    tileLayers.clear();
+    tileLayerNames.clear();
     textObjects.clear();
     entranceAreas.clear();
     spawnX.reset();
@@ -1198,16 +1767,271 @@ void TMJMap::cleanup() {
     m_professors.clear();  
     m_shopTriggers.clear(); 
     respawnPoint = RespawnPoint();  
+    triggerRevision = nextTriggerRevision();
+    notWalkRects.clear();
+    notWalkPolys.clear();
+    collisionCellSize = 0.f;
+    collisionCols = 0;
+    collisionRows = 0;
+    collisionRectBuckets.clear();
+    collisionPolyBuckets.clear();
+    animatedTiles.clear();
+    tileVertices.clear();
+    tileRuns.clear();
+    lights.clear();
+    lightmap.clear();
+    effectAreas.clear();
+    loadTimings = MapLoadTimings();
+    tileMemory.release();
+    objectMemory.release();
+    collisionMemory.release();
+    tilesetMemory.release();
+    tilesetGpuMemory.release();
+    lightmapMemory.release();
+    lightmapGpuMemory.release();
+}
+
+
+/**
+ * @brief Charge the loaded map's containers and tileset textures to the memory tracker.
+ *
+ * Called once the map is complete; cleanup() releases the charges again.
+ */
+void TMJMap::accountMemory() {
+    using MT = MemoryTracker;
+
+    tileMemory = MemoryCharge(memoryScope, MemoryTag::MapTiles, MemoryKind::Cpu);
+    tileMemory.set(MT::vectorBytes(tiles) + MT::vectorBytes(tileLayers) +
+                   MT::vectorBytes(tileVertices) + MT::vectorBytes(tileRuns));
+
+    size_t objectBytes = MT::vectorBytes(textObjects) + MT::vectorBytes(entranceAreas) +
+        MT::vectorBytes(gameTriggers) + MT::vectorBytes(m_chefs) + MT::vectorBytes(m_professors) +
+        MT::vectorBytes(interactionObjects) + MT::vectorBytes(m_tables) + MT::vectorBytes(m_foodAnchors) +
+        MT::vectorBytes(lawnAreas) + MT::vectorBytes(m_shopTriggers) + MT::vectorBytes(effectAreas);
+    for (const auto& t : textObjects) objectBytes += MT::stringBytes(t.text);
+    for (const auto& o : interactionObjects) {
+        objectBytes += MT::vectorBytes(o.options);
+        for (const auto& option : o.options) objectBytes += MT::stringBytes(option);
+    }
+    objectMemory = MemoryCharge(memoryScope, MemoryTag::MapObjects, MemoryKind::Cpu);
+    objectMemory.set(objectBytes);
+
+    size_t collisionBytes = MT::vectorBytes(notWalkRects) + MT::vectorBytes(notWalkPolys) +
+        MT::vectorBytes(collisionRectBuckets) + MT::vectorBytes(collisionPolyBuckets);
+    for (const auto& poly : notWalkPolys) collisionBytes += MT::vectorBytes(poly.points);
+    for (const auto& bucket : collisionRectBuckets) collisionBytes += MT::vectorBytes(bucket);
+    for (const auto& bucket : collisionPolyBuckets) collisionBytes += MT::vectorBytes(bucket);
+    collisionMemory = MemoryCharge(memoryScope, MemoryTag::MapCollision, MemoryKind::Cpu);
+    collisionMemory.set(collisionBytes);
+
+    size_t tilesetBytes = MT::vectorBytes(tilesets);
+    size_t tilesetGpuBytes = 0;
+    for (const auto& ts : tilesets) {
+        tilesetBytes += MT::vectorBytes(ts.opaqueTiles) + MT::imageBytes(ts.image);
+        for (const auto& [id, rects] : ts.collisionRects) tilesetBytes += 4 * sizeof(void*) + MT::vectorBytes(rects);
+        for (const auto& [id, polys] : ts.collisionPolys) {
+            tilesetBytes += 4 * sizeof(void*) + MT::vectorBytes(polys);
+            for (const auto& poly : polys) tilesetBytes += MT::vectorBytes(poly);
+        }
+        tilesetGpuBytes += MT::textureBytes(ts.texture);
+    }
+    tilesetMemory = MemoryCharge(memoryScope, MemoryTag::Tilesets, MemoryKind::Cpu);
+    tilesetMemory.set(tilesetBytes);
+    tilesetGpuMemory = MemoryCharge(memoryScope, MemoryTag::Tilesets, MemoryKind::Gpu);
+    tilesetGpuMemory.set(tilesetGpuBytes);
+
+    lightmapMemory = MemoryCharge(memoryScope, MemoryTag::Lightmaps, MemoryKind::Cpu);
+    lightmapMemory.set(MT::vectorBytes(lights) + lightmap.getCpuBytes());
+    lightmapGpuMemory = MemoryCharge(memoryScope, MemoryTag::Lightmaps, MemoryKind::Gpu);
+    lightmapGpuMemory.set(lightmap.getGpuBytes());
+}
+
+
+/**
+ * @brief Drop tiles that are completely hidden under an opaque tile drawn later in the same cell.
+ *
+ * Tiles are stored in draw order, so walking backwards and remembering which
+ * cells already have an opaque occluder on top identifies every tile that can
+ * never contribute a visible pixel.
+ *
+ * @param tileCells Grid cell index per entry of tiles, or -1 if the tile is not cell-aligned.
+ * @param tileOccludes Non-zero per entry of tiles if it is opaque and covers its whole cell.
+ * @return Number of tiles removed.
+ */
+size_t TMJMap::cullOccludedTiles(
+    const std::pmr::vector<int>& tileCells,
+    const std::pmr::vector<uint8_t>& tileOccludes,
+    std::pmr::vector<int>& tileAnimations
+) {
+    if (tileCells.size() != tiles.size() || tileOccludes.size() != tiles.size() ||
+        tileAnimations.size() != tiles.size()) return 0;
+    if (mapWidthTiles <= 0 || mapHeightTiles <= 0) return 0;
+
+    std::vector<uint8_t> covered(static_cast<size_t>(mapWidthTiles * mapHeightTiles), 0);
+    std::vector<uint8_t> hidden(tiles.size(), 0);
+    size_t hiddenCount = 0;
+
+    for (size_t i = tiles.size(); i-- > 0;) {
+        const int cell = tileCells[i];
+        if (cell < 0) continue;
+        if (covered[static_cast<size_t>(cell)]) {
+            hidden[i] = 1;
+            ++hiddenCount;
+        } else if (tileOccludes[i]) {
+            covered[static_cast<size_t>(cell)] = 1;
+        }
+    }
+
+    if (hiddenCount == 0) return 0;
+
+    std::vector<sf::Sprite> visible;
+    std::vector<uint16_t> visibleLayers;
+    visible.reserve(tiles.size() - hiddenCount);
+    visibleLayers.reserve(tiles.size() - hiddenCount);
+    size_t kept = 0;
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        if (hidden[i]) continue;
+        visible.push_back(std::move(tiles[i]));
+        visibleLayers.push_back(i < tileLayers.size() ? tileLayers[i] : 0);
+        tileAnimations[kept++] = tileAnimations[i];
+    }
+    tileAnimations.resize(kept);
+    tiles = std::move(visible);
+    tileLayers = std::move(visibleLayers);
+    return hiddenCount;
+}
+
+
+/**
+ * @brief Merge fully blocked tile cells into as few rectangles as possible.
+ *
+ * Greedy merge: each row is split into horizontal runs of solid cells, and a
+ * run is extended downwards while the next row has a solid, unused run with
+ * exactly the same span. Every merged block becomes one NotWalkable rect.
+ *
+ * @param solidCells Row-major grid (mapWidthTiles x mapHeightTiles), non-zero = blocked.
+ * @return Number of rectangles emitted.
+ */
+size_t TMJMap::mergeSolidCells(const std::pmr::vector<uint8_t>& solidCells) {
+    const int w = mapWidthTiles;
+    const int h = mapHeightTiles;
+    if (w <= 0 || h <= 0 || solidCells.size() != static_cast<size_t>(w * h)) return 0;
+
+    std::vector<uint8_t> used(solidCells.size(), 0);
+    auto available = [&](int x, int y) {
+        const size_t i = static_cast<size_t>(x + y * w);
+        return solidCells[i] != 0 && used[i] == 0;
+    };
+
+    size_t emitted = 0;
+    for (int y = 0; y < h; ++y) {
+        int x = 0;
+        while (x < w) {
+            if (!available(x, y)) { ++x; continue; }
+
+            // Horizontal run [x, x1)
+            int x1 = x;
+            while (x1 < w && available(x1, y)) ++x1;
+
+            // Extend down while the row below has the same span available
+            int y1 = y + 1;
+            while (y1 < h) {
+                bool rowOk = true;
+                for (int xx = x; xx < x1 && rowOk; ++xx) rowOk = available(xx, y1);
+                // Do not swallow part of a wider run on the next row
+                if (rowOk && x > 0 && available(x - 1, y1)) rowOk = false;
+                if (rowOk && x1 < w && available(x1, y1)) rowOk = false;
+                if (!rowOk) break;
+                ++y1;
+            }
+
+            for (int yy = y; yy < y1; ++yy)
+                for (int xx = x; xx < x1; ++xx)
+                    used[static_cast<size_t>(xx + yy * w)] = 1;
+
+            notWalkRects.emplace_back(
+                sf::Vector2f{static_cast<float>(x * tileWidth), static_cast<float>(y * tileHeight)},
+                sf::Vector2f{static_cast<float>((x1 - x) * tileWidth), static_cast<float>((y1 - y) * tileHeight)}
+            );
+            ++emitted;
+            x = x1;
+        }
+    }
+    return emitted;
+}
+
+
+/**
+ * @brief Build the uniform grid used by feetBlockedAt to look up nearby blockers.
+ *
+ * The world is split into square buckets of a few tiles each; every NotWalkable
+ * rect and polygon (by its bounds) is registered in all buckets it overlaps.
+ */
+void TMJMap::buildCollisionIndex() {
+    collisionRectBuckets.clear();
+    collisionPolyBuckets.clear();
+
+    const int worldW = getWorldPixelWidth();
+    const int worldH = getWorldPixelHeight();
+    if (worldW <= 0 || worldH <= 0) {
+        collisionCols = collisionRows = 0;
+        return;
+    }
+
+    collisionCellSize = static_cast<float>(std::max(tileWidth, tileHeight) * 4);
+    collisionCols = static_cast<int>(std::ceil(worldW / collisionCellSize));
+    collisionRows = static_cast<int>(std::ceil(worldH / collisionCellSize));
+    const size_t bucketCount = static_cast<size_t>(collisionCols * collisionRows);
+    collisionRectBuckets.assign(bucketCount, {});
+    collisionPolyBuckets.assign(bucketCount, {});
+
+    auto insert = [&](const sf::FloatRect& b, std::vector<std::vector<uint32_t>>& buckets, uint32_t idx) {
+        const int cx0 = std::clamp(static_cast<int>(std::floor(b.position.x / collisionCellSize)), 0, collisionCols - 1);
+        const int cy0 = std::clamp(static_cast<int>(std::floor(b.position.y / collisionCellSize)), 0, collisionRows - 1);
+        const int cx1 = std::clamp(static_cast<int>(std::floor((b.position.x + b.size.x) / collisionCellSize)), 0, collisionCols - 1);
+        const int cy1 = std::clamp(static_cast<int>(std::floor((b.position.y + b.size.y) / collisionCellSize)), 0, collisionRows - 1);
+        for (int cy = cy0; cy <= cy1; ++cy)
+            for (int cx = cx0; cx <= cx1; ++cx)
+                buckets[static_cast<size_t>(cx + cy * collisionCols)].push_back(idx);
+    };
+
+    for (size_t i = 0; i < notWalkRects.size(); ++i)
+        insert(notWalkRects[i], collisionRectBuckets, static_cast<uint32_t>(i));
+    for (size_t i = 0; i < notWalkPolys.size(); ++i)
+        insert(notWalkPolys[i].bounds, collisionPolyBuckets, static_cast<uint32_t>(i));
+
+    Logger::info("Collision index: " + std::to_string(collisionCols) + "x" + std::to_string(collisionRows) +
+                 " buckets, " + std::to_string(notWalkRects.size()) + " rects, " +
+                 std::to_string(notWalkPolys.size()) + " polygons");
 }
 
 
 /**
  * @brief Check whether a feet point lies within any NotWalkable region (rectangles or polygons).
+ *
+ * Uses the collision index when the point is inside the world; points outside
+ * (or maps without an index) fall back to a full scan.
  * 
  * @param feet The point to check (player's feet position).
  * @return true if the point is inside any non-walkable area, false otherwise.
  */
 bool TMJMap::feetBlockedAt(const sf::Vector2f& feet) const {
+    if (collisionCols > 0 && collisionRows > 0 && feet.x >= 0.f && feet.y >= 0.f) {
+        const int cx = static_cast<int>(feet.x / collisionCellSize);
+        const int cy = static_cast<int>(feet.y / collisionCellSize);
+        if (cx < collisionCols && cy < collisionRows) {
+            const size_t bucket = static_cast<size_t>(cx + cy * collisionCols);
+            for (uint32_t i : collisionRectBuckets[bucket]) {
+                if (notWalkRects[i].contains(feet)) return true;
+            }
+            for (uint32_t i : collisionPolyBuckets[bucket]) {
+                const auto& poly = notWalkPolys[i];
+                if (poly.bounds.contains(feet) && pointInPolygon(feet, poly.points)) return true;
+            }
+            return false;
+        }
+    }
+
     // Check rectangles first for quick rejection.
     for (const auto& r : notWalkRects) {
         if (r.contains(feet)) return true;
@@ -1221,3 +2045,82 @@ bool TMJMap::feetBlockedAt(const sf::Vector2f& feet) const {
     return false;
 
 }
+
+
+/**
+ * @brief Advance every animated tile's frame clock; rewrite tiles only on frame changes.
+ *
+ * @param dt Elapsed seconds since the last call.
+ * @return Number of tiles whose texture coordinates were rewritten.
+ */
+size_t TMJMap::updateAnimations(float dt) {
+    if (dt <= 0.f) return 0;
+
+    size_t rewritten = 0;
+    for (auto& anim : animatedTiles) {
+        // Whole cycles (e.g. after a long hitch) don't change the frame
+        anim.clockMs = std::fmod(anim.clockMs + dt * 1000.f, anim.cycleMs);
+
+        const size_t before = anim.frame;
+        while (anim.clockMs >= anim.frames[anim.frame].durationMs) {
+            anim.clockMs -= anim.frames[anim.frame].durationMs;
+            anim.frame = (anim.frame + 1) % anim.frames.size();
+        }
+        if (anim.frame != before) rewritten += applyAnimationFrame(anim);
+    }
+    return rewritten;
+}
+
+
+size_t TMJMap::applyAnimationFrame(const AnimatedTile& anim) {
+    const TilesetInfo& ts = tilesets[anim.tileset];
+    const sf::IntRect rect = tileRect(ts, anim.frames[anim.frame].localId);
+    const sf::Vector2f t0(rect.position);
+    const sf::Vector2f t1(rect.position + rect.size);
+
+    // Same corner order as buildTileGeometry: tl, tr, br, tl, br, bl
+    for (uint32_t i : anim.tiles) {
+        sf::Vertex* v = &tileVertices[static_cast<size_t>(i) * 6];
+        v[0].texCoords = t0;
+        v[1].texCoords = {t1.x, t0.y};
+        v[2].texCoords = t1;
+        v[3].texCoords = t0;
+        v[4].texCoords = t1;
+        v[5].texCoords = {t0.x, t1.y};
+    }
+    return anim.tiles.size();
+}
+
+
+void TMJMap::buildTileGeometry() {
+    tileVertices.clear();
+    tileRuns.clear();
+    tileVertices.reserve(tiles.size() * 6);
+
+    // Two triangles per sprite, as DrawQueue would submit it
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        const sf::Sprite& sprite = tiles[i];
+        const sf::IntRect tr = sprite.getTextureRect();
+        const float w = std::abs(static_cast<float>(tr.size.x));
+        const float h = std::abs(static_cast<float>(tr.size.y));
+        const sf::Vector2f t0(tr.position);
+        const sf::Vector2f t1(tr.position + tr.size);
+
+        const sf::Transform& xf = sprite.getTransform();
+        const sf::Color color = sprite.getColor();
+        const sf::Vertex tl{xf.transformPoint({0.f, 0.f}), color, t0};
+        const sf::Vertex trv{xf.transformPoint({w, 0.f}), color, {t1.x, t0.y}};
+        const sf::Vertex br{xf.transformPoint({w, h}), color, t1};
+        const sf::Vertex bl{xf.transformPoint({0.f, h}), color, {t0.x, t1.y}};
+
+        const uint32_t first = static_cast<uint32_t>(tileVertices.size());
+        tileVertices.insert(tileVertices.end(), {tl, trv, br, tl, br, bl});
+
+        const uint16_t layer = i < tileLayers.size() ? tileLayers[i] : 0;
+        const sf::Texture* texture = &sprite.getTexture();
+        if (tileRuns.empty() || tileRuns.back().texture != texture || tileRuns.back().layer != layer) {
+            tileRuns.push_back({texture, layer, first, 0});
+        }
+        tileRuns.back().vertexCount += 6;
+    }
+}
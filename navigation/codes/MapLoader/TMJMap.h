@@ -3,6 +3,9 @@
 
 // Map object lightweight types (TextObject, EntranceArea, BlockPoly).
 #include "MapObjects.h"
+#include "Lightmap.h"
+#include "Utils/MemoryTracker.h"
+#include "Utils/Arena.h"
 
 // SFML types for sprites and images.
 #include <SFML/Graphics.hpp>
@@ -13,10 +16,39 @@
 #include <string>
 #include <optional>
 #include <memory>
+#include <unordered_map>
+#include <cstdint>
+#include <map>
 
 // Forward declaration for tileset manager used by TMJ loading logic.
 class TileSetManager;
 
+// Parsed TMJ/TSJ documents; their nodes, keys and string values come from the
+// load arena (see loadFromFile). get<std::string>() copies a value out of it.
+using MapJson = nlohmann::basic_json<
+    std::map, std::vector, ArenaString, bool, std::int64_t, std::uint64_t, double, ArenaAllocator
+>;
+
+/**
+ * @struct TileAnimationFrame
+ * @brief One frame of a Tiled tile animation ("tiles[].animation" in a tileset).
+ */
+struct TileAnimationFrame {
+    int localId = 0;          ///< Tile shown during this frame
+    float durationMs = 0.f;
+};
+
+/**
+ * @struct TileRun
+ * @brief Consecutive tiles sharing a tile layer and a tileset texture (see TMJMap::getTileRuns).
+ */
+struct TileRun {
+    const sf::Texture* texture = nullptr;
+    uint16_t layer = 0;           ///< Tile layer index (draw depth)
+    uint32_t firstVertex = 0;     ///< Into getTileVertices()
+    uint32_t vertexCount = 0;
+};
+
 /**
  * @struct TilesetInfo
  * @brief Container for tileset metadata and the associated extruded texture.
@@ -41,6 +73,39 @@ struct TilesetInfo {
     std::string name;
     std::string imagePath;
     sf::Texture texture; 
+
+    // CPU copy of the sheet texture points into; only kept in headless mode.
+    sf::Image image;
+
+    // Per-tile collision rectangles (tile-local pixels) keyed by local tile id,
+    // read from the tileset's "tiles[].objectgroup" metadata.
+    std::unordered_map<int, std::vector<sf::FloatRect>> collisionRects;
+
+    // Per-tile collision polygons (tile-local pixels; ellipses as 12-gons), same keys.
+    std::unordered_map<int, std::vector<std::vector<sf::Vector2f>>> collisionPolys;
+
+    // 1 if every pixel of the tile (by local id) has full alpha; filled once per tileset.
+    std::vector<uint8_t> opaqueTiles;
+
+    // Animation frames keyed by the local id of the animated tile.
+    std::unordered_map<int, std::vector<TileAnimationFrame>> animations;
+};
+
+/**
+ * @struct MapLoadTimings
+ * @brief Wall-clock time of each phase of the last TMJMap::loadFromFile, in milliseconds.
+ *
+ * Collision, culling and lighting run as parallel jobs, so their times overlap.
+ */
+struct MapLoadTimings {
+    double parseMs = 0.0;        ///< Reading and parsing the JSON document
+    double tilesetsMs = 0.0;     ///< Decoding, extruding and uploading tileset sheets
+    double objectsMs = 0.0;      ///< Object layers (labels, entrances, triggers, NotWalkable)
+    double tileLayersMs = 0.0;   ///< Building tile sprites
+    double collisionMs = 0.0;    ///< Merging tile collision and building the collision grid
+    double cullingMs = 0.0;      ///< Occlusion culling of hidden tiles
+    double lightingMs = 0.0;     ///< Baking the night lightmap
+    double totalMs = 0.0;
 };
 
 /*
@@ -51,10 +116,13 @@ struct TilesetInfo {
  *   - Parse a TMJ JSON file and load tileset textures (with optional extrusion).
  *   - Provide accessors for tiles, text objects, entrance areas and spawn point.
  *   - Store NotWalkable regions (rectangles and polygons) and answer feet-block queries.
+ *   - Bake the lamps of a "lights" object layer into the night Lightmap.
  *
  * Notes:
  *   - TMJMap stores SFML sprites referencing internal textures; ensure the
  *     TMJMap instance outlives any rendering usage that references its textures.
+ *   - In headless mode no GPU textures are created; tileset pixels are kept in
+ *     TilesetInfo::image and sprites reference the (empty) texture by address.
  */
 class TMJMap : public sf::Drawable {
 public:
@@ -74,6 +142,17 @@ public:
      * @brief Clean up all resources associated with the loaded map.
      */
     void cleanup();
+
+    /**
+     * @brief Select headless loading for all maps loaded afterwards.
+     *
+     * Headless maps never touch OpenGL: tileset sheets stay in CPU images
+     * for the software render backend.
+     *
+     * @param enabled true to load without GPU textures.
+     */
+    static void setHeadless(bool enabled) { headless = enabled; }
+    static bool isHeadless() { return headless; }
     
     // Getters
     int getMapWidthTiles() const { return mapWidthTiles; }
@@ -84,6 +163,21 @@ public:
     int getWorldPixelHeight() const { return mapHeightTiles * tileHeight; }
     const std::vector<InteractionObject>& getInteractionObjects() const { return interactionObjects; }
     const std::vector<sf::Sprite>& getTiles() const { return tiles; }
+    const std::vector<TilesetInfo>& getTilesets() const { return tilesets; }
+    const std::vector<uint16_t>& getTileLayers() const { return tileLayers; }
+    const std::vector<std::string>& getTileLayerNames() const { return tileLayerNames; }
+
+    /**
+     * @brief Map geometry: six world-space vertices per entry of getTiles(), in the same order.
+     *
+     * This is what the game draws; tile animations rewrite its texture coordinates,
+     * while the sprites keep showing the first animation frame.
+     */
+    const std::vector<sf::Vertex>& getTileVertices() const { return tileVertices; }
+    const std::vector<TileRun>& getTileRuns() const { return tileRuns; }
+    const std::vector<sf::FloatRect>& getNotWalkRects() const { return notWalkRects; }
+    const std::vector<BlockPoly>& getNotWalkPolys() const { return notWalkPolys; }
+    const MapLoadTimings& getLoadTimings() const { return loadTimings; }
     const std::vector<TextObject>& getTextObjects() const { return textObjects; }
     const std::vector<EntranceArea>& getEntranceAreas() const { return entranceAreas; }
     const std::vector<GameTriggerArea>& getGameTriggers() const { return gameTriggers; }
@@ -96,6 +190,13 @@ public:
     const std::vector<LawnArea>& getLawnAreas() const { return lawnAreas; }
     const std::vector<ShopTrigger>& getShopTriggers() const { return m_shopTriggers; }
     const RespawnPoint& getRespawnPoint() const { return respawnPoint; }
+    const std::vector<LightSource>& getLights() const { return lights; }
+    const std::vector<EffectArea>& getEffectAreas() const { return effectAreas; }
+
+    /**
+     * @brief Night lighting baked from getLights() at load (empty if the map has no lamps).
+     */
+    const Lightmap& getLightmap() const { return lightmap; }
 
     /**
      * @brief Set the spawn point coordinates.
@@ -113,6 +214,24 @@ public:
      */
     bool feetBlockedAt(const sf::Vector2f& feet) const;
 
+    /**
+     * @brief Advance the tile animations.
+     *
+     * Every animated tile id keeps one frame clock. Only when its frame changes
+     * are the texture coordinates of the tiles showing it rewritten in the map
+     * geometry, so the cost follows the number of frame changes rather than the
+     * number of tiles.
+     *
+     * @param dt Elapsed seconds since the last call.
+     * @return Number of tiles whose texture coordinates were rewritten.
+     */
+    size_t updateAnimations(float dt);
+
+    /**
+     * @brief Number of distinct animated tile ids placed on the map.
+     */
+    size_t getAnimatedTileCount() const { return animatedTiles.size(); }
+
     /**
      * @brief Manual rendering method (fallback if draw override fails).
      * 
@@ -131,6 +250,7 @@ public:
      */
     void addShopTrigger(const ShopTrigger& shopTrigger) {
         m_shopTriggers.push_back(shopTrigger);
+        triggerRevision = nextTriggerRevision();
     }
 
     /**
@@ -140,9 +260,63 @@ public:
      */
     void addGameTrigger(const GameTriggerArea& gameTrigger) {
         gameTriggers.push_back(gameTrigger); 
+        triggerRevision = nextTriggerRevision();
     }
 
+    /**
+     * @brief Revision stamp of the trigger areas (entrances, game and shop triggers).
+     *
+     * Changes whenever a map is loaded or a trigger is added, and is unique across
+     * all maps, so callers can cache geometry derived from the trigger lists.
+     *
+     * @return uint64_t Current trigger revision.
+     */
+    uint64_t getTriggerRevision() const { return triggerRevision; }
+
+    /**
+     * @brief Find the tileset information that contains a given global tile ID (gid).
+     *
+     * @param gid Global tile ID to lookup.
+     * @return Pointer to matching TilesetInfo or nullptr if not found.
+     */
+    TilesetInfo* findTilesetForGid(int gid);
+    const TilesetInfo* findTilesetForGid(int gid) const;
+
+    /**
+     * @brief Build the extruded tileset image without uploading it.
+     *
+     * @param src Source image containing the tileset.
+     * @param srcTileW Original tile width in pixels.
+     * @param srcTileH Original tile height in pixels.
+     * @param columns Number of tile columns in the source image.
+     * @param spacing Pixel spacing between tiles in the source.
+     * @param margin Pixel margin around tiles in the source.
+     * @param extrude Number of pixels to extrude around each tile.
+     * @param outImage Output image receiving the extruded sheet.
+     * @return true if the extruded image was created successfully.
+     */
+    static bool makeExtrudedImage(
+        const sf::Image& src, 
+        int srcTileW, 
+        int srcTileH,
+        int columns, 
+        int spacing, 
+        int margin, 
+        int extrude, 
+        sf::Image& outImage
+    );
+
 private:
+    // An animated tile id placed on the map: its frames, frame clock and the tiles showing it.
+    struct AnimatedTile {
+        size_t tileset = 0;                       // Index into tilesets
+        std::vector<TileAnimationFrame> frames;
+        float cycleMs = 0.f;                      // Sum of the frame durations
+        size_t frame = 0;
+        float clockMs = 0.f;                      // Time spent in the current frame
+        std::vector<uint32_t> tiles;              // Indices into tiles
+    };
+
     /**
      * @brief Override sf::Drawable's draw method (automatically called by window.draw(map)).
      * 
@@ -164,7 +338,7 @@ private:
      * @return true on success, false on parse or resource errors.
      */
     bool parseMapData(
-        const nlohmann::json& j, 
+        const MapJson& j, 
         const std::string& baseDir, 
         int extrude
     );
@@ -178,7 +352,7 @@ private:
      * @return true if tilesets loaded successfully; false if critical resources are missing.
      */
     bool loadTilesets(
-        const nlohmann::json& tilesetsData, 
+        const MapJson& tilesetsData, 
         const std::string& baseDir, 
         int extrude
     );
@@ -212,15 +386,63 @@ private:
      *
      * @param layers JSON array containing TMJ layer objects.
      */
-    void parseObjectLayers(const nlohmann::json& layers);
+    void parseObjectLayers(const MapJson& layers);
 
     /**
-     * @brief Find the tileset information that contains a given global tile ID (gid).
+     * @brief Produce a new process-wide unique trigger revision stamp.
      *
-     * @param gid Global tile ID to lookup.
-     * @return Pointer to matching TilesetInfo or nullptr if not found.
+     * @return uint64_t Next revision value.
      */
-    TilesetInfo* findTilesetForGid(int gid);
+    static uint64_t nextTriggerRevision();
+
+    /**
+     * @brief Merge fully blocked tile cells into as few rectangles as possible.
+     *
+     * Runs of solid cells are merged horizontally first, then identical runs
+     * on consecutive rows are extended downwards. Results go to notWalkRects.
+     *
+     * @param solidCells Row-major grid (mapWidthTiles x mapHeightTiles), non-zero = blocked.
+     * @return Number of rectangles emitted.
+     */
+    size_t mergeSolidCells(const std::pmr::vector<uint8_t>& solidCells);
+
+    /**
+     * @brief Drop tiles that are completely hidden under an opaque tile drawn later in the same cell.
+     *
+     * @param tileCells Grid cell index per entry of tiles, or -1 if the tile is not cell-aligned.
+     * @param tileOccludes Non-zero per entry of tiles if it is opaque and covers its whole cell.
+     * @param tileAnimations Animation index per entry of tiles (or -1); compacted along with tiles.
+     * @return Number of tiles removed.
+     */
+    size_t cullOccludedTiles(
+        const std::pmr::vector<int>& tileCells,
+        const std::pmr::vector<uint8_t>& tileOccludes,
+        std::pmr::vector<int>& tileAnimations
+    );
+
+    /**
+     * @brief Show an animated tile's current frame on every tile using it (map geometry only).
+     *
+     * @return Number of tiles rewritten.
+     */
+    size_t applyAnimationFrame(const AnimatedTile& animation);
+
+    /**
+     * @brief Build tileVertices and tileRuns from the final tiles.
+     */
+    void buildTileGeometry();
+
+    /**
+     * @brief Build the uniform grid used by feetBlockedAt to look up nearby blockers.
+     *
+     * Must be called after all NotWalkable rectangles and polygons are known.
+     */
+    void buildCollisionIndex();
+
+    /**
+     * @brief Charge the map's data to the memory tracker under memoryScope.
+     */
+    void accountMemory();
     
 private:
     int mapWidthTiles = 0;
@@ -230,6 +452,10 @@ private:
     
     std::vector<TilesetInfo> tilesets;
     std::vector<sf::Sprite> tiles;
+    std::vector<uint16_t> tileLayers;   // Tile layer index per entry of tiles (draw depth)
+    std::vector<sf::Vertex> tileVertices;   // Six per entry of tiles
+    std::vector<TileRun> tileRuns;
+    std::vector<std::string> tileLayerNames;   // Tiled name per tile layer index
     std::vector<TextObject> textObjects;
     std::vector<EntranceArea> entranceAreas;
     std::vector<GameTriggerArea> gameTriggers;
@@ -238,6 +464,21 @@ private:
     std::vector<InteractionObject> interactionObjects;
     std::vector<sf::FloatRect> notWalkRects; 
     std::vector<BlockPoly>     notWalkPolys; 
+
+    std::vector<AnimatedTile> animatedTiles;
+
+    std::vector<LightSource> lights;
+    std::vector<EffectArea> effectAreas;
+    Lightmap lightmap;
+
+    MapLoadTimings loadTimings;
+
+    // Uniform grid over the world: each bucket lists the rect/poly indices overlapping it.
+    float collisionCellSize = 0.f;
+    int collisionCols = 0;
+    int collisionRows = 0;
+    std::vector<std::vector<uint32_t>> collisionRectBuckets;
+    std::vector<std::vector<uint32_t>> collisionPolyBuckets;
     
     std::optional<float> spawnX;
     std::optional<float> spawnY;
@@ -248,4 +489,17 @@ private:
     std::vector<LawnArea> lawnAreas;
     std::vector<ShopTrigger> m_shopTriggers;
     RespawnPoint respawnPoint;  
+    uint64_t triggerRevision = 0;
+
+    // Memory accounting (see MemoryTracker), scoped by the map file's name
+    std::string memoryScope = "map";
+    MemoryCharge tileMemory;
+    MemoryCharge objectMemory;
+    MemoryCharge collisionMemory;
+    MemoryCharge tilesetMemory;
+    MemoryCharge tilesetGpuMemory;
+    MemoryCharge lightmapMemory;
+    MemoryCharge lightmapGpuMemory;
+
+    static bool headless;
 };
@@ -108,6 +108,7 @@ public:
      * @param quizJsonPath Path to quiz JSON file.
      * @param tm TaskManager reference.
      * @param outHint Optional pointer to receive hint message.
+     * @param renderer Paused game renderer the quiz records input latency with (optional).
      * @return Result Trigger result.
      */
     inline Result tryTrigger(const std::string& weekday,
@@ -115,7 +116,8 @@ public:
                              int minutesSinceMidnight,
                              const std::string& quizJsonPath,
                              TaskManager& tm,
-                             std::string* outHint /*= nullptr*/)
+                             std::string* outHint /*= nullptr*/,
+                             Renderer* renderer = nullptr)
     {
         auto it = schedules.find(weekday);
         if (it == schedules.end()) {
@@ -174,7 +176,7 @@ public:
 
                 // Open quiz
                 QuizGame quiz(quizJsonPath, ps->course);
-                quiz.run();
+                quiz.run(renderer);
                 auto eff = quiz.getResultEffects();
                 applyQuizRewards(tm, eff);
 
@@ -201,6 +203,43 @@ public:
         return Result::WrongBuildingHintShown;
     }
 
+    /**
+     * @brief Loaded schedules by weekday (course and building names end up in hints).
+     */
+    const std::unordered_map<std::string, DaySchedule>& getSchedules() const { return schedules; }
+
+    /**
+     * @brief Building the player should head to: an ongoing class whose quiz is not
+     *        done yet, otherwise the next class of the day.
+     *
+     * @param weekday Weekday string like "Monday".
+     * @param minutesSinceMidnight Current time in minutes since midnight.
+     * @return Building name from the schedule, or an empty string when no class is left today.
+     */
+    inline std::string targetBuilding(const std::string& weekday, int minutesSinceMidnight) const {
+        auto it = schedules.find(weekday);
+        if (it == schedules.end()) return {};
+
+        const Slot* nextSlot = nullptr;
+        for (const auto& s : it->second.slots) {
+            if (minutesSinceMidnight >= s.startMin && minutesSinceMidnight <= s.endMin) {
+                if (!fired.count(makeSlotKey(weekday, s.location, s.startMin, s.endMin, s.course))) {
+                    return s.location;
+                }
+            } else if (minutesSinceMidnight < s.startMin) {
+                if (!nextSlot || s.startMin < nextSlot->startMin) nextSlot = &s;
+            }
+        }
+        return nextSlot ? nextSlot->location : std::string{};
+    }
+
+    /**
+     * @brief Whether two building names match, ignoring spaces and case (as tryTrigger does).
+     */
+    static inline bool sameBuilding(const std::string& a, const std::string& b) {
+        return normalizeBuilding(a) == normalizeBuilding(b);
+    }
+
 private:
     /**
      * @brief Parse time range string like "09:00-10:15".
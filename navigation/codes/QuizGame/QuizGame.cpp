@@ -6,6 +6,9 @@
 #include <nlohmann/json.hpp>
 #include <random>
 #include "Utils/Logger.h"
+#include "Renderer/GlyphPrewarmer.h"
+#include "Renderer/Renderer.h"
+#include "Input/InputManager.h"
 
 // OptionButton Implementation
 QuizGame::OptionButton::OptionButton(const sf::Font& font,
@@ -38,6 +41,23 @@ void QuizGame::OptionButton::setFont(const sf::Font& f) {
 }
 
 // QuizGame private methods
+
+// Rasterize the bank's glyphs before the first frame, so answering never hitches
+void QuizGame::prewarmGlyphs() {
+    GlyphPrewarmer glyphs;
+    glyphs.addFace(32, sf::Text::Bold);   // title
+    glyphs.addFace(24, sf::Text::Bold);   // question
+    glyphs.addFace(36, sf::Text::Bold);   // "Quiz Completed!"
+    glyphs.addFace(28);                   // result
+    glyphs.addFace(20, sf::Text::Bold);   // score, continue
+    glyphs.addFace(22, sf::Text::Bold);   // options
+    for (const auto& q : questions) {
+        glyphs.addText(q.text);
+        for (const auto& option : q.options) glyphs.addText(option);
+    }
+    glyphs.warm(font);
+}
+
 std::string QuizGame::wrapText(const std::string& text, size_t lineLength) const {
     std::stringstream ss(text);
     std::string word;
@@ -328,6 +348,32 @@ void QuizGame::updateScoreDisplay() {
     scoreText.setString(ss.str());
 }
 
+// Window-less instance: members only, no window, font or question bank
+QuizGame::QuizGame(HeadlessTag)
+    : font()
+    , titleText(font)
+    , questionText(font)
+    , resultText(font)
+    , scoreText(font)
+    , continueText(font)
+    , continueButton()
+    , currentQuestionIndex(0)
+    , totalQuestions(0)
+    , correctAnswers(0)
+    , answered(false)
+    , gameCompleted(false)
+    , showContinueButton(false)
+{
+}
+
+int QuizGame::loadQuestionBank(const std::string& jsonPath, const std::string& forcedCategory) {
+    QuizGame probe{HeadlessTag{}};
+    const bool loaded = forcedCategory.empty()
+        ? probe.loadQuestionsFromFile(jsonPath)
+        : probe.loadQuestionsFromFile(jsonPath, forcedCategory);
+    return loaded ? static_cast<int>(probe.totalQuestions) : -1;
+}
+
 // Constructors
 QuizGame::QuizGame()
     : font()
@@ -407,6 +453,7 @@ QuizGame::QuizGame()
 
     // Load questions and display first question
     loadQuestions();
+    prewarmGlyphs();
     displayCurrentQuestion();
     updateScoreDisplay();
 }
@@ -490,6 +537,7 @@ QuizGame::QuizGame(const std::string& jsonPath)
         // Fallback to built-in question bank
         loadQuestions();
     }
+    prewarmGlyphs();
     displayCurrentQuestion();
     updateScoreDisplay();
 }
@@ -567,15 +615,62 @@ QuizGame::QuizGame(const std::string& jsonPath, const std::string& forcedCategor
     if (!loaded) {
         loadQuestions();
     }
+    prewarmGlyphs();
     displayCurrentQuestion();
     updateScoreDisplay();
 }
 
+// Moves past an answered question; after the last one shows the final score
+void QuizGame::continueToNextQuestion() {
+    showContinueButton = false;
+    ++currentQuestionIndex;
+    if (currentQuestionIndex < totalQuestions) {
+        displayCurrentQuestion();
+        updateScoreDisplay();
+    } else {
+        // Game ended
+        gameCompleted = true;
+        questionText.setString("Quiz Completed!");
+        questionText.setFillColor(sf::Color(255, 215, 0));
+        questionText.setCharacterSize(36);
+        questionText.setPosition(sf::Vector2f(220.f, 150.f));
+
+        std::string finalMessage;
+        if (correctAnswers == totalQuestions) {
+            finalMessage = "Perfect Score!\nFinal Score: " + std::to_string(correctAnswers) +
+                           "/" + std::to_string(totalQuestions) + "\nClick to close";
+        } else if (correctAnswers >= totalQuestions / 2) {
+            finalMessage = "Good Job!\nFinal Score: " + std::to_string(correctAnswers) +
+                           "/" + std::to_string(totalQuestions) + "\nClick to close";
+        } else {
+            finalMessage = "Keep Practicing!\nFinal Score: " + std::to_string(correctAnswers) +
+                           "/" + std::to_string(totalQuestions) + "\nClick to close";
+        }
+
+        resultText.setString(finalMessage);
+        resultText.setFillColor(sf::Color::White);
+        resultText.setCharacterSize(28);
+        resultText.setPosition(sf::Vector2f(200.f, 220.f));
+        // determine effects based on performance
+        if (correctAnswers == totalQuestions) {
+            lastEffect = perfectEffect;
+        } else if (correctAnswers >= totalQuestions / 2) {
+            lastEffect = goodEffect;
+        } else {
+            lastEffect = poorEffect;
+        }
+        options.clear();
+        showContinueButton = false;
+    }
+}
+
 // run() 
-void QuizGame::run() {
+void QuizGame::run(Renderer* renderer) {
+    InputManager& inputManager = InputManager::getInstance();
     while (window.isOpen()) {
         for (auto ev = window.pollEvent(); ev.has_value(); ev = window.pollEvent()) {
             const auto& e = ev.value();
+            inputManager.handleEvent(e, InputManager::Clock::now());
             // Close event
             if (e.is<sf::Event::Closed>()) {
                 window.close();
@@ -610,48 +705,7 @@ void QuizGame::run() {
                     }
                     // Answered and show continue button -> click continue
                     else if (answered && !gameCompleted && showContinueButton) {
-                        if (continueButton.getGlobalBounds().contains(mousePos)) {
-                            showContinueButton = false;
-                            ++currentQuestionIndex;
-                            if (currentQuestionIndex < totalQuestions) {
-                                displayCurrentQuestion();
-                                updateScoreDisplay();
-                            } else {
-                                // Game ended
-                                gameCompleted = true;
-                                questionText.setString("Quiz Completed!");
-                                questionText.setFillColor(sf::Color(255, 215, 0));
-                                questionText.setCharacterSize(36);
-                                questionText.setPosition(sf::Vector2f(220.f, 150.f));
-
-                                std::string finalMessage;
-                                if (correctAnswers == totalQuestions) {
-                                    finalMessage = "Perfect Score!\nFinal Score: " + std::to_string(correctAnswers) +
-                                                   "/" + std::to_string(totalQuestions) + "\nClick to close";
-                                } else if (correctAnswers >= totalQuestions / 2) {
-                                    finalMessage = "Good Job!\nFinal Score: " + std::to_string(correctAnswers) +
-                                                   "/" + std::to_string(totalQuestions) + "\nClick to close";
-                                } else {
-                                    finalMessage = "Keep Practicing!\nFinal Score: " + std::to_string(correctAnswers) +
-                                                   "/" + std::to_string(totalQuestions) + "\nClick to close";
-                                }
-
-                                resultText.setString(finalMessage);
-                                resultText.setFillColor(sf::Color::White);
-                                resultText.setCharacterSize(28);
-                                resultText.setPosition(sf::Vector2f(200.f, 220.f));
-                                // determine effects based on performance
-                                if (correctAnswers == totalQuestions) {
-                                    lastEffect = perfectEffect;
-                                } else if (correctAnswers >= totalQuestions / 2) {
-                                    lastEffect = goodEffect;
-                                } else {
-                                    lastEffect = poorEffect;
-                                }
-                                options.clear();
-                                showContinueButton = false;
-                            }
-                        }
+                        if (continueButton.getGlobalBounds().contains(mousePos)) continueToNextQuestion();
                     }
                     // After game completed click -> close this window
                     else if (gameCompleted) {
@@ -660,6 +714,24 @@ void QuizGame::run() {
                 }
             } // end mouse event
         } // end polling events
+        if (!window.isOpen()) break;
+
+        // Keys: Confirm continues or closes the finished quiz, Cancel leaves it
+        inputManager.update();
+        if (renderer) {
+            if (const auto inputAt = inputManager.getFrameInputTime()) renderer->noteInput(*inputAt);
+        }
+        if (inputManager.consumeAction(InputAction::Cancel)) {
+            window.close();
+            break;
+        }
+        if (inputManager.consumeAction(InputAction::Confirm)) {
+            if (gameCompleted) {
+                window.close();
+                break;
+            }
+            if (answered && showContinueButton) continueToNextQuestion();
+        }
 
         // Drawing
         window.clear(sf::Color(30, 30, 60));
@@ -689,6 +761,7 @@ void QuizGame::run() {
             window.draw(continueText);
         }
 
-        window.display();
+        if (renderer) renderer->presentModal(window);
+        else window.display();
     } // end window loop
 }
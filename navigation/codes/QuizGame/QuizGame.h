@@ -7,6 +7,8 @@
 #include <string>
 #include <optional>
 
+class Renderer;
+
 class QuizGame {
 public:
     // Public type for effects so callers can read result values
@@ -86,6 +88,8 @@ private:
     bool loadQuestionsFromFile(const std::string& path, const std::string& forcedCategory); 
     void displayCurrentQuestion();
     void updateScoreDisplay();
+    void continueToNextQuestion();
+    void prewarmGlyphs();
     std::string wrapText(const std::string& text, size_t lineLength) const;
     // UI config loaded from JSON (optional)
     unsigned int uiWindowW = 800;
@@ -96,7 +100,11 @@ private:
     Effects perfectEffect;
     Effects goodEffect;
     Effects poorEffect;
-    Effects lastEffect; 
+    Effects lastEffect;
+
+    // Tag for the window-less instance used by loadQuestionBank
+    struct HeadlessTag {};
+    explicit QuizGame(HeadlessTag); 
 
 public:
     /**
@@ -123,8 +131,13 @@ public:
 
     /**
      * @brief Run the quiz game (blocking, until window closes).
+     *
+     * Keys go through the InputManager: Confirm continues (or closes the finished
+     * quiz) and Cancel closes the window.
+     *
+     * @param renderer Paused game renderer recording input latency (optional).
      */
-    void run();
+    void run(Renderer* renderer = nullptr);
 
     /**
      * @brief Get resulting effects after quiz completion.
@@ -132,6 +145,15 @@ public:
      * @return Effects Points and energy changes from quiz.
      */
     Effects getResultEffects() const { return lastEffect; }
+
+    /**
+     * @brief Parse a question bank the same way the quiz does, without opening a window.
+     * 
+     * @param jsonPath Path to JSON file containing questions.
+     * @param forcedCategory Category to force; empty picks one at random.
+     * @return int Number of questions selected, or -1 if the file could not be loaded.
+     */
+    static int loadQuestionBank(const std::string& jsonPath, const std::string& forcedCategory = "");
 };
 
 #endif // QUIZ_GAME_H
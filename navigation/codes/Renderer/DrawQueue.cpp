@@ -0,0 +1,229 @@
+// DrawQueue.cpp
+#include "Renderer/DrawQueue.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+/*
+ * File: DrawQueue.cpp
+ * Description: Implements sorting and batching for the per-frame draw command buffer.
+ *
+ * Sort key layout (most significant first):
+ *   bits 56..63  layer
+ *   bits 32..55  depth (rounded, biased so negative values sort first)
+ *   bits 16..31  texture id (assigned per frame in first-use order)
+ *   bits  0..15  shader id
+ * Ties keep submission order, so equal keys draw exactly as submitted.
+ */
+
+namespace {
+
+constexpr uint64_t DigestSeed = 0x9E3779B97F4A7C15ull;
+
+uint64_t mixWord(uint64_t h, uint64_t word) {
+    h ^= word + DigestSeed + (h << 6) + (h >> 2);
+    h *= 0xFF51AFD7ED558CCDull;
+    return h ^ (h >> 32);
+}
+
+} // namespace
+
+void DrawQueue::begin() {
+    commands.clear();
+    vertices.clear();
+    custom.clear();
+    textCount = 0;
+    textureIds.clear();
+    shaderIds.clear();
+    digest = DigestSeed;
+}
+
+
+uint64_t DrawQueue::mixDigest(uint64_t h, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    while (size >= sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, bytes, sizeof(word));
+        h = mixWord(h, word);
+        bytes += sizeof(word);
+        size -= sizeof(word);
+    }
+    if (size > 0) {
+        uint64_t word = 0;
+        std::memcpy(&word, bytes, size);
+        h = mixWord(h, word ^ (static_cast<uint64_t>(size) << 56));
+    }
+    return h;
+}
+
+
+void DrawQueue::submitText(const sf::Text& text, DrawLayer layer, float depth) {
+    // Copy-assigning into an old slot reuses its string and vertex capacity
+    if (textCount < texts.size()) texts[textCount] = text;
+    else texts.push_back(text);
+
+    pushCommand(layer, depth, nullptr, nullptr, 0, 0, -1);
+    commands.back().textIndex = static_cast<int>(textCount++);
+}
+
+
+uint16_t DrawQueue::idFor(std::unordered_map<const void*, uint16_t>& ids, const void* ptr) {
+    if (!ptr) return 0;
+    auto it = ids.find(ptr);
+    if (it != ids.end()) return it->second;
+    const uint16_t id = static_cast<uint16_t>(std::min<size_t>(ids.size() + 1, 0xFFFF));
+    ids.emplace(ptr, id);
+    return id;
+}
+
+
+void DrawQueue::pushCommand(
+    DrawLayer layer,
+    float depth,
+    const sf::Texture* texture,
+    const sf::Shader* shader,
+    uint32_t firstVertex,
+    uint32_t vertexCount,
+    int customIndex,
+    DrawBlend blend
+) {
+    const long biased = std::clamp(std::lround(depth) + (1L << 23), 0L, (1L << 24) - 1);
+
+    Command cmd;
+    cmd.key = (static_cast<uint64_t>(layer) << 56) |
+              (static_cast<uint64_t>(biased) << 32) |
+              (static_cast<uint64_t>(idFor(textureIds, texture)) << 16) |
+              static_cast<uint64_t>(idFor(shaderIds, shader));
+    cmd.sequence = static_cast<uint32_t>(commands.size());
+    cmd.texture = texture;
+    cmd.shader = shader;
+    cmd.firstVertex = firstVertex;
+    cmd.vertexCount = vertexCount;
+    cmd.customIndex = customIndex;
+    cmd.blend = blend;
+    commands.push_back(cmd);
+
+    digest = mixWord(digest, cmd.key ^ static_cast<uint64_t>(blend));
+    digest = mixWord(digest, reinterpret_cast<uintptr_t>(texture) ^ (static_cast<uint64_t>(vertexCount) << 48));
+    if (vertexCount > 0) digest = mixDigest(digest, &vertices[firstVertex], vertexCount * sizeof(sf::Vertex));
+}
+
+
+void DrawQueue::submit(
+    const sf::Sprite& sprite,
+    DrawLayer layer,
+    float depth,
+    const sf::Shader* shader
+) {
+    const sf::IntRect tr = sprite.getTextureRect();
+    const float w = std::abs(static_cast<float>(tr.size.x));
+    const float h = std::abs(static_cast<float>(tr.size.y));
+    const float u0 = static_cast<float>(tr.position.x);
+    const float v0 = static_cast<float>(tr.position.y);
+    const float u1 = u0 + static_cast<float>(tr.size.x);
+    const float v1 = v0 + static_cast<float>(tr.size.y);
+
+    const sf::Transform& xf = sprite.getTransform();
+    const sf::Color color = sprite.getColor();
+    const sf::Vertex tl{xf.transformPoint({0.f, 0.f}), color, {u0, v0}};
+    const sf::Vertex trv{xf.transformPoint({w, 0.f}), color, {u1, v0}};
+    const sf::Vertex br{xf.transformPoint({w, h}), color, {u1, v1}};
+    const sf::Vertex bl{xf.transformPoint({0.f, h}), color, {u0, v1}};
+
+    const uint32_t first = static_cast<uint32_t>(vertices.size());
+    vertices.push_back(tl);
+    vertices.push_back(trv);
+    vertices.push_back(br);
+    vertices.push_back(tl);
+    vertices.push_back(br);
+    vertices.push_back(bl);
+
+    pushCommand(layer, depth, &sprite.getTexture(), shader, first, 6, -1);
+}
+
+
+void DrawQueue::submit(
+    const sf::VertexArray& triangles,
+    const sf::Texture* texture,
+    DrawLayer layer,
+    float depth,
+    DrawBlend blend
+) {
+    const size_t n = triangles.getVertexCount();
+    if (n == 0) return;
+    submit(&triangles[0], n, texture, layer, depth, blend);
+}
+
+
+void DrawQueue::submit(
+    const sf::Vertex* triangles,
+    size_t count,
+    const sf::Texture* texture,
+    DrawLayer layer,
+    float depth,
+    DrawBlend blend
+) {
+    if (count == 0) return;
+
+    const uint32_t first = static_cast<uint32_t>(vertices.size());
+    vertices.insert(vertices.end(), triangles, triangles + count);
+
+    pushCommand(layer, depth, texture, nullptr, first, static_cast<uint32_t>(count), -1, blend);
+}
+
+
+void DrawQueue::flush(RenderBackend& backend) {
+    DrawStats stats;
+    stats.commands = commands.size();
+
+    std::stable_sort(commands.begin(), commands.end(), [](const Command& a, const Command& b) {
+        return a.key < b.key;
+    });
+
+    const sf::Texture* boundTexture = nullptr;
+    bool anyBound = false;
+
+    auto issue = [&](const sf::Texture* texture, const sf::Shader* shader, DrawBlend blend) {
+        if (batch.empty()) return;
+        backend.drawTriangles(batch.data(), batch.size(), texture, shader, blend);
+        ++stats.drawCalls;
+        stats.vertices += batch.size();
+        if (!anyBound || texture != boundTexture) {
+            ++stats.textureBinds;
+            boundTexture = texture;
+            anyBound = true;
+        }
+        batch.clear();
+    };
+
+    const sf::Texture* batchTexture = nullptr;
+    const sf::Shader* batchShader = nullptr;
+    DrawBlend batchBlend = DrawBlend::Alpha;
+
+    for (const auto& cmd : commands) {
+        if (cmd.customIndex >= 0 || cmd.textIndex >= 0) {
+            issue(batchTexture, batchShader, batchBlend);
+            if (cmd.textIndex >= 0) backend.drawText(texts[static_cast<size_t>(cmd.textIndex)]);
+            else custom[static_cast<size_t>(cmd.customIndex)](backend);
+            ++stats.drawCalls;
+            ++stats.textureBinds;
+            anyBound = false;   // the drawable bound its own texture
+            continue;
+        }
+
+        if (!batch.empty() &&
+            (cmd.texture != batchTexture || cmd.shader != batchShader || cmd.blend != batchBlend)) {
+            issue(batchTexture, batchShader, batchBlend);
+        }
+        batchTexture = cmd.texture;
+        batchShader = cmd.shader;
+        batchBlend = cmd.blend;
+        batch.insert(batch.end(),
+                     vertices.begin() + cmd.firstVertex,
+                     vertices.begin() + cmd.firstVertex + cmd.vertexCount);
+    }
+    issue(batchTexture, batchShader, batchBlend);
+
+    lastStats = stats;
+    begin();
+}
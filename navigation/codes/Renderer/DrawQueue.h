@@ -0,0 +1,251 @@
+// DrawQueue.h
+#pragma once
+
+#include "Renderer/RenderBackend.h"
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <functional>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * File: DrawQueue.h
+ * Description: Per-frame, sort-keyed draw command buffer sitting between game code and SFML.
+ *
+ * Game code submits sprites, raw triangles or arbitrary drawables together with a
+ * layer and a depth. At flush time the commands are stably sorted by a 64-bit key
+ * (layer, depth, texture, shader) and consecutive textured geometry that shares a
+ * texture and shader is coalesced into one draw call. The result goes to a
+ * RenderBackend, so the same stream feeds SFML or the headless CPU rasterizer.
+ *
+ * Every submission is also folded into a 64-bit digest of the frame's content,
+ * so callers can tell whether two recorded frames would draw the same pixels.
+ *
+ * Notes:
+ *   - Textures and shaders are referenced by pointer and must outlive the flush.
+ *   - Drawables submitted with submitDrawable are copied and cannot be batched.
+ *     Texts are copied into slots kept across frames, so a steady HUD reuses
+ *     their string and vertex buffers instead of allocating new ones.
+ *   - Only sprites, texts and shapes are digested by content; any other drawable
+ *     makes the digest unique, so such frames never compare equal.
+ */
+
+/**
+ * @enum DrawLayer
+ * @brief Coarse draw order; lower layers are drawn first.
+ */
+enum class DrawLayer : uint8_t {
+    Ground   = 0,   ///< Map tiles (depth = Tiled layer index)
+    Overlays = 1,   ///< Trigger/entrance overlays
+    Actors   = 2,   ///< NPCs and the player (depth = feet y)
+    Labels   = 3,   ///< World-space text
+    Effects  = 4    ///< Anything that must sit on top of the world
+};
+
+/**
+ * @struct DrawStats
+ * @brief Counters gathered by the last DrawQueue::flush.
+ */
+struct DrawStats {
+    size_t commands = 0;      ///< Commands submitted this frame
+    size_t drawCalls = 0;     ///< Draw calls issued to the backend
+    size_t textureBinds = 0;  ///< Texture changes between consecutive draw calls
+    size_t vertices = 0;      ///< Vertices sent to the backend
+};
+
+class DrawQueue {
+public:
+    /**
+     * @brief Drop all commands from the previous frame and start collecting.
+     */
+    void begin();
+
+    /**
+     * @brief Submit a sprite as two textured triangles.
+     *
+     * @param sprite Sprite to draw (its transform, texture rect and color are captured).
+     * @param layer Draw layer.
+     * @param depth Ordering inside the layer (lower first).
+     * @param shader Optional shader; part of the sort key.
+     */
+    void submit(
+        const sf::Sprite& sprite,
+        DrawLayer layer,
+        float depth = 0.f,
+        const sf::Shader* shader = nullptr
+    );
+
+    /**
+     * @brief Submit a triangle list (already in world coordinates).
+     *
+     * @param triangles Vertex array with PrimitiveType::Triangles.
+     * @param texture Texture to sample, or nullptr for flat colored geometry.
+     * @param layer Draw layer.
+     * @param depth Ordering inside the layer (lower first).
+     * @param blend How the triangles combine with what is below; batches never mix blends.
+     */
+    void submit(
+        const sf::VertexArray& triangles,
+        const sf::Texture* texture,
+        DrawLayer layer,
+        float depth = 0.f,
+        DrawBlend blend = DrawBlend::Alpha
+    );
+
+    /**
+     * @brief Submit a triangle list held in any contiguous storage (e.g. an arena vector).
+     *
+     * @param triangles First vertex; three per triangle.
+     * @param count Number of vertices.
+     * @param texture Texture to sample, or nullptr for flat colored geometry.
+     * @param layer Draw layer.
+     * @param depth Ordering inside the layer (lower first).
+     * @param blend How the triangles combine with what is below.
+     */
+    void submit(
+        const sf::Vertex* triangles,
+        size_t count,
+        const sf::Texture* texture,
+        DrawLayer layer,
+        float depth = 0.f,
+        DrawBlend blend = DrawBlend::Alpha
+    );
+
+    /**
+     * @brief Submit any SFML drawable (text, shapes). A copy is kept until flush.
+     *
+     * Texts and rectangle shapes reach the backend as such, so backends without
+     * SFML drawing (the software rasterizer) can still render them.
+     *
+     * @param drawable Drawable to copy and draw.
+     * @param layer Draw layer.
+     * @param depth Ordering inside the layer (lower first).
+     */
+    template <typename T>
+    void submitDrawable(const T& drawable, DrawLayer layer, float depth = 0.f) {
+        digest = digestDrawable(digest, drawable);
+        if constexpr (std::is_base_of_v<sf::Text, T>) {
+            submitText(drawable, layer, depth);
+        } else {
+            custom.emplace_back([copy = drawable](RenderBackend& backend) {
+                if constexpr (std::is_base_of_v<sf::RectangleShape, T>) backend.drawRect(copy);
+                else backend.drawDrawable(copy);
+            });
+            pushCommand(layer, depth, nullptr, nullptr, 0, 0, static_cast<int>(custom.size()) - 1);
+        }
+    }
+
+    /**
+     * @brief Sort, batch and draw everything submitted since begin().
+     *
+     * @param backend Backend (with its view already set) to draw into.
+     */
+    void flush(RenderBackend& backend);
+
+    /**
+     * @brief Sort, batch and draw everything into an SFML render target.
+     *
+     * @param target Render target (with its view already set) to draw into.
+     */
+    void flush(sf::RenderTarget& target) {
+        SfmlRenderBackend backend(target);
+        flush(backend);
+    }
+
+    /**
+     * @brief Counters from the most recent flush.
+     *
+     * @return const DrawStats& Stats of the last flushed frame.
+     */
+    const DrawStats& getLastStats() const { return lastStats; }
+
+    /**
+     * @brief Digest of everything submitted since begin().
+     *
+     * Equal digests mean the frames draw the same geometry, textures, texts and
+     * colors (up to hash collisions).
+     *
+     * @return uint64_t Content digest.
+     */
+    uint64_t getDigest() const { return digest; }
+
+private:
+    struct Command {
+        uint64_t key = 0;
+        uint32_t sequence = 0;
+        const sf::Texture* texture = nullptr;
+        const sf::Shader* shader = nullptr;
+        uint32_t firstVertex = 0;
+        uint32_t vertexCount = 0;
+        int customIndex = -1;     ///< Index into custom, or -1 for vertex geometry
+        int textIndex = -1;       ///< Index into texts, or -1
+        DrawBlend blend = DrawBlend::Alpha;
+    };
+
+    void pushCommand(
+        DrawLayer layer,
+        float depth,
+        const sf::Texture* texture,
+        const sf::Shader* shader,
+        uint32_t firstVertex,
+        uint32_t vertexCount,
+        int customIndex,
+        DrawBlend blend = DrawBlend::Alpha
+    );
+
+    void submitText(const sf::Text& text, DrawLayer layer, float depth);
+
+    uint16_t idFor(std::unordered_map<const void*, uint16_t>& ids, const void* ptr);
+
+    static uint64_t mixDigest(uint64_t h, const void* data, size_t size);
+
+    template <typename V>
+    static uint64_t mixValue(uint64_t h, const V& value) { return mixDigest(h, &value, sizeof(value)); }
+
+    static uint64_t digestTransform(uint64_t h, const sf::Transform& transform) {
+        return mixDigest(h, transform.getMatrix(), 16 * sizeof(float));
+    }
+
+    template <typename T>
+    static uint64_t digestDrawable(uint64_t h, const T& drawable) {
+        if constexpr (std::is_base_of_v<sf::Text, T>) {
+            for (char32_t c : drawable.getString()) h = mixValue(h, c);
+            h = mixValue(h, &drawable.getFont());
+            h = mixValue(h, drawable.getCharacterSize());
+            h = mixValue(h, drawable.getStyle());
+            h = mixValue(h, drawable.getFillColor());
+            h = mixValue(h, drawable.getOutlineColor());
+            h = mixValue(h, drawable.getOutlineThickness());
+            return digestTransform(h, drawable.getTransform());
+        } else if constexpr (std::is_base_of_v<sf::Shape, T>) {
+            const size_t points = drawable.getPointCount();
+            for (size_t i = 0; i < points; ++i) h = mixValue(h, drawable.getPoint(i));
+            h = mixValue(h, drawable.getFillColor());
+            h = mixValue(h, drawable.getOutlineColor());
+            h = mixValue(h, drawable.getOutlineThickness());
+            return digestTransform(h, drawable.getTransform());
+        } else if constexpr (std::is_base_of_v<sf::Sprite, T>) {
+            h = mixValue(h, &drawable.getTexture());
+            h = mixValue(h, drawable.getTextureRect());
+            h = mixValue(h, drawable.getColor());
+            return digestTransform(h, drawable.getTransform());
+        } else {
+            static std::atomic<uint64_t> opaqueSerial{0};
+            return mixValue(h, opaqueSerial.fetch_add(1, std::memory_order_relaxed));
+        }
+    }
+
+    std::vector<Command> commands;
+    std::vector<sf::Vertex> vertices;
+    std::vector<std::function<void(RenderBackend&)>> custom;
+    std::vector<sf::Text> texts;    ///< Text slots; only the first textCount are this frame's
+    size_t textCount = 0;
+    std::vector<sf::Vertex> batch;
+    std::unordered_map<const void*, uint16_t> textureIds;
+    std::unordered_map<const void*, uint16_t> shaderIds;
+    DrawStats lastStats;
+    uint64_t digest = 0;
+};
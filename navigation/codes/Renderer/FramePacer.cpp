@@ -0,0 +1,136 @@
+// FramePacer.cpp
+#include "Renderer/FramePacer.h"
+#include <algorithm>
+#include <thread>
+
+/*
+ * File: FramePacer.cpp
+ * Description: Implements the sleep+spin frame limiter and the adaptive vsync hysteresis.
+ */
+
+namespace {
+    constexpr int MinIdleFPS = 10;   // The game loop clamps deltaTime to 0.1 s
+
+    constexpr std::chrono::microseconds MinSpinMargin{250};
+    constexpr std::chrono::microseconds MaxSpinMargin{4000};
+
+    // Adaptive vsync: frames slower than 1.5 periods with vsync on mean the
+    // display rate was halved; frames whose work fits in 75% of a period can
+    // afford vsync again. Streaks keep single hitches from toggling it.
+    constexpr double MissedFactor = 1.5;
+    constexpr double HeadroomFactor = 0.75;
+    constexpr double IgnoredFactor = 4.0;
+    constexpr int MissedStreak = 20;
+    constexpr int HeadroomStreak = 120;
+}
+
+
+PacingMode FramePacer::parseMode(const std::string& name, bool vsync) {
+    if (!vsync || name == "limiter") return PacingMode::Limiter;
+    if (name == "vsync") return PacingMode::VSync;
+    return PacingMode::Adaptive;
+}
+
+
+const char* FramePacer::modeName(PacingMode mode) {
+    switch (mode) {
+        case PacingMode::Limiter: return "limiter";
+        case PacingMode::VSync:   return "vsync";
+        default:                  return "adaptive";
+    }
+}
+
+
+void FramePacer::configure(int targetFPS, int idleFPS) {
+    const int fps = std::max(1, targetFPS);
+    const int idle = std::clamp(idleFPS, std::min(MinIdleFPS, fps), fps);
+    period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / fps));
+    idlePeriod = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / idle));
+    reset();
+}
+
+
+FramePacer::Clock::time_point FramePacer::nextDeadline(bool idle) {
+    const Clock::duration step = idle ? idlePeriod : period;
+    const Clock::time_point now = Clock::now();
+    deadline += step;
+    if (deadline < now) deadline = now;                           // Fell behind: don't try to catch up
+    else if (deadline > now + step) deadline = now + step;        // Came back from a longer (idle) tick
+    return deadline;
+}
+
+
+void FramePacer::sleepUntil(Clock::time_point target) {
+    const Clock::time_point wake = target - spinMargin;
+    if (Clock::now() < wake) {
+        std::this_thread::sleep_until(wake);
+
+        // Wake up early enough next time: follow oversleep up at once, decay slowly
+        const Clock::duration overslept = Clock::now() - wake;
+        const Clock::duration wanted = overslept + overslept / 4;
+        spinMargin = wanted > spinMargin ? wanted : spinMargin - (spinMargin - wanted) / 32;
+        spinMargin = std::clamp<Clock::duration>(spinMargin, MinSpinMargin, MaxSpinMargin);
+    }
+    while (Clock::now() < target) std::this_thread::yield();
+}
+
+
+void AdaptiveVSync::configure(int targetFPS, PacingMode pacingMode) {
+    mode = pacingMode;
+    periodMs = 1000.0 / std::max(1, targetFPS);
+    vsync = mode != PacingMode::Limiter;
+    streak = 0;
+    switches = 0;
+}
+
+
+bool AdaptiveVSync::recordFrame(double intervalMs, double workMs) {
+    if (mode != PacingMode::Adaptive || intervalMs > periodMs * IgnoredFactor) return false;
+
+    const bool trigger = vsync
+        ? intervalMs > periodMs * MissedFactor
+        : workMs < periodMs * HeadroomFactor;
+    streak = trigger ? streak + 1 : 0;
+    if (streak < (vsync ? MissedStreak : HeadroomStreak)) return false;
+
+    vsync = !vsync;
+    streak = 0;
+    ++switches;
+    return true;
+}
+
+
+void InputLatency::reset() {
+    count = 0;
+    totalMs = 0.0;
+    maxMs = 0.0;
+}
+
+
+void InputLatency::record(double latencyMs) {
+    recent[count % Window] = latencyMs;
+    ++count;
+    totalMs += latencyMs;
+    maxMs = std::max(maxMs, latencyMs);
+}
+
+
+double InputLatency::getPercentileMs(double fraction) const {
+    const size_t samples = std::min(count, Window);
+    if (samples == 0) return 0.0;
+
+    std::array<double, Window> sorted = recent;
+    const auto last = sorted.begin() + static_cast<std::ptrdiff_t>(samples);
+    const auto nth = sorted.begin() + static_cast<std::ptrdiff_t>(
+        std::clamp(fraction, 0.0, 1.0) * static_cast<double>(samples - 1));
+    std::nth_element(sorted.begin(), nth, last);
+    return *nth;
+}
+
+
+std::string InputLatency::describe() const {
+    if (count == 0) return "no inputs";
+    return std::to_string(count) + " inputs, avg " + std::to_string(getAverageMs()) +
+           " ms, p95 " + std::to_string(getPercentileMs(0.95)) +
+           " ms, max " + std::to_string(maxMs) + " ms";
+}
@@ -0,0 +1,180 @@
+// FramePacer.h
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+/*
+ * File: FramePacer.h
+ * Description: Frame-rate limiting and adaptive vsync for the game loop.
+ *
+ * FramePacer schedules loop ticks at the target rate (or the idle rate) and
+ * waits for them precisely: it sleeps until shortly before the deadline and
+ * spins for the rest, learning from measured oversleep how early it has to
+ * wake up. sf::Window::setFramerateLimit only sleeps, which typically
+ * overshoots by one or two milliseconds and makes frame times uneven.
+ *
+ * AdaptiveVSync decides, from the presented frame intervals, whether vsync
+ * should be on: it stays on while frames keep up with the refresh rate and is
+ * turned off while they don't, so a slow stretch tears briefly instead of
+ * dropping to half the refresh rate.
+ *
+ * InputLatency collects the time from an input event leaving the OS queue to
+ * display() returning with the first frame that reacted to it.
+ *
+ * Notes:
+ *   - FramePacer belongs to the simulation thread, AdaptiveVSync and
+ *     InputLatency to whichever thread calls display(); none is thread-safe
+ *     on its own.
+ *   - The refresh rate is assumed to be performance.targetFPS.
+ */
+
+/**
+ * @enum PacingMode
+ * @brief How frames are paced (performance.pacing).
+ */
+enum class PacingMode {
+    Limiter,   ///< Precise sleep+spin limiter, vsync off
+    VSync,     ///< Vsync always on
+    Adaptive   ///< Vsync while frames keep up, limiter while they don't
+};
+
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Parse performance.pacing.
+     *
+     * @param name "limiter", "vsync" or "adaptive" (unknown names give adaptive).
+     * @param vsync performance.vsync; false forces the limiter.
+     * @return PacingMode Parsed mode.
+     */
+    static PacingMode parseMode(const std::string& name, bool vsync);
+
+    static const char* modeName(PacingMode mode);
+
+    /**
+     * @brief Set the tick rates and restart the schedule.
+     *
+     * @param targetFPS Loop rate while active.
+     * @param idleFPS Loop rate while idle (raised to at least 10 and at most targetFPS).
+     */
+    void configure(int targetFPS, int idleFPS);
+
+    /**
+     * @brief Deadline of the next tick.
+     *
+     * Ticks follow each other at a fixed period so the rate doesn't drift; after
+     * a stall the schedule restarts from now instead of catching up.
+     *
+     * @param idle Use the idle period for this tick.
+     * @return Clock::time_point When the next tick starts.
+     */
+    Clock::time_point nextDeadline(bool idle);
+
+    /**
+     * @brief Wait until the deadline: coarse sleep, then spin for the last stretch.
+     *
+     * @param deadline Time point to wait for.
+     */
+    void sleepUntil(Clock::time_point deadline);
+
+    /**
+     * @brief Restart the schedule from now (after input, pauses or blocking displays).
+     */
+    void reset() { deadline = Clock::now(); }
+
+    Clock::duration getPeriod() const { return period; }
+
+    double getSpinMarginMs() const {
+        return std::chrono::duration<double, std::milli>(spinMargin).count();
+    }
+
+private:
+    Clock::duration period = std::chrono::microseconds(16667);
+    Clock::duration idlePeriod = std::chrono::milliseconds(100);
+    Clock::duration spinMargin = std::chrono::milliseconds(1);
+    Clock::time_point deadline = Clock::now();
+};
+
+/*
+ * Class: AdaptiveVSync
+ * Description: Hysteresis deciding whether vsync is on, fed with presented frames.
+ */
+class AdaptiveVSync {
+public:
+    /**
+     * @brief Reset to the initial state of a pacing mode.
+     *
+     * @param targetFPS Assumed refresh rate.
+     * @param mode Pacing mode; only Adaptive ever changes its decision.
+     */
+    void configure(int targetFPS, PacingMode mode);
+
+    bool wantsVSync() const { return vsync; }
+
+    /**
+     * @brief Account one presented frame.
+     *
+     * Intervals longer than a few refresh periods (idle ticks, pauses) are ignored.
+     *
+     * @param intervalMs Time since the previous display() returned.
+     * @param workMs Time spent producing the frame (update and drawing), without
+     *               any waiting for the limiter or the vertical blank.
+     * @return true if wantsVSync() changed.
+     */
+    bool recordFrame(double intervalMs, double workMs);
+
+    size_t getSwitchCount() const { return switches; }
+
+private:
+    PacingMode mode = PacingMode::Adaptive;
+    double periodMs = 1000.0 / 60.0;
+    bool vsync = true;
+    int streak = 0;
+    size_t switches = 0;
+};
+
+/*
+ * Class: InputLatency
+ * Description: Input-to-present latency samples with a running summary.
+ */
+class InputLatency {
+public:
+    void reset();
+
+    /**
+     * @brief Account one input that reached the screen.
+     *
+     * @param latencyMs Time from receiving the event to display() returning.
+     */
+    void record(double latencyMs);
+
+    size_t getCount() const { return count; }
+    double getAverageMs() const { return count ? totalMs / static_cast<double>(count) : 0.0; }
+    double getMaxMs() const { return maxMs; }
+
+    /**
+     * @brief Percentile over the most recent samples.
+     *
+     * @param fraction Percentile as a fraction (0.95 for p95).
+     * @return double Latency in milliseconds, 0 without samples.
+     */
+    double getPercentileMs(double fraction) const;
+
+    /**
+     * @brief One-line summary for the log ("n inputs, avg .. ms, p95 .. ms, max .. ms").
+     */
+    std::string describe() const;
+
+private:
+    static constexpr size_t Window = 256;
+
+    std::array<double, Window> recent{};   // Ring of the latest samples
+    size_t count = 0;
+    double totalMs = 0.0;
+    double maxMs = 0.0;
+};
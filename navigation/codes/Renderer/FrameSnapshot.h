@@ -0,0 +1,90 @@
+// FrameSnapshot.h
+#pragma once
+
+#include "Renderer/DrawQueue.h"
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/*
+ * File: FrameSnapshot.h
+ * Description: Immutable per-frame render input and the triple buffer handing it
+ *              from the simulation thread to the render thread.
+ *
+ * The simulation records a whole frame (camera, world commands, HUD commands)
+ * into a snapshot it owns exclusively, then publishes it. The render thread
+ * always draws the most recent published snapshot, so neither side waits for
+ * the other: frame time becomes max(update, render) instead of their sum.
+ *
+ * Notes:
+ *   - Commands hold copies of sprites, texts and shapes, but textures are still
+ *     referenced by pointer; anything a published snapshot references must stay
+ *     alive until the render thread has moved on (see Renderer::RenderThreadPause).
+ */
+
+/**
+ * @struct FrameSnapshot
+ * @brief Everything the render thread needs to draw one frame.
+ */
+struct FrameSnapshot {
+    uint64_t frame = 0;        ///< Simulation frame that produced the snapshot
+    double updateMs = 0.0;     ///< Simulation time spent on the frame (for adaptive vsync)
+    std::chrono::steady_clock::time_point inputAt{};   ///< Oldest input the frame reacts to (epoch if none)
+    sf::View worldView;        ///< Camera used for the world pass
+    sf::Color clearColor;      ///< Background behind the world
+    float worldScale = 1.f;    ///< World render-target resolution multiplier
+    sf::Vector2f worldTargetSize;   ///< Unzoomed camera size the low-res world texture is sized from
+    DrawQueue world;           ///< World-space commands (tiles, overlays, actors, labels)
+    DrawQueue ui;              ///< Screen-space commands (HUD, buttons, prompts, dialogs)
+};
+
+/*
+ * Class: TripleBuffer
+ * Description: Lock-free single-producer / single-consumer triple buffer.
+ *
+ * The writer fills writeSlot() and calls publish(); the reader calls acquire()
+ * to swap in the newest published slot. Each side only ever touches its own
+ * slot, and the third slot is the hand-over point, so publishing never blocks
+ * and stale frames are simply overwritten.
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    T& writeSlot() { return slots[writeIndex]; }
+
+    /**
+     * @brief Make the write slot the newest frame and start writing into a free slot.
+     */
+    void publish() {
+        const uint8_t previous = ready.exchange(static_cast<uint8_t>(writeIndex | FreshBit), std::memory_order_acq_rel);
+        writeIndex = previous & IndexMask;
+    }
+
+    /**
+     * @brief Whether a frame was published since the last acquire.
+     */
+    bool hasFresh() const { return (ready.load(std::memory_order_acquire) & FreshBit) != 0; }
+
+    /**
+     * @brief Take the newest published frame (reader side).
+     *
+     * @return T* The newest frame, or nullptr if nothing new was published.
+     */
+    T* acquire() {
+        if (!hasFresh()) return nullptr;
+        const uint8_t previous = ready.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & IndexMask;
+        return &slots[readIndex];
+    }
+
+private:
+    static constexpr uint8_t FreshBit = 0x4;
+    static constexpr uint8_t IndexMask = 0x3;
+
+    std::array<T, 3> slots;
+    uint8_t writeIndex = 0;
+    uint8_t readIndex = 1;
+    std::atomic<uint8_t> ready{2};
+};
@@ -0,0 +1,84 @@
+// GlyphPrewarmer.cpp
+#include "Renderer/GlyphPrewarmer.h"
+#include "Utils/MemoryTracker.h"
+#include <tuple>
+
+/*
+ * File: GlyphPrewarmer.cpp
+ * Description: Collects faces and characters and requests their glyphs from fonts.
+ */
+
+namespace {
+    constexpr char32_t FirstPrintable = U' ';
+    constexpr char32_t LastPrintable = U'~';
+
+    // sf::Text lays these out without a glyph of their own
+    bool isLayoutOnly(char32_t c) {
+        return c == U' ' || c == U'\t' || c == U'\n' || c == U'\r';
+    }
+}
+
+
+bool GlyphPrewarmer::Face::operator<(const Face& other) const {
+    return std::tie(size, bold, outline) < std::tie(other.size, other.bold, other.outline);
+}
+
+
+GlyphPrewarmer::GlyphPrewarmer() {
+    for (char32_t c = FirstPrintable; c <= LastPrintable; ++c) {
+        if (!isLayoutOnly(c)) characters.insert(c);
+    }
+}
+
+
+void GlyphPrewarmer::addFace(unsigned int size, uint32_t style, float outline) {
+    if (size == 0) return;
+    faces.insert(Face{size, (style & sf::Text::Bold) != 0, outline > 0.f ? outline : 0.f});
+}
+
+
+void GlyphPrewarmer::addText(const sf::String& text) {
+    for (char32_t c : text) {
+        if (!isLayoutOnly(c)) characters.insert(c);
+    }
+}
+
+
+void GlyphPrewarmer::addTextObjects(const std::vector<TextObject>& textObjects, float outline) {
+    for (const auto& textObj : textObjects) {
+        if (textObj.text.empty()) continue;
+        addText(textObj.text);
+        addFace(textObj.fontSize, textObj.bold ? sf::Text::Bold : sf::Text::Regular, outline);
+    }
+}
+
+
+size_t GlyphPrewarmer::warm(const sf::Font& font) const {
+    size_t requested = 0;
+    for (const Face& face : faces) {
+        // Spacing is measured from the space glyph of every face
+        (void)font.getGlyph(U' ', face.size, face.bold);
+        ++requested;
+
+        for (char32_t c : characters) {
+            (void)font.getGlyph(c, face.size, face.bold);
+            ++requested;
+            if (face.outline > 0.f) {
+                (void)font.getGlyph(c, face.size, face.bold, face.outline);
+                ++requested;
+            }
+        }
+    }
+    return requested;
+}
+
+
+size_t GlyphPrewarmer::pageBytes(const sf::Font& font) const {
+    // Pages are per character size; bold and outlined glyphs share them
+    std::set<unsigned int> sizes;
+    for (const Face& face : faces) sizes.insert(face.size);
+
+    size_t bytes = 0;
+    for (unsigned int size : sizes) bytes += MemoryTracker::textureBytes(font.getTexture(size));
+    return bytes;
+}
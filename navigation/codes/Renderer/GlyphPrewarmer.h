@@ -0,0 +1,99 @@
+// GlyphPrewarmer.h
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <vector>
+#include "MapLoader/MapObjects.h"
+
+/*
+ * File: GlyphPrewarmer.h
+ * Description: Rasterizes the glyphs the game can display before they are first drawn.
+ *
+ * sf::Font renders a glyph into its page texture the first time a
+ * (character, size, bold, outline) combination is requested, so new dialogs,
+ * quiz questions and map labels hitch when they first appear, once for every
+ * sf::Font instance (each keeps its own cache). The prewarmer collects the
+ * faces (size, style, outline thickness) and characters the game draws and
+ * requests every combination up front.
+ *
+ * Notes:
+ *   - Faces and characters are combined as a cross product, so strings built at
+ *     runtime (clock, counters, task lines) are covered by their characters.
+ *     Printable ASCII is always included; data-driven text (map labels, task
+ *     descriptions, quiz banks) adds whatever else it uses.
+ *   - Outlined texts need the plain and the outlined glyph; both are warmed.
+ *   - warm() touches the font's textures: call it on the thread that draws with
+ *     the font (see Renderer::prewarmGlyphs for the render-thread copies).
+ */
+class GlyphPrewarmer {
+public:
+    /**
+     * @struct Face
+     * @brief Character size, boldness and outline a text is drawn with.
+     */
+    struct Face {
+        unsigned int size = 16;
+        bool bold = false;
+        float outline = 0.f;
+
+        bool operator<(const Face& other) const;
+    };
+
+    /**
+     * @brief Starts with the printable ASCII characters and no faces.
+     */
+    GlyphPrewarmer();
+
+    /**
+     * @brief Add a face texts are drawn with.
+     *
+     * @param size Character size.
+     * @param style sf::Text style flags (only Bold changes the glyphs).
+     * @param outline Outline thickness, 0 for none.
+     */
+    void addFace(unsigned int size, uint32_t style = sf::Text::Regular, float outline = 0.f);
+
+    /**
+     * @brief Add the characters of a string (converted like sf::Text converts it).
+     *
+     * @param text Displayable string.
+     */
+    void addText(const sf::String& text);
+
+    /**
+     * @brief Add the characters and faces of map labels.
+     *
+     * @param textObjects Text objects of a map.
+     * @param outline Outline thickness TextRenderer draws labels with.
+     */
+    void addTextObjects(const std::vector<TextObject>& textObjects, float outline);
+
+    /**
+     * @brief Rasterize every face/character combination into a font.
+     *
+     * Glyphs already in the font's cache cost a lookup, so warming again after
+     * adding characters or faces only renders the new combinations.
+     *
+     * @param font Font instance to warm.
+     * @return size_t Number of glyphs requested.
+     */
+    size_t warm(const sf::Font& font) const;
+
+    /**
+     * @brief GPU bytes of the font's glyph pages for the prewarmed character sizes.
+     *
+     * @param font Font instance to measure.
+     * @return size_t Bytes of the page textures (RGBA).
+     */
+    size_t pageBytes(const sf::Font& font) const;
+
+    size_t getFaceCount() const { return faces.size(); }
+    size_t getCharacterCount() const { return characters.size(); }
+
+private:
+    std::set<Face> faces;
+    std::set<char32_t> characters;
+};
@@ -0,0 +1,164 @@
+// MapChunkCache.cpp
+#include "Renderer/MapChunkCache.h"
+#include "Renderer/Renderer.h"
+#include "Renderer/DrawQueue.h"
+#include "MapLoader/TMJMap.h"
+#include "Utils/Logger.h"
+#include "Utils/Arena.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+// Tiled layer names (lowercase) whose tiles count as small props
+const char* const DetailLayerWords[] = {"deco", "dec_", "prop", "plant", "furniture"};
+
+} // namespace
+
+
+bool MapChunkCache::isDetailLayer(const std::string& layerName) {
+    std::string lower = layerName;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    for (const char* word : DetailLayerWords) {
+        if (lower.find(word) != std::string::npos) return true;
+    }
+    return false;
+}
+
+
+size_t MapChunkCache::build(const TMJMap& map, float scale, Renderer& renderer) {
+    const auto start = std::chrono::steady_clock::now();
+    Renderer::RenderThreadPause pause(renderer);
+    clear();
+
+    const int worldW = map.getWorldPixelWidth();
+    const int worldH = map.getWorldPixelHeight();
+    if (worldW <= 0 || worldH <= 0 || scale <= 0.f) return 0;
+
+    columns = (worldW + ChunkPixels - 1) / ChunkPixels;
+    rows = (worldH + ChunkPixels - 1) / ChunkPixels;
+
+    // Stay within the GPU budget (4 bytes per texel, a third more for the mipmaps)
+    const double fullBytes = static_cast<double>(columns) * rows * ChunkPixels * ChunkPixels * 4.0 * 4.0 / 3.0;
+    const double budgetScale = std::sqrt(static_cast<double>(MaxBytes) / fullBytes);
+    texelScale = std::min(scale, static_cast<float>(budgetScale));
+    const unsigned texels = std::max(1u, static_cast<unsigned>(std::ceil(ChunkPixels * texelScale)));
+
+    // Bucket tile indices by the chunks their bounds touch (scratch lists, dropped with the arena)
+    Arena bucketArena("chunk buckets", 64 * 1024);
+    const auto& tiles = map.getTiles();
+    const auto& tileLayers = map.getTileLayers();
+    const auto& layerNames = map.getTileLayerNames();
+    std::vector<bool> detail(layerNames.size());
+    for (size_t i = 0; i < layerNames.size(); ++i) detail[i] = isDetailLayer(layerNames[i]);
+
+    std::pmr::vector<std::pmr::vector<uint32_t>> buckets(static_cast<size_t>(columns) * rows, &bucketArena);
+    size_t skipped = 0;
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        const uint16_t layer = i < tileLayers.size() ? tileLayers[i] : 0;
+        if (layer < detail.size() && detail[layer]) { ++skipped; continue; }
+
+        const sf::FloatRect b = tiles[i].getGlobalBounds();
+        const int cx0 = std::clamp(static_cast<int>(std::floor(b.position.x / ChunkPixels)), 0, columns - 1);
+        const int cy0 = std::clamp(static_cast<int>(std::floor(b.position.y / ChunkPixels)), 0, rows - 1);
+        const int cx1 = std::clamp(static_cast<int>(std::floor((b.position.x + b.size.x) / ChunkPixels)), 0, columns - 1);
+        const int cy1 = std::clamp(static_cast<int>(std::floor((b.position.y + b.size.y) / ChunkPixels)), 0, rows - 1);
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            for (int cx = cx0; cx <= cx1; ++cx) {
+                buckets[static_cast<size_t>(cy) * columns + cx].push_back(static_cast<uint32_t>(i));
+            }
+        }
+    }
+
+    sf::RenderTexture scratch;
+    if (!scratch.resize({texels, texels})) {
+        Logger::error("MapChunkCache: cannot create a " + std::to_string(texels) + "px render texture");
+        columns = rows = 0;
+        return 0;
+    }
+
+    chunks.resize(buckets.size());
+    DrawQueue queue;
+    size_t baked = 0;
+    size_t bytes = 0;
+    for (int cy = 0; cy < rows; ++cy) {
+        for (int cx = 0; cx < columns; ++cx) {
+            const size_t index = static_cast<size_t>(cy) * columns + cx;
+            Chunk& chunk = chunks[index];
+            chunk.bounds = sf::FloatRect(
+                {static_cast<float>(cx * ChunkPixels), static_cast<float>(cy * ChunkPixels)},
+                {static_cast<float>(ChunkPixels), static_cast<float>(ChunkPixels)});
+            if (buckets[index].empty()) continue;
+
+            // Same stacking as MapLoader::render, batched per tileset texture
+            queue.begin();
+            for (uint32_t i : buckets[index]) {
+                const float depth = i < tileLayers.size() ? static_cast<float>(tileLayers[i]) : 0.f;
+                queue.submit(tiles[i], DrawLayer::Ground, depth);
+            }
+            scratch.setView(sf::View(chunk.bounds));
+            scratch.clear(sf::Color::Transparent);
+            queue.flush(scratch);
+            scratch.display();
+
+            chunk.texture = scratch.getTexture();
+            chunk.texture.setSmooth(true);
+            if (!chunk.texture.generateMipmap()) {
+                Logger::warn("MapChunkCache: mipmaps unavailable, zoomed-out chunks may shimmer");
+            }
+            chunk.hasTiles = true;
+            bytes += MemoryTracker::textureBytes(chunk.texture) * 4 / 3;
+            ++baked;
+        }
+    }
+
+    gpuMemory = MemoryCharge("global", MemoryTag::MapTiles, MemoryKind::Gpu);
+    gpuMemory.set(bytes);
+
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    Logger::info("MapChunkCache: baked " + std::to_string(baked) + " chunks of " + std::to_string(texels) +
+                 "px (" + std::to_string(tiles.size() - skipped) + " tiles, " + std::to_string(skipped) +
+                 " detail tiles left out) in " + std::to_string(static_cast<int>(ms)) + " ms");
+    return baked;
+}
+
+
+void MapChunkCache::clear() {
+    chunks.clear();
+    columns = rows = 0;
+    gpuMemory.release();
+}
+
+
+size_t MapChunkCache::render(Renderer& renderer, const sf::FloatRect& view) {
+    if (chunks.empty()) return 0;
+
+    const int cx0 = std::clamp(static_cast<int>(std::floor(view.position.x / ChunkPixels)), 0, columns - 1);
+    const int cy0 = std::clamp(static_cast<int>(std::floor(view.position.y / ChunkPixels)), 0, rows - 1);
+    const int cx1 = std::clamp(static_cast<int>(std::floor((view.position.x + view.size.x) / ChunkPixels)), 0, columns - 1);
+    const int cy1 = std::clamp(static_cast<int>(std::floor((view.position.y + view.size.y) / ChunkPixels)), 0, rows - 1);
+
+    size_t submitted = 0;
+    for (int cy = cy0; cy <= cy1; ++cy) {
+        for (int cx = cx0; cx <= cx1; ++cx) {
+            const Chunk& chunk = chunks[static_cast<size_t>(cy) * columns + cx];
+            if (!chunk.hasTiles) continue;
+
+            const sf::Vector2f a = chunk.bounds.position;
+            const sf::Vector2f c = a + chunk.bounds.size;
+            const sf::Vector2f t(chunk.texture.getSize());
+            const sf::Vertex tl{a, sf::Color::White, {0.f, 0.f}};
+            const sf::Vertex tr{{c.x, a.y}, sf::Color::White, {t.x, 0.f}};
+            const sf::Vertex br{c, sf::Color::White, t};
+            const sf::Vertex bl{{a.x, c.y}, sf::Color::White, {0.f, t.y}};
+            chunkQuad[0] = tl; chunkQuad[1] = tr; chunkQuad[2] = br;
+            chunkQuad[3] = tl; chunkQuad[4] = br; chunkQuad[5] = bl;
+            renderer.submitTriangles(chunkQuad, &chunk.texture, DrawLayer::Ground);
+            ++submitted;
+        }
+    }
+    return submitted;
+}
@@ -0,0 +1,92 @@
+// MapChunkCache.h
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Utils/MemoryTracker.h"
+
+class Renderer;
+class TMJMap;
+
+/*
+ * File: MapChunkCache.h
+ * Description: The map's tiles pre-rendered into downsampled, mipmapped chunk textures.
+ *
+ * Zoomed out, the view covers several times more tiles than at the default
+ * zoom. Instead of submitting each of them, the renderer draws one textured
+ * quad per visible chunk: build() renders the tiles of every ChunkPixels
+ * square once, at texelScale texels per world pixel, and keeps the result as
+ * a mipmapped texture so every zoom below the bake scale samples a matching
+ * level. The cost of a zoomed-out frame is the number of visible chunks,
+ * whatever the tile density.
+ *
+ * Notes:
+ *   - Detail layers (decoration, props, plants, furniture; see isDetailLayer)
+ *     are left out of the bake, so small props disappear once the chunks take over.
+ *   - Animated tiles are baked in their first frame (the frame their sprites
+ *     keep), so tile animations stop while zoomed out. Re-baking a chunk texture
+ *     per frame change would cost more than the chunks save.
+ *   - The bake scale is lowered for very large maps to keep the textures within
+ *     MaxBytes of GPU memory.
+ */
+class MapChunkCache {
+public:
+    static constexpr int ChunkPixels = 1024;              ///< World pixels per chunk side
+    static constexpr size_t MaxBytes = 48 * 1024 * 1024;  ///< GPU budget for all chunk textures
+
+    /**
+     * @brief Bake a map's tiles into chunk textures, replacing any previous bake.
+     *
+     * Suspends the render thread while drawing, since published frames may still
+     * show the previous map's chunks.
+     *
+     * @param map Map to bake.
+     * @param scale Texels per world pixel (the zoom the chunks are used from).
+     * @param renderer Renderer owning the window (for the render-thread pause).
+     * @return Number of chunks that received a texture.
+     */
+    size_t build(const TMJMap& map, float scale, Renderer& renderer);
+
+    /**
+     * @brief Drop all chunk textures.
+     */
+    void clear();
+
+    bool empty() const { return chunks.empty(); }
+
+    /**
+     * @brief Queue one quad per visible chunk on DrawLayer::Ground.
+     *
+     * @param renderer Renderer in its world pass.
+     * @param view Camera rectangle in world coordinates.
+     * @return Number of chunks submitted.
+     */
+    size_t render(Renderer& renderer, const sf::FloatRect& view);
+
+    float getTexelScale() const { return texelScale; }
+    size_t getGpuBytes() const { return gpuMemory.getBytes(); }
+
+    /**
+     * @brief Whether a Tiled layer holds small props left out of the bake (by name).
+     */
+    static bool isDetailLayer(const std::string& layerName);
+
+private:
+    struct Chunk {
+        sf::FloatRect bounds;   // World rectangle covered (a full ChunkPixels square)
+        sf::Texture texture;
+        bool hasTiles = false;
+    };
+
+    std::vector<Chunk> chunks;   // Row-major, columns x rows
+    int columns = 0;
+    int rows = 0;
+    float texelScale = 1.f;
+
+    sf::VertexArray chunkQuad{sf::PrimitiveType::Triangles, 6};
+    MemoryCharge gpuMemory;
+};
@@ -0,0 +1,340 @@
+// ParticleSystem.cpp
+#include "Renderer/ParticleSystem.h"
+#include "Renderer/Renderer.h"
+#include "Jobs/JobSystem.h"
+#include "MapLoader/TMJMap.h"
+#include "Utils/Logger.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+
+/*
+ * File: ParticleSystem.cpp
+ * Description: Effect presets, SoA pool update and emitter spawning.
+ */
+
+namespace {
+    constexpr float SpawnMargin = 128.f;    // Emitters also spawn this far outside the view
+    constexpr float RateBlock = 256.f * 256.f;
+
+    // Pool sizes per effect; rain covers the whole view, the others are local
+    constexpr size_t PoolCapacity[] = {12000, 2000, 1500};
+
+    // Updates run in blocks of this many particles (arrays are padded to a
+    // multiple), so even -O2 turns each block into SIMD instructions
+    constexpr size_t Lanes = 8;
+
+    size_t padded(size_t n) { return (n + Lanes - 1) / Lanes * Lanes; }
+
+    // Blocks of Lanes particles per update job; smaller pools update inline
+    constexpr size_t UpdateGrainBlocks = 256;
+
+    // dst[i] += src[i] * scale over n (a multiple of Lanes); the arrays never overlap
+    void addScaled(float* __restrict dst, const float* __restrict src, float scale, size_t n) {
+        for (size_t i = 0; i < n; i += Lanes) {
+            for (size_t k = 0; k < Lanes; ++k) dst[i + k] += src[i + k] * scale;
+        }
+    }
+
+    // dst[i] += value over n (a multiple of Lanes)
+    void addConstant(float* __restrict dst, float value, size_t n) {
+        for (size_t i = 0; i < n; i += Lanes) {
+            for (size_t k = 0; k < Lanes; ++k) dst[i + k] += value;
+        }
+    }
+
+    uint8_t mixChannel(uint8_t a, uint8_t b, float t) {
+        return static_cast<uint8_t>(static_cast<float>(a) + (static_cast<float>(b) - static_cast<float>(a)) * t);
+    }
+
+    sf::Color mixColor(sf::Color a, sf::Color b, float t) {
+        return sf::Color(mixChannel(a.r, b.r, t), mixChannel(a.g, b.g, t),
+                         mixChannel(a.b, b.b, t), mixChannel(a.a, b.a, t));
+    }
+
+    // Area intersection that also accepts empty emitters (points) lying inside the rectangle
+    std::optional<sf::FloatRect> spawnRegion(const sf::FloatRect& area, const sf::FloatRect& bounds) {
+        if (area.size.x <= 0.f || area.size.y <= 0.f) {
+            if (bounds.contains(area.position)) return area;
+            return std::nullopt;
+        }
+        return area.findIntersection(bounds);
+    }
+}
+
+
+ParticleStyle ParticleStyle::preset(ParticleEffect effect) {
+    ParticleStyle style;
+    switch (effect) {
+        case ParticleEffect::Rain:
+            // Thin fast streaks slanting slightly left
+            style.velocityMin = {-70.f, 620.f};
+            style.velocityMax = {-40.f, 760.f};
+            style.lifeMin = 0.5f;
+            style.lifeMax = 0.9f;
+            style.sizeStart = style.sizeEnd = {1.f, 12.f};
+            style.colorStart = sf::Color(170, 190, 230, 170);
+            style.colorEnd = sf::Color(170, 190, 230, 90);
+            style.defaultRate = 45.f;
+            break;
+        case ParticleEffect::Leaves:
+            // Slow, swaying fall that fades out
+            style.velocityMin = {-20.f, 18.f};
+            style.velocityMax = {20.f, 40.f};
+            style.swayAmplitude = 30.f;
+            style.swayFrequency = 2.2f;
+            style.lifeMin = 4.f;
+            style.lifeMax = 7.f;
+            style.sizeStart = style.sizeEnd = {4.f, 3.f};
+            style.colorStart = sf::Color(204, 140, 58, 230);
+            style.colorEnd = sf::Color(150, 88, 40, 0);
+            style.defaultRate = 0.6f;
+            break;
+        case ParticleEffect::Steam:
+            // Rising puffs that grow and vanish
+            style.velocityMin = {-6.f, -30.f};
+            style.velocityMax = {6.f, -18.f};
+            style.acceleration = {0.f, -6.f};
+            style.swayAmplitude = 6.f;
+            style.swayFrequency = 3.f;
+            style.lifeMin = 1.4f;
+            style.lifeMax = 2.4f;
+            style.sizeStart = {3.f, 3.f};
+            style.sizeEnd = {10.f, 10.f};
+            style.colorStart = sf::Color(255, 255, 255, 110);
+            style.colorEnd = sf::Color(255, 255, 255, 0);
+            style.defaultRate = 6.f;
+            break;
+        default:
+            break;
+    }
+    return style;
+}
+
+
+// ---------------------------------------------------------------- ParticlePool
+
+ParticlePool::ParticlePool(const ParticleStyle& style, size_t capacity)
+    : style(style), capacity(capacity),
+      posX(padded(capacity)), posY(padded(capacity)), velX(padded(capacity)), velY(padded(capacity)),
+      progress(padded(capacity)), progressRate(padded(capacity)), swayPhase(padded(capacity)) {}
+
+
+size_t ParticlePool::spawn(const sf::FloatRect& area, size_t wanted, std::mt19937& rng) {
+    const size_t n = std::min(wanted, capacity - count);
+    if (n == 0) return 0;
+
+    std::uniform_real_distribution<float> x(area.position.x, area.position.x + area.size.x);
+    std::uniform_real_distribution<float> y(area.position.y, area.position.y + area.size.y);
+    std::uniform_real_distribution<float> vx(style.velocityMin.x, style.velocityMax.x);
+    std::uniform_real_distribution<float> vy(style.velocityMin.y, style.velocityMax.y);
+    std::uniform_real_distribution<float> life(style.lifeMin, std::max(style.lifeMin, style.lifeMax));
+    std::uniform_real_distribution<float> phase(0.f, 6.2831853f);
+
+    for (size_t i = count; i < count + n; ++i) {
+        posX[i] = x(rng);
+        posY[i] = y(rng);
+        velX[i] = vx(rng);
+        velY[i] = vy(rng);
+        progress[i] = 0.f;
+        progressRate[i] = 1.f / std::max(life(rng), 0.01f);
+        swayPhase[i] = phase(rng);
+    }
+    count += n;
+    return n;
+}
+
+
+void ParticlePool::update(float dt) {
+    // Jobs take whole blocks, so every chunk stays a multiple of Lanes
+    const size_t blocks = padded(count) / Lanes;   // The padding slots are updated too and never read
+    JobSystem::getInstance().parallelFor(0, blocks, UpdateGrainBlocks, [&](size_t first, size_t last) {
+        integrate(dt, first * Lanes, last * Lanes);
+    });
+
+    // Move the last live particle into every expired slot
+    size_t i = 0;
+    while (i < count) {
+        if (progress[i] < 1.f) {
+            ++i;
+            continue;
+        }
+        const size_t last = --count;
+        posX[i] = posX[last];
+        posY[i] = posY[last];
+        velX[i] = velX[last];
+        velY[i] = velY[last];
+        progress[i] = progress[last];
+        progressRate[i] = progressRate[last];
+        swayPhase[i] = swayPhase[last];
+    }
+}
+
+
+void ParticlePool::integrate(float dt, size_t begin, size_t end) {
+    const size_t n = end - begin;
+    // One branch-free pass per array, so every pass vectorizes
+    addScaled(progress.data() + begin, progressRate.data() + begin, dt, n);
+    addConstant(velX.data() + begin, style.acceleration.x * dt, n);
+    addConstant(velY.data() + begin, style.acceleration.y * dt, n);
+    addScaled(posX.data() + begin, velX.data() + begin, dt, n);
+    addScaled(posY.data() + begin, velY.data() + begin, dt, n);
+
+    if (style.swayAmplitude > 0.f) {
+        const float dPhase = style.swayFrequency * dt;
+        const float sway = style.swayAmplitude * dt;
+        const size_t live = std::min(end, count);
+        for (size_t i = begin; i < live; ++i) {
+            swayPhase[i] += dPhase;
+            posX[i] += std::sin(swayPhase[i]) * sway;
+        }
+    }
+}
+
+
+size_t ParticlePool::buildVertices(const sf::FloatRect& view) {
+    const float margin = std::max({style.sizeStart.x, style.sizeStart.y, style.sizeEnd.x, style.sizeEnd.y});
+    const float left = view.position.x - margin;
+    const float top = view.position.y - margin;
+    const float right = view.position.x + view.size.x + margin;
+    const float bottom = view.position.y + view.size.y + margin;
+
+    const sf::Vector2f uv0(style.textureRect.position);
+    const sf::Vector2f uv1 = uv0 + sf::Vector2f(style.textureRect.size);
+    const sf::Vector2f growth = style.sizeEnd - style.sizeStart;
+
+    vertices.resize(count * 6);
+    size_t written = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const float x = posX[i];
+        const float y = posY[i];
+        if (x < left || x > right || y < top || y > bottom) continue;
+
+        const float t = std::min(progress[i], 1.f);
+        const float hw = (style.sizeStart.x + growth.x * t) * 0.5f;
+        const float hh = (style.sizeStart.y + growth.y * t) * 0.5f;
+        const sf::Color color = mixColor(style.colorStart, style.colorEnd, t);
+
+        const sf::Vertex tl{{x - hw, y - hh}, color, uv0};
+        const sf::Vertex tr{{x + hw, y - hh}, color, {uv1.x, uv0.y}};
+        const sf::Vertex br{{x + hw, y + hh}, color, uv1};
+        const sf::Vertex bl{{x - hw, y + hh}, color, {uv0.x, uv1.y}};
+
+        const size_t v = written * 6;
+        vertices[v] = tl;
+        vertices[v + 1] = tr;
+        vertices[v + 2] = br;
+        vertices[v + 3] = tl;
+        vertices[v + 4] = br;
+        vertices[v + 5] = bl;
+        ++written;
+    }
+    vertices.resize(written * 6);
+    return written;
+}
+
+
+// ---------------------------------------------------------------- ParticleSystem
+
+ParticleSystem::ParticleSystem() {
+    pools.reserve(static_cast<size_t>(ParticleEffect::Count));
+    for (size_t i = 0; i < static_cast<size_t>(ParticleEffect::Count); ++i) {
+        pools.emplace_back(ParticleStyle::preset(static_cast<ParticleEffect>(i)), PoolCapacity[i]);
+    }
+}
+
+
+void ParticleSystem::loadFromMap(const TMJMap& map) {
+    clear();
+
+    for (const auto& area : map.getEffectAreas()) {
+        auto effect = effectFromName(area.effect);
+        if (!effect) {
+            Logger::warn("Unknown particle effect '" + area.effect + "' on the effects layer");
+            continue;
+        }
+        addEmitter(*effect, area.rect, area.rate);
+    }
+
+    // Steam rising from the served food
+    for (const auto& anchor : map.getFoodAnchors()) {
+        addEmitter(ParticleEffect::Steam, sf::FloatRect(anchor.position - sf::Vector2f(6.f, 4.f), {12.f, 4.f}));
+    }
+
+    if (!emitters.empty()) {
+        Logger::info("Particles: " + std::to_string(emitters.size()) + " emitters");
+    }
+}
+
+
+void ParticleSystem::addEmitter(ParticleEffect effect, const sf::FloatRect& area, float rate) {
+    Emitter emitter;
+    emitter.effect = effect;
+    emitter.area = area;
+    emitter.rate = rate;
+    if (emitter.rate <= 0.f) {
+        const float blocks = std::max(1.f, area.size.x * area.size.y / RateBlock);
+        emitter.rate = ParticleStyle::preset(effect).defaultRate * blocks;
+    }
+    emitters.push_back(emitter);
+}
+
+
+void ParticleSystem::clear() {
+    emitters.clear();
+    for (auto& pool : pools) pool.clear();
+    visibleCount = 0;
+}
+
+
+void ParticleSystem::update(float dt, const sf::FloatRect& view) {
+    if (dt <= 0.f) return;
+
+    const sf::FloatRect nearView(view.position - sf::Vector2f(SpawnMargin, SpawnMargin),
+                             view.size + sf::Vector2f(2.f * SpawnMargin, 2.f * SpawnMargin));
+    for (auto& emitter : emitters) {
+        auto region = spawnRegion(emitter.area, nearView);
+        if (!region) {
+            emitter.pending = 0.f;
+            continue;
+        }
+
+        // Only the share of the area near the view spawns, at the same density
+        const float areaSize = emitter.area.size.x * emitter.area.size.y;
+        const float share = areaSize > 0.f ? region->size.x * region->size.y / areaSize : 1.f;
+        emitter.pending += emitter.rate * share * dt;
+        const size_t wanted = static_cast<size_t>(emitter.pending);
+        emitter.pending -= static_cast<float>(wanted);
+        if (wanted > 0) getPool(emitter.effect).spawn(*region, wanted, rng);
+    }
+
+    for (auto& pool : pools) pool.update(dt);
+}
+
+
+void ParticleSystem::render(Renderer& renderer, const sf::FloatRect& view) {
+    visibleCount = 0;
+    for (auto& pool : pools) {
+        if (pool.size() == 0) continue;
+        visibleCount += pool.buildVertices(view);
+        renderer.submitTriangles(pool.getVertices(), pool.getStyle().texture, DrawLayer::Effects);
+    }
+}
+
+
+size_t ParticleSystem::getParticleCount() const {
+    size_t total = 0;
+    for (const auto& pool : pools) total += pool.size();
+    return total;
+}
+
+
+std::optional<ParticleEffect> ParticleSystem::effectFromName(const std::string& name) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (lower == "rain") return ParticleEffect::Rain;
+    if (lower == "leaves" || lower == "leaf") return ParticleEffect::Leaves;
+    if (lower == "steam") return ParticleEffect::Steam;
+    return std::nullopt;
+}
@@ -0,0 +1,217 @@
+// ParticleSystem.h
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+class Renderer;
+class TMJMap;
+
+/*
+ * File: ParticleSystem.h
+ * Description: Pooled particles for weather and ambient effects (rain, leaves, steam).
+ *
+ * Every effect owns a ParticlePool of fixed capacity that stores its particles
+ * as a structure of arrays: positions, velocities and life progress live in
+ * separate float arrays, so the per-frame update is a few straight loops the
+ * compiler can vectorize. Expired particles are replaced by the last live one,
+ * so nothing is allocated after construction.
+ *
+ * Emitters spawn into a pool over a world rectangle at a rate per second. They
+ * only spawn into the part of their area near the view, and only particles in
+ * the view become vertices; each pool is drawn as one vertex array, i.e. one
+ * draw call per texture.
+ *
+ * Important classes:
+ *   - ParticleStyle: motion, size, color and lifetime of an effect.
+ *   - ParticlePool: fixed-capacity SoA storage, update and vertex building.
+ *   - ParticleSystem: one pool per effect plus the emitters of the current map.
+ *
+ * Notes:
+ *   - Emitters come from an "effects" object layer (see EffectArea) and from
+ *     code; loadFromMap also puts steam above every FoodAnchor.
+ *   - A full pool drops new spawns instead of growing.
+ */
+
+/**
+ * @enum ParticleEffect
+ * @brief Built-in effects; each has its own pool and style.
+ */
+enum class ParticleEffect : uint8_t {
+    Rain,
+    Leaves,
+    Steam,
+    Count
+};
+
+/**
+ * @struct ParticleStyle
+ * @brief Look and motion shared by all particles of a pool.
+ */
+struct ParticleStyle {
+    sf::Vector2f velocityMin;            ///< Spawn velocity range, px/s
+    sf::Vector2f velocityMax;
+    sf::Vector2f acceleration;           ///< Gravity or buoyancy, px/s^2
+    float swayAmplitude = 0.f;           ///< Sideways drift, px/s (0 = none)
+    float swayFrequency = 0.f;           ///< Sway speed, rad/s
+    float lifeMin = 1.f;                 ///< Lifetime range, s
+    float lifeMax = 1.f;
+    sf::Vector2f sizeStart{2.f, 2.f};    ///< Quad size at spawn and at death, px
+    sf::Vector2f sizeEnd{2.f, 2.f};
+    sf::Color colorStart = sf::Color::White;
+    sf::Color colorEnd = sf::Color::White;
+    float defaultRate = 1.f;             ///< Spawns per second per 256x256 px of emitter area
+    const sf::Texture* texture = nullptr;   ///< nullptr draws flat colored quads
+    sf::IntRect textureRect;
+
+    /**
+     * @brief Style of a built-in effect.
+     */
+    static ParticleStyle preset(ParticleEffect effect);
+};
+
+/*
+ * Class: ParticlePool
+ * Description: Fixed-capacity particles of one style, stored as a structure of arrays.
+ */
+class ParticlePool {
+public:
+    ParticlePool(const ParticleStyle& style, size_t capacity);
+
+    /**
+     * @brief Spawn particles at random positions inside an area.
+     *
+     * @param area World rectangle to spawn in.
+     * @param count Particles wanted.
+     * @param rng Random source.
+     * @return Number spawned (fewer than count once the pool is full).
+     */
+    size_t spawn(const sf::FloatRect& area, size_t count, std::mt19937& rng);
+
+    /**
+     * @brief Age, accelerate and move every particle, then drop the expired ones.
+     *
+     * Large pools integrate in parallel chunks on the JobSystem; dropping the
+     * expired particles stays on the calling thread.
+     *
+     * @param dt Elapsed time in seconds.
+     */
+    void update(float dt);
+
+    /**
+     * @brief Rebuild the vertex array from the particles inside a rectangle.
+     *
+     * @param view World rectangle to keep (usually the camera view).
+     * @return Number of particles written.
+     */
+    size_t buildVertices(const sf::FloatRect& view);
+
+    void clear() { count = 0; }
+
+    const ParticleStyle& getStyle() const { return style; }
+    const sf::VertexArray& getVertices() const { return vertices; }
+    size_t size() const { return count; }
+    size_t getCapacity() const { return capacity; }
+
+private:
+    // Integrates particles [begin, end); both are multiples of the SIMD block size
+    void integrate(float dt, size_t begin, size_t end);
+
+    ParticleStyle style;
+    size_t capacity;
+    size_t count = 0;
+
+    // One entry per live particle in [0, count)
+    std::vector<float> posX, posY;
+    std::vector<float> velX, velY;
+    std::vector<float> progress;       // 0 at spawn, expired at 1
+    std::vector<float> progressRate;   // 1 / lifetime
+    std::vector<float> swayPhase;
+
+    sf::VertexArray vertices{sf::PrimitiveType::Triangles};
+};
+
+/*
+ * Class: ParticleSystem
+ * Description: One pool per ParticleEffect and the emitters feeding them.
+ */
+class ParticleSystem {
+public:
+    /**
+     * @struct Emitter
+     * @brief Spawns one effect over a world rectangle.
+     */
+    struct Emitter {
+        ParticleEffect effect = ParticleEffect::Rain;
+        sf::FloatRect area;
+        float rate = 0.f;       ///< Spawns per second over the whole area
+        float pending = 0.f;    ///< Fraction of a spawn carried to the next frame
+    };
+
+    ParticleSystem();
+
+    /**
+     * @brief Replace the emitters with the ones of a map and drop all particles.
+     *
+     * Adds an emitter per "effects" object, and steam above every FoodAnchor.
+     *
+     * @param map Newly entered map.
+     */
+    void loadFromMap(const TMJMap& map);
+
+    /**
+     * @brief Add an emitter from code.
+     *
+     * @param effect Effect to spawn.
+     * @param area World rectangle to spawn in.
+     * @param rate Spawns per second over the whole area; <= 0 uses the effect's default density.
+     */
+    void addEmitter(ParticleEffect effect, const sf::FloatRect& area, float rate = 0.f);
+
+    /**
+     * @brief Remove all emitters and particles.
+     */
+    void clear();
+
+    /**
+     * @brief Spawn near the view and advance every particle.
+     *
+     * @param dt Elapsed time in seconds.
+     * @param view Camera rectangle in world coordinates.
+     */
+    void update(float dt, const sf::FloatRect& view);
+
+    /**
+     * @brief Queue the particles inside the view for the world pass, one call per pool.
+     *
+     * @param renderer Renderer in its world pass.
+     * @param view Camera rectangle in world coordinates.
+     */
+    void render(Renderer& renderer, const sf::FloatRect& view);
+
+    ParticlePool& getPool(ParticleEffect effect) { return pools[static_cast<size_t>(effect)]; }
+    const std::vector<Emitter>& getEmitters() const { return emitters; }
+
+    size_t getParticleCount() const;
+
+    /**
+     * @brief Particles drawn by the last render().
+     */
+    size_t getVisibleCount() const { return visibleCount; }
+
+    /**
+     * @brief Effect for a TMJ name ("rain", "leaves", "steam"), case-insensitive.
+     */
+    static std::optional<ParticleEffect> effectFromName(const std::string& name);
+
+private:
+    std::vector<ParticlePool> pools;   // Indexed by ParticleEffect
+    std::vector<Emitter> emitters;
+    std::mt19937 rng{0x5EEDu};
+    size_t visibleCount = 0;
+};
@@ -0,0 +1,90 @@
+// QualityGovernor.cpp
+#include "Renderer/QualityGovernor.h"
+#include <algorithm>
+#include <numeric>
+
+/*
+ * File: QualityGovernor.cpp
+ * Description: Quality level table and the step down / step up hysteresis.
+ */
+
+namespace {
+    // Level 0 is full quality; each level keeps the savings of the previous one.
+    const QualitySettings Levels[] = {
+        {true,  true,  1, true,  1.00f},
+        {false, true,  1, true,  1.00f},
+        {false, false, 1, true,  1.00f},
+        {false, false, 2, true,  1.00f},
+        {false, false, 2, false, 1.00f},
+        {false, false, 2, false, 0.75f},
+        {false, false, 2, false, 0.50f},
+    };
+    constexpr int LevelCount = static_cast<int>(sizeof(Levels) / sizeof(Levels[0]));
+
+    const char* const LevelNames[LevelCount] = {
+        "full quality",
+        "no label outlines",
+        "no trigger overlays",
+        "animations every other frame",
+        "night overlay in world pass",
+        "world scale 0.75",
+        "world scale 0.5",
+    };
+
+    constexpr size_t WindowFrames = 30;        // Samples averaged per decision
+    constexpr double HeadroomFactor = 0.6;     // Step up when average < 60% of budget...
+    constexpr size_t HeadroomFrames = 180;     // ...for this many consecutive frames
+}
+
+
+void QualityGovernor::configure(int targetFPS, bool governorEnabled) {
+    enabled = governorEnabled;
+    budgetMs = 1000.0 / std::max(1, targetFPS);
+    level = 0;
+    samples.clear();
+    samples.reserve(WindowFrames);
+    headroomFrames = 0;
+    lastAverageMs = 0.0;
+}
+
+
+int QualityGovernor::getLevelCount() {
+    return LevelCount;
+}
+
+
+const QualitySettings& QualityGovernor::getSettings() const {
+    return Levels[level];
+}
+
+
+const char* QualityGovernor::describeLevel(int index) {
+    return LevelNames[std::clamp(index, 0, LevelCount - 1)];
+}
+
+
+bool QualityGovernor::recordFrame(double workMs) {
+    if (!enabled) return false;
+
+    samples.push_back(workMs);
+    if (samples.size() < WindowFrames) return false;
+
+    const double average = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+    samples.clear();
+
+    if (average > budgetMs && level + 1 < LevelCount) {
+        ++level;
+        headroomFrames = 0;
+        lastAverageMs = average;
+        return true;
+    }
+
+    headroomFrames = average < budgetMs * HeadroomFactor ? headroomFrames + WindowFrames : 0;
+    if (headroomFrames >= HeadroomFrames && level > 0) {
+        --level;
+        headroomFrames = 0;
+        lastAverageMs = average;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,80 @@
+// QualityGovernor.h
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/*
+ * File: QualityGovernor.h
+ * Description: Trades optional rendering costs for frame time when a machine can't keep up.
+ *
+ * The governor watches the work time of recent frames (update plus drawing,
+ * without pacing waits) against the frame budget 1000 / targetFPS. While the
+ * average is over budget it steps down one quality level at a time, in this
+ * order:
+ *   1. label outlines (TextRenderer draws one extra copy per label)
+ *   2. trigger overlays
+ *   3. animation updates (tile animations and particles advance every other
+ *      frame, by the time of both)
+ *   4. night overlay drawn into the low-res world pass instead of full screen
+ *   5. world render-target scale 0.75, then 0.5
+ * It steps back up only after a longer stretch well under budget, and waits
+ * for a full window of new samples after every change, so levels don't flap.
+ */
+
+/**
+ * @struct QualitySettings
+ * @brief Optional rendering costs enabled at a quality level.
+ */
+struct QualitySettings {
+    bool labelOutlines = true;          ///< Outline copies behind map labels
+    bool triggerOverlays = true;        ///< Highlighted entrance/game/shop areas
+    int animationStride = 1;            ///< Frames per tile animation and particle update
+    bool screenNightOverlay = true;     ///< Night tint at window resolution (else in the world pass)
+    float worldScale = 1.f;             ///< World render-target resolution multiplier
+};
+
+class QualityGovernor {
+public:
+    /**
+     * @brief Reset to full quality.
+     *
+     * @param targetFPS Frame rate whose period is the budget.
+     * @param enabled false keeps full quality regardless of frame times.
+     */
+    void configure(int targetFPS, bool enabled);
+
+    /**
+     * @brief Account the work time of one drawn frame.
+     *
+     * @param workMs Update and drawing time of the frame.
+     * @return true if the quality level changed.
+     */
+    bool recordFrame(double workMs);
+
+    int getLevel() const { return level; }
+    static int getLevelCount();
+
+    const QualitySettings& getSettings() const;
+
+    /**
+     * @brief Short description of what a level turns off (for logs).
+     *
+     * @param level Quality level, 0 = full quality.
+     * @return const char* Description.
+     */
+    static const char* describeLevel(int level);
+
+    /**
+     * @brief Average work time of the window that triggered the last change.
+     */
+    double getLastAverageMs() const { return lastAverageMs; }
+
+private:
+    bool enabled = true;
+    double budgetMs = 1000.0 / 60.0;
+    int level = 0;
+    std::vector<double> samples;
+    size_t headroomFrames = 0;
+    double lastAverageMs = 0.0;
+};
@@ -0,0 +1,131 @@
+// RenderBackend.h
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * File: RenderBackend.h
+ * Description: Minimal drawing interface the world pass is flushed into.
+ *
+ * DrawQueue::flush emits sorted, batched geometry through this interface, so the
+ * same command stream can go to an SFML render target (window or world texture)
+ * or to the CPU rasterizer used for headless rendering tests and benchmarks.
+ *
+ * Important types:
+ *   - DrawBlend: how triangles are combined with what is already drawn.
+ *   - RenderBackend: abstract sink for triangles, text, rectangles and drawables.
+ *   - SfmlRenderBackend: forwards everything to an sf::RenderTarget.
+ */
+
+/**
+ * @enum DrawBlend
+ * @brief Blending of triangle geometry with the target.
+ */
+enum class DrawBlend : uint8_t {
+    Alpha,    ///< Straight alpha blending (sf::BlendAlpha)
+    Darken    ///< Scale the target by one minus the source color (baked lightmaps)
+};
+
+/*
+ * Class: RenderBackend
+ * Description: Abstract destination for world-pass draw commands.
+ */
+class RenderBackend {
+public:
+    virtual ~RenderBackend() = default;
+
+    /**
+     * @brief Set the view used to map world coordinates to pixels.
+     *
+     * @param view View to apply to subsequent draws.
+     */
+    virtual void setView(const sf::View& view) = 0;
+
+    /**
+     * @brief Fill the whole target with a color.
+     *
+     * @param color Clear color.
+     */
+    virtual void clear(sf::Color color) = 0;
+
+    /**
+     * @brief Draw a triangle list in world coordinates.
+     *
+     * @param vertices First vertex (three per triangle).
+     * @param count Number of vertices.
+     * @param texture Texture to sample (texCoords in pixels), or nullptr for flat color.
+     * @param shader Optional shader; backends without shader support ignore it.
+     * @param blend How the triangles are combined with the target.
+     */
+    virtual void drawTriangles(
+        const sf::Vertex* vertices,
+        std::size_t count,
+        const sf::Texture* texture,
+        const sf::Shader* shader,
+        DrawBlend blend
+    ) = 0;
+
+    /**
+     * @brief Draw a text (fill and outline).
+     *
+     * @param text Text to draw.
+     */
+    virtual void drawText(const sf::Text& text) = 0;
+
+    /**
+     * @brief Draw an axis-aligned rectangle shape (fill and outline).
+     *
+     * @param rect Rectangle to draw.
+     */
+    virtual void drawRect(const sf::RectangleShape& rect) = 0;
+
+    /**
+     * @brief Draw any other SFML drawable. Backends that cannot may skip it.
+     *
+     * @param drawable Drawable to draw.
+     */
+    virtual void drawDrawable(const sf::Drawable& drawable) = 0;
+};
+
+/*
+ * Class: SfmlRenderBackend
+ * Description: RenderBackend that draws straight into an SFML render target.
+ */
+class SfmlRenderBackend final : public RenderBackend {
+public:
+    explicit SfmlRenderBackend(sf::RenderTarget& renderTarget) : target(renderTarget) {}
+
+    void setView(const sf::View& view) override { target.setView(view); }
+
+    void clear(sf::Color color) override { target.clear(color); }
+
+    void drawTriangles(
+        const sf::Vertex* vertices,
+        std::size_t count,
+        const sf::Texture* texture,
+        const sf::Shader* shader,
+        DrawBlend blend
+    ) override {
+        sf::RenderStates states;
+        states.texture = texture;
+        states.shader = shader;
+        if (blend == DrawBlend::Darken) {
+            // rgb = dst * (1 - src), alpha untouched (world textures are composited later)
+            using F = sf::BlendMode::Factor;
+            states.blendMode = sf::BlendMode(F::Zero, F::OneMinusSrcColor, sf::BlendMode::Equation::Add,
+                                             F::Zero, F::One, sf::BlendMode::Equation::Add);
+        }
+        target.draw(vertices, count, sf::PrimitiveType::Triangles, states);
+    }
+
+    void drawText(const sf::Text& text) override { target.draw(text); }
+
+    void drawRect(const sf::RectangleShape& rect) override { target.draw(rect); }
+
+    void drawDrawable(const sf::Drawable& drawable) override { target.draw(drawable); }
+
+private:
+    sf::RenderTarget& target;
+};
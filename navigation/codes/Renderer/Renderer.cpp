@@ -1,8 +1,10 @@
 // Renderer.cpp
 #include "Renderer/Renderer.h"
+#include "MapLoader/TMJMap.h"
 #include "Utils/Logger.h"
 #include <SFML/Graphics.hpp>
 #include <cmath>
+#include <cstring>
 #include <algorithm>
 #include <fstream>
 #include <nlohmann/json.hpp>
@@ -53,6 +55,116 @@ namespace {
         // Apply the new clamped center to the view
         view.setCenter(center);
     }
+
+    // Append two triangles covering [l,r]x[t,b] in a single color.
+    void appendQuad(std::pmr::vector<sf::Vertex>& va, float l, float t, float r, float b, sf::Color color) {
+        va.push_back({{l, t}, color});
+        va.push_back({{r, t}, color});
+        va.push_back({{r, b}, color});
+        va.push_back({{l, t}, color});
+        va.push_back({{r, b}, color});
+        va.push_back({{l, b}, color});
+    }
+
+    // Append the same geometry sf::RectangleShape would produce: fill, then an outline
+    // band that grows outwards for positive thickness and inwards for negative.
+    void appendOverlayRect(
+        std::pmr::vector<sf::Vertex>& va,
+        const sf::FloatRect& rect,
+        sf::Color fill,
+        sf::Color outline,
+        float thickness
+    ) {
+        const float l = rect.position.x;
+        const float t = rect.position.y;
+        const float r = l + rect.size.x;
+        const float b = t + rect.size.y;
+        appendQuad(va, l, t, r, b, fill);
+
+        if (thickness == 0.f) return;
+        const float grow = std::max(thickness, 0.f);
+        const float shrink = std::max(-thickness, 0.f);
+        const float ol = l - grow, ot = t - grow, orr = r + grow, ob = b + grow;
+        const float il = l + shrink, it = t + shrink, ir = r - shrink, ib = b - shrink;
+
+        appendQuad(va, ol, ot, orr, it, outline);  // top
+        appendQuad(va, ol, ib, orr, ob, outline);  // bottom
+        appendQuad(va, ol, it, il, ib, outline);   // left
+        appendQuad(va, ir, it, orr, ib, outline);  // right
+    }
+
+    // Frame pacing: an unchanged frame is still redrawn this often, and idle
+    // waits poll for input at this granularity.
+    constexpr std::chrono::seconds IdleRedrawInterval{1};
+    constexpr std::chrono::milliseconds InputPollSlice{2};
+
+    // Camera zoom: factor per wheel notch, and how fast the zoom eases in (1/s)
+    constexpr float ZoomStep = 1.1f;
+    constexpr float ZoomEaseRate = 12.f;
+
+    // Digest of everything a snapshot would put on screen.
+    uint64_t snapshotDigest(const FrameSnapshot& frame) {
+        const sf::View& v = frame.worldView;
+        const sf::FloatRect viewport = v.getViewport();
+        const float camera[] = {
+            v.getCenter().x, v.getCenter().y, v.getSize().x, v.getSize().y, v.getRotation().asDegrees(),
+            viewport.position.x, viewport.position.y, viewport.size.x, viewport.size.y
+        };
+
+        uint64_t h = frame.world.getDigest() ^ (frame.ui.getDigest() * 0x9E3779B97F4A7C15ull);
+        for (float f : camera) {
+            uint32_t bits;
+            std::memcpy(&bits, &f, sizeof(bits));
+            h = (h ^ bits) * 0x100000001B3ull;
+        }
+        return (h ^ frame.clearColor.toInteger()) * 0x100000001B3ull;
+    }
+
+    // SFML backend for the render thread: texts are redrawn with the render
+    // thread's own copy of their font, everything else is forwarded unchanged.
+    // Without a font table (inline drawing) texts are forwarded as well.
+    class RenderThreadBackend final : public RenderBackend {
+    public:
+        RenderThreadBackend(
+            sf::RenderTarget& target,
+            const std::unordered_map<const sf::Font*, std::unique_ptr<sf::Font>>* threadFonts
+        ) : inner(target), fonts(threadFonts) {}
+
+        void setView(const sf::View& view) override { inner.setView(view); }
+        void clear(sf::Color color) override { inner.clear(color); }
+        void drawTriangles(
+            const sf::Vertex* vertices,
+            std::size_t count,
+            const sf::Texture* texture,
+            const sf::Shader* shader,
+            DrawBlend blend
+        ) override {
+            inner.drawTriangles(vertices, count, texture, shader, blend);
+        }
+        void drawRect(const sf::RectangleShape& rect) override { inner.drawRect(rect); }
+        void drawDrawable(const sf::Drawable& drawable) override { inner.drawDrawable(drawable); }
+
+        void drawText(const sf::Text& text) override {
+            if (!fonts) {
+                inner.drawText(text);
+                return;
+            }
+            auto it = fonts->find(&text.getFont());
+            if (it == fonts->end()) {
+                ++skippedTexts;
+                return;
+            }
+            sf::Text local = text;
+            local.setFont(*it->second);
+            inner.drawText(local);
+        }
+
+        size_t skippedTexts = 0;
+
+    private:
+        SfmlRenderBackend inner;
+        const std::unordered_map<const sf::Font*, std::unique_ptr<sf::Font>>* fonts;
+    };
 }
 
 
@@ -95,7 +207,75 @@ bool Renderer::initialize(
     // Store the provided configurations
     currentAppConfig = appConfig;
     currentRenderConfig = renderConfig;
-    // Attempt to read optional render style overrides from config/render_config.json
+    // Read optional render style overrides from config/render_config.json
+    loadStyleOverrides();
+    
+    // Calculate window dimensions with maximum limits
+    const int winW = std::min(appConfig.window.width, 1200);
+    const int winH = std::min(appConfig.window.height, 800);
+    
+    try {
+        // Create SFML window with calculated dimensions
+        window.create(
+            sf::VideoMode({
+                static_cast<unsigned int>(winW), 
+                static_cast<unsigned int>(winH)
+            }), 
+            appConfig.window.title
+        );
+        
+        // Check if window creation was successful
+        if (!window.isOpen()) {
+            Logger::error("Failed to create SFML window");
+            return false;
+        }
+        
+    } catch (const std::exception& e) {
+        // Log any exceptions during window creation
+        Logger::error("Exception creating window: " + std::string(e.what()));
+        return false;
+    }
+    
+    // Set frame rate limit from configuration
+    window.setFramerateLimit(appConfig.performance.targetFPS);
+    
+    // Initialize the game view
+    const float tilesW = 40.f, tilesH = 40.f;
+    const float viewW = tilesW * 16; // Assuming default tile width of 16 pixels
+    const float viewH = tilesH * 16; // Assuming default tile height of 16 pixels
+    
+    // Create and set the initial view
+    view = sf::View(sf::Vector2f(viewW * 0.5f, viewH * 0.5f), sf::Vector2f(viewW, viewH));
+    window.setView(view);
+    configureZoom(view.getSize());
+
+    // Initialize text renderer with font from config
+    if (!textRenderer->initialize(renderConfig.text.fontPath)) {
+        Logger::warn("Failed to initialize text renderer, building names will not be displayed");
+    }
+    // Also load a UI font for button rendering (fallback to same font)
+    uiFont = std::make_unique<sf::Font>();
+    if (!uiFont->openFromFile(renderConfig.text.fontPath)) {
+        Logger::warn("UI font not found at " + renderConfig.text.fontPath);
+    } else {
+        registerFont(*uiFont, renderConfig.text.fontPath);
+    }
+    if (const sf::Font* labelFont = textRenderer->getFont()) {
+        registerFont(*labelFont, renderConfig.text.fontPath);
+    }
+
+    return true;
+    
+    // Log successful initialization
+    Logger::info("Renderer initialized successfully");
+    return true;
+}
+
+
+/**
+ * Reads optional entrance/game trigger style overrides from config/render_config.json.
+ */
+void Renderer::loadStyleOverrides() {
     try {
         std::string cfgPath = currentAppConfig.paths.configDirectory + "render_config.json";
         std::ifstream ifs(cfgPath);
@@ -148,69 +328,94 @@ bool Renderer::initialize(
     } catch (const std::exception& ex) {
         Logger::warn(std::string("Renderer: failed to parse render_config.json: ") + ex.what());
     }
-    
-    // Calculate window dimensions with maximum limits
-    const int winW = std::min(appConfig.window.width, 1200);
-    const int winH = std::min(appConfig.window.height, 800);
-    
-    try {
-        // Create SFML window with calculated dimensions
-        window.create(
-            sf::VideoMode({
-                static_cast<unsigned int>(winW), 
-                static_cast<unsigned int>(winH)
-            }), 
-            appConfig.window.title
-        );
-        
-        // Check if window creation was successful
-        if (!window.isOpen()) {
-            Logger::error("Failed to create SFML window");
-            return false;
-        }
-        
-    } catch (const std::exception& e) {
-        // Log any exceptions during window creation
-        Logger::error("Exception creating window: " + std::string(e.what()));
+}
+
+
+/**
+ * Initializes a windowless renderer that rasterizes the world pass on the CPU.
+ * @param appConfig The application configuration settings.
+ * @param renderConfig The rendering configuration settings.
+ * @param frameSize Size of the in-memory frame in pixels.
+ * @return True if initialization succeeded, false otherwise.
+ */
+bool Renderer::initializeHeadless(
+    const AppConfig& appConfig,
+    const RenderConfig& renderConfig,
+    sf::Vector2u frameSize
+) {
+    Logger::info("Initializing headless Renderer");
+
+    if (frameSize.x == 0 || frameSize.y == 0) {
+        Logger::error("Headless renderer needs a non-empty frame size");
         return false;
     }
-    
-    // Set frame rate limit from configuration
-    window.setFramerateLimit(appConfig.performance.targetFPS);
-    
-    // Initialize the game view
-    const float tilesW = 40.f, tilesH = 40.f;
-    const float viewW = tilesW * 16; // Assuming default tile width of 16 pixels
-    const float viewH = tilesH * 16; // Assuming default tile height of 16 pixels
-    
-    // Create and set the initial view
-    view = sf::View(sf::Vector2f(viewW * 0.5f, viewH * 0.5f), sf::Vector2f(viewW, viewH));
-    window.setView(view);
 
-    // Initialize text renderer with font from config
+    currentAppConfig = appConfig;
+    currentRenderConfig = renderConfig;
+    loadStyleOverrides();
+
+    softwareBackend = std::make_unique<SoftwareRenderBackend>(frameSize);
+
+    // One world pixel per frame pixel, like the low-res world texture
+    const sf::Vector2f viewSize(static_cast<float>(frameSize.x), static_cast<float>(frameSize.y));
+    view = sf::View(viewSize * 0.5f, viewSize);
+    configureZoom(viewSize);
+
+    // Glyph metrics would need OpenGL; lay labels out with the bitmap font instead
+    textRenderer->setApproximateMetrics(true);
     if (!textRenderer->initialize(renderConfig.text.fontPath)) {
         Logger::warn("Failed to initialize text renderer, building names will not be displayed");
     }
-    // Also load a UI font for button rendering (fallback to same font)
-    uiFont = std::make_unique<sf::Font>();
-    if (!uiFont->openFromFile(renderConfig.text.fontPath)) {
-        Logger::warn("UI font not found at " + renderConfig.text.fontPath);
-    }
 
-    return true;
-    
-    // Log successful initialization
-    Logger::info("Renderer initialized successfully");
+    running = true;
+    Logger::info("Headless renderer " + std::to_string(frameSize.x) + "x" + std::to_string(frameSize.y));
     return true;
 }
 
 
+/**
+ * Registers the CPU tileset images of a headless map with the software backend.
+ * @param map Map loaded with TMJMap::setHeadless(true).
+ */
+void Renderer::registerMapTextures(const TMJMap& map) {
+    if (!softwareBackend) return;
+    for (const auto& ts : map.getTilesets()) {
+        if (ts.image.getSize().x == 0) continue;
+        softwareBackend->registerTexture(&ts.texture, &ts.image);
+    }
+    const Lightmap& lightmap = map.getLightmap();
+    for (size_t i = 0; i < lightmap.getTextureCount(); ++i) {
+        const int index = static_cast<int>(i);
+        softwareBackend->registerTexture(&lightmap.getTexture(index), &lightmap.getImage(index));
+    }
+}
+
+
+/**
+ * Loads an NPC sprite sheet to the GPU, or to a CPU image in headless mode.
+ * @param path Image file path.
+ * @param texture Texture the NPC sprite will reference.
+ * @param image Image that receives the pixels in headless mode.
+ * @return True if the sheet was loaded.
+ */
+bool Renderer::loadActorTexture(const std::string& path, sf::Texture& texture, sf::Image& image) {
+    if (!softwareBackend) {
+        return texture.loadFromFile(path);
+    }
+    if (!image.loadFromFile(path)) return false;
+    softwareBackend->registerTexture(&texture, &image);
+    return true;
+}
+
 /**
  * Cleans up renderer resources and closes the window.
  */
 void Renderer::cleanup() {
     // Log cleanup process
     Logger::debug("Cleaning up Renderer resources");
+
+    // The render thread may still reference the textures released below
+    stopFramePacing();
     
     // Clear all loaded textures (SFML textures auto-manage memory)
     for (auto& texture : loadedTextures) {
@@ -223,6 +428,8 @@ void Renderer::cleanup() {
     
     m_professorTexture = sf::Texture(); 
     m_professorSprite.reset(); 
+
+    softwareBackend.reset();
     
     // Close the window if it's open
     if (window.isOpen()) {
@@ -242,7 +449,7 @@ void Renderer::handleEvents() {
     if (!window.isOpen()) return;
     
     // Process all pending events
-    while (const std::optional event = window.pollEvent())
+    while (const std::optional event = pollEvent())
     {
         // Forward event handling for UI buttons could be added here if desired.
     // Handle window close event
@@ -265,10 +472,11 @@ void Renderer::handleEvents() {
         if (const auto* resized = event->getIf<sf::Event::Resized>())
         {
             // Update view size to match new window dimensions
-            view.setSize({
+            baseViewSize = {
                 static_cast<float>(resized->size.x),
                 static_cast<float>(resized->size.y)
-            });
+            };
+            view.setSize(baseViewSize / zoom);
             window.setView(view);
         }
 
@@ -318,27 +526,727 @@ void Renderer::handleEvents() {
  * Clears the window with the configured clear color.
  */
 void Renderer::clear() {
+    // The render thread clears with the snapshot's color itself
+    if (recordsSnapshots()) return;
+
     // Return early if window is not open
     if (!window.isOpen()) return;
     
-    // Get clear color from configuration and convert to SFML color
-    const auto& clearColor = currentRenderConfig.clearColor;
+    window.clear(clearColorValue());
+}
+
 
-    window.clear(sf::Color(
+/**
+ * Converts the configured clear color to an SFML color.
+ * @return The clear color.
+ */
+sf::Color Renderer::clearColorValue() const {
+    const auto& clearColor = currentRenderConfig.clearColor;
+    return sf::Color(
         static_cast<uint8_t>(clearColor.r * 255),
         static_cast<uint8_t>(clearColor.g * 255),
         static_cast<uint8_t>(clearColor.b * 255),
         static_cast<uint8_t>(clearColor.a * 255)
+    );
+}
+
+
+/**
+ * Prepares the off-screen world texture for this frame when lowResWorld is enabled.
+ * The texture is resized to the view size (one texel per world pixel) only when
+ * the view size changes, and the camera center is snapped to whole pixels.
+ * With the render thread running this only records the camera into the snapshot.
+ */
+void Renderer::beginWorldPass() {
+    // Last frame's scratch geometry was copied into its queue when submitted
+    frameScratch.reset();
+
+    if (recordsSnapshots()) {
+        FrameSnapshot& frame = recordingFrame();
+        frame.worldView = view;
+        frame.clearColor = clearColorValue();
+        return;
+    }
+
+    drawQueue.begin();
+    worldPassActive = false;
+
+    if (softwareBackend) {
+        sf::View worldView = view;
+        worldView.setCenter(sf::Vector2f(std::round(view.getCenter().x), std::round(view.getCenter().y)));
+        softwareBackend->setView(worldView);
+        softwareBackend->clear(clearColorValue());
+        return;
+    }
+
+    setupWorldTarget(view, baseViewSize);
+}
+
+
+/**
+ * Points worldTarget() at the low-res world texture for the given camera,
+ * (re)creating the texture when the unzoomed view size changed.
+ * @param camera World camera of the frame.
+ * @param unzoomedSize Camera size at zoom 1.
+ * @param scale Resolution multiplier.
+ */
+void Renderer::setupWorldTarget(const sf::View& camera, const sf::Vector2f& unzoomedSize, float scale) {
+    worldPassActive = false;
+    const bool lowRes = currentAppConfig.performance.lowResWorld;
+    if (!window.isOpen() || (!lowRes && scale >= 1.f)) return;
+
+    // One texel per world pixel at zoom 1, or per window pixel without lowResWorld, times the
+    // scale; a zoomed camera maps more or less world into the same texture
+    const sf::Vector2f baseSize = lowRes ? unzoomedSize : sf::Vector2f(window.getSize());
+    const sf::Vector2u texSize(
+        static_cast<unsigned int>(std::max(1L, std::lround(baseSize.x * scale))),
+        static_cast<unsigned int>(std::max(1L, std::lround(baseSize.y * scale)))
+    );
+
+    if (worldTexture.getSize() != texSize) {
+        if (!worldTexture.resize(texSize)) {
+            Logger::warn("Renderer: failed to create low-res world texture, drawing world at window resolution");
+            currentAppConfig.performance.lowResWorld = false;
+            return;
+        }
+        worldTexture.setSmooth(false);
+        Logger::info("Renderer: world texture " + std::to_string(texSize.x) + "x" + std::to_string(texSize.y));
+    }
+
+    sf::View worldView = camera;
+    worldView.setViewport(sf::FloatRect({0.f, 0.f}, {1.f, 1.f}));
+    worldView.setCenter(sf::Vector2f(std::round(camera.getCenter().x), std::round(camera.getCenter().y)));
+    worldTexture.setView(worldView);
+
+    worldTexture.clear(clearColorValue());
+    worldPassActive = true;
+}
+
+
+/**
+ * Flushes the world draw queue and upscales the world texture onto the window.
+ * With the render thread running the world stays recorded until present().
+ */
+void Renderer::endWorldPass() {
+    if (recordsSnapshots()) return;
+
+    if (softwareBackend) drawQueue.flush(*softwareBackend);
+    else drawQueue.flush(worldTarget());
+
+    const DrawStats& stats = drawQueue.getLastStats();
+    if (++statsFrameCounter % 600 == 0) {
+        Logger::debug("World pass: " + std::to_string(stats.commands) + " commands, " +
+                      std::to_string(stats.drawCalls) + " draw calls, " +
+                      std::to_string(stats.textureBinds) + " texture binds, " +
+                      std::to_string(stats.vertices) + " vertices");
+    }
+
+    compositeWorld(view);
+}
+
+
+/**
+ * Upscales the world texture onto the window. Stretches to the window like the
+ * plain game view would, or uses the largest whole multiple when integerUpscale
+ * is set (falling back to a fit if the window is smaller than the texture).
+ * @param camera World camera of the frame.
+ */
+void Renderer::compositeWorld(const sf::View& camera) {
+    if (!worldPassActive) return;
+    worldPassActive = false;
+    worldTexture.display();
+
+    const sf::Vector2u ws = window.getSize();
+    const sf::Vector2u ts = worldTexture.getSize();
+    if (ws.x == 0 || ws.y == 0 || ts.x == 0 || ts.y == 0) return;
+
+    float sx = static_cast<float>(ws.x) / static_cast<float>(ts.x);
+    float sy = static_cast<float>(ws.y) / static_cast<float>(ts.y);
+    if (currentAppConfig.performance.integerUpscale) {
+        const float fit = std::min(sx, sy);
+        sx = sy = fit >= 1.f ? std::floor(fit) : fit;
+    }
+
+    const sf::Vector2f dstSize(static_cast<float>(ts.x) * sx, static_cast<float>(ts.y) * sy);
+    const sf::Vector2f dstPos(
+        std::round((static_cast<float>(ws.x) - dstSize.x) * 0.5f),
+        std::round((static_cast<float>(ws.y) - dstSize.y) * 0.5f)
+    );
+
+    sf::Sprite upscaled(worldTexture.getTexture());
+    upscaled.setScale(sf::Vector2f(sx, sy));
+    upscaled.setPosition(dstPos);
+    window.setView(window.getDefaultView());
+    window.draw(upscaled);
+
+    // Keep later world-space draws on the window aligned with the upscaled image
+    sf::View windowView = camera;
+    windowView.setViewport(sf::FloatRect(
+        {dstPos.x / static_cast<float>(ws.x), dstPos.y / static_cast<float>(ws.y)},
+        {dstSize.x / static_cast<float>(ws.x), dstSize.y / static_cast<float>(ws.y)}
     ));
+    window.setView(windowView);
 }
 
 
 /**
  * Presents the rendered content to the screen.
+ * Draws the recorded HUD first; with the render thread running, publishes the
+ * recorded snapshot instead and paces the simulation to the target frame rate.
  */
 void Renderer::present() {
+    if (recordsSnapshots()) {
+        FrameSnapshot& frame = recordingFrame();
+        const uint64_t digest = snapshotDigest(frame);
+        const auto now = FramePacer::Clock::now();
+
+        // Unchanged frame without input: the window already shows it
+        const bool changed = !currentAppConfig.performance.idleThrottle || inputSinceFrame ||
+                             digest != lastDrawnDigest || now - lastDrawnAt >= IdleRedrawInterval;
+        inputSinceFrame = false;
+        recording = nullptr;
+
+        if (changed) {
+            lastDrawnDigest = digest;
+            lastDrawnAt = now;
+            ++pacedFramesDrawn;
+            frame.frame = ++recordedFrames;
+            frame.updateMs = std::chrono::duration<double, std::milli>(now - lastTickAt).count();
+            frame.inputAt = frameInputAt;
+            frameInputAt = {};
+            if (renderThreadRunning) {
+                snapshots.publish();
+                {
+                    std::lock_guard<std::mutex> lock(renderMutex);
+                }
+                renderCondition.notify_all();
+            } else if (window.isOpen()) {
+                renderSnapshot(frame);
+                std::lock_guard<std::mutex> lock(renderMutex);
+                renderedStats = frame.world.getLastStats();
+            }
+
+            // Update and drawing overlap with the render thread and add up without it
+            const double renderMs = lastRenderMs.load();
+            const double workMs = renderThreadRunning ? std::max(frame.updateMs, renderMs) : frame.updateMs + renderMs;
+            if (qualityGovernor.recordFrame(workMs)) applyQuality();
+        } else {
+            ++pacedFramesSkipped;
+        }
+
+        paceFrame(currentAppConfig.performance.idleThrottle && (!changed || !windowFocused));
+        return;
+    }
+
+    if (!window.isOpen()) {
+        hudQueue.begin();
+        uiSequence = 0;
+        return;
+    }
+
+    const sf::View worldView = window.getView();
+    window.setView(window.getDefaultView());
+    hudQueue.flush(window);
+    hudQueue.begin();
+    uiSequence = 0;
+    window.setView(worldView);
+
+    window.display();
+    if (frameInputAt != FramePacer::Clock::time_point{}) {
+        inputLatency.record(std::chrono::duration<double, std::milli>(FramePacer::Clock::now() - frameInputAt).count());
+        frameInputAt = {};
+    }
+}
+
+
+/**
+ * Remembers the oldest input the current frame reacts to.
+ * @param receivedAt Time the input event was received.
+ */
+void Renderer::noteInput(FramePacer::Clock::time_point receivedAt) {
+    if (frameInputAt == FramePacer::Clock::time_point{} || receivedAt < frameInputAt) frameInputAt = receivedAt;
+}
+
+
+/**
+ * Displays a modal window; the render thread is paused, so the latency
+ * samples belong to the calling thread meanwhile.
+ * @param modal The modal window to display.
+ */
+void Renderer::presentModal(sf::RenderWindow& modal) {
+    modal.display();
+    if (frameInputAt != FramePacer::Clock::time_point{}) {
+        inputLatency.record(std::chrono::duration<double, std::milli>(FramePacer::Clock::now() - frameInputAt).count());
+        frameInputAt = {};
+    }
+}
+
+
+/**
+ * Stops the render thread (if any) and closes the window.
+ */
+void Renderer::quit() {
+    stopFramePacing();
+    window.close();
+}
+
+
+/**
+ * Returns the draw stats of the last world pass.
+ * @return Stats of the last flushed world pass.
+ */
+DrawStats Renderer::getFrameStats() const {
+    if (!framePacing) return drawQueue.getLastStats();
+    std::lock_guard<std::mutex> lock(renderMutex);
+    return renderedStats;
+}
+
+
+/**
+ * Returns the snapshot being recorded for this frame, starting a new one if needed.
+ * @return The snapshot receiving this frame's commands.
+ */
+FrameSnapshot& Renderer::recordingFrame() {
+    if (!recording) {
+        recording = &snapshots.writeSlot();
+        recording->world.begin();
+        recording->ui.begin();
+        recording->worldView = view;
+        recording->clearColor = clearColorValue();
+        recording->worldScale = qualityGovernor.getSettings().worldScale;
+        recording->worldTargetSize = baseViewSize;
+        uiSequence = 0;
+    }
+    return *recording;
+}
+
+
+/**
+ * Starts recording frames as snapshots and pacing the loop from AppConfig::performance.
+ */
+void Renderer::startFramePacing() {
+    if (framePacing || !window.isOpen() || softwareBackend) return;
+
+    const auto& perf = currentAppConfig.performance;
+    const PacingMode mode = FramePacer::parseMode(perf.pacing, perf.vsync);
+    framePacer.configure(perf.targetFPS, perf.idleFPS);
+    adaptiveVSync.configure(perf.targetFPS, mode);
+    vsyncWanted = adaptiveVSync.wantsVSync();
+    qualityGovernor.configure(perf.targetFPS, perf.qualityGovernor);
+    lastRenderMs = 0.0;
+
+    // present() limits the loop from now on; SFML's limiter would only add jitter
+    window.setFramerateLimit(0);
+    pendingEvent.reset();
+    inputSinceFrame = true;
+    windowFocused = window.hasFocus();
+    lastDisplayAt = {};
+    lastTickAt = FramePacer::Clock::now();
+    pacedFramesDrawn = pacedFramesSkipped = idleTicks = 0;
+    frameInputAt = {};
+    inputLatency.reset();
+    recording = nullptr;
+    framePacing = true;
+
+    Logger::info(std::string("Renderer: frame pacing ") + FramePacer::modeName(mode) +
+                 " at " + std::to_string(perf.targetFPS) + " FPS" +
+                 (perf.idleThrottle ? ", idle " + std::to_string(perf.idleFPS) + " FPS" : ""));
+}
+
+
+/**
+ * Stops the render thread and frame pacing; SFML limits the frame rate again.
+ */
+void Renderer::stopFramePacing() {
+    if (!framePacing) return;
+
+    stopRenderThread();
+    framePacing = false;
+    recording = nullptr;
+    pendingEvent.reset();
+
+    const int finalQuality = qualityGovernor.getLevel();
+    qualityGovernor.configure(currentAppConfig.performance.targetFPS, false);
+    if (textRenderer) textRenderer->setOutlinesEnabled(true);
+
+    if (window.isOpen()) {
+        if (vsyncApplied) window.setVerticalSyncEnabled(false);
+        window.setFramerateLimit(currentAppConfig.performance.targetFPS);
+    }
+    vsyncApplied = false;
+
+    Logger::info("Renderer: frame pacing stopped (" + std::to_string(pacedFramesDrawn) + " frames drawn, " +
+                 std::to_string(pacedFramesSkipped) + " unchanged frames skipped, " +
+                 std::to_string(idleTicks) + " idle ticks, " +
+                 std::to_string(adaptiveVSync.getSwitchCount()) + " vsync switches, spin margin " +
+                 std::to_string(framePacer.getSpinMarginMs()) + " ms, quality " +
+                 QualityGovernor::describeLevel(finalQuality) + ", input latency " +
+                 inputLatency.describe() + ")");
+}
+
+
+/**
+ * Applies the quality governor's new level and logs it.
+ */
+void Renderer::applyQuality() {
+    const QualitySettings& quality = qualityGovernor.getSettings();
+    if (textRenderer) textRenderer->setOutlinesEnabled(quality.labelOutlines);
+
+    const double budgetMs = 1000.0 / std::max(1, currentAppConfig.performance.targetFPS);
+    Logger::info("Quality governor: frame work " + std::to_string(qualityGovernor.getLastAverageMs()) +
+                 " ms (budget " + std::to_string(budgetMs) + " ms) -> level " +
+                 std::to_string(qualityGovernor.getLevel()) + ", " +
+                 QualityGovernor::describeLevel(qualityGovernor.getLevel()));
+}
+
+
+/**
+ * Polls the next window event; an event that ended an idle wait comes first.
+ * @return The next event, if any.
+ */
+std::optional<sf::Event> Renderer::pollEvent() {
+    std::optional<sf::Event> event;
+    if (pendingEvent) {
+        event = std::move(pendingEvent);
+        pendingEvent.reset();
+        lastEventAt = pendingEventAt;
+    } else {
+        event = window.pollEvent();
+        lastEventAt = FramePacer::Clock::now();
+    }
+    if (!event) return event;
+
+    // Any event may change what is drawn (hover, resize, key handling)
+    inputSinceFrame = true;
+    if (event->is<sf::Event::FocusLost>()) windowFocused = false;
+    else if (event->is<sf::Event::FocusGained>()) windowFocused = true;
+    return event;
+}
+
+
+/**
+ * Waits for the next loop tick.
+ * @param idle Whether this tick runs at the idle rate and ends early on input.
+ */
+void Renderer::paceFrame(bool idle) {
+    const auto deadline = framePacer.nextDeadline(idle);
+    if (idle) {
+        ++idleTicks;
+        waitForInput(deadline);
+    } else if (!renderThreadRunning && vsyncApplied) {
+        // Without the render thread a vsynced display() already blocked until the vertical blank
+        framePacer.reset();
+    } else {
+        framePacer.sleepUntil(deadline);
+    }
+    lastTickAt = FramePacer::Clock::now();
+}
+
+
+/**
+ * Sleeps until the deadline in short slices, returning as soon as an event arrives.
+ * @param deadline End of the idle tick.
+ */
+void Renderer::waitForInput(FramePacer::Clock::time_point deadline) {
+    while (window.isOpen() && !pendingEvent) {
+        pendingEvent = window.pollEvent();
+        if (pendingEvent) {
+            pendingEventAt = FramePacer::Clock::now();
+            framePacer.reset();
+            return;
+        }
+        const auto now = FramePacer::Clock::now();
+        if (now >= deadline) return;
+        std::this_thread::sleep_for(std::min<FramePacer::Clock::duration>(deadline - now, InputPollSlice));
+    }
+}
+
+
+/**
+ * Loads a render-thread copy of a font used by recorded texts.
+ * @param font Font referenced by texts.
+ * @param path File the font was loaded from.
+ */
+void Renderer::registerFont(const sf::Font& font, const std::string& path) {
+    if (renderFonts.count(&font)) return;
+
+    auto copy = std::make_unique<sf::Font>();
+    if (!copy->openFromFile(path)) {
+        Logger::warn("Renderer: cannot load render-thread font " + path);
+        return;
+    }
+
+    RenderThreadPause pause(*this);
+    renderFonts.emplace(&font, std::move(copy));
+}
+
+
+/**
+ * Drops the render-thread copy of a font that is about to be destroyed.
+ * @param font Font previously passed to registerFont.
+ */
+void Renderer::unregisterFont(const sf::Font& font) {
+    RenderThreadPause pause(*this);
+    renderFonts.erase(&font);
+}
+
+
+/**
+ * Adds the faces and labels of texts built inside the renderer.
+ * @param glyphs Prewarmer collecting the game's glyphs.
+ */
+void Renderer::addGlyphFaces(GlyphPrewarmer& glyphs) const {
+    glyphs.addFace(mapButtonConfig.fontSize);
+    glyphs.addText(mapButtonConfig.label);
+    glyphs.addFace(scheduleButtonConfig.fontSize);
+    glyphs.addText(scheduleButtonConfig.label);
+    glyphs.addFace(16);   // renderRestingText
+}
+
+
+/**
+ * Requests every collected glyph from the registered fonts and their
+ * render-thread copies (parked meanwhile, since fonts aren't thread-safe).
+ * @param glyphs Faces and characters to warm.
+ */
+void Renderer::prewarmGlyphs(const GlyphPrewarmer& glyphs) {
     if (!window.isOpen()) return;
+
+    const sf::Clock timer;
+    size_t requested = 0;
+    size_t fonts = 0;
+    {
+        RenderThreadPause pause(*this);
+        size_t pageBytes = 0;
+        for (const auto& [font, copy] : renderFonts) {
+            requested += glyphs.warm(*font);
+            pageBytes += glyphs.pageBytes(*font);
+            ++fonts;
+            if (renderThreadRunning) {
+                requested += glyphs.warm(*copy);
+                pageBytes += glyphs.pageBytes(*copy);
+                ++fonts;
+            }
+        }
+        glyphPageMemory.set(pageBytes);
+    }
+
+    Logger::info("Renderer: prewarmed " + std::to_string(glyphs.getFaceCount()) + " faces x "
+                 + std::to_string(glyphs.getCharacterCount()) + " characters on "
+                 + std::to_string(fonts) + " fonts (" + std::to_string(requested) + " glyphs) in "
+                 + std::to_string(timer.getElapsedTime().asMilliseconds()) + " ms");
+}
+
+
+/**
+ * Starts the render thread; the window's OpenGL context moves to it.
+ * @return True if the render thread is running.
+ */
+bool Renderer::startRenderThread() {
+    if (renderThreadRunning) return true;
+    if (!window.isOpen() || softwareBackend) return false;
+
+    startFramePacing();
+
+    if (!window.setActive(false)) {
+        Logger::warn("Renderer: cannot release the window context, keeping single-threaded rendering");
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(renderMutex);
+        renderStopRequested = false;
+        renderPauseDepth = 0;
+        renderPaused = false;
+    }
+    recording = nullptr;
+    framePacer.reset();
+    renderThreadRunning = true;
+    renderThread = std::thread(&Renderer::renderThreadMain, this);
+
+    Logger::info("Renderer: render thread started");
+    return true;
+}
+
+
+/**
+ * Stops the render thread and reactivates the window context on the calling thread.
+ */
+void Renderer::stopRenderThread() {
+    if (!renderThreadRunning) return;
+
+    {
+        std::lock_guard<std::mutex> lock(renderMutex);
+        renderStopRequested = true;
+    }
+    renderCondition.notify_all();
+    if (renderThread.joinable()) renderThread.join();
+
+    renderThreadRunning = false;
+    recording = nullptr;
+    hudQueue.begin();
+    uiSequence = 0;
+    if (window.isOpen() && !window.setActive(true)) {
+        Logger::warn("Renderer: cannot reactivate the window context");
+    }
+    Logger::info("Renderer: render thread stopped");
+}
+
+
+/**
+ * Suspends the render thread and takes the window context back (nestable).
+ */
+void Renderer::pauseRenderThread() {
+    if (!framePacing) return;
+
+    std::unique_lock<std::mutex> lock(renderMutex);
+    if (renderPauseDepth++ > 0) return;
+    if (renderThreadRunning) {
+        renderCondition.notify_all();
+        renderCondition.wait(lock, [this]() { return renderPaused; });
+    }
+    lock.unlock();
+
+    if (renderThreadRunning && window.isOpen() && !window.setActive(true)) {
+        Logger::warn("Renderer: cannot activate the window context while paused");
+    }
+
+    // Screens drawing on the window directly meanwhile rely on SFML's own limiter
+    if (window.isOpen()) window.setFramerateLimit(currentAppConfig.performance.targetFPS);
+}
+
+
+/**
+ * Hands the window context back to the render thread. Frames published before
+ * the pause are dropped, since they may reference resources freed meanwhile.
+ */
+void Renderer::resumeRenderThread() {
+    if (!framePacing) return;
+
+    std::unique_lock<std::mutex> lock(renderMutex);
+    if (renderPauseDepth == 0) return;
+    if (renderPauseDepth > 1) {
+        --renderPauseDepth;
+        return;
+    }
+    lock.unlock();
+
+    if (window.isOpen()) window.setFramerateLimit(0);
+
+    // The render thread stays parked until the depth drops to zero below,
+    // so releasing the context and taking the pending frame cannot race with it
+    if (renderThreadRunning) {
+        (void)window.setActive(false);
+        (void)snapshots.acquire();
+    }
+    recording = nullptr;
+    inputSinceFrame = true;   // Redraw over whatever the paused screen left behind
+    framePacer.reset();
+
+    lock.lock();
+    renderPauseDepth = 0;
+    lock.unlock();
+    renderCondition.notify_all();
+}
+
+
+Renderer::RenderThreadPause::RenderThreadPause(Renderer& renderer) : renderer(renderer) {
+    renderer.pauseRenderThread();
+}
+
+Renderer::RenderThreadPause::~RenderThreadPause() {
+    renderer.resumeRenderThread();
+}
+
+
+/**
+ * Render thread body: waits for published snapshots and draws the newest one.
+ */
+void Renderer::renderThreadMain() {
+    bool active = window.setActive(true);
+    if (!active) Logger::error("Renderer: render thread cannot activate the window context");
+
+    std::unique_lock<std::mutex> lock(renderMutex);
+    while (true) {
+        renderCondition.wait(lock, [this]() {
+            return renderStopRequested || renderPauseDepth > 0 || snapshots.hasFresh();
+        });
+        if (renderStopRequested) break;
+
+        if (renderPauseDepth > 0) {
+            if (active) (void)window.setActive(false);
+            active = false;
+            renderPaused = true;
+            renderCondition.notify_all();
+            renderCondition.wait(lock, [this]() { return renderStopRequested || renderPauseDepth == 0; });
+            renderPaused = false;
+            if (renderStopRequested) break;
+            active = window.setActive(true);
+            continue;
+        }
+
+        FrameSnapshot* frame = snapshots.acquire();
+        if (!frame) continue;
+
+        lock.unlock();
+        if (active && window.isOpen()) renderSnapshot(*frame);
+        lock.lock();
+        renderedStats = frame->world.getLastStats();
+    }
+    lock.unlock();
+
+    if (active) (void)window.setActive(false);
+}
+
+
+/**
+ * Draws one snapshot: world (through the low-res texture when enabled), then HUD.
+ * @param frame Snapshot to draw.
+ */
+void Renderer::renderSnapshot(FrameSnapshot& frame) {
+    const auto renderStart = FramePacer::Clock::now();
+    window.clear(frame.clearColor);
+
+    setupWorldTarget(frame.worldView, frame.worldTargetSize, frame.worldScale);
+    if (!worldPassActive) window.setView(frame.worldView);
+    // Inline drawing (no render thread) can use the game's fonts directly
+    const auto* fonts = renderThreadRunning ? &renderFonts : nullptr;
+    RenderThreadBackend worldBackend(worldTarget(), fonts);
+    frame.world.flush(worldBackend);
+    compositeWorld(frame.worldView);
+
+    window.setView(window.getDefaultView());
+    RenderThreadBackend uiBackend(window, fonts);
+    frame.ui.flush(uiBackend);
+
+    const bool vsync = vsyncWanted.load(std::memory_order_relaxed);
+    if (vsync != vsyncApplied) {
+        window.setVerticalSyncEnabled(vsync);
+        vsyncApplied = vsync;
+    }
+
+    const auto beforeDisplay = FramePacer::Clock::now();
+    lastRenderMs.store(std::chrono::duration<double, std::milli>(beforeDisplay - renderStart).count());
     window.display();
+    const auto afterDisplay = FramePacer::Clock::now();
+    if (lastDisplayAt != FramePacer::Clock::time_point{}) {
+        // Update and drawing overlap on the render thread and add up without it
+        const double intervalMs = std::chrono::duration<double, std::milli>(afterDisplay - lastDisplayAt).count();
+        const double renderMs = std::chrono::duration<double, std::milli>(beforeDisplay - renderStart).count();
+        const double workMs = renderThreadRunning ? std::max(frame.updateMs, renderMs) : frame.updateMs + renderMs;
+        if (adaptiveVSync.recordFrame(intervalMs, workMs)) {
+            vsyncWanted.store(adaptiveVSync.wantsVSync(), std::memory_order_relaxed);
+            Logger::info(std::string("Renderer: adaptive vsync ") + (adaptiveVSync.wantsVSync() ? "on" : "off"));
+        }
+    }
+    lastDisplayAt = afterDisplay;
+    if (frame.inputAt != FramePacer::Clock::time_point{}) {
+        inputLatency.record(std::chrono::duration<double, std::milli>(afterDisplay - frame.inputAt).count());
+    }
+
+    if (worldBackend.skippedTexts + uiBackend.skippedTexts > 0 && ++statsFrameCounter % 600 == 1) {
+        Logger::warn("Renderer: skipped texts whose font was not registered with registerFont");
+    }
 }
 
 // Simple helper: parse "#RRGGBB" or "#RRGGBBAA" into sf::Color. Returns white on parse error.
@@ -408,10 +1316,7 @@ void Renderer::drawMapButton() {
 
     int py = mapButtonConfig.y;
 
-    // Draw in window (screen) coordinates: switch to default view temporarily.
-    sf::View prevView = window.getView();
-    window.setView(window.getDefaultView());
-
+    // Recorded as HUD, i.e. drawn in window (screen) coordinates
     sf::RectangleShape rect(sf::Vector2f(
         static_cast<float>(mapButtonConfig.width),
         static_cast<float>(mapButtonConfig.height)
@@ -433,7 +1338,7 @@ void Renderer::drawMapButton() {
     );
     rect.setOutlineThickness(0);
 
-    window.draw(rect);
+    submitUi(rect);
 
     // Draw label
     if (uiFont && mapButtonConfig.fontSize > 0) {
@@ -465,11 +1370,8 @@ void Renderer::drawMapButton() {
             static_cast<float>(py) + mapButtonConfig.height*0.5f
         ));
 
-        window.draw(txt);
+        submitUi(txt);
     }
-
-    // restore previous view
-    window.setView(prevView);
 }
 
 bool Renderer::scheduleButtonContainsPoint(const sf::Vector2i& mousePos) const {
@@ -508,10 +1410,7 @@ void Renderer::drawScheduleButton() {
 
     int py = scheduleButtonConfig.y;
 
-    // Draw in window (screen) coordinates: switch to default view temporarily.
-    sf::View prevView = window.getView();
-    window.setView(window.getDefaultView());
-
+    // Recorded as HUD, i.e. drawn in window (screen) coordinates
     sf::RectangleShape rect(sf::Vector2f(
         static_cast<float>(scheduleButtonConfig.width),
         static_cast<float>(scheduleButtonConfig.height)
@@ -533,7 +1432,7 @@ void Renderer::drawScheduleButton() {
     );
     rect.setOutlineThickness(0);
 
-    window.draw(rect);
+    submitUi(rect);
 
     // Draw label
     if (uiFont && scheduleButtonConfig.fontSize > 0) {
@@ -565,11 +1464,8 @@ void Renderer::drawScheduleButton() {
             static_cast<float>(py) + scheduleButtonConfig.height*0.5f
         ));
 
-        window.draw(txt);
+        submitUi(txt);
     }
-
-    // restore previous view
-    window.setView(prevView);
 }
 
 void Renderer::drawScheduleButtonOnWindow(sf::RenderWindow& targetWindow) {
@@ -747,7 +1643,7 @@ void Renderer::drawSprite(const sf::Sprite& sprite) {
     }
     
     // Draw the sprite
-    window.draw(sprite);
+    worldTarget().draw(sprite);
 }
 
 
@@ -780,11 +1676,12 @@ void Renderer::drawText(const sf::Text& text) {
  * @param newView The new view to set as active.
  */
 void Renderer::setView(const sf::View& newView) {
-    // Return early if window is not open
-    if (!window.isOpen()) return;
+    // Return early if there is nothing to draw into
+    if (!canDrawWorld()) return;
     // Update and apply the new view
     view = newView;
-    window.setView(view);
+    baseViewSize = view.getSize() * zoom;
+    if (window.isOpen()) window.setView(view);
 }
 
 
@@ -810,14 +1707,15 @@ void Renderer::updateCamera(
     int mapWidth, 
     int mapHeight
 ) {
-    // Return early if window is not open
-    if (!window.isOpen()) return;
+    // Return early if there is nothing to draw into
+    if (!canDrawWorld()) return;
     
     // Set new camera center position
     view.setCenter(position);
     
-    // Adjust view size if it exceeds map boundaries
-    sf::Vector2f size = view.getSize();
+    // Size the view from the zoom, then shrink it if it exceeds map boundaries
+    sf::Vector2f size = baseViewSize / zoom;
+    view.setSize(size);
     bool adjust = false;
     if (size.x > static_cast<float>(mapWidth)) { 
         size.x = static_cast<float>(mapWidth); 
@@ -831,7 +1729,36 @@ void Renderer::updateCamera(
     
     // Clamp view to stay within map boundaries and apply
     clampViewToMap(view, mapWidth, mapHeight);
-    window.setView(view);
+    if (window.isOpen()) window.setView(view);
+}
+
+
+void Renderer::configureZoom(const sf::Vector2f& viewSize) {
+    const auto& display = currentAppConfig.mapDisplay;
+    minZoom = display.minZoom > 0.f ? display.minZoom : 1.f;
+    maxZoom = std::max(minZoom, display.maxZoom);
+    zoom = targetZoom = std::clamp(display.defaultZoom > 0.f ? display.defaultZoom : 1.f, minZoom, maxZoom);
+    baseViewSize = viewSize;
+    view.setSize(baseViewSize / zoom);
+}
+
+
+void Renderer::zoomBy(float steps) {
+    if (steps == 0.f) return;
+    targetZoom = std::clamp(targetZoom * std::pow(ZoomStep, steps), minZoom, maxZoom);
+}
+
+
+/**
+ * Eases the zoom toward the target in log space, so zooming in and out feel alike.
+ * @param deltaTime Elapsed time in seconds.
+ */
+void Renderer::updateZoom(float deltaTime) {
+    if (zoom == targetZoom) return;
+    const float t = 1.f - std::exp(-ZoomEaseRate * deltaTime);
+    zoom *= std::pow(targetZoom / zoom, t);
+    // Snap once the remaining change is below a hundredth of a pixel across the view
+    if (std::abs(zoom - targetZoom) * baseViewSize.x < 0.01f * zoom) zoom = targetZoom;
 }
 
 
@@ -876,47 +1803,148 @@ const sf::View& Renderer::getCurrentView() const {
 void Renderer::renderTextObjects(const std::vector<TextObject>& textObjects) {
     if (textObjects.empty()) return;
     
-    textRenderer->renderTextObjects(textObjects, window);
+    labelScratch.clear();
+    textRenderer->buildTexts(textObjects, labelScratch);
+    for (const auto& text : labelScratch) {
+        worldQueue().submitDrawable(text, DrawLayer::Labels);
+    }
 }
 
 
-void Renderer::renderEntranceAreas(const std::vector<EntranceArea>& areas) {
-    for (const auto& area : areas) {
-        sf::RectangleShape rect(sf::Vector2f(area.width, area.height));
-        rect.setPosition(sf::Vector2f{area.x, area.y});
-        rect.setFillColor(entranceFillColor);
-        rect.setOutlineThickness(entranceOutlineThickness);
-        rect.setOutlineColor(entranceOutlineColor);
-        window.draw(rect);
+void Renderer::renderMapTiles(const TMJMap& map) {
+    if (!canDrawWorld()) return;
+
+    const auto& vertices = map.getTileVertices();
+    for (const TileRun& run : map.getTileRuns()) {
+        worldQueue().submit(&vertices[run.firstVertex], run.vertexCount, run.texture,
+                            DrawLayer::Ground, static_cast<float>(run.layer));
     }
 }
 
 
-void Renderer::renderGameTriggerAreas(const std::vector<GameTriggerArea>& areas) {
-    if (!window.isOpen()) return;
+void Renderer::renderTriggerOverlays(const TMJMap& map) {
+    if (!canDrawWorld() || !getQuality().triggerOverlays) return;
 
-    for (const auto& area : areas) {
-        sf::RectangleShape rect(sf::Vector2f(area.width, area.height));
-        rect.setPosition(sf::Vector2f(area.x, area.y));
-        rect.setFillColor(gameTriggerFillColor);
-        rect.setOutlineThickness(gameTriggerOutlineThickness);
-        rect.setOutlineColor(gameTriggerOutlineColor);
-        window.draw(rect);
+    if (map.getTriggerRevision() != triggerOverlayRevision) {
+        rebuildTriggerOverlays(map);
     }
+    worldQueue().submit(triggerOverlay.data(), triggerOverlay.size(), nullptr, DrawLayer::Overlays);
 }
 
 
-void Renderer::renderShopTriggerAreas(const std::vector<ShopTrigger>& areas) {
-    if (!window.isOpen()) return;
+/**
+ * Draws the night tint over the window, or over the world only (cheaper with a
+ * low-res world target) when the quality governor has stepped it down.
+ * @param tint Overlay color.
+ */
+void Renderer::renderNightOverlay(sf::Color tint) {
+    if (tint.a == 0) return;
+
+    if (getQuality().screenNightOverlay) {
+        const sf::Vector2u ws = getWindowSize();
+        sf::RectangleShape overlay(sf::Vector2f(static_cast<float>(ws.x), static_cast<float>(ws.y)));
+        overlay.setFillColor(tint);
+        submitUi(overlay);
+        return;
+    }
 
-    for (const auto& area : areas) {
-        sf::RectangleShape rect(area.rect.size);            
-        rect.setPosition(area.rect.position);            
-        rect.setFillColor(shopTriggerFillColor);
-        rect.setOutlineThickness(shopTriggerOutlineThickness);
-        rect.setOutlineColor(shopTriggerOutlineColor);
-        window.draw(rect);
+    // Above everything else in the world, including labels and effects
+    sf::RectangleShape overlay(view.getSize());
+    overlay.setPosition(view.getCenter() - view.getSize() / 2.f);
+    overlay.setFillColor(tint);
+    worldQueue().submitDrawable(overlay, DrawLayer::Effects, 1.0e6f);
+}
+
+
+/**
+ * Draws the baked lightmap chunks under the view with DrawBlend::Darken. The
+ * vertex color is the shade at full night, so one texture serves every hour.
+ * @param map Map whose lightmap is drawn.
+ * @param tint Night color; its alpha sets the darkness.
+ */
+void Renderer::renderNightLighting(const TMJMap& map, sf::Color tint) {
+    const Lightmap& lightmap = map.getLightmap();
+    if (lightmap.empty()) {
+        renderNightOverlay(tint);
+        return;
     }
+    if (tint.a == 0) return;
+
+    // Darken blending scales the scene by 1 - color: a channel the tint keeps is darkened less
+    auto shade = [&](uint8_t channel) {
+        return static_cast<uint8_t>((tint.a * (255u - channel) + 127u) / 255u);
+    };
+    const sf::Color color(shade(tint.r), shade(tint.g), shade(tint.b));
+
+    auto appendQuad = [&](std::pmr::vector<sf::Vertex>& quads, const sf::FloatRect& bounds) {
+        const sf::Vector2f p0 = bounds.position;
+        const sf::Vector2f p1 = bounds.position + bounds.size;
+        const sf::Vector2f t1 = bounds.size / static_cast<float>(Lightmap::TexelPixels);
+        const sf::Vertex tl{p0, color, {0.f, 0.f}};
+        const sf::Vertex tr{{p1.x, p0.y}, color, {t1.x, 0.f}};
+        const sf::Vertex br{p1, color, t1};
+        const sf::Vertex bl{{p0.x, p1.y}, color, {0.f, t1.y}};
+        quads.insert(quads.end(), {tl, tr, br, tl, br, bl});
+    };
+
+    const sf::Vector2f topLeft = view.getCenter() - view.getSize() / 2.f;
+    const sf::Vector2f bottomRight = topLeft + view.getSize();
+    const float chunk = static_cast<float>(Lightmap::ChunkPixels);
+    const int c0 = std::max(0, static_cast<int>(std::floor(topLeft.x / chunk)));
+    const int c1 = std::min(lightmap.getColumns() - 1, static_cast<int>(std::floor(bottomRight.x / chunk)));
+    const int r0 = std::max(0, static_cast<int>(std::floor(topLeft.y / chunk)));
+    const int r1 = std::min(lightmap.getRows() - 1, static_cast<int>(std::floor(bottomRight.y / chunk)));
+
+    // Above everything else in the world, like the plain overlay
+    std::pmr::vector<sf::Vertex> unlitChunkQuads(&frameScratch);
+    std::pmr::vector<sf::Vertex> litChunkQuad(&frameScratch);
+    for (int row = r0; row <= r1; ++row) {
+        for (int col = c0; col <= c1; ++col) {
+            const Lightmap::Chunk& c = lightmap.getChunk(col, row);
+            if (c.texture < 0) {
+                appendQuad(unlitChunkQuads, c.bounds);
+                continue;
+            }
+            litChunkQuad.clear();
+            appendQuad(litChunkQuad, c.bounds);
+            worldQueue().submit(litChunkQuad.data(), litChunkQuad.size(), &lightmap.getTexture(c.texture),
+                                DrawLayer::Effects, 1.0e6f, DrawBlend::Darken);
+        }
+    }
+    worldQueue().submit(unlitChunkQuads.data(), unlitChunkQuads.size(), nullptr,
+                        DrawLayer::Effects, 1.0e6f, DrawBlend::Darken);
+}
+
+
+void Renderer::rebuildTriggerOverlays(const TMJMap& map) {
+    const auto& entrances = map.getEntranceAreas();
+    const auto& games = map.getGameTriggers();
+    const auto& shops = map.getShopTriggers();
+
+    // 6 fill vertices + 24 outline vertices per area; the old triangles go with the arena
+    std::pmr::vector<sf::Vertex>(&triggerArena).swap(triggerOverlay);
+    triggerArena.reset();
+    triggerOverlay.reserve((entrances.size() + games.size() + shops.size()) * 30);
+
+    for (const auto& area : entrances) {
+        appendOverlayRect(triggerOverlay,
+            sf::FloatRect({area.x, area.y}, {area.width, area.height}),
+            entranceFillColor, entranceOutlineColor, entranceOutlineThickness);
+    }
+    for (const auto& area : games) {
+        appendOverlayRect(triggerOverlay,
+            sf::FloatRect({area.x, area.y}, {area.width, area.height}),
+            gameTriggerFillColor, gameTriggerOutlineColor, gameTriggerOutlineThickness);
+    }
+    for (const auto& area : shops) {
+        appendOverlayRect(triggerOverlay, area.rect,
+            shopTriggerFillColor, shopTriggerOutlineColor, shopTriggerOutlineThickness);
+    }
+
+    triggerOverlayRevision = map.getTriggerRevision();
+    Logger::debug("Rebuilt trigger overlays: " +
+                  std::to_string(entrances.size() + games.size() + shops.size()) + " areas, " +
+                  std::to_string(triggerOverlay.size()) + " vertices");
 }
 
 
@@ -930,7 +1958,7 @@ void Renderer::renderShopTriggerAreas(const std::vector<ShopTrigger>& areas) {
  * @return true if texture loaded successfully, false if loading failed.
  */
 bool Renderer::initializeProfessorTexture() {
-    if (!m_professorTexture.loadFromFile("tiles/M_10.png")) { 
+    if (!loadActorTexture("tiles/M_10.png", m_professorTexture, m_professorImage)) { 
         Logger::error("Failed to load professor texture: tiles/M_10.png");
         return false;
     }
@@ -952,7 +1980,7 @@ bool Renderer::initializeProfessorTexture() {
  * @param professors Vector of professor objects.
  */
 void Renderer::renderProfessors(const std::vector<Professor>& professors) {
-    if (!m_professorSprite || !m_professorTexture.getSize().x) return;
+    if (!m_professorSprite) return;
     
     for (const auto& prof : professors) {
         if (!prof.available) continue; 
@@ -962,7 +1990,7 @@ void Renderer::renderProfessors(const std::vector<Professor>& professors) {
             prof.rect.position.y + prof.rect.size.y / 2 - 8.5f 
         );
         m_professorSprite->setPosition(spritePos);
-        window.draw(*m_professorSprite);
+        worldQueue().submit(*m_professorSprite, DrawLayer::Actors, prof.rect.position.y + prof.rect.size.y);
     }
 }
 
@@ -993,17 +2021,12 @@ void Renderer::renderModalPrompt(
 ) {
     if (!window.isOpen()) return;
 
-    // draw overlay using a UI view that matches current window pixel size
-    sf::View prevView = window.getView();
+    // draw overlay as HUD (window pixel coordinates)
     sf::Vector2u winSz = getWindowSize();
-    sf::View uiView = window.getDefaultView();
-    uiView.setSize(sf::Vector2f(static_cast<float>(winSz.x), static_cast<float>(winSz.y)));
-    uiView.setCenter(sf::Vector2f(static_cast<float>(winSz.x) * 0.5f, static_cast<float>(winSz.y) * 0.5f));
-    window.setView(uiView);
     sf::RectangleShape overlay(sf::Vector2f(static_cast<float>(winSz.x), static_cast<float>(winSz.y)));
     overlay.setPosition(sf::Vector2f(0.f, 0.f));
     overlay.setFillColor(sf::Color(0, 0, 0, 160));
-    window.draw(overlay);
+    submitUi(overlay);
 
     sf::Text t(font, prompt, static_cast<unsigned int>(fontSize));
     t.setFillColor(colorFromHex(currentRenderConfig.text.textColor));
@@ -1027,24 +2050,21 @@ void Renderer::renderModalPrompt(
         sf::Text shadow = t;
         shadow.setFillColor(sf::Color(0,0,0,200));
         shadow.setPosition(sf::Vector2f(pos.x + 2.f, pos.y + 2.f));
-        window.draw(shadow);
+        submitUi(shadow);
 
         t.setFillColor(colorFromHex(currentRenderConfig.text.textColor));
         t.setPosition(pos);
-        window.draw(t);
+        submitUi(t);
     } else {
         t.setPosition(sf::Vector2f(static_cast<float>(winSz.x) * 0.5f, static_cast<float>(winSz.y) * 0.5f));
         // shadow
         sf::Text shadow = t;
         shadow.setFillColor(sf::Color(0,0,0,200));
         shadow.setPosition(t.getPosition() + sf::Vector2f(2.f, 2.f));
-        window.draw(shadow);
+        submitUi(shadow);
         t.setFillColor(colorFromHex(currentRenderConfig.text.textColor));
-        window.draw(t);
+        submitUi(t);
     }
-
-    // restore view
-    window.setView(prevView);
 }
 
 /**
@@ -1056,7 +2076,7 @@ void Renderer::renderModalPrompt(
  * @param font Font for the resting text.
  */
 void Renderer::renderRestingText(const sf::Vector2f& characterPos, const sf::Font& font) {
-    if (!window.isOpen()) return;
+    if (!canDrawWorld()) return;
 
     sf::Text text(font, "Resting......", 16);
     text.setFillColor(sf::Color::Green);
@@ -1064,12 +2084,14 @@ void Renderer::renderRestingText(const sf::Vector2f& characterPos, const sf::Fon
     sf::Vector2f textPos = characterPos;
     textPos.y -= 30; 
     
-    sf::FloatRect textBounds = text.getLocalBounds();
+    sf::FloatRect textBounds = softwareBackend
+        ? sf::FloatRect({0.f, 0.f}, SoftwareRenderBackend::measureText(text.getString(), text.getCharacterSize()))
+        : text.getLocalBounds();
     text.setOrigin(sf::Vector2f(
         textBounds.position.x + textBounds.size.x / 2,
         textBounds.position.y + textBounds.size.y / 2
     ));
     text.setPosition(textPos);
     
-    window.draw(text);
+    worldQueue().submitDrawable(text, DrawLayer::Labels);
 }
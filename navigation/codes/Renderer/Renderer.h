@@ -13,8 +13,25 @@
 #include "Config/ConfigManager.h"
 #include "MapLoader/MapObjects.h"
 #include "Renderer/TextRenderer.h"
+#include "Renderer/DrawQueue.h"
+#include "Renderer/SoftwareRenderBackend.h"
+#include "Renderer/FrameSnapshot.h"
+#include "Renderer/FramePacer.h"
+#include "Renderer/QualityGovernor.h"
+#include "Renderer/GlyphPrewarmer.h"
 #include "Utils/Logger.h" 
+#include "Utils/MemoryTracker.h"
+#include "Utils/Arena.h"
 #include <optional>
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+class TMJMap;
 
 /*
  * File: Renderer.h
@@ -31,6 +48,12 @@
  * Notes:
  *   - The class stores textures loaded via loadTexture and returns raw pointers.
  *   - For TMJMap rendering, sprites should reference textures owned by TMJMap.
+ *   - initializeHeadless replaces the window with a SoftwareRenderBackend; only the
+ *     world pass (tiles, overlays, actors, labels) is rendered in that mode.
+ *   - World and HUD drawing is recorded (submitSprite / submitDrawable / submitUi)
+ *     and flushed at endWorldPass / present, or, once startFramePacing was called,
+ *     collected into a FrameSnapshot that present() draws (or publishes to the
+ *     render thread) only when its content changed.
  */
 
 
@@ -67,6 +90,39 @@ public:
         const RenderConfig& renderConfig
     );
     
+    /**
+     * @brief Initializes the renderer without a window, drawing the world pass
+     *        into an in-memory frame with the CPU rasterizer.
+     *
+     * No OpenGL context is created. Maps must be loaded with TMJMap::setHeadless(true)
+     * and registered with registerMapTextures before they are drawn.
+     *
+     * @param appConfig The application configuration settings.
+     * @param renderConfig The rendering-specific configuration settings.
+     * @param frameSize Frame size in pixels; the view shows one world pixel per frame pixel.
+     *
+     * @return true if initialization was successful.
+     */
+    bool initializeHeadless(
+        const AppConfig& appConfig,
+        const RenderConfig& renderConfig,
+        sf::Vector2u frameSize
+    );
+
+    /**
+     * @brief Software backend of a headless renderer.
+     *
+     * @return SoftwareRenderBackend* The backend, or nullptr when rendering to a window.
+     */
+    SoftwareRenderBackend* getSoftwareBackend() { return softwareBackend.get(); }
+
+    /**
+     * @brief Make a headless map's tileset images available to the software backend.
+     *
+     * @param map Map loaded in headless mode; must outlive the frames that draw it.
+     */
+    void registerMapTextures(const TMJMap& map);
+    
     /**
      * @brief Cleans up all resources used by the renderer.
      */
@@ -92,9 +148,214 @@ public:
     
     /**
      * @brief Presents the rendered frame to the display.
+     *
+     * Draws the recorded HUD on top of the world first. With frame pacing started
+     * this draws (or, with the render thread running, publishes) the recorded
+     * snapshot instead, unless it is identical to the last drawn one and no input
+     * arrived, then waits until the next tick of the loop.
      */
     void present();
+
+    /**
+     * @brief Let the renderer pace the game loop (performance.pacing / idleThrottle).
+     *
+     * From now on frames are recorded as snapshots and present() limits the loop
+     * to performance.targetFPS with a precise sleep+spin limiter, vsync or adaptive
+     * vsync. While nothing changes on screen and no input arrives, or while the
+     * window is unfocused, the loop drops to performance.idleFPS and unchanged
+     * frames are not drawn again; incoming input ends an idle wait immediately.
+     */
+    void startFramePacing();
+
+    /**
+     * @brief Stop frame pacing (and the render thread) and restore SFML's frame limit.
+     */
+    void stopFramePacing();
+
+    /**
+     * @brief Optional rendering costs currently enabled by the quality governor.
+     *
+     * Frame pacing feeds the governor (performance.qualityGovernor) with the work
+     * time of every drawn frame; outside frame pacing this is always full quality.
+     *
+     * @return const QualitySettings& Current settings.
+     */
+    const QualitySettings& getQuality() const { return qualityGovernor.getSettings(); }
+
+    /**
+     * @brief Move drawing onto a dedicated render thread fed with frame snapshots.
+     *
+     * Afterwards every frame recorded between beginWorldPass and present goes into a
+     * FrameSnapshot; the render thread owns the window's OpenGL context and draws the
+     * newest snapshot, so simulation and drawing overlap. Events are still polled on
+     * the calling thread. Texts are drawn with render-thread copies of their fonts,
+     * so every font used in recorded texts must be registered with registerFont.
+     * Starts frame pacing if it isn't running yet.
+     *
+     * @return true if the thread is running (needs an open window, never headless).
+     */
+    bool startRenderThread();
+
+    /**
+     * @brief Stop the render thread and give the window's context back to this thread.
+     */
+    void stopRenderThread();
+
+    bool isRenderThreadRunning() const { return renderThreadRunning; }
+
+    /**
+     * @brief Let the render thread draw texts that use this font.
+     *
+     * The render thread loads its own instance from the same file, because sf::Font
+     * caches glyphs lazily and must not be shared between threads.
+     *
+     * @param font Font referenced by recorded texts.
+     * @param path File the font was loaded from.
+     */
+    void registerFont(const sf::Font& font, const std::string& path);
+
+    /**
+     * @brief Forget a font registered with registerFont (call before destroying it).
+     *
+     * @param font Font previously registered.
+     */
+    void unregisterFont(const sf::Font& font);
+
+    /**
+     * @brief Add the faces and fixed strings of the texts the renderer draws itself
+     *        (map/schedule buttons, resting label).
+     *
+     * @param glyphs Prewarmer collecting the game's glyphs.
+     */
+    void addGlyphFaces(GlyphPrewarmer& glyphs) const;
+
+    /**
+     * @brief Rasterize the collected glyphs into every registered font up front.
+     *
+     * Warms the game's fonts and, while the render thread runs, its copies of
+     * them, so no text drawn later renders glyphs mid-frame. Call again after
+     * adding strings (e.g. the labels of a newly loaded map); glyphs already
+     * cached are only looked up.
+     *
+     * @param glyphs Faces and characters to warm.
+     */
+    void prewarmGlyphs(const GlyphPrewarmer& glyphs);
+
+    /*
+     * Class: RenderThreadPause
+     * Description: RAII guard suspending the render thread while the calling thread
+     *              uses the window directly (nested screens) or frees resources that
+     *              published snapshots may reference (map switches). Nestable.
+     */
+    class RenderThreadPause {
+    public:
+        explicit RenderThreadPause(Renderer& renderer);
+        ~RenderThreadPause();
+
+        RenderThreadPause(const RenderThreadPause&) = delete;
+        RenderThreadPause& operator=(const RenderThreadPause&) = delete;
+
+    private:
+        Renderer& renderer;
+    };
     
+    /**
+     * @brief Start drawing the world (tiles, NPCs, character, labels) for this frame.
+     *
+     * Resets the world draw queue; submitted commands are sorted and batched in endWorldPass.
+     * When AppConfig::performance.lowResWorld is enabled the world is drawn into an
+     * off-screen texture that has one texel per world pixel of the current view,
+     * so fill cost depends on the art resolution instead of the window size.
+     */
+    void beginWorldPass();
+
+    /**
+     * @brief Flush the world draw queue and upscale the result to the window
+     *        with nearest-neighbour sampling (when lowResWorld is enabled).
+     *
+     * Afterwards the window view maps world coordinates onto the upscaled image,
+     * so world-space draws made later in the frame stay aligned. UI is drawn at
+     * full window resolution on top.
+     */
+    void endWorldPass();
+
+    /**
+     * @brief Queue a sprite for the world pass (sorted and batched at endWorldPass).
+     *
+     * @param sprite Sprite to draw; its texture must stay alive until the pass ends.
+     * @param layer Draw layer.
+     * @param depth Ordering inside the layer (e.g. Tiled layer index or feet y).
+     */
+    void submitSprite(const sf::Sprite& sprite, DrawLayer layer, float depth = 0.f) {
+        worldQueue().submit(sprite, layer, depth);
+    }
+
+    /**
+     * @brief Queue a copy of any drawable (text, shapes) for the world pass.
+     *
+     * @param drawable Drawable to copy.
+     * @param layer Draw layer.
+     * @param depth Ordering inside the layer.
+     */
+    template <typename T>
+    void submitDrawable(const T& drawable, DrawLayer layer, float depth = 0.f) {
+        worldQueue().submitDrawable(drawable, layer, depth);
+    }
+
+    /**
+     * @brief Queue a triangle list (world coordinates) for the world pass.
+     *
+     * @param triangles Vertex array with PrimitiveType::Triangles; copied into the queue.
+     * @param texture Texture to sample (must outlive the pass), or nullptr for flat color.
+     * @param layer Draw layer.
+     * @param depth Ordering inside the layer.
+     */
+    void submitTriangles(const sf::VertexArray& triangles, const sf::Texture* texture,
+                         DrawLayer layer, float depth = 0.f) {
+        worldQueue().submit(triangles, texture, layer, depth);
+    }
+
+    /**
+     * @brief Queue a copy of a drawable for the HUD, in window (default view) coordinates.
+     *
+     * HUD commands are drawn in submission order on top of the world at present().
+     *
+     * @param drawable Drawable to copy (its texture and font must outlive the frame).
+     */
+    template <typename T>
+    void submitUi(const T& drawable) {
+        uiQueue().submitDrawable(drawable, DrawLayer::Effects, static_cast<float>(uiSequence++));
+    }
+
+    /**
+     * @brief Queue a triangle list for the HUD, in window (default view) coordinates.
+     *
+     * Lets retained UI (see WidgetTree) draw all panels sharing a texture in one call.
+     *
+     * @param triangles Vertex array with PrimitiveType::Triangles.
+     * @param texture Texture to sample (must outlive the frame), or nullptr for flat color.
+     */
+    void submitUiTriangles(const sf::VertexArray& triangles, const sf::Texture* texture) {
+        uiQueue().submit(triangles, texture, DrawLayer::Effects, static_cast<float>(uiSequence++));
+    }
+
+    /**
+     * @brief Draw calls, texture binds and vertices of the last flushed world pass.
+     *
+     * @return DrawStats Stats of the previous frame (drawn by the render thread when it runs).
+     */
+    DrawStats getFrameStats() const;
+
+    /**
+     * @brief Target that world-space drawing should go to for the current frame.
+     *
+     * @return sf::RenderTarget& The world texture during a low-res world pass, otherwise the window.
+     */
+    sf::RenderTarget& worldTarget() {
+        if (worldPassActive) return worldTexture;
+        return window;
+    }
+
     /**
      * @brief Loads a texture from the specified file path.
      * 
@@ -174,15 +435,40 @@ public:
      * 
      * @return std::optional<sf::Event> Optional event if available.
      */
-    std::optional<sf::Event> pollEvent() { 
-        return window.pollEvent(); 
-    }
+    std::optional<sf::Event> pollEvent();
+
+    /**
+     * @brief Time the event last returned by pollEvent() was taken from the OS queue.
+     *
+     * Events that ended an idle wait carry the time the wait saw them.
+     */
+    FramePacer::Clock::time_point getLastEventTime() const { return lastEventAt; }
+
+    /**
+     * @brief Mark the frame being recorded as the first one reacting to an input.
+     *
+     * When that frame's display() returns, the time since receivedAt is recorded
+     * as input-to-present latency (logged when frame pacing stops).
+     *
+     * @param receivedAt Time the input event was received (see getLastEventTime).
+     */
+    void noteInput(FramePacer::Clock::time_point receivedAt);
+
+    /**
+     * @brief Display a blocking modal window, recording the noted input's latency.
+     *
+     * Modal screens open their own window and replace present() while they run;
+     * call only while holding a RenderThreadPause.
+     *
+     * @param modal The modal window to display.
+     */
+    void presentModal(sf::RenderWindow& modal);
 
     
     /**
-     * @brief Quit the application (close window).
+     * @brief Quit the application (stop the render thread and close the window).
      */
-    void quit() { window.close(); }
+    void quit();
     
     /**
      * @brief Updates the camera position and clamps it to map boundaries.
@@ -196,6 +482,26 @@ public:
         int mapWidth, 
         int mapHeight
     );
+
+    /**
+     * @brief Change the zoom the camera eases toward, within mapDisplay's minZoom..maxZoom.
+     *
+     * @param steps Zoom steps (wheel notches); positive zooms in, each step by 10%.
+     */
+    void zoomBy(float steps);
+
+    /**
+     * @brief Ease the current zoom toward the requested one (call once per frame
+     *        before updateCamera, which sizes the view from it).
+     *
+     * @param deltaTime Elapsed time in seconds.
+     */
+    void updateZoom(float deltaTime);
+
+    /**
+     * @brief Current zoom: 1 shows the default view, below 1 more of the map.
+     */
+    float getZoom() const { return zoom; }
     
     /**
      * @brief Checks if the render window is open.
@@ -225,22 +531,46 @@ public:
     void renderTextObjects(const std::vector<TextObject>& textObjects);
     
     /**
-     * @brief Renders entrance areas as semi-transparent rectangles
+     * @brief Queue a map's tile geometry on DrawLayer::Ground, one triangle list per tile run.
+     *
+     * Runs keep the Tiled layer index as depth, so the stacking matches submitting
+     * every tile sprite, and animated tiles show their current frame.
+     *
+     * @param map Map providing the geometry (see TMJMap::getTileVertices).
      */
-    void renderEntranceAreas(const std::vector<EntranceArea>& areas);
+    void renderMapTiles(const TMJMap& map);
 
     /**
-     * @brief Renders game trigger areas (from Tiled object layer "game_triggers").
-     *        Each GameTriggerArea can be highlighted differently by gameType.
+     * @brief Renders entrance, game trigger and shop trigger areas of a map in one draw call.
+     *
+     * Fill and outline geometry for all areas is baked into a single vertex array
+     * the first time a map is drawn and rebuilt only when the map's trigger
+     * revision changes (new map, or addShopTrigger/addGameTrigger).
+     *
+     * @param map Map providing the trigger areas.
      */
-    void renderGameTriggerAreas(const std::vector<GameTriggerArea>& areas);
+    void renderTriggerOverlays(const TMJMap& map);
 
     /**
-     * @brief Renders shop trigger areas.
-     * 
-     * @param areas Vector of shop trigger areas to render.
+     * @brief Tint the world for night time.
+     *
+     * Covers the whole window from the UI pass, or, when the quality governor
+     * asks for it, only the world from the (low-res) world pass.
+     *
+     * @param tint Overlay color; its alpha sets the darkness.
+     */
+    void renderNightOverlay(sf::Color tint);
+
+    /**
+     * @brief Darken the world for night time, leaving the map's lamps lit.
+     *
+     * Draws the map's baked Lightmap, one quad per visible chunk, in the world
+     * pass. Maps without lamps fall back to renderNightOverlay.
+     *
+     * @param map Map whose lightmap is drawn.
+     * @param tint Night color; its alpha sets the darkness, its rgb what survives of it.
      */
-    void renderShopTriggerAreas(const std::vector<ShopTrigger>& areas);
+    void renderNightLighting(const TMJMap& map, sf::Color tint);
     
     /**
      * @brief Render a simple modal prompt overlay using the UI/default view.
@@ -333,7 +663,7 @@ public:
      * @return true if texture loaded successfully, false if loading failed.
      */
     bool initializeChefTexture() {
-        if (!m_chefTexture.loadFromFile("tiles/F_05.png")) {
+        if (!loadActorTexture("tiles/F_05.png", m_chefTexture, m_chefImage)) {
             Logger::error("Failed to load chef texture: tiles/F_05.png");
             return false;
         }
@@ -352,7 +682,7 @@ public:
      */
     void renderChefs(const std::vector<Chef>& chefs) {
 
-        if (!m_chefSprite || !m_chefTexture.getSize().x) return;
+        if (!m_chefSprite) return;
         for (const auto& chef : chefs) {
        
             sf::Vector2f spritePos(
@@ -360,7 +690,7 @@ public:
                 chef.rect.position.y + chef.rect.size.y / 2 - 8.5f 
             );
             m_chefSprite->setPosition(spritePos);
-            window.draw(*m_chefSprite);  
+            worldQueue().submit(*m_chefSprite, DrawLayer::Actors, chef.rect.position.y + chef.rect.size.y);  
         }
     }
 
@@ -373,6 +703,111 @@ public:
     void renderRestingText(const sf::Vector2f& characterPos, const sf::Font& font); 
 
 private:
+    /**
+     * @brief Load an NPC sprite sheet; headless renderers keep it as a CPU image
+     *        registered against the (empty) texture instead of uploading it.
+     *
+     * @param path Image file path.
+     * @param texture Texture sprites will reference.
+     * @param image Image receiving the pixels in headless mode.
+     * @return true if the sheet was loaded.
+     */
+    bool loadActorTexture(const std::string& path, sf::Texture& texture, sf::Image& image);
+
+    /**
+     * @brief Read optional trigger style overrides from render_config.json.
+     */
+    void loadStyleOverrides();
+
+    /**
+     * @brief Whether world-pass drawing has a destination (open window or headless frame).
+     */
+    bool canDrawWorld() const { return window.isOpen() || softwareBackend != nullptr; }
+
+    /**
+     * @brief Queues the current frame records into: the snapshot being recorded when
+     *        the render thread runs, otherwise the renderer's own queues.
+     */
+    DrawQueue& worldQueue() { return recordsSnapshots() ? recordingFrame().world : drawQueue; }
+    DrawQueue& uiQueue() { return recordsSnapshots() ? recordingFrame().ui : hudQueue; }
+
+    /**
+     * @brief Whether frames are recorded into snapshots (frame pacing started and not paused).
+     */
+    bool recordsSnapshots() const { return framePacing && renderPauseDepth == 0; }
+
+    /**
+     * @brief Snapshot being recorded this frame; started on first use after present().
+     */
+    FrameSnapshot& recordingFrame();
+
+    /**
+     * @brief Configured clear color as an sf::Color.
+     */
+    sf::Color clearColorValue() const;
+
+    /**
+     * @brief Point worldTarget() at the low-res world texture (when enabled) for a camera.
+     *
+     * The texture is sized from the unzoomed camera, so zooming maps more or less
+     * world into the same texture instead of reallocating it.
+     *
+     * @param camera World camera of the frame.
+     * @param unzoomedSize Camera size at zoom 1 (one texel per world pixel there).
+     * @param scale Resolution multiplier (quality governor); below 1 an off-screen
+     *              target is used even without lowResWorld.
+     */
+    void setupWorldTarget(const sf::View& camera, const sf::Vector2f& unzoomedSize, float scale = 1.f);
+
+    /**
+     * @brief Upscale the low-res world texture onto the window (no-op without one).
+     *
+     * @param camera World camera of the frame.
+     */
+    void compositeWorld(const sf::View& camera);
+
+    /**
+     * @brief Render thread body: draw the newest snapshot, honour pause/stop requests.
+     */
+    void renderThreadMain();
+
+    /**
+     * @brief Draw one snapshot into the window and display it (on the thread owning the context).
+     *
+     * @param frame Snapshot to draw.
+     */
+    void renderSnapshot(FrameSnapshot& frame);
+
+    void pauseRenderThread();
+    void resumeRenderThread();
+
+    /**
+     * @brief Wait for the next loop tick after a frame was presented or skipped.
+     *
+     * @param idle Tick at the idle rate and return early on input.
+     */
+    void paceFrame(bool idle);
+
+    /**
+     * @brief Take the zoom limits from mapDisplay and start at defaultZoom.
+     *
+     * @param viewSize View size at zoom 1.
+     */
+    void configureZoom(const sf::Vector2f& viewSize);
+
+    /**
+     * @brief Sleep until the deadline unless an event arrives first (kept in pendingEvent).
+     *
+     * @param deadline End of the idle tick.
+     */
+    void waitForInput(FramePacer::Clock::time_point deadline);
+
+    /**
+     * @brief Rebuild the baked trigger overlay vertex array from a map's trigger lists.
+     *
+     * @param map Map providing the trigger areas.
+     */
+    void rebuildTriggerOverlays(const TMJMap& map);
 
     bool running = true;
     bool modalActive = false;
@@ -382,9 +817,24 @@ private:
    
     sf::RenderWindow window;
     sf::View view;
+    sf::Vector2f baseViewSize;        // View size at zoom 1
+    float zoom = 1.f;                 // Current zoom, eases toward targetZoom
+    float targetZoom = 1.f;
+    float minZoom = 1.f;
+    float maxZoom = 1.f;
+    sf::RenderTexture worldTexture;   // Native-resolution world target (lowResWorld)
+    bool worldPassActive = false;
+    DrawQueue drawQueue;              // World-pass command buffer, flushed in endWorldPass
+    DrawQueue hudQueue;               // HUD command buffer, flushed in present
+    uint32_t uiSequence = 0;          // Keeps HUD commands in submission order
+    std::vector<sf::Text> labelScratch;
+    unsigned int statsFrameCounter = 0;
+    std::unique_ptr<SoftwareRenderBackend> softwareBackend;   // Set only by initializeHeadless
     sf::Texture m_chefTexture;  
+    sf::Image m_chefImage;            // Headless copy of m_chefTexture
     std::unique_ptr<sf::Sprite> m_chefSprite;   
     sf::Texture m_professorTexture; 
+    sf::Image m_professorImage;       // Headless copy of m_professorTexture
     std::unique_ptr<sf::Sprite> m_professorSprite;  
     std::vector<std::unique_ptr<sf::Texture>> loadedTextures;
     std::unique_ptr<TextRenderer> textRenderer;
@@ -403,4 +853,59 @@ private:
     sf::Color shopTriggerFillColor = sf::Color(255, 165, 0, 100); 
     sf::Color shopTriggerOutlineColor = sf::Color(255, 140, 0, 255);
     float shopTriggerOutlineThickness = 2.f;
+
+    // Trigger overlay triangles; the arena is reset whenever they are rebuilt
+    Arena triggerArena{"trigger overlays", 16 * 1024};
+    std::pmr::vector<sf::Vertex> triggerOverlay{&triggerArena};
+    uint64_t triggerOverlayRevision = 0;
+
+    // Geometry built while recording a frame (night lighting quads), reset in beginWorldPass
+    Arena frameScratch{"render scratch", 16 * 1024};
+
+    // Render thread (see startRenderThread). Only the render thread touches the
+    // window's context while it runs; the rest is guarded by renderMutex.
+    std::thread renderThread;
+    bool renderThreadRunning = false;
+    TripleBuffer<FrameSnapshot> snapshots;
+    FrameSnapshot* recording = nullptr;
+    uint64_t recordedFrames = 0;
+    mutable std::mutex renderMutex;
+    std::condition_variable renderCondition;
+    bool renderStopRequested = false;
+    int renderPauseDepth = 0;
+    bool renderPaused = false;
+    DrawStats renderedStats;
+    std::unordered_map<const sf::Font*, std::unique_ptr<sf::Font>> renderFonts;   // Game font -> render-thread copy
+    MemoryCharge glyphPageMemory{"global", MemoryTag::Fonts, MemoryKind::Gpu};      // Pages of the prewarmed sizes
+
+    // Frame pacing (see startFramePacing). adaptiveVSync and vsyncApplied belong to
+    // the thread that calls display(); vsyncWanted carries its decision across.
+    bool framePacing = false;
+    FramePacer framePacer;
+    AdaptiveVSync adaptiveVSync;
+    std::atomic<bool> vsyncWanted{false};
+    bool vsyncApplied = false;
+    FramePacer::Clock::time_point lastDisplayAt{};
+    FramePacer::Clock::time_point lastTickAt{};  // End of the previous paceFrame
+    std::optional<sf::Event> pendingEvent;      // Event that ended an idle wait
+    FramePacer::Clock::time_point pendingEventAt{};
+    FramePacer::Clock::time_point lastEventAt{};
+    FramePacer::Clock::time_point frameInputAt{};   // Oldest input of the frame being recorded
+    InputLatency inputLatency;                      // Owned by the thread calling display()
+    bool inputSinceFrame = true;
+    bool windowFocused = true;
+    uint64_t lastDrawnDigest = 0;
+    FramePacer::Clock::time_point lastDrawnAt{};
+    uint64_t pacedFramesDrawn = 0;
+    uint64_t pacedFramesSkipped = 0;
+    uint64_t idleTicks = 0;
+
+    // Quality governor, fed with the work time of drawn frames (see getQuality).
+    QualityGovernor qualityGovernor;
+    std::atomic<double> lastRenderMs{0.0};     // Drawing time of the last snapshot
+
+    /**
+     * @brief Push the governor's settings to the text renderer and log the change.
+     */
+    void applyQuality();
 };
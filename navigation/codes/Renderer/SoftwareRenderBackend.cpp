@@ -0,0 +1,407 @@
+// SoftwareRenderBackend.cpp
+#include "Renderer/SoftwareRenderBackend.h"
+#include <algorithm>
+#include <cmath>
+
+/*
+ * File: SoftwareRenderBackend.cpp
+ * Description: Edge-function CPU rasterizer for the headless render backend.
+ *
+ * Triangles are filled by testing pixel centers against edge functions inside
+ * the triangle's clipped bounding box. A top-left style tie-break keeps pixels
+ * on an edge shared by two triangles (e.g. the diagonal of a sprite quad) from
+ * being blended twice. Text and rectangle shapes are reduced to axis-aligned
+ * pixel rectangles.
+ */
+
+namespace {
+    // Classic 5x7 font for ASCII 0x20..0x7E. One byte per column, bit 0 = top row.
+    const uint8_t kFont5x7[95][5] = {
+        {0x00,0x00,0x00,0x00,0x00}, {0x00,0x00,0x5F,0x00,0x00}, {0x00,0x07,0x00,0x07,0x00}, {0x14,0x7F,0x14,0x7F,0x14},
+        {0x24,0x2A,0x7F,0x2A,0x12}, {0x23,0x13,0x08,0x64,0x62}, {0x36,0x49,0x55,0x22,0x50}, {0x00,0x05,0x03,0x00,0x00},
+        {0x00,0x1C,0x22,0x41,0x00}, {0x00,0x41,0x22,0x1C,0x00}, {0x14,0x08,0x3E,0x08,0x14}, {0x08,0x08,0x3E,0x08,0x08},
+        {0x00,0x50,0x30,0x00,0x00}, {0x08,0x08,0x08,0x08,0x08}, {0x00,0x60,0x60,0x00,0x00}, {0x20,0x10,0x08,0x04,0x02},
+        {0x3E,0x51,0x49,0x45,0x3E}, {0x00,0x42,0x7F,0x40,0x00}, {0x42,0x61,0x51,0x49,0x46}, {0x21,0x41,0x45,0x4B,0x31},
+        {0x18,0x14,0x12,0x7F,0x10}, {0x27,0x45,0x45,0x45,0x39}, {0x3C,0x4A,0x49,0x49,0x30}, {0x01,0x71,0x09,0x05,0x03},
+        {0x36,0x49,0x49,0x49,0x36}, {0x06,0x49,0x49,0x29,0x1E}, {0x00,0x36,0x36,0x00,0x00}, {0x00,0x56,0x36,0x00,0x00},
+        {0x08,0x14,0x22,0x41,0x00}, {0x14,0x14,0x14,0x14,0x14}, {0x00,0x41,0x22,0x14,0x08}, {0x02,0x01,0x51,0x09,0x06},
+        {0x32,0x49,0x79,0x41,0x3E}, {0x7E,0x11,0x11,0x11,0x7E}, {0x7F,0x49,0x49,0x49,0x36}, {0x3E,0x41,0x41,0x41,0x22},
+        {0x7F,0x41,0x41,0x22,0x1C}, {0x7F,0x49,0x49,0x49,0x41}, {0x7F,0x09,0x09,0x09,0x01}, {0x3E,0x41,0x49,0x49,0x7A},
+        {0x7F,0x08,0x08,0x08,0x7F}, {0x00,0x41,0x7F,0x41,0x00}, {0x20,0x40,0x41,0x3F,0x01}, {0x7F,0x08,0x14,0x22,0x41},
+        {0x7F,0x40,0x40,0x40,0x40}, {0x7F,0x02,0x0C,0x02,0x7F}, {0x7F,0x04,0x08,0x10,0x7F}, {0x3E,0x41,0x41,0x41,0x3E},
+        {0x7F,0x09,0x09,0x09,0x06}, {0x3E,0x41,0x51,0x21,0x5E}, {0x7F,0x09,0x19,0x29,0x46}, {0x46,0x49,0x49,0x49,0x31},
+        {0x01,0x01,0x7F,0x01,0x01}, {0x3F,0x40,0x40,0x40,0x3F}, {0x1F,0x20,0x40,0x20,0x1F}, {0x3F,0x40,0x38,0x40,0x3F},
+        {0x63,0x14,0x08,0x14,0x63}, {0x07,0x08,0x70,0x08,0x07}, {0x61,0x51,0x49,0x45,0x43}, {0x00,0x7F,0x41,0x41,0x00},
+        {0x02,0x04,0x08,0x10,0x20}, {0x00,0x41,0x41,0x7F,0x00}, {0x04,0x02,0x01,0x02,0x04}, {0x40,0x40,0x40,0x40,0x40},
+        {0x00,0x01,0x02,0x04,0x00}, {0x20,0x54,0x54,0x54,0x78}, {0x7F,0x48,0x44,0x44,0x38}, {0x38,0x44,0x44,0x44,0x20},
+        {0x38,0x44,0x44,0x48,0x7F}, {0x38,0x54,0x54,0x54,0x18}, {0x08,0x7E,0x09,0x01,0x02}, {0x0C,0x52,0x52,0x52,0x3E},
+        {0x7F,0x08,0x04,0x04,0x78}, {0x00,0x44,0x7D,0x40,0x00}, {0x20,0x40,0x44,0x3D,0x00}, {0x7F,0x10,0x28,0x44,0x00},
+        {0x00,0x41,0x7F,0x40,0x00}, {0x7C,0x04,0x18,0x04,0x78}, {0x7C,0x08,0x04,0x04,0x78}, {0x38,0x44,0x44,0x44,0x38},
+        {0x7C,0x14,0x14,0x14,0x08}, {0x08,0x14,0x14,0x18,0x7C}, {0x7C,0x08,0x04,0x04,0x08}, {0x48,0x54,0x54,0x54,0x20},
+        {0x04,0x3F,0x44,0x40,0x20}, {0x3C,0x40,0x40,0x20,0x7C}, {0x1C,0x20,0x40,0x20,0x1C}, {0x3C,0x40,0x30,0x40,0x3C},
+        {0x44,0x28,0x10,0x28,0x44}, {0x0C,0x50,0x50,0x50,0x3C}, {0x44,0x64,0x54,0x4C,0x44}, {0x00,0x08,0x36,0x41,0x00},
+        {0x00,0x00,0x7F,0x00,0x00}, {0x00,0x41,0x36,0x08,0x00}, {0x08,0x04,0x08,0x10,0x08}
+    };
+
+    // Layout of the bitmap font in units of characterSize / 8.
+    constexpr float kGlyphAdvance = 6.f;
+    constexpr float kGlyphHeight = 7.f;
+    constexpr float kLineAdvance = 10.f;
+
+    const uint8_t* glyphFor(char32_t ch) {
+        if (ch < 0x20 || ch > 0x7E) ch = U'?';
+        return kFont5x7[ch - 0x20];
+    }
+
+    float edge(const sf::Vector2f& a, const sf::Vector2f& b, float px, float py) {
+        return (b.x - a.x) * (py - a.y) - (b.y - a.y) * (px - a.x);
+    }
+
+    // Exactly one of an edge and its reverse owns pixel centers lying on it.
+    bool ownsEdge(const sf::Vector2f& a, const sf::Vector2f& b) {
+        const float dy = b.y - a.y;
+        return dy > 0.f || (dy == 0.f && b.x < a.x);
+    }
+
+    bool insideEdge(float e, bool owns) {
+        return e > 0.f || (e == 0.f && owns);
+    }
+
+    uint8_t modulate(uint8_t a, uint8_t b) {
+        return static_cast<uint8_t>((static_cast<unsigned>(a) * b + 127u) / 255u);
+    }
+}
+
+
+SoftwareRenderBackend::SoftwareRenderBackend(sf::Vector2u frameSize) {
+    resize(frameSize);
+}
+
+
+void SoftwareRenderBackend::resize(sf::Vector2u newSize) {
+    size = newSize;
+    pixels.assign(static_cast<size_t>(size.x) * size.y * 4u, 0);
+    setView(sf::View(
+        sf::Vector2f(static_cast<float>(size.x) * 0.5f, static_cast<float>(size.y) * 0.5f),
+        sf::Vector2f(static_cast<float>(size.x), static_cast<float>(size.y))
+    ));
+}
+
+
+void SoftwareRenderBackend::registerTexture(const sf::Texture* texture, const sf::Image* image) {
+    if (!texture) return;
+    if (image) textures[texture] = image;
+    else textures.erase(texture);
+}
+
+
+void SoftwareRenderBackend::setView(const sf::View& view) {
+    const sf::Vector2f viewSize = view.getSize();
+    const sf::FloatRect& vp = view.getViewport();
+    const float fw = static_cast<float>(size.x);
+    const float fh = static_cast<float>(size.y);
+
+    viewportOffset = sf::Vector2f(vp.position.x * fw, vp.position.y * fh);
+    viewScale = sf::Vector2f(
+        viewSize.x != 0.f ? vp.size.x * fw / viewSize.x : 1.f,
+        viewSize.y != 0.f ? vp.size.y * fh / viewSize.y : 1.f
+    );
+    viewTopLeft = view.getCenter() - viewSize * 0.5f;
+
+    clipLeft = std::clamp(static_cast<int>(std::lround(viewportOffset.x)), 0, static_cast<int>(size.x));
+    clipTop = std::clamp(static_cast<int>(std::lround(viewportOffset.y)), 0, static_cast<int>(size.y));
+    clipRight = std::clamp(static_cast<int>(std::lround(viewportOffset.x + vp.size.x * fw)), 0, static_cast<int>(size.x));
+    clipBottom = std::clamp(static_cast<int>(std::lround(viewportOffset.y + vp.size.y * fh)), 0, static_cast<int>(size.y));
+}
+
+
+sf::Vector2f SoftwareRenderBackend::toPixel(sf::Vector2f world) const {
+    return sf::Vector2f(
+        (world.x - viewTopLeft.x) * viewScale.x + viewportOffset.x,
+        (world.y - viewTopLeft.y) * viewScale.y + viewportOffset.y
+    );
+}
+
+
+void SoftwareRenderBackend::clear(sf::Color color) {
+    for (size_t i = 0; i < pixels.size(); i += 4) {
+        pixels[i] = color.r;
+        pixels[i + 1] = color.g;
+        pixels[i + 2] = color.b;
+        pixels[i + 3] = color.a;
+    }
+}
+
+
+void SoftwareRenderBackend::blend(size_t index, sf::Color c) {
+    uint8_t* dst = &pixels[index];
+    ++stats.pixelsShaded;
+    if (c.a == 255) {
+        dst[0] = c.r; dst[1] = c.g; dst[2] = c.b; dst[3] = 255;
+        return;
+    }
+    if (c.a == 0) return;
+
+    // sf::BlendAlpha: rgb = src * srcA + dst * (1 - srcA), a = srcA + dstA * (1 - srcA)
+    const unsigned a = c.a;
+    const unsigned ia = 255u - a;
+    dst[0] = static_cast<uint8_t>((c.r * a + dst[0] * ia + 127u) / 255u);
+    dst[1] = static_cast<uint8_t>((c.g * a + dst[1] * ia + 127u) / 255u);
+    dst[2] = static_cast<uint8_t>((c.b * a + dst[2] * ia + 127u) / 255u);
+    dst[3] = static_cast<uint8_t>(a + (dst[3] * ia + 127u) / 255u);
+}
+
+
+void SoftwareRenderBackend::darken(size_t index, sf::Color c) {
+    uint8_t* dst = &pixels[index];
+    ++stats.pixelsShaded;
+    dst[0] = static_cast<uint8_t>((dst[0] * (255u - c.r) + 127u) / 255u);
+    dst[1] = static_cast<uint8_t>((dst[1] * (255u - c.g) + 127u) / 255u);
+    dst[2] = static_cast<uint8_t>((dst[2] * (255u - c.b) + 127u) / 255u);
+}
+
+
+void SoftwareRenderBackend::fillPixelRect(float left, float top, float right, float bottom, sf::Color color) {
+    if (color.a == 0) return;
+
+    // Cover pixels whose centers fall inside [left, right) x [top, bottom)
+    const int x0 = std::max(clipLeft, static_cast<int>(std::ceil(left - 0.5f)));
+    const int x1 = std::min(clipRight, static_cast<int>(std::ceil(right - 0.5f)));
+    const int y0 = std::max(clipTop, static_cast<int>(std::ceil(top - 0.5f)));
+    const int y1 = std::min(clipBottom, static_cast<int>(std::ceil(bottom - 0.5f)));
+
+    for (int y = y0; y < y1; ++y) {
+        size_t index = (static_cast<size_t>(y) * size.x + static_cast<size_t>(x0)) * 4u;
+        for (int x = x0; x < x1; ++x, index += 4u) {
+            blend(index, color);
+        }
+    }
+}
+
+
+void SoftwareRenderBackend::rasterTriangle(
+    const sf::Vertex& va,
+    const sf::Vertex& vb,
+    const sf::Vertex& vc,
+    const sf::Image* texture,
+    DrawBlend mode
+) {
+    const sf::Vertex* v0 = &va;
+    const sf::Vertex* v1 = &vb;
+    const sf::Vertex* v2 = &vc;
+    sf::Vector2f p0 = toPixel(v0->position);
+    sf::Vector2f p1 = toPixel(v1->position);
+    sf::Vector2f p2 = toPixel(v2->position);
+
+    float area = edge(p0, p1, p2.x, p2.y);
+    if (std::abs(area) < 1e-6f) return;
+    if (area < 0.f) {
+        std::swap(v1, v2);
+        std::swap(p1, p2);
+        area = -area;
+    }
+
+    const int minX = std::max(clipLeft, static_cast<int>(std::floor(std::min({p0.x, p1.x, p2.x}))));
+    const int maxX = std::min(clipRight - 1, static_cast<int>(std::ceil(std::max({p0.x, p1.x, p2.x}))));
+    const int minY = std::max(clipTop, static_cast<int>(std::floor(std::min({p0.y, p1.y, p2.y}))));
+    const int maxY = std::min(clipBottom - 1, static_cast<int>(std::ceil(std::max({p0.y, p1.y, p2.y}))));
+    if (minX > maxX || minY > maxY) return;
+
+    const bool own12 = ownsEdge(p1, p2);
+    const bool own20 = ownsEdge(p2, p0);
+    const bool own01 = ownsEdge(p0, p1);
+    const float invArea = 1.f / area;
+
+    const bool flatColor = v0->color == v1->color && v1->color == v2->color;
+    const uint8_t* texels = texture ? texture->getPixelsPtr() : nullptr;
+    const int texW = texture ? static_cast<int>(texture->getSize().x) : 0;
+    const int texH = texture ? static_cast<int>(texture->getSize().y) : 0;
+    if (texW == 0 || texH == 0) texels = nullptr;
+
+    for (int y = minY; y <= maxY; ++y) {
+        const float py = static_cast<float>(y) + 0.5f;
+        for (int x = minX; x <= maxX; ++x) {
+            const float px = static_cast<float>(x) + 0.5f;
+            const float e0 = edge(p1, p2, px, py);
+            const float e1 = edge(p2, p0, px, py);
+            const float e2 = edge(p0, p1, px, py);
+            if (!insideEdge(e0, own12) || !insideEdge(e1, own20) || !insideEdge(e2, own01)) continue;
+
+            const float w0 = e0 * invArea;
+            const float w1 = e1 * invArea;
+            const float w2 = e2 * invArea;
+
+            sf::Color color = v0->color;
+            if (!flatColor) {
+                auto mix = [&](uint8_t c0, uint8_t c1, uint8_t c2) {
+                    const float c = w0 * c0 + w1 * c1 + w2 * c2;
+                    return static_cast<uint8_t>(std::clamp(std::lround(c), 0L, 255L));
+                };
+                color = sf::Color(
+                    mix(v0->color.r, v1->color.r, v2->color.r),
+                    mix(v0->color.g, v1->color.g, v2->color.g),
+                    mix(v0->color.b, v1->color.b, v2->color.b),
+                    mix(v0->color.a, v1->color.a, v2->color.a)
+                );
+            }
+
+            if (texels) {
+                const float u = w0 * v0->texCoords.x + w1 * v1->texCoords.x + w2 * v2->texCoords.x;
+                const float v = w0 * v0->texCoords.y + w1 * v1->texCoords.y + w2 * v2->texCoords.y;
+                const int tx = std::clamp(static_cast<int>(std::floor(u)), 0, texW - 1);
+                const int ty = std::clamp(static_cast<int>(std::floor(v)), 0, texH - 1);
+                const uint8_t* t = texels + (static_cast<size_t>(ty) * static_cast<size_t>(texW) + static_cast<size_t>(tx)) * 4u;
+                color = sf::Color(
+                    modulate(t[0], color.r),
+                    modulate(t[1], color.g),
+                    modulate(t[2], color.b),
+                    modulate(t[3], color.a)
+                );
+            }
+
+            const size_t index = (static_cast<size_t>(y) * size.x + static_cast<size_t>(x)) * 4u;
+            if (mode == DrawBlend::Darken) darken(index, color);
+            else blend(index, color);
+        }
+    }
+}
+
+
+void SoftwareRenderBackend::drawTriangles(
+    const sf::Vertex* vertices,
+    std::size_t count,
+    const sf::Texture* texture,
+    const sf::Shader* /*shader*/,
+    DrawBlend mode
+) {
+    const sf::Image* image = nullptr;
+    if (texture) {
+        auto it = textures.find(texture);
+        if (it != textures.end()) image = it->second;
+        else ++stats.missingTextures;
+    }
+
+    for (std::size_t i = 0; i + 2 < count; i += 3) {
+        rasterTriangle(vertices[i], vertices[i + 1], vertices[i + 2], image, mode);
+        ++stats.triangles;
+    }
+}
+
+
+void SoftwareRenderBackend::drawRect(const sf::RectangleShape& rect) {
+    ++stats.rects;
+
+    const sf::Transform& xf = rect.getTransform();
+    auto fillLocal = [&](float l, float t, float r, float b, sf::Color color) {
+        const sf::Vector2f a = toPixel(xf.transformPoint({l, t}));
+        const sf::Vector2f c = toPixel(xf.transformPoint({r, b}));
+        fillPixelRect(std::min(a.x, c.x), std::min(a.y, c.y), std::max(a.x, c.x), std::max(a.y, c.y), color);
+    };
+
+    const sf::Vector2f sz = rect.getSize();
+    fillLocal(0.f, 0.f, sz.x, sz.y, rect.getFillColor());
+
+    const float thickness = rect.getOutlineThickness();
+    if (thickness == 0.f) return;
+
+    // Same bands as sf::RectangleShape: outwards for positive thickness, inwards for negative
+    const float grow = std::max(thickness, 0.f);
+    const float shrink = std::max(-thickness, 0.f);
+    const float ol = -grow, ot = -grow, orr = sz.x + grow, ob = sz.y + grow;
+    const float il = shrink, it = shrink, ir = sz.x - shrink, ib = sz.y - shrink;
+    const sf::Color outline = rect.getOutlineColor();
+
+    fillLocal(ol, ot, orr, it, outline);
+    fillLocal(ol, ib, orr, ob, outline);
+    fillLocal(ol, it, il, ib, outline);
+    fillLocal(ir, it, orr, ib, outline);
+}
+
+
+void SoftwareRenderBackend::drawGlyphs(const sf::Text& text, sf::Color color, float grow) {
+    const float unit = static_cast<float>(text.getCharacterSize()) / 8.f;
+    if (unit <= 0.f || color.a == 0) return;
+
+    const uint32_t style = text.getStyle();
+    const float boldExtra = (style & sf::Text::Bold) ? unit * 0.5f : 0.f;
+    const bool italic = (style & sf::Text::Italic) != 0;
+    const sf::Transform& xf = text.getTransform();
+
+    float penX = 0.f;
+    float penY = 0.f;
+    for (char32_t ch : text.getString()) {
+        if (ch == U'\n') {
+            penX = 0.f;
+            penY += kLineAdvance * unit;
+            continue;
+        }
+
+        const uint8_t* glyph = glyphFor(ch);
+        for (int col = 0; col < 5; ++col) {
+            const uint8_t bits = glyph[col];
+            int row = 0;
+            while (row < 7) {
+                if (!(bits & (1u << row))) { ++row; continue; }
+
+                // Merge the vertical run of set pixels into one rectangle
+                int end = row;
+                while (end < 7 && (bits & (1u << end))) ++end;
+
+                const float shear = italic ? (kGlyphHeight - static_cast<float>(row)) * unit * 0.2f : 0.f;
+                const float l = penX + static_cast<float>(col) * unit + shear - grow;
+                const float t = penY + static_cast<float>(row) * unit - grow;
+                const float r = penX + static_cast<float>(col + 1) * unit + boldExtra + shear + grow;
+                const float b = penY + static_cast<float>(end) * unit + grow;
+
+                const sf::Vector2f a = toPixel(xf.transformPoint({l, t}));
+                const sf::Vector2f c = toPixel(xf.transformPoint({r, b}));
+                fillPixelRect(std::min(a.x, c.x), std::min(a.y, c.y), std::max(a.x, c.x), std::max(a.y, c.y), color);
+                row = end;
+            }
+        }
+        penX += kGlyphAdvance * unit;
+    }
+}
+
+
+void SoftwareRenderBackend::drawText(const sf::Text& text) {
+    ++stats.texts;
+    if (text.getOutlineThickness() > 0.f) {
+        drawGlyphs(text, text.getOutlineColor(), text.getOutlineThickness());
+    }
+    drawGlyphs(text, text.getFillColor(), 0.f);
+}
+
+
+void SoftwareRenderBackend::drawDrawable(const sf::Drawable& /*drawable*/) {
+    ++stats.unsupported;
+}
+
+
+sf::Image SoftwareRenderBackend::toImage() const {
+    if (size.x == 0 || size.y == 0) return sf::Image();
+    return sf::Image(size, pixels.data());
+}
+
+
+sf::Vector2f SoftwareRenderBackend::measureText(const sf::String& string, unsigned int characterSize) {
+    const float unit = static_cast<float>(characterSize) / 8.f;
+
+    size_t lines = 0;
+    size_t column = 0;
+    size_t widest = 0;
+    for (char32_t ch : string) {
+        if (lines == 0) lines = 1;
+        if (ch == U'\n') {
+            ++lines;
+            column = 0;
+            continue;
+        }
+        widest = std::max(widest, ++column);
+    }
+    if (lines == 0) return sf::Vector2f(0.f, 0.f);
+
+    const float width = widest > 0 ? (static_cast<float>(widest) * kGlyphAdvance - 1.f) * unit : 0.f;
+    const float height = (static_cast<float>(lines - 1) * kLineAdvance + kGlyphHeight) * unit;
+    return sf::Vector2f(width, height);
+}
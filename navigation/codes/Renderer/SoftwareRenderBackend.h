@@ -0,0 +1,148 @@
+// SoftwareRenderBackend.h
+#pragma once
+
+#include "Renderer/RenderBackend.h"
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * File: SoftwareRenderBackend.h
+ * Description: CPU rasterizer implementing RenderBackend for headless rendering.
+ *
+ * Frames are rendered into an in-memory RGBA8 buffer without touching OpenGL,
+ * so maps can be rendered on machines without a display or GPU (CI, benchmarks,
+ * golden-image comparisons).
+ *
+ * Notes:
+ *   - Textures are resolved through a registry mapping the sf::Texture a sprite
+ *     references to a CPU sf::Image with the same pixels (see TMJMap headless mode).
+ *     Both must outlive the frames that use them.
+ *   - Sampling is nearest-neighbour with straight alpha blending, matching the
+ *     smooth=false textures and sf::BlendAlpha used by the game (DrawBlend::Darken
+ *     is supported as well; smooth lightmap textures are sampled nearest too).
+ *   - Text is drawn with a built-in 5x7 bitmap font scaled to the character size;
+ *     it approximates layout and coverage, not the exact TrueType glyphs.
+ *   - Views are treated as axis-aligned (rotation is ignored).
+ */
+
+/**
+ * @struct SoftwareRasterStats
+ * @brief Work done by the rasterizer since the last resetStats.
+ */
+struct SoftwareRasterStats {
+    size_t triangles = 0;        ///< Triangles submitted
+    size_t texts = 0;            ///< Texts drawn
+    size_t rects = 0;            ///< Rectangle shapes drawn
+    size_t pixelsShaded = 0;     ///< Pixels blended into the frame
+    size_t missingTextures = 0;  ///< Draws whose texture had no registered image
+    size_t unsupported = 0;      ///< Drawables skipped because they cannot be rasterized
+};
+
+class SoftwareRenderBackend final : public RenderBackend {
+public:
+    /**
+     * @brief Create a backend rendering into a frame of the given size.
+     *
+     * @param frameSize Frame size in pixels.
+     */
+    explicit SoftwareRenderBackend(sf::Vector2u frameSize = {0u, 0u});
+
+    /**
+     * @brief Resize the frame (contents are cleared to transparent).
+     *
+     * @param size New frame size in pixels.
+     */
+    void resize(sf::Vector2u size);
+
+    sf::Vector2u getSize() const { return size; }
+
+    /**
+     * @brief Associate a texture with the CPU image holding its pixels.
+     *
+     * @param texture Texture referenced by sprites and vertex batches.
+     * @param pixels Image with the same contents; nullptr removes the entry.
+     */
+    void registerTexture(const sf::Texture* texture, const sf::Image* pixels);
+
+    /**
+     * @brief Forget all registered textures.
+     */
+    void clearTextures() { textures.clear(); }
+
+    void setView(const sf::View& view) override;
+    void clear(sf::Color color) override;
+    void drawTriangles(
+        const sf::Vertex* vertices,
+        std::size_t count,
+        const sf::Texture* texture,
+        const sf::Shader* shader,
+        DrawBlend mode
+    ) override;
+    void drawText(const sf::Text& text) override;
+    void drawRect(const sf::RectangleShape& rect) override;
+    void drawDrawable(const sf::Drawable& drawable) override;
+
+    /**
+     * @brief Raw RGBA8 pixels of the current frame, row-major, top row first.
+     *
+     * @return const std::vector<uint8_t>& Frame pixels (size.x * size.y * 4 bytes).
+     */
+    const std::vector<uint8_t>& getPixels() const { return pixels; }
+
+    /**
+     * @brief Copy the current frame into an image (e.g. to save it as PNG).
+     *
+     * @return sf::Image Frame contents.
+     */
+    sf::Image toImage() const;
+
+    const SoftwareRasterStats& getStats() const { return stats; }
+    void resetStats() { stats = SoftwareRasterStats(); }
+
+    /**
+     * @brief Size the built-in bitmap font gives a string, in text-local units.
+     *
+     * Used in place of sf::Text::getLocalBounds when laying out text headlessly,
+     * since querying real glyph metrics needs an OpenGL context.
+     *
+     * @param string Text to measure (newlines start new lines).
+     * @param characterSize Character size in pixels.
+     * @return sf::Vector2f Width and height of the text block.
+     */
+    static sf::Vector2f measureText(const sf::String& string, unsigned int characterSize);
+
+private:
+    sf::Vector2f toPixel(sf::Vector2f world) const;
+
+    void blend(size_t index, sf::Color color);
+
+    // DrawBlend::Darken: rgb = dst * (1 - color), alpha untouched
+    void darken(size_t index, sf::Color color);
+
+    void fillPixelRect(float left, float top, float right, float bottom, sf::Color color);
+
+    void rasterTriangle(
+        const sf::Vertex& a,
+        const sf::Vertex& b,
+        const sf::Vertex& c,
+        const sf::Image* texture,
+        DrawBlend mode
+    );
+
+    void drawGlyphs(const sf::Text& text, sf::Color color, float grow);
+
+    sf::Vector2u size;
+    std::vector<uint8_t> pixels;
+
+    // World -> pixel mapping of the current view, plus its viewport in pixels.
+    sf::Vector2f viewTopLeft;
+    sf::Vector2f viewScale{1.f, 1.f};
+    sf::Vector2f viewportOffset;
+    int clipLeft = 0, clipTop = 0, clipRight = 0, clipBottom = 0;
+
+    std::unordered_map<const sf::Texture*, const sf::Image*> textures;
+    SoftwareRasterStats stats;
+};
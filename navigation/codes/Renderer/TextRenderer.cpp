@@ -1,5 +1,6 @@
 // TextRenderer.cpp
 #include "TextRenderer.h"
+#include "Renderer/SoftwareRenderBackend.h"
 #include "Utils/Logger.h"
 #include <filesystem>
 
@@ -9,7 +10,7 @@
  *
  * The TextRenderer wraps font loading and provides routines to convert
  * TextObject descriptors into styled sf::Text instances and to render them
- * to an sf::RenderWindow.
+ * to an sf::RenderTarget (window or off-screen world texture).
  */
 
 TextRenderer::TextRenderer() {
@@ -67,11 +68,11 @@ void TextRenderer::cleanup() {
  * @brief Render multiple text objects.
  * 
  * @param textObjects Vector of text objects to render.
- * @param window Render window to draw text to.
+ * @param window Render target to draw text to.
  */
 void TextRenderer::renderTextObjects(
     const std::vector<TextObject>& textObjects, 
-    sf::RenderWindow& window
+    sf::RenderTarget& window
 ) {
     if (!fontLoaded) return;
     
@@ -84,11 +85,11 @@ void TextRenderer::renderTextObjects(
  * @brief Render single text object.
  * 
  * @param textObj Text object to render.
- * @param window Render window to draw text to.
+ * @param window Render target to draw text to.
  */
 void TextRenderer::renderText(
     const TextObject& textObj, 
-    sf::RenderWindow& window
+    sf::RenderTarget& window
 ) {
     if (!fontLoaded || textObj.text.empty()) return;
     
@@ -106,6 +107,34 @@ void TextRenderer::renderText(
     window.draw(text);
 }
 
+/**
+ * @brief Build the styled texts for text objects without drawing them.
+ * 
+ * @param textObjects Vector of text objects to convert.
+ * @param out Output vector the texts are appended to.
+ */
+void TextRenderer::buildTexts(
+    const std::vector<TextObject>& textObjects,
+    std::vector<sf::Text>& out
+) {
+    if (!fontLoaded) return;
+
+    for (const auto& textObj : textObjects) {
+        if (textObj.text.empty()) continue;
+
+        sf::Text text = createText(textObj);
+        applyTextAlignment(text, textObj);
+
+        if (text.getOutlineThickness() > 0) {
+            sf::Text outlineText = text;
+            outlineText.setFillColor(sf::Color::Black);
+            outlineText.setOutlineColor(sf::Color::Black);
+            out.push_back(outlineText);
+        }
+        out.push_back(text);
+    }
+}
+
 /**
  * @brief Create sf::Text from TextObject descriptor.
  * 
@@ -122,9 +151,9 @@ sf::Text TextRenderer::createText(const TextObject& textObj) {
     if (textObj.italic) style |= sf::Text::Italic;
     text.setStyle(style);
     
-    // Add outline for better readability on maps
+    // Add outline for better readability on maps (dropped by the quality governor)
     text.setOutlineColor(sf::Color(0, 0, 0, 160));
-    text.setOutlineThickness(1.0f);
+    text.setOutlineThickness(outlinesEnabled ? LabelOutline : 0.0f);
     
     return text;
 }
@@ -139,9 +168,11 @@ void TextRenderer::applyTextAlignment(
     sf::Text& text, 
     const TextObject& textObj
 ) {
-    sf::FloatRect localBounds = text.getLocalBounds();
-    float textWidth = localBounds.size.x;
-    float textHeight = localBounds.size.y;
+    const sf::Vector2f textSize = approximateMetrics
+        ? SoftwareRenderBackend::measureText(text.getString(), text.getCharacterSize())
+        : text.getLocalBounds().size;
+    float textWidth = textSize.x;
+    float textHeight = textSize.y;
     
     float posX = textObj.x;
     float posY = textObj.y;
@@ -46,22 +46,36 @@ public:
      * @brief Render multiple text objects.
      * 
      * @param textObjects Vector of text objects to render.
-     * @param window Render window to draw text to.
+     * @param window Render target to draw text to.
      */
     void renderTextObjects(
         const std::vector<TextObject>& textObjects, 
-        sf::RenderWindow& window
+        sf::RenderTarget& window
     );
 
     /**
      * @brief Render single text object.
      * 
      * @param textObj Text object to render.
-     * @param window Render window to draw text to.
+     * @param window Render target to draw text to.
      */
     void renderText(
         const TextObject& textObj, 
-        sf::RenderWindow& window
+        sf::RenderTarget& window
+    );
+
+    /**
+     * @brief Build the styled texts for text objects without drawing them.
+     *
+     * For each object the outline copy (if any) is appended before the text itself,
+     * so drawing the result in order matches renderTextObjects.
+     *
+     * @param textObjects Vector of text objects to convert.
+     * @param out Output vector the texts are appended to.
+     */
+    void buildTexts(
+        const std::vector<TextObject>& textObjects,
+        std::vector<sf::Text>& out
     );
 
     /**
@@ -71,9 +85,38 @@ public:
      */
     bool isFontLoaded() const { return fontLoaded; }
 
+    /**
+     * @brief Font the built texts reference.
+     * 
+     * @return const sf::Font* The font, or nullptr if none is loaded.
+     */
+    const sf::Font* getFont() const { return fontLoaded ? font.get() : nullptr; }
+
+    /**
+     * @brief Lay out texts with the software backend's bitmap font metrics.
+     *
+     * Real glyph metrics need an OpenGL context, so headless rendering uses
+     * SoftwareRenderBackend::measureText for alignment instead.
+     *
+     * @param enabled true to use approximate metrics.
+     */
+    void setApproximateMetrics(bool enabled) { approximateMetrics = enabled; }
+
+    /**
+     * @brief Enable or disable label outlines (each outline costs an extra text draw).
+     *
+     * @param enabled true to draw outlines.
+     */
+    void setOutlinesEnabled(bool enabled) { outlinesEnabled = enabled; }
+
+    /// Outline thickness of label texts (while outlines are enabled)
+    static constexpr float LabelOutline = 1.0f;
+
 private:
     std::unique_ptr<sf::Font> font;    ///< Font used for text rendering
     bool fontLoaded = false;    ///< Flag indicating whether font is loaded
+    bool approximateMetrics = false;    ///< Align with bitmap font metrics (headless)
+    bool outlinesEnabled = true;    ///< Draw outlines behind labels
 
     /**
      * @brief Create sf::Text from TextObject descriptor.
@@ -0,0 +1,168 @@
+// Minimap.cpp
+#include "UI/Minimap.h"
+#include "Renderer/Renderer.h"
+#include "Renderer/DrawQueue.h"
+#include "MapLoader/TMJMap.h"
+#include "Utils/Logger.h"
+#include <algorithm>
+
+namespace {
+
+constexpr float DisplaySide = 200.f;   // Longest on-screen side, window px
+constexpr float Supersample = 2.f;     // Texture texels per on-screen pixel
+constexpr float Margin = 16.f;         // Gap to the window's bottom-right corner
+constexpr float Border = 3.f;
+
+constexpr float EntranceMinSize = 3.f;   // Markers never shrink below this, window px
+constexpr float TargetMinSize = 6.f;
+constexpr float PlayerRadius = 4.f;
+
+const sf::Color FrameColor(20, 20, 30, 200);
+const sf::Color EntranceColor(0, 100, 255, 220);
+const sf::Color TargetColor(255, 200, 0, 230);
+const sf::Color PlayerColor(230, 40, 40);
+
+void appendQuad(sf::VertexArray& triangles, const sf::FloatRect& rect, sf::Color color) {
+    const sf::Vector2f a = rect.position;
+    const sf::Vector2f c = rect.position + rect.size;
+    const sf::Vector2f b(c.x, a.y);
+    const sf::Vector2f d(a.x, c.y);
+    for (const sf::Vector2f& p : {a, b, c, a, c, d}) {
+        triangles.append(sf::Vertex{p, color});
+    }
+}
+
+// Rect of at least minSize per side, grown around its center
+sf::FloatRect atLeast(const sf::FloatRect& rect, float minSize) {
+    const sf::Vector2f size(std::max(rect.size.x, minSize), std::max(rect.size.y, minSize));
+    const sf::Vector2f center = rect.position + rect.size / 2.f;
+    return sf::FloatRect(center - size / 2.f, size);
+}
+
+} // namespace
+
+
+bool Minimap::rebuild(const TMJMap& map, Renderer& renderer) {
+    ready = false;
+    origin = sf::Vector2f(-1.f, -1.f);
+    if (TMJMap::isHeadless()) return false;
+
+    worldSize = sf::Vector2f(static_cast<float>(map.getWorldPixelWidth()),
+                             static_cast<float>(map.getWorldPixelHeight()));
+    if (worldSize.x <= 0.f || worldSize.y <= 0.f) return false;
+
+    scale = DisplaySide / std::max(worldSize.x, worldSize.y);
+    displaySize = worldSize * scale;
+    const sf::Vector2u texSize(
+        std::max(1u, static_cast<unsigned>(displaySize.x * Supersample)),
+        std::max(1u, static_cast<unsigned>(displaySize.y * Supersample)));
+
+    Renderer::RenderThreadPause pause(renderer);
+
+    if (texture.getSize() != texSize && !texture.resize(texSize)) {
+        Logger::error("Minimap: cannot create a " + std::to_string(texSize.x) + "x" +
+                      std::to_string(texSize.y) + " render texture");
+        gpuMemory.release();
+        return false;
+    }
+    texture.setSmooth(true);
+    texture.setView(sf::View(sf::FloatRect({0.f, 0.f}, worldSize)));
+    texture.clear(sf::Color::Transparent);
+
+    // Same stacking as MapLoader::render, batched per tileset texture
+    const auto& tiles = map.getTiles();
+    const auto& tileLayers = map.getTileLayers();
+    DrawQueue queue;
+    queue.begin();
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        const float depth = i < tileLayers.size() ? static_cast<float>(tileLayers[i]) : 0.f;
+        queue.submit(tiles[i], DrawLayer::Ground, depth);
+    }
+    queue.flush(texture);
+    texture.display();
+    if (!texture.generateMipmap()) {
+        Logger::warn("Minimap: mipmaps unavailable, the minimap may shimmer");
+    }
+
+    const size_t bytes = MemoryTracker::textureBytes(texture.getTexture()) * 4 / 3;
+    if (gpuMemory.getBytes() == 0) {
+        gpuMemory = MemoryCharge("global", MemoryTag::UiTextures, MemoryKind::Gpu);
+    }
+    gpuMemory.set(bytes);
+
+    Logger::info("Minimap: baked " + std::to_string(tiles.size()) + " tiles into " +
+                 std::to_string(texSize.x) + "x" + std::to_string(texSize.y) + " in " +
+                 std::to_string(queue.getLastStats().drawCalls) + " draw calls");
+    ready = true;
+    return true;
+}
+
+
+void Minimap::setMarkers(const std::vector<sf::FloatRect>& newEntrances,
+                         const std::vector<sf::FloatRect>& newTargets) {
+    entrances = newEntrances;
+    targets = newTargets;
+    if (ready && origin.x >= 0.f) layoutStatic();
+}
+
+
+void Minimap::render(Renderer& renderer, const sf::Vector2f& playerPosition) {
+    if (!ready) return;
+
+    const sf::Vector2u windowSize = renderer.getWindowSize();
+    const sf::Vector2f newOrigin(static_cast<float>(windowSize.x) - Margin - Border - displaySize.x,
+                                 static_cast<float>(windowSize.y) - Margin - Border - displaySize.y);
+    if (newOrigin != origin) {
+        origin = newOrigin;
+        layoutStatic();
+    }
+
+    // The only per-frame work: six vertices for the player
+    const sf::Vector2f clamped(std::clamp(playerPosition.x, 0.f, worldSize.x),
+                               std::clamp(playerPosition.y, 0.f, worldSize.y));
+    const sf::Vector2f p = toScreen(clamped);
+    const sf::Vector2f top(p.x, p.y - PlayerRadius);
+    const sf::Vector2f right(p.x + PlayerRadius, p.y);
+    const sf::Vector2f bottom(p.x, p.y + PlayerRadius);
+    const sf::Vector2f left(p.x - PlayerRadius, p.y);
+    const sf::Vector2f corners[6] = {top, right, bottom, top, bottom, left};
+    for (size_t i = 0; i < 6; ++i) {
+        playerMarker[i].position = corners[i];
+        playerMarker[i].color = PlayerColor;
+    }
+
+    sf::Sprite map(texture.getTexture());
+    map.setScale(sf::Vector2f(1.f / Supersample, 1.f / Supersample));
+    map.setPosition(origin);
+
+    renderer.submitUiTriangles(frame, nullptr);
+    renderer.submitUi(map);
+    if (staticMarkers.getVertexCount() > 0) renderer.submitUiTriangles(staticMarkers, nullptr);
+    renderer.submitUiTriangles(playerMarker, nullptr);
+}
+
+
+sf::Vector2f Minimap::toScreen(const sf::Vector2f& world) const {
+    return origin + world * scale;
+}
+
+
+void Minimap::layoutStatic() {
+    frame.clear();
+    appendQuad(frame,
+               sf::FloatRect(origin - sf::Vector2f(Border, Border),
+                             displaySize + sf::Vector2f(Border * 2.f, Border * 2.f)),
+               FrameColor);
+
+    staticMarkers.clear();
+    auto toScreenRect = [this](const sf::FloatRect& world) {
+        return sf::FloatRect(toScreen(world.position), world.size * scale);
+    };
+    for (const auto& rect : entrances) {
+        appendQuad(staticMarkers, atLeast(toScreenRect(rect), EntranceMinSize), EntranceColor);
+    }
+    // Targets after entrances so the highlight covers the entrance markers
+    for (const auto& rect : targets) {
+        appendQuad(staticMarkers, atLeast(toScreenRect(rect), TargetMinSize), TargetColor);
+    }
+}
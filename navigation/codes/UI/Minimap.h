@@ -0,0 +1,83 @@
+// Minimap.h
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+#include "Utils/MemoryTracker.h"
+
+class Renderer;
+class TMJMap;
+
+/*
+ * File: Minimap.h
+ * Description: Always-on minimap: the map baked once into a small texture, markers on top.
+ *
+ * rebuild() draws every tile of a map once, batched through a DrawQueue, into
+ * an sf::RenderTexture of about twice the on-screen size (mipmapped, so the
+ * scaled-down sprite stays smooth). A frame then costs four UI submissions:
+ * the frame, the baked texture, the static markers (entrances and the current
+ * lesson's building) and the player marker. Only the player marker's six
+ * vertices change per frame; the static markers are rebuilt when setMarkers()
+ * is given new rectangles or the window size changes.
+ *
+ * Notes:
+ *   - Animated tiles are baked in their first frame.
+ *   - Headless runs (TMJMap::isHeadless) never bake and render() draws nothing.
+ */
+class Minimap {
+public:
+    /**
+     * @brief Bake a map's tiles into the minimap texture.
+     *
+     * Suspends the render thread while drawing, since published frames may still
+     * show the previous map's texture.
+     *
+     * @param map Newly entered map.
+     * @param renderer Renderer owning the window (for the render-thread pause).
+     * @return true if the texture was baked.
+     */
+    bool rebuild(const TMJMap& map, Renderer& renderer);
+
+    /**
+     * @brief Replace the static markers.
+     *
+     * @param entrances Entrance rectangles in world coordinates.
+     * @param targets Rectangles of the building to highlight (may be empty).
+     */
+    void setMarkers(const std::vector<sf::FloatRect>& entrances, const std::vector<sf::FloatRect>& targets);
+
+    /**
+     * @brief Queue the minimap in the bottom-right corner of the HUD.
+     *
+     * @param renderer Renderer collecting the UI pass.
+     * @param playerPosition Player position in world coordinates.
+     */
+    void render(Renderer& renderer, const sf::Vector2f& playerPosition);
+
+    bool isReady() const { return ready; }
+
+private:
+    // Window position of a world point
+    sf::Vector2f toScreen(const sf::Vector2f& world) const;
+
+    // Rebuild the frame and static markers for the current origin
+    void layoutStatic();
+
+    sf::RenderTexture texture;
+    bool ready = false;
+
+    sf::Vector2f worldSize;
+    sf::Vector2f displaySize;     // On-screen size in window pixels
+    float scale = 1.f;            // Window pixels per world pixel
+    sf::Vector2f origin{-1.f, -1.f};   // Window position of the map's top-left corner
+
+    std::vector<sf::FloatRect> entrances;
+    std::vector<sf::FloatRect> targets;
+
+    sf::VertexArray frame{sf::PrimitiveType::Triangles};
+    sf::VertexArray staticMarkers{sf::PrimitiveType::Triangles};
+    sf::VertexArray playerMarker{sf::PrimitiveType::Triangles, 6};
+
+    MemoryCharge gpuMemory;
+};
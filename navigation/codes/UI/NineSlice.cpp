@@ -0,0 +1,115 @@
+// NineSlice.cpp
+#include "UI/NineSlice.h"
+#include "Renderer/Renderer.h"
+#include <algorithm>
+#include <utility>
+
+/*
+ * File: NineSlice.cpp
+ * Description: Emits nine-slice quads and groups them per atlas page.
+ */
+
+namespace {
+    void appendQuad(
+        sf::VertexArray& triangles,
+        sf::Vector2f p0, sf::Vector2f p1,
+        sf::Vector2f t0, sf::Vector2f t1,
+        sf::Color color
+    ) {
+        if (p1.x <= p0.x || p1.y <= p0.y) return;
+
+        const sf::Vertex tl{p0, color, t0};
+        const sf::Vertex tr{{p1.x, p0.y}, color, {t1.x, t0.y}};
+        const sf::Vertex br{p1, color, t1};
+        const sf::Vertex bl{{p0.x, p1.y}, color, {t0.x, t1.y}};
+        triangles.append(tl);
+        triangles.append(tr);
+        triangles.append(br);
+        triangles.append(tl);
+        triangles.append(br);
+        triangles.append(bl);
+    }
+
+    /**
+     * @brief Pixel widths of the two borders of one axis, shrunk to fit the extent.
+     */
+    std::pair<float, float> fitBorders(float first, float second, float extent) {
+        const float total = first + second;
+        if (total <= extent || total <= 0.f) return {first, second};
+        const float shrink = extent / total;
+        return {first * shrink, second * shrink};
+    }
+}
+
+
+NineSlice NineSlice::uniform(const sf::Texture& texture, const sf::IntRect& source, int border) {
+    NineSlice slice;
+    slice.texture = &texture;
+    slice.source = source;
+    slice.left = slice.top = slice.right = slice.bottom = border;
+    return slice;
+}
+
+
+void appendNineSlice(
+    sf::VertexArray& triangles,
+    const NineSlice& slice,
+    const sf::FloatRect& dest,
+    sf::Color color,
+    float borderScale
+) {
+    const auto [left, right] = fitBorders(slice.left * borderScale, slice.right * borderScale, dest.size.x);
+    const auto [top, bottom] = fitBorders(slice.top * borderScale, slice.bottom * borderScale, dest.size.y);
+
+    // Column/row edges in pixels and texels
+    const float x[4] = {dest.position.x, dest.position.x + left,
+                        dest.position.x + dest.size.x - right, dest.position.x + dest.size.x};
+    const float y[4] = {dest.position.y, dest.position.y + top,
+                        dest.position.y + dest.size.y - bottom, dest.position.y + dest.size.y};
+
+    const sf::Vector2f s0(slice.source.position);
+    const sf::Vector2f s1 = s0 + sf::Vector2f(slice.source.size);
+    const float u[4] = {s0.x, s0.x + slice.left, s1.x - slice.right, s1.x};
+    const float v[4] = {s0.y, s0.y + slice.top, s1.y - slice.bottom, s1.y};
+
+    for (int row = 0; row < 3; ++row) {
+        for (int col = 0; col < 3; ++col) {
+            appendQuad(triangles,
+                {x[col], y[row]}, {x[col + 1], y[row + 1]},
+                {u[col], v[row]}, {u[col + 1], v[row + 1]},
+                color);
+        }
+    }
+}
+
+
+void UiBatch::clear() {
+    pages.clear();
+}
+
+
+void UiBatch::add(const NineSlice& slice, const sf::FloatRect& dest, sf::Color color, float borderScale) {
+    if (!slice.texture) return;
+
+    auto page = std::find_if(pages.begin(), pages.end(),
+        [&slice](const Page& p) { return p.texture == slice.texture; });
+    if (page == pages.end()) {
+        pages.push_back(Page{slice.texture});
+        page = pages.end() - 1;
+    }
+    appendNineSlice(page->triangles, slice, dest, color, borderScale);
+}
+
+
+void UiBatch::draw(sf::RenderTarget& target) const {
+    for (const Page& page : pages) {
+        target.draw(page.triangles, sf::RenderStates(page.texture));
+    }
+}
+
+
+void UiBatch::submit(Renderer& renderer) const {
+    for (const Page& page : pages) {
+        renderer.submitUiTriangles(page.triangles, page.texture);
+    }
+}
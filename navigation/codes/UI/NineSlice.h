@@ -0,0 +1,119 @@
+// NineSlice.h
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <vector>
+
+class Renderer;
+
+/*
+ * File: NineSlice.h
+ * Description: Nine-slice panel geometry and a per-page batch for UI panels and buttons.
+ *
+ * A nine-slice region splits a texture rect into corners, edges and a center:
+ * corners keep their texel size, edges stretch along one axis and the center
+ * along both, so a panel can take any size without stretching its rounded
+ * corners or rivets. UiBatch collects the quads of every panel of a UI frame
+ * into one triangle list per atlas page, so a dialog costs one draw call per
+ * page it uses instead of one per sprite.
+ *
+ * Notes:
+ *   - UiBatch draws pages in the order they were first used; panels that overlap
+ *     each other should come from the same page (see UiAtlas).
+ *   - Textures are referenced and must outlive the batch.
+ */
+
+/**
+ * @struct NineSlice
+ * @brief Texture region with the widths of its unstretched borders.
+ */
+struct NineSlice {
+    const sf::Texture* texture = nullptr;
+    sf::IntRect source;        ///< Region on the texture, in texels
+    int left = 0;              ///< Border widths in texels
+    int top = 0;
+    int right = 0;
+    int bottom = 0;
+
+    /**
+     * @brief A region whose four borders have the same width.
+     *
+     * @param texture Texture (atlas page or sheet) holding the region.
+     * @param source Region on the texture.
+     * @param border Border width in texels.
+     * @return NineSlice The region.
+     */
+    static NineSlice uniform(const sf::Texture& texture, const sf::IntRect& source, int border);
+
+    sf::Vector2f getSize() const { return sf::Vector2f(source.size); }
+};
+
+/**
+ * @brief Append a nine-slice panel as triangles (up to 9 quads).
+ *
+ * Borders are drawn at borderScale texels per pixel; when the destination is
+ * smaller than both borders together they shrink proportionally.
+ *
+ * @param triangles Vertex array with PrimitiveType::Triangles.
+ * @param slice Region and borders.
+ * @param dest Destination rect.
+ * @param color Vertex color (tint).
+ * @param borderScale Pixel size of one border texel.
+ */
+void appendNineSlice(
+    sf::VertexArray& triangles,
+    const NineSlice& slice,
+    const sf::FloatRect& dest,
+    sf::Color color = sf::Color::White,
+    float borderScale = 1.f
+);
+
+/*
+ * Class: UiBatch
+ * Description: One triangle list per atlas page for all panels of a UI frame.
+ */
+class UiBatch {
+public:
+    void clear();
+
+    /**
+     * @brief Add a nine-slice panel to the list of its page.
+     *
+     * @param slice Region and borders.
+     * @param dest Destination rect.
+     * @param color Vertex color (tint).
+     * @param borderScale Pixel size of one border texel.
+     */
+    void add(
+        const NineSlice& slice,
+        const sf::FloatRect& dest,
+        sf::Color color = sf::Color::White,
+        float borderScale = 1.f
+    );
+
+    /**
+     * @brief Draw every page with one call each.
+     *
+     * @param target Render target (screens drawing on the window directly).
+     */
+    void draw(sf::RenderTarget& target) const;
+
+    /**
+     * @brief Queue every page for the renderer's UI pass.
+     *
+     * @param renderer Renderer to submit to.
+     */
+    void submit(Renderer& renderer) const;
+
+    size_t getPageCount() const { return pages.size(); }
+    bool isEmpty() const { return pages.empty(); }
+
+private:
+    struct Page {
+        const sf::Texture* texture = nullptr;
+        sf::VertexArray triangles{sf::PrimitiveType::Triangles};
+    };
+
+    std::vector<Page> pages;   ///< First-use order
+};
@@ -0,0 +1,127 @@
+// UiAtlas.cpp
+#include "UI/UiAtlas.h"
+#include "Utils/Logger.h"
+#include <algorithm>
+
+/*
+ * File: UiAtlas.cpp
+ * Description: Shelf packing of UI images and page upload.
+ */
+
+namespace {
+    constexpr unsigned Gap = 1;             // Transparent texels between regions
+    constexpr unsigned MinPageWidth = 256;
+
+    unsigned nextPowerOfTwo(unsigned value) {
+        unsigned result = 1;
+        while (result < value) result <<= 1;
+        return result;
+    }
+
+    struct Placement {
+        size_t image;      // Index into the pending list
+        size_t page;
+        sf::Vector2u position;
+    };
+}
+
+
+bool UiAtlas::add(const std::string& name, const std::string& path, int left, int top, int right, int bottom) {
+    Pending entry{name, sf::Image(), left, top, right, bottom};
+    if (!entry.image.loadFromFile(path)) {
+        Logger::warn("UiAtlas: cannot load " + path);
+        return false;
+    }
+    pending.push_back(std::move(entry));
+    return true;
+}
+
+
+bool UiAtlas::build() {
+    if (pending.empty()) return true;
+
+    const unsigned maxSize = sf::Texture::getMaximumSize();
+    unsigned widest = 0;
+    for (const auto& entry : pending) widest = std::max(widest, entry.image.getSize().x + Gap);
+    if (widest > maxSize) {
+        Logger::error("UiAtlas: an image is wider than the maximum texture size");
+        return false;
+    }
+    const unsigned pageWidth = std::min(maxSize, std::max(MinPageWidth, nextPowerOfTwo(widest)));
+
+    // Tallest first keeps the shelves tight
+    std::vector<size_t> order(pending.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        return pending[a].image.getSize().y > pending[b].image.getSize().y;
+    });
+
+    std::vector<Placement> placements;
+    std::vector<unsigned> pageHeights{0};
+    unsigned shelfX = 0, shelfY = 0, shelfHeight = 0;
+
+    for (size_t index : order) {
+        const sf::Vector2u size = pending[index].image.getSize() + sf::Vector2u(Gap, Gap);
+        if (shelfX + size.x > pageWidth) {      // Next shelf
+            shelfY += shelfHeight;
+            shelfX = 0;
+            shelfHeight = 0;
+        }
+        if (shelfY + size.y > maxSize) {        // Next page
+            pageHeights.push_back(0);
+            shelfX = shelfY = shelfHeight = 0;
+        }
+        placements.push_back({index, pageHeights.size() - 1, {shelfX, shelfY}});
+        shelfX += size.x;
+        shelfHeight = std::max(shelfHeight, size.y);
+        pageHeights.back() = std::max(pageHeights.back(), shelfY + shelfHeight);
+    }
+
+    // Compose and upload the pages
+    std::vector<sf::Image> images;
+    for (unsigned height : pageHeights) {
+        images.emplace_back(sf::Vector2u(pageWidth, nextPowerOfTwo(height)), sf::Color::Transparent);
+    }
+    for (const Placement& place : placements) {
+        if (!images[place.page].copy(pending[place.image].image, place.position)) {
+            Logger::error("UiAtlas: cannot place " + pending[place.image].name);
+            return false;
+        }
+    }
+
+    const size_t firstPage = pages.size();
+    for (const sf::Image& image : images) {
+        auto page = std::make_unique<sf::Texture>();
+        if (!page->loadFromImage(image)) {
+            Logger::error("UiAtlas: cannot upload a page");
+            return false;
+        }
+        const size_t bytes = MemoryTracker::textureBytes(*page);
+        MemoryTracker::getInstance().countUpload(bytes);
+        pageMemory.set(pageMemory.getBytes() + bytes);
+        pages.push_back(std::move(page));
+    }
+
+    for (const Placement& place : placements) {
+        const Pending& entry = pending[place.image];
+        NineSlice slice;
+        slice.texture = pages[firstPage + place.page].get();
+        slice.source = sf::IntRect(sf::Vector2i(place.position), sf::Vector2i(entry.image.getSize()));
+        slice.left = entry.left;
+        slice.top = entry.top;
+        slice.right = entry.right;
+        slice.bottom = entry.bottom;
+        regions[entry.name] = slice;
+    }
+
+    Logger::info("UiAtlas: packed " + std::to_string(pending.size()) + " images onto "
+                 + std::to_string(images.size()) + " page(s) of width " + std::to_string(pageWidth));
+    pending.clear();
+    return true;
+}
+
+
+const NineSlice* UiAtlas::find(const std::string& name) const {
+    auto it = regions.find(name);
+    return it != regions.end() ? &it->second : nullptr;
+}
@@ -0,0 +1,70 @@
+// UiAtlas.h
+#pragma once
+
+#include "UI/NineSlice.h"
+#include "Utils/MemoryTracker.h"
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * File: UiAtlas.h
+ * Description: Packs loose UI images (dialog backgrounds, buttons) into shared texture pages.
+ *
+ * Every image added is placed on a page with simple shelf packing when build()
+ * runs; the result is a NineSlice per image pointing at its page. Panels and
+ * buttons from one page end up in the same UiBatch list, so a dialog made of
+ * several images still draws its panels with a single call.
+ *
+ * Notes:
+ *   - Pages are as large as needed, up to sf::Texture::getMaximumSize(); images
+ *     that don't fit on a page start a new one.
+ *   - Regions are separated by a transparent texel so neighbours never bleed.
+ */
+class UiAtlas {
+public:
+    /**
+     * @brief Queue an image for the next build.
+     *
+     * @param name Name to look the region up with.
+     * @param path Image file.
+     * @param left Border widths of the nine-slice, in texels.
+     * @param top
+     * @param right
+     * @param bottom
+     * @return true if the image was loaded.
+     */
+    bool add(const std::string& name, const std::string& path, int left, int top, int right, int bottom);
+
+    /**
+     * @brief Pack the queued images onto pages and upload them.
+     *
+     * @return true if every image was placed and every page uploaded.
+     */
+    bool build();
+
+    /**
+     * @brief Region of a packed image.
+     *
+     * @param name Name given to add.
+     * @return const NineSlice* Region, or nullptr if unknown or not built yet.
+     */
+    const NineSlice* find(const std::string& name) const;
+
+    size_t getPageCount() const { return pages.size(); }
+
+private:
+    struct Pending {
+        std::string name;
+        sf::Image image;
+        int left, top, right, bottom;
+    };
+
+    std::vector<Pending> pending;
+    std::vector<std::unique_ptr<sf::Texture>> pages;     // Stable addresses for NineSlice::texture
+    std::unordered_map<std::string, NineSlice> regions;
+    MemoryCharge pageMemory{"global", MemoryTag::UiTextures, MemoryKind::Gpu};
+};
@@ -0,0 +1,524 @@
+// Widget.cpp
+#include "UI/Widget.h"
+#include "Renderer/Renderer.h"
+#include <algorithm>
+
+/*
+ * File: Widget.cpp
+ * Description: Layout, hit-testing and geometry caching of the retained widget tree.
+ */
+
+namespace {
+    /**
+     * @brief Break a string at spaces so no line is wider than maxWidth.
+     *
+     * @param str Input text (existing line breaks are kept).
+     * @param font Font used for text rendering.
+     * @param characterSize Font character size.
+     * @param maxWidth Maximum allowed width in pixels.
+     * @return std::string Wrapped text.
+     */
+    std::string wrapText(
+        const std::string& str,
+        const sf::Font& font,
+        unsigned int characterSize,
+        float maxWidth
+    ) {
+        const float spaceWidth = font.getGlyph(' ', characterSize, false).advance;
+
+        auto wordWidth = [&](const std::string& w) {
+            float width = 0.f;
+            for (unsigned char ch : w) width += font.getGlyph(ch, characterSize, false).advance;
+            return width;
+        };
+
+        std::string result;
+        std::string word;
+        float lineWidth = 0.f;
+
+        auto flushWord = [&]() {
+            if (word.empty()) return;
+            const float w = wordWidth(word);
+            if (lineWidth > 0.f && lineWidth + w > maxWidth) {
+                result.push_back('\n');
+                lineWidth = 0.f;
+            } else if (lineWidth > 0.f) {
+                result.push_back(' ');
+                lineWidth += spaceWidth;
+            }
+            result += word;
+            lineWidth += w;
+            word.clear();
+        };
+
+        for (char c : str) {
+            if (c == ' ' || c == '\n') {
+                flushWord();
+                if (c == '\n') {
+                    result.push_back('\n');
+                    lineWidth = 0.f;
+                }
+            } else {
+                word.push_back(c);
+            }
+        }
+        flushWord();
+        return result;
+    }
+}
+
+
+// ---------------------------------------------------------------- Widget
+
+Widget::Widget(WidgetLayout layout) : layout(layout) {}
+
+
+void Widget::adopt(std::unique_ptr<Widget> child) {
+    child->parent = this;
+    children.push_back(std::move(child));
+    markLayoutDirty();
+}
+
+
+void Widget::truncateChildren(size_t count) {
+    if (count >= children.size()) return;
+    if (WidgetTree* owner = findTree()) owner->dropHitState();
+    children.erase(children.begin() + static_cast<std::ptrdiff_t>(count), children.end());
+    markLayoutDirty();
+}
+
+
+void Widget::setPadding(float top, float horizontal) {
+    paddingTop = top;
+    paddingHorizontal = horizontal;
+    markLayoutDirty();
+}
+
+
+void Widget::setSpacing(float value) {
+    spacing = value;
+    markLayoutDirty();
+}
+
+
+void Widget::setMarginBottom(float margin) {
+    marginBottom = margin;
+    markLayoutDirty();
+}
+
+
+void Widget::setVisible(bool value) {
+    if (visible == value) return;
+    visible = value;
+    markLayoutDirty();
+}
+
+
+void Widget::setOnClick(std::function<void()> callback) {
+    const bool wasClickable = static_cast<bool>(onClick);
+    onClick = std::move(callback);
+    if (wasClickable != static_cast<bool>(onClick)) markLayoutDirty();   // Hit rects change
+}
+
+
+WidgetTree* Widget::findTree() const {
+    const Widget* node = this;
+    while (node->parent) node = node->parent;
+    return node->tree;
+}
+
+
+void Widget::markLayoutDirty() {
+    if (WidgetTree* owner = findTree()) owner->layoutDirty = true;
+}
+
+
+void Widget::markVisualDirty() {
+    if (WidgetTree* owner = findTree()) owner->visualDirty = true;
+}
+
+
+sf::Vector2f Widget::measure(float availableWidth) {
+    const float contentWidth = availableWidth - paddingHorizontal * 2.f;
+    float height = paddingTop;
+    bool first = true;
+    for (auto& child : children) {
+        if (!child->visible) continue;
+        const sf::Vector2f size = child->measure(contentWidth);
+        if (layout == WidgetLayout::Column || layout == WidgetLayout::ColumnLeft) {
+            height += (first ? 0.f : spacing) + size.y + child->marginBottom;
+        } else {
+            height = std::max(height, paddingTop + size.y);
+        }
+        first = false;
+    }
+    return {availableWidth, height};
+}
+
+
+sf::Vector2f Widget::measureLargestChild(float availableWidth) {
+    sf::Vector2f largest;
+    for (auto& child : children) {
+        if (!child->visible) continue;
+        const sf::Vector2f size = child->measure(availableWidth);
+        largest.x = std::max(largest.x, size.x);
+        largest.y = std::max(largest.y, size.y);
+    }
+    return largest;
+}
+
+
+/**
+ * Moves the widget to its final position and lays out its children inside it
+ * (rect.size was set by the parent from measure()).
+ */
+void Widget::place(sf::Vector2f position) {
+    rect.position = position;
+    arranged();
+
+    const float left = position.x + paddingHorizontal;
+    const float contentWidth = getContentWidth();
+    const float contentHeight = rect.size.y - paddingTop;
+    float y = position.y + paddingTop;
+
+    for (auto& child : children) {
+        if (!child->visible) continue;
+        child->rect.size = child->measure(contentWidth);
+        const sf::Vector2f size = child->rect.size;
+        const float x = layout == WidgetLayout::ColumnLeft ? left : left + (contentWidth - size.x) * 0.5f;
+
+        if (layout == WidgetLayout::Column || layout == WidgetLayout::ColumnLeft) {
+            child->place({x, y});
+            y += size.y + child->marginBottom + spacing;
+        } else if (layout == WidgetLayout::Bottom) {
+            child->place({x, position.y + rect.size.y - size.y - child->marginBottom});
+        } else {
+            child->place({x, position.y + paddingTop + (contentHeight - size.y) * 0.5f});
+        }
+    }
+}
+
+
+// ---------------------------------------------------------------- PanelWidget
+
+PanelWidget::PanelWidget(const NineSlice& art, WidgetLayout layout)
+    : Widget(layout), art(art) {}
+
+
+void PanelWidget::setWidthFraction(float fraction, float minimum, float maximum) {
+    widthFraction = fraction;
+    minScale = minimum;
+    maxScale = maximum;
+    markLayoutDirty();
+}
+
+
+void PanelWidget::setGrowToContent(bool grow) {
+    growToContent = grow;
+    markLayoutDirty();
+}
+
+
+void PanelWidget::setColor(sf::Color value) {
+    if (color == value) return;
+    color = value;
+    markVisualDirty();
+}
+
+
+sf::Vector2f PanelWidget::measure(float availableWidth) {
+    const sf::Vector2f artSize = art.getSize();
+    if (artSize.x <= 0.f) return {0.f, 0.f};
+
+    const float scale = std::clamp(availableWidth * widthFraction / artSize.x, minScale, maxScale);
+    sf::Vector2f size = artSize * scale;
+    if (growToContent) {
+        const float contentHeight = Widget::measure(size.x).y + getPaddingTop();
+        size.y = std::max(size.y, contentHeight);
+    }
+    return size;
+}
+
+
+void PanelWidget::appendGeometry(WidgetGeometry& geometry) const {
+    geometry.panels.add(art, getRect(), color);
+}
+
+
+// ---------------------------------------------------------------- LabelWidget
+
+LabelWidget::LabelWidget(const sf::Font& font, unsigned int characterSize)
+    : text(font, "", characterSize) {
+    text.setFillColor(color);
+}
+
+
+void LabelWidget::setString(std::string_view value) {
+    if (value == source) return;
+    source.assign(value);
+    wrappedWidth = -1.f;
+    markLayoutDirty();
+}
+
+
+void LabelWidget::setColor(sf::Color value) {
+    if (color == value) return;
+    color = value;
+    if (!hovered || !hoverColor) {
+        text.setFillColor(color);
+        markVisualDirty();
+    }
+}
+
+
+void LabelWidget::setOutline(sf::Color outline, float thickness) {
+    text.setOutlineColor(outline);
+    text.setOutlineThickness(thickness);
+    markLayoutDirty();
+}
+
+
+void LabelWidget::setHovered(bool value) {
+    hovered = value;
+    if (!hoverColor) return;
+    text.setFillColor(hovered ? *hoverColor : color);
+    markVisualDirty();
+}
+
+
+void LabelWidget::setLineSpacing(float factor) {
+    text.setLineSpacing(factor);
+    markLayoutDirty();
+}
+
+
+void LabelWidget::setWrapping(bool enabled, float sideMargin) {
+    wrap = enabled;
+    wrapMargin = sideMargin;
+    wrappedWidth = -1.f;
+    markLayoutDirty();
+}
+
+
+sf::Vector2f LabelWidget::measure(float availableWidth) {
+    const float width = wrap ? std::max(0.f, availableWidth - wrapMargin * 2.f) : 0.f;
+    if (width != wrappedWidth) {
+        text.setString(wrap ? wrapText(source, text.getFont(), text.getCharacterSize(), width) : source);
+        wrappedWidth = width;
+    }
+    return text.getLocalBounds().size;
+}
+
+
+void LabelWidget::arranged() {
+    // Align the glyph bounds (not the baseline origin) with the rect
+    text.setPosition(getRect().position - text.getLocalBounds().position);
+}
+
+
+void LabelWidget::appendGeometry(WidgetGeometry& geometry) const {
+    if (!source.empty()) geometry.texts.push_back(text);
+}
+
+
+// ---------------------------------------------------------------- ButtonWidget
+
+ButtonWidget::ButtonWidget(const NineSlice& art, const sf::Font& font, unsigned int characterSize)
+    : PanelWidget(art, WidgetLayout::Center),
+      label(addChild<LabelWidget>(font, characterSize)) {}
+
+
+void ButtonWidget::setHovered(bool hovered) {
+    setColor(hovered ? hoverColor : sf::Color::White);
+}
+
+
+// ---------------------------------------------------------------- BoxWidget
+
+namespace {
+    void appendRect(sf::VertexArray& triangles, const sf::FloatRect& rect, sf::Color color) {
+        const sf::Vector2f a = rect.position;
+        const sf::Vector2f c = rect.position + rect.size;
+        const sf::Vector2f b(c.x, a.y);
+        const sf::Vector2f d(a.x, c.y);
+        for (const sf::Vector2f& p : {a, b, c, a, c, d}) {
+            triangles.append(sf::Vertex{p, color});
+        }
+    }
+}
+
+
+BoxWidget::BoxWidget(sf::Vector2f boxSize, sf::Color fillColor)
+    : Widget(WidgetLayout::Center), size(boxSize), fill(fillColor) {}
+
+
+void BoxWidget::setSize(sf::Vector2f value) {
+    if (size == value) return;
+    size = value;
+    markLayoutDirty();
+}
+
+
+void BoxWidget::setFillColor(sf::Color value) {
+    if (fill == value) return;
+    fill = value;
+    markVisualDirty();
+}
+
+
+void BoxWidget::setOutline(sf::Color color, float thickness) {
+    outlineColor = color;
+    outlineThickness = thickness;
+    markVisualDirty();
+}
+
+
+void BoxWidget::setMeter(float fraction, sf::Color color) {
+    fraction = std::clamp(fraction, 0.f, 1.f);
+    if (meter == fraction && meterColor == color) return;
+    meter = fraction;
+    meterColor = color;
+    markVisualDirty();
+}
+
+
+void BoxWidget::setHovered(bool value) {
+    hovered = value;
+    if (hoverColor) markVisualDirty();
+}
+
+
+void BoxWidget::setFitContent(sf::Vector2f padding) {
+    fitPadding = padding;
+    markLayoutDirty();
+}
+
+
+sf::Vector2f BoxWidget::measure(float availableWidth) {
+    if (!fitPadding) return size;
+    return measureLargestChild(availableWidth - fitPadding->x * 2.f) + *fitPadding * 2.f;
+}
+
+
+void BoxWidget::appendGeometry(WidgetGeometry& geometry) const {
+    const sf::FloatRect& r = getRect();
+    if (outlineThickness > 0.f) {
+        const float t = outlineThickness;
+        appendRect(geometry.boxes, {{r.position.x - t, r.position.y - t}, {r.size.x + 2.f * t, t}}, outlineColor);
+        appendRect(geometry.boxes, {{r.position.x - t, r.position.y + r.size.y}, {r.size.x + 2.f * t, t}}, outlineColor);
+        appendRect(geometry.boxes, {{r.position.x - t, r.position.y}, {t, r.size.y}}, outlineColor);
+        appendRect(geometry.boxes, {{r.position.x + r.size.x, r.position.y}, {t, r.size.y}}, outlineColor);
+    }
+    appendRect(geometry.boxes, r, hovered && hoverColor ? *hoverColor : fill);
+    if (meter > 0.f) {
+        appendRect(geometry.boxes, {r.position, {r.size.x * meter, r.size.y}}, meterColor);
+    }
+}
+
+
+// ---------------------------------------------------------------- WidgetTree
+
+WidgetTree::WidgetTree(WidgetLayout rootLayout) : root(rootLayout) {
+    root.tree = this;
+}
+
+
+void WidgetTree::setViewport(sf::Vector2u size) {
+    const sf::Vector2f value(size);
+    if (value == viewport) return;
+    viewport = value;
+    layoutDirty = true;
+}
+
+
+void WidgetTree::update() {
+    if (layoutDirty) {
+        layoutDirty = false;
+        root.rect.size = viewport;
+        root.place({0.f, 0.f});
+
+        hitRects.clear();
+        collectHitRects(root);
+        const bool hoverAlive = std::any_of(hitRects.begin(), hitRects.end(),
+            [this](const auto& entry) { return entry.second == hovered; });
+        if (hovered && !hoverAlive) {
+            hovered->setHovered(false);
+            hovered = nullptr;
+        }
+
+        visualDirty = true;
+        ++layoutCount;
+    }
+
+    if (visualDirty) {
+        visualDirty = false;
+        geometry.clear();
+        collectGeometry(root);
+    }
+}
+
+
+void WidgetTree::collectHitRects(Widget& widget) {
+    if (!widget.visible) return;
+    if (widget.onClick) hitRects.emplace_back(widget.rect, &widget);
+    for (auto& child : widget.children) collectHitRects(*child);
+}
+
+
+void WidgetTree::collectGeometry(Widget& widget) {
+    if (!widget.visible) return;
+    widget.appendGeometry(geometry);
+    for (auto& child : widget.children) collectGeometry(*child);
+}
+
+
+/**
+ * Forgets hover and hit rects before widgets are destroyed; the next update
+ * rebuilds them.
+ */
+void WidgetTree::dropHitState() {
+    if (hovered) hovered->setHovered(false);
+    hovered = nullptr;
+    hitRects.clear();
+    layoutDirty = true;
+}
+
+
+Widget* WidgetTree::hitTest(sf::Vector2f point) {
+    update();
+    for (auto it = hitRects.rbegin(); it != hitRects.rend(); ++it) {
+        if (it->first.contains(point)) return it->second;
+    }
+    return nullptr;
+}
+
+
+bool WidgetTree::updateHover(sf::Vector2f point) {
+    Widget* hit = hitTest(point);
+    if (hit == hovered) return false;
+
+    if (hovered) hovered->setHovered(false);
+    hovered = hit;
+    if (hovered) hovered->setHovered(true);
+    return true;
+}
+
+
+void WidgetTree::render(Renderer& renderer) {
+    update();
+    if (geometry.boxes.getVertexCount() > 0) renderer.submitUiTriangles(geometry.boxes, nullptr);
+    geometry.panels.submit(renderer);
+    for (const auto& text : geometry.texts) {
+        renderer.submitUi(text);
+    }
+}
+
+
+void WidgetTree::draw(sf::RenderTarget& target) {
+    update();
+    if (geometry.boxes.getVertexCount() > 0) target.draw(geometry.boxes);
+    geometry.panels.draw(target);
+    for (const auto& text : geometry.texts) {
+        target.draw(text);
+    }
+}
@@ -0,0 +1,459 @@
+// Widget.h
+#pragma once
+
+#include "UI/NineSlice.h"
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+class Renderer;
+class WidgetTree;
+
+/*
+ * File: Widget.h
+ * Description: Retained-mode widget tree for dialogs and menu screens.
+ *
+ * A screen builds its widgets once and afterwards only changes what changes
+ * (a label's string, a button's hover state). The tree caches:
+ *   - the layout, recomputed only after a widget marked it dirty (new text,
+ *     added or removed children, visibility, window size);
+ *   - a flattened list of the clickable rects in draw order, rebuilt with the
+ *     layout, which hit-testing scans instead of walking the widgets;
+ *   - the geometry: panels go into a UiBatch (one triangle list per atlas
+ *     page), texts are kept ready to submit; rebuilt only after a visual change.
+ * A frame in which nothing changed therefore costs a few submissions to the
+ * renderer's UI pass, however many widgets exist.
+ *
+ * Important classes:
+ *   - Widget: container laying out its children (column or centered).
+ *   - PanelWidget: nine-slice panel scaled to a fraction of the available width.
+ *   - LabelWidget: text, optionally wrapped to the available width.
+ *   - ButtonWidget: panel with a centered label and a hover tint.
+ *   - BoxWidget: flat-colored rect with an outline and an optional meter (HUD bars, plain buttons).
+ *   - WidgetTree: owns the root, the caches and hit-testing.
+ *
+ * Notes:
+ *   - Coordinates are window pixels (default view).
+ *   - Boxes are drawn first, then panels, then texts, so a tree's texts always
+ *     sit on top of its panels; this is what dialogs and menus want and lets
+ *     each kind batch into one call.
+ *   - Textures and fonts are referenced and must outlive the tree.
+ */
+
+/**
+ * @enum WidgetLayout
+ * @brief How a widget arranges its children inside its content area.
+ */
+enum class WidgetLayout {
+    Column,      ///< Top to bottom, horizontally centered, separated by the spacing
+    ColumnLeft,  ///< Top to bottom, left-aligned, separated by the spacing
+    Center,      ///< Each child centered in the content area
+    Bottom       ///< Each child horizontally centered on the bottom edge, lifted by its bottom margin
+};
+
+/**
+ * @struct WidgetGeometry
+ * @brief Cached draw data of a whole tree.
+ */
+struct WidgetGeometry {
+    sf::VertexArray boxes{sf::PrimitiveType::Triangles};   ///< Flat-colored rects, drawn first
+    UiBatch panels;               ///< Panels and buttons, one list per atlas page
+    std::vector<sf::Text> texts;  ///< Texts, drawn after all panels
+
+    void clear() {
+        boxes.clear();
+        panels.clear();
+        texts.clear();
+    }
+};
+
+/*
+ * Class: Widget
+ * Description: Node of the tree; a plain widget is an invisible container.
+ */
+class Widget {
+public:
+    explicit Widget(WidgetLayout layout = WidgetLayout::Column);
+    virtual ~Widget() = default;
+
+    Widget(const Widget&) = delete;
+    Widget& operator=(const Widget&) = delete;
+
+    /**
+     * @brief Append a child constructed in place.
+     *
+     * @return T& The new child, owned by this widget.
+     */
+    template <typename T, typename... Args>
+    T& addChild(Args&&... args) {
+        auto child = std::make_unique<T>(std::forward<Args>(args)...);
+        T& added = *child;
+        adopt(std::move(child));
+        return added;
+    }
+
+    /**
+     * @brief Destroy the children from index `count` on.
+     *
+     * @param count Number of children to keep.
+     */
+    void truncateChildren(size_t count);
+
+    size_t getChildCount() const { return children.size(); }
+
+    /**
+     * @brief Space between the widget's edge and its children.
+     *
+     * @param top Space above the first child (Column) or the content area.
+     * @param horizontal Space on the left and right.
+     */
+    void setPadding(float top, float horizontal);
+
+    /**
+     * @brief Space between consecutive children of a column.
+     */
+    void setSpacing(float spacing);
+
+    /**
+     * @brief Extra space below this widget inside a column.
+     */
+    void setMarginBottom(float margin);
+
+    /**
+     * @brief Hidden widgets take no space, draw nothing and can't be clicked.
+     */
+    void setVisible(bool visible);
+    bool isVisible() const { return visible; }
+
+    /**
+     * @brief Make the widget clickable; hit-testing only reports clickable widgets.
+     *
+     * @param callback Action of the widget (an empty function makes it inert again).
+     */
+    void setOnClick(std::function<void()> callback);
+    const std::function<void()>& getOnClick() const { return onClick; }
+
+    /**
+     * @brief Rect in window pixels from the last layout.
+     */
+    const sf::FloatRect& getRect() const { return rect; }
+
+protected:
+    /**
+     * @brief Size the widget takes, given the width its parent offers.
+     *
+     * The default container takes the whole width and the height of its children.
+     *
+     * @param availableWidth Content width of the parent.
+     * @return sf::Vector2f Size of the widget.
+     */
+    virtual sf::Vector2f measure(float availableWidth);
+
+    /**
+     * @brief Called once the rect is final (e.g. to move a text there).
+     */
+    virtual void arranged() {}
+
+    /**
+     * @brief Append the widget's own draw data (children are visited by the tree).
+     */
+    virtual void appendGeometry(WidgetGeometry&) const {}
+
+    /**
+     * @brief Hover state change of a clickable widget.
+     */
+    virtual void setHovered(bool) {}
+
+    void markLayoutDirty();
+    void markVisualDirty();
+
+    float getContentWidth() const { return rect.size.x - paddingHorizontal * 2.f; }
+
+    /**
+     * @brief Largest width and height among the visible children.
+     */
+    sf::Vector2f measureLargestChild(float availableWidth);
+    float getPaddingTop() const { return paddingTop; }
+
+private:
+    friend class WidgetTree;
+
+    void adopt(std::unique_ptr<Widget> child);
+    WidgetTree* findTree() const;
+    void place(sf::Vector2f position);
+
+    Widget* parent = nullptr;
+    WidgetTree* tree = nullptr;      ///< Set on the root only
+    std::vector<std::unique_ptr<Widget>> children;
+
+    WidgetLayout layout;
+    float paddingTop = 0.f;
+    float paddingHorizontal = 0.f;
+    float spacing = 0.f;
+    float marginBottom = 0.f;
+    bool visible = true;
+    std::function<void()> onClick;
+
+    sf::FloatRect rect;
+};
+
+/*
+ * Class: PanelWidget
+ * Description: Nine-slice panel; by default it keeps the art's aspect ratio.
+ */
+class PanelWidget : public Widget {
+public:
+    explicit PanelWidget(const NineSlice& art, WidgetLayout layout = WidgetLayout::Column);
+
+    /**
+     * @brief Scale the panel to a fraction of the available width.
+     *
+     * @param fraction Wanted width relative to the available width.
+     * @param minScale Smallest scale of the art.
+     * @param maxScale Largest scale of the art.
+     */
+    void setWidthFraction(float fraction, float minScale, float maxScale);
+
+    /**
+     * @brief Grow taller than the art's aspect ratio when the children need it.
+     *
+     * The bottom padding then equals the top padding. Borders stay crisp since
+     * only the nine-slice center and edges stretch.
+     *
+     * @param grow true to fit the children.
+     */
+    void setGrowToContent(bool grow);
+
+    void setColor(sf::Color color);
+
+protected:
+    sf::Vector2f measure(float availableWidth) override;
+    void appendGeometry(WidgetGeometry& geometry) const override;
+
+private:
+    NineSlice art;
+    float widthFraction = 1.f;
+    float minScale = 1.f;
+    float maxScale = 1.f;
+    bool growToContent = false;
+    sf::Color color = sf::Color::White;
+};
+
+/*
+ * Class: LabelWidget
+ * Description: Text whose rect is its glyph bounds.
+ */
+class LabelWidget : public Widget {
+public:
+    LabelWidget(const sf::Font& font, unsigned int characterSize);
+
+    /**
+     * @brief Change the text; equal strings don't dirty the layout.
+     *
+     * Per-frame values (a clock, a score) can be passed every frame: only a
+     * change reaches the sf::Text and the layout.
+     */
+    void setString(std::string_view text);
+    const std::string& getString() const { return source; }
+
+    void setColor(sf::Color color);
+    void setLineSpacing(float factor);
+
+    /**
+     * @brief Outline around the glyphs (grows the label's rect by the thickness).
+     */
+    void setOutline(sf::Color color, float thickness);
+
+    /**
+     * @brief Fill color while the label is hovered (only clickable labels get hovered).
+     */
+    void setHoverColor(sf::Color color) { hoverColor = color; }
+
+    /**
+     * @brief Break lines at spaces to fit the available width.
+     *
+     * @param wrap true to wrap.
+     * @param sideMargin Space kept free on each side of the available width.
+     */
+    void setWrapping(bool wrap, float sideMargin = 0.f);
+
+protected:
+    sf::Vector2f measure(float availableWidth) override;
+    void arranged() override;
+    void appendGeometry(WidgetGeometry& geometry) const override;
+    void setHovered(bool hovered) override;
+
+private:
+    sf::Text text;
+    std::string source;
+    sf::Color color = sf::Color::White;
+    std::optional<sf::Color> hoverColor;
+    bool hovered = false;
+    bool wrap = false;
+    float wrapMargin = 0.f;
+    float wrappedWidth = -1.f;   ///< Width the current string was wrapped for
+};
+
+/*
+ * Class: ButtonWidget
+ * Description: Panel with a centered label, tinted while hovered.
+ */
+class ButtonWidget : public PanelWidget {
+public:
+    ButtonWidget(const NineSlice& art, const sf::Font& font, unsigned int characterSize);
+
+    LabelWidget& getLabel() { return label; }
+
+    void setHoverColor(sf::Color color) { hoverColor = color; }
+
+protected:
+    void setHovered(bool hovered) override;
+
+private:
+    LabelWidget& label;
+    sf::Color hoverColor = sf::Color(220, 220, 220);
+};
+
+/*
+ * Class: BoxWidget
+ * Description: Fixed-size flat rect; children are centered on it.
+ *
+ * The outline is drawn outside the rect like sf::RectangleShape's, and the
+ * meter fills a fraction of the rect from the left (e.g. an energy bar).
+ */
+class BoxWidget : public Widget {
+public:
+    BoxWidget(sf::Vector2f size, sf::Color fill);
+
+    /**
+     * @brief Change the size; equal sizes don't dirty the layout.
+     */
+    void setSize(sf::Vector2f size);
+
+    void setFillColor(sf::Color color);
+    void setOutline(sf::Color color, float thickness);
+
+    /**
+     * @brief Size the box to its largest child plus a padding instead of the fixed size.
+     *
+     * @param padding Space on each side of the child (x) and above and below it (y).
+     */
+    void setFitContent(sf::Vector2f padding);
+
+    /**
+     * @brief Fill color while the box is hovered (only clickable boxes get hovered).
+     */
+    void setHoverColor(sf::Color color) { hoverColor = color; }
+
+    /**
+     * @brief Fill the left part of the box; only the geometry is rebuilt on change.
+     *
+     * @param fraction Filled part, clamped to 0..1.
+     * @param color Color of the filled part.
+     */
+    void setMeter(float fraction, sf::Color color);
+
+protected:
+    sf::Vector2f measure(float availableWidth) override;
+    void appendGeometry(WidgetGeometry& geometry) const override;
+    void setHovered(bool hovered) override;
+
+private:
+    sf::Vector2f size;
+    std::optional<sf::Vector2f> fitPadding;
+    sf::Color fill;
+    std::optional<sf::Color> hoverColor;
+    bool hovered = false;
+    sf::Color outlineColor = sf::Color::Transparent;
+    float outlineThickness = 0.f;
+    float meter = -1.f;            ///< Filled fraction, negative for no meter
+    sf::Color meterColor;
+};
+
+/*
+ * Class: WidgetTree
+ * Description: Root of a screen's widgets with cached layout, hit rects and geometry.
+ */
+class WidgetTree {
+public:
+    /**
+     * @param rootLayout Layout of the root (Center for dialogs, ColumnLeft for a HUD).
+     */
+    explicit WidgetTree(WidgetLayout rootLayout = WidgetLayout::Center);
+
+    WidgetTree(const WidgetTree&) = delete;
+    WidgetTree& operator=(const WidgetTree&) = delete;
+
+    /**
+     * @brief Container spanning the window; lays its children out with the root layout.
+     */
+    Widget& getRoot() { return root; }
+
+    /**
+     * @brief Window size the root spans; a new size dirties the layout.
+     */
+    void setViewport(sf::Vector2u size);
+
+    /**
+     * @brief Recompute the layout and geometry if something changed since the last call.
+     */
+    void update();
+
+    /**
+     * @brief Topmost clickable widget under a point.
+     *
+     * @param point Position in window pixels.
+     * @return Widget* Widget hit, or nullptr.
+     */
+    Widget* hitTest(sf::Vector2f point);
+
+    /**
+     * @brief Move the hover state to the clickable widget under a point.
+     *
+     * @param point Mouse position in window pixels.
+     * @return true if the hovered widget changed.
+     */
+    bool updateHover(sf::Vector2f point);
+
+    /**
+     * @brief Submit the cached geometry to the renderer's UI pass.
+     *
+     * @param renderer Renderer to submit to.
+     */
+    void render(Renderer& renderer);
+
+    /**
+     * @brief Draw the cached geometry straight onto a target.
+     *
+     * For screens that run their own event loop on the window before the
+     * renderer's frame loop starts (login, map guide).
+     *
+     * @param target Render target in the default view.
+     */
+    void draw(sf::RenderTarget& target);
+
+    size_t getLayoutCount() const { return layoutCount; }
+
+private:
+    friend class Widget;
+
+    void collectHitRects(Widget& widget);
+    void collectGeometry(Widget& widget);
+    void dropHitState();
+
+    Widget root;
+    sf::Vector2f viewport;
+    bool layoutDirty = true;
+    bool visualDirty = true;
+
+    std::vector<std::pair<sf::FloatRect, Widget*>> hitRects;   ///< Draw order
+    Widget* hovered = nullptr;
+    WidgetGeometry geometry;
+    size_t layoutCount = 0;
+};
@@ -0,0 +1,138 @@
+// Arena.cpp
+#include "Utils/Arena.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+
+/*
+ * File: Arena.cpp
+ * Description: Block management and counters of the bump allocator.
+ */
+
+namespace {
+    thread_local Arena* currentArena = nullptr;
+
+    constexpr size_t MaxBlockGrowth = 8;   // Later blocks are at most 8x the first one
+}
+
+Arena::Arena(std::string name, size_t blockSize)
+    : name(std::move(name)), blockSize(std::max<size_t>(blockSize, 1024)) {}
+
+
+Arena::~Arena() {
+    for (const Block& block : blocks) {
+        ::operator delete(block.data, std::align_val_t{alignof(std::max_align_t)});
+    }
+}
+
+
+void Arena::addBlock(size_t minBytes) {
+    const size_t grown = blockSize << std::min(blocks.size(), size_t{3});
+    const size_t size = std::max(minBytes, std::min(grown, blockSize * MaxBlockGrowth));
+
+    Block block;
+    block.data = static_cast<std::byte*>(
+        ::operator new(size, std::align_val_t{alignof(std::max_align_t)}));
+    block.size = size;
+    blocks.push_back(block);
+
+    cursor = block.data;
+    end = block.data + size;
+    ++stats.heapBlocks;
+    ++totals.heapBlocks;
+    stats.capacity += size;
+}
+
+
+void* Arena::do_allocate(size_t bytes, size_t alignment) {
+    auto aligned = [&](std::byte* p) {
+        const auto address = reinterpret_cast<std::uintptr_t>(p);
+        return reinterpret_cast<std::byte*>((address + alignment - 1) & ~(alignment - 1));
+    };
+
+    std::byte* p = cursor ? aligned(cursor) : nullptr;
+    if (!p || p + bytes > end) {
+        addBlock(bytes + alignment);
+        p = aligned(cursor);
+    }
+
+    cursor = p + bytes;
+    ++stats.allocations;
+    ++totals.allocations;
+    stats.bytes += bytes;
+    totals.peakBytes = std::max(totals.peakBytes, stats.bytes);
+    return p;
+}
+
+
+void Arena::do_deallocate(void*, size_t, size_t) {
+    // Freed all at once by reset()
+}
+
+
+bool Arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+
+void Arena::reset() {
+    if (blocks.size() > 1) {
+        // Outgrew the first block: replace all blocks by one that holds the whole
+        // cycle, so the next cycle of the same size needs no heap at all
+        const size_t capacity = stats.capacity;
+        for (const Block& block : blocks) {
+            ::operator delete(block.data, std::align_val_t{alignof(std::max_align_t)});
+        }
+        blocks.clear();
+        addBlock(capacity);
+    } else if (!blocks.empty()) {
+        cursor = blocks.front().data;
+        end = cursor + blocks.front().size;
+    }
+
+    ++totals.resets;
+    stats = Stats{};
+    stats.capacity = blocks.empty() ? 0 : blocks.front().size;
+}
+
+
+bool Arena::owns(const void* p) const {
+    const auto* byte = static_cast<const std::byte*>(p);
+    for (const Block& block : blocks) {
+        if (byte >= block.data && byte < block.data + block.size) return true;
+    }
+    return false;
+}
+
+
+std::string Arena::describe() const {
+    char buffer[200];
+    if (totals.resets == 0) {
+        std::snprintf(buffer, sizeof(buffer),
+                      "%s arena: %zu allocations, %.1f KB from %zu heap blocks",
+                      name.c_str(), totals.allocations, totals.peakBytes / 1024.0, totals.heapBlocks);
+    } else {
+        std::snprintf(buffer, sizeof(buffer),
+                      "%s arena: %zu allocations over %zu resets from %zu heap blocks, peak %.1f KB per reset",
+                      name.c_str(), totals.allocations, totals.resets, totals.heapBlocks,
+                      totals.peakBytes / 1024.0);
+    }
+    return buffer;
+}
+
+
+Arena* Arena::current() {
+    return currentArena;
+}
+
+
+// ---------------------------------------------------------------- ArenaScope
+
+ArenaScope::ArenaScope(Arena& arena) : previous(currentArena) {
+    currentArena = &arena;
+}
+
+
+ArenaScope::~ArenaScope() {
+    currentArena = previous;
+}
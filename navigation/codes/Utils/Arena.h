@@ -0,0 +1,169 @@
+// Arena.h
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <vector>
+
+/*
+ * File: Arena.h
+ * Description: Linear (bump) allocators for short-lived data.
+ *
+ * An Arena hands out memory from large blocks by moving a pointer forward;
+ * freeing a single allocation does nothing, and reset() frees everything at
+ * once. This suits data with one clear lifetime:
+ *   - the transient parse data of a map load (the JSON document, layer
+ *     copies, collision scratch grids), dropped when the load returns;
+ *   - per-frame scratch strings and geometry, dropped at the next frame.
+ *
+ * Arena is a std::pmr::memory_resource, so std::pmr containers use it
+ * directly. Code that needs an allocator type instead of a resource (the
+ * JSON document) uses ArenaAllocator, which allocates from the arena made
+ * current by an ArenaScope on this thread.
+ *
+ * Every arena counts the allocations it served and the heap blocks it had
+ * to take, per reset and since it was created, so the log shows how much
+ * heap traffic it removed.
+ *
+ * Important classes:
+ *   - Arena: bump allocator with counters.
+ *   - ArenaScope: makes an arena current on this thread for ArenaAllocator.
+ *   - ArenaAllocator: stateless allocator using the current arena.
+ *
+ * Notes:
+ *   - Not thread-safe; an arena belongs to the thread using it.
+ *   - Objects in an arena are never destroyed by it; only put data there
+ *     whose destructors just free memory (containers, strings, PODs).
+ */
+
+class Arena : public std::pmr::memory_resource {
+public:
+    struct Stats {
+        size_t allocations = 0;   ///< Allocations served since the last reset
+        size_t bytes = 0;         ///< Bytes handed out since the last reset
+        size_t heapBlocks = 0;    ///< Blocks taken from the heap since the last reset
+        size_t capacity = 0;      ///< Bytes currently owned by the arena
+    };
+
+    struct Totals {
+        size_t allocations = 0;   ///< Allocations served since construction
+        size_t heapBlocks = 0;    ///< Blocks taken from the heap since construction
+        size_t resets = 0;
+        size_t peakBytes = 0;     ///< Most bytes handed out between two resets
+    };
+
+    /**
+     * @param name Name used in the log.
+     * @param blockSize Size of the first block; later blocks double up to 8x.
+     */
+    explicit Arena(std::string name, size_t blockSize = 64 * 1024);
+    ~Arena() override;
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * @brief Free every allocation at once.
+     *
+     * One block is kept, merged to the size of all blocks used in the last
+     * cycle, so an arena reset every frame stops touching the heap once it
+     * has grown to the frame's needs.
+     */
+    void reset();
+
+    /**
+     * @brief Check whether a pointer lies in one of the arena's blocks.
+     */
+    bool owns(const void* p) const;
+
+    const Stats& getStats() const { return stats; }
+    const Totals& getTotals() const { return totals; }
+
+    /**
+     * @brief One-line summary of the counters since construction, e.g. for the log.
+     */
+    std::string describe() const;
+
+    /**
+     * @brief Arena made current on this thread by an ArenaScope, or nullptr.
+     */
+    static Arena* current();
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+private:
+    struct Block {
+        std::byte* data = nullptr;
+        size_t size = 0;
+    };
+
+    void addBlock(size_t minBytes);
+
+    std::string name;
+    size_t blockSize;
+    std::vector<Block> blocks;
+    std::byte* cursor = nullptr;
+    std::byte* end = nullptr;
+    Stats stats;
+    Totals totals;
+};
+
+/*
+ * Class: ArenaScope
+ * Description: Makes an arena current on this thread until the scope ends (scopes nest).
+ */
+class ArenaScope {
+public:
+    explicit ArenaScope(Arena& arena);
+    ~ArenaScope();
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+private:
+    Arena* previous;
+};
+
+/**
+ * @brief Allocator drawing from the current arena, or from the heap when none is current.
+ *
+ * Containers using it must be destroyed inside the scope they were filled
+ * in: memory from the arena is recognized and left alone, anything else is
+ * given back to the heap.
+ */
+template <typename T>
+struct ArenaAllocator {
+    using value_type = T;
+
+    ArenaAllocator() noexcept = default;
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        if (Arena* arena = Arena::current()) {
+            return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        Arena* arena = Arena::current();
+        if (arena && arena->owns(p)) return;
+        ::operator delete(p, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>&) const noexcept { return false; }
+};
+
+/**
+ * @brief String whose buffer comes from the current arena (see ArenaAllocator).
+ */
+using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
@@ -0,0 +1,149 @@
+// MemoryTracker.cpp
+#include "Utils/MemoryTracker.h"
+#include "Utils/Logger.h"
+#include <algorithm>
+#include <cstdio>
+
+/*
+ * File: MemoryTracker.cpp
+ * Description: Charge bookkeeping and the memory report.
+ */
+
+namespace {
+    int keyOf(MemoryTag tag, MemoryKind kind) {
+        return static_cast<int>(tag) * 2 + (kind == MemoryKind::Gpu ? 1 : 0);
+    }
+
+    std::string formatBytes(double bytes) {
+        char buffer[32];
+        if (bytes >= 1024.0 * 1024.0) std::snprintf(buffer, sizeof(buffer), "%.1f MB", bytes / (1024.0 * 1024.0));
+        else std::snprintf(buffer, sizeof(buffer), "%.1f KB", bytes / 1024.0);
+        return buffer;
+    }
+
+    std::string formatDelta(size_t now, size_t before) {
+        const double delta = static_cast<double>(now) - static_cast<double>(before);
+        return (delta < 0 ? "-" : "+") + formatBytes(delta < 0 ? -delta : delta);
+    }
+}
+
+
+// ---------------------------------------------------------------- MemoryCharge
+
+MemoryCharge::MemoryCharge(std::string scope, MemoryTag tag, MemoryKind kind)
+    : scope(std::move(scope)), tag(tag), kind(kind) {}
+
+
+MemoryCharge::MemoryCharge(MemoryCharge&& other) noexcept
+    : scope(std::move(other.scope)), tag(other.tag), kind(other.kind), bytes(other.bytes) {
+    other.tag = MemoryTag::Count;
+    other.bytes = 0;
+}
+
+
+MemoryCharge& MemoryCharge::operator=(MemoryCharge&& other) noexcept {
+    if (this != &other) {
+        release();
+        scope = std::move(other.scope);
+        tag = other.tag;
+        kind = other.kind;
+        bytes = other.bytes;
+        other.tag = MemoryTag::Count;
+        other.bytes = 0;
+    }
+    return *this;
+}
+
+
+void MemoryCharge::set(size_t value) {
+    if (tag == MemoryTag::Count || value == bytes) return;
+    MemoryTracker::getInstance().adjust(scope, tag, kind,
+        static_cast<long long>(value) - static_cast<long long>(bytes));
+    bytes = value;
+}
+
+
+// ---------------------------------------------------------------- MemoryTracker
+
+MemoryTracker& MemoryTracker::getInstance() {
+    static MemoryTracker instance;
+    return instance;
+}
+
+
+void MemoryTracker::adjust(const std::string& scope, MemoryTag tag, MemoryKind kind, long long delta) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Usage& entry = usage[{scope, keyOf(tag, kind)}];
+    const long long updated = static_cast<long long>(entry.bytes) + delta;
+    entry.bytes = updated > 0 ? static_cast<size_t>(updated) : 0;
+    entry.peak = std::max(entry.peak, entry.bytes);
+}
+
+
+void MemoryTracker::countUpload(size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    ++uploads;
+    uploadedBytes += bytes;
+}
+
+
+size_t MemoryTracker::getTotal(MemoryKind kind) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t total = 0;
+    for (const auto& [key, entry] : usage) {
+        if ((key.second & 1) == (kind == MemoryKind::Gpu ? 1 : 0)) total += entry.bytes;
+    }
+    return total;
+}
+
+
+const char* MemoryTracker::tagName(MemoryTag tag) {
+    switch (tag) {
+        case MemoryTag::MapTiles:     return "tiles";
+        case MemoryTag::MapObjects:   return "objects";
+        case MemoryTag::MapCollision: return "collision";
+        case MemoryTag::MapJson:      return "json";
+        case MemoryTag::Tilesets:     return "tilesets";
+        case MemoryTag::Lightmaps:    return "lightmaps";
+        case MemoryTag::Fonts:        return "fonts";
+        case MemoryTag::UiTextures:   return "ui textures";
+        case MemoryTag::Characters:   return "characters";
+        default:                      return "?";
+    }
+}
+
+
+std::vector<std::string> MemoryTracker::reportLines() const {
+    const size_t cpu = getTotal(MemoryKind::Cpu);
+    const size_t gpu = getTotal(MemoryKind::Gpu);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<std::string> lines;
+    lines.push_back("Memory: CPU " + formatBytes(static_cast<double>(cpu)) + " (" +
+                    formatDelta(cpu, loggedCpu) + "), GPU " + formatBytes(static_cast<double>(gpu)) +
+                    " (" + formatDelta(gpu, loggedGpu) + "), " + std::to_string(uploads) +
+                    " uploads of " + formatBytes(static_cast<double>(uploadedBytes)));
+    for (const auto& [key, entry] : usage) {
+        if (entry.peak == 0) continue;
+        const auto tag = static_cast<MemoryTag>(key.second / 2);
+        const bool gpuEntry = (key.second & 1) != 0;
+        lines.push_back("  " + key.first + " / " + tagName(tag) + (gpuEntry ? " (GPU): " : ": ") +
+                        formatBytes(static_cast<double>(entry.bytes)) + ", peak " +
+                        formatBytes(static_cast<double>(entry.peak)));
+    }
+    return lines;
+}
+
+
+void MemoryTracker::logReport(const std::string& reason) {
+    const std::vector<std::string> lines = reportLines();
+    Logger::info(lines.front() + " - " + reason);
+    for (size_t i = 1; i < lines.size(); ++i) Logger::info(lines[i]);
+
+    // The next report shows the change since this one
+    const size_t cpu = getTotal(MemoryKind::Cpu);
+    const size_t gpu = getTotal(MemoryKind::Gpu);
+    std::lock_guard<std::mutex> lock(mutex);
+    loggedCpu = cpu;
+    loggedGpu = gpu;
+}
@@ -0,0 +1,173 @@
+// MemoryTracker.h
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+ * File: MemoryTracker.h
+ * Description: Memory accounting per map and subsystem, CPU and GPU separately.
+ *
+ * Owners of large data hold a MemoryCharge per subsystem and update it when
+ * their data changes (a map after loading, a tileset after its upload). The
+ * tracker sums the live charges by scope (a map name, or "global") and tag,
+ * and remembers the peak of each. Releasing a charge - explicitly or by
+ * destroying it with its owner - gives the bytes back, so memory that keeps
+ * growing across map transitions shows up as a growing total in the report.
+ *
+ * CPU sizes are counted, not measured by hooking the allocator: containers
+ * report capacity() * sizeof(T) plus the heap strings they own (see the
+ * helpers below). GPU sizes are width * height * 4 bytes per uploaded texture;
+ * every upload is also counted cumulatively, so reloads show up even when the
+ * live total stays flat.
+ *
+ * Important classes:
+ *   - MemoryCharge: move-only handle owning a number of bytes of one scope/tag/kind.
+ *   - MemoryTracker: singleton summing the charges; builds the log/overlay report.
+ *
+ * Notes:
+ *   - Thread-safe; charges may be created and updated from job threads.
+ */
+
+/**
+ * @enum MemoryTag
+ * @brief Subsystem a charge belongs to.
+ */
+enum class MemoryTag {
+    MapTiles,      ///< Tile sprites and their layer indices
+    MapObjects,    ///< Text objects, triggers, NPCs, tables, ...
+    MapCollision,  ///< NotWalkable shapes and the collision grid
+    MapJson,       ///< Parsed TMJ document (transient, only its peak matters)
+    Tilesets,      ///< Tileset textures and per-tile metadata
+    Lightmaps,     ///< Baked night-lighting chunk textures
+    Fonts,         ///< Glyph atlas pages
+    UiTextures,    ///< Dialog and menu textures
+    Characters,    ///< Character sprite sheets
+    Count
+};
+
+/**
+ * @enum MemoryKind
+ * @brief Where the bytes live.
+ */
+enum class MemoryKind {
+    Cpu,
+    Gpu
+};
+
+/*
+ * Class: MemoryCharge
+ * Description: Bytes of one scope, tag and kind, given back when released or destroyed.
+ */
+class MemoryCharge {
+public:
+    MemoryCharge() = default;
+    MemoryCharge(std::string scope, MemoryTag tag, MemoryKind kind);
+    ~MemoryCharge() { release(); }
+
+    MemoryCharge(MemoryCharge&& other) noexcept;
+    MemoryCharge& operator=(MemoryCharge&& other) noexcept;
+    MemoryCharge(const MemoryCharge&) = delete;
+    MemoryCharge& operator=(const MemoryCharge&) = delete;
+
+    /**
+     * @brief Change the number of bytes held (the tracker sees the difference).
+     */
+    void set(size_t bytes);
+
+    void release() { set(0); }
+
+    size_t getBytes() const { return bytes; }
+
+private:
+    std::string scope;
+    MemoryTag tag = MemoryTag::Count;   // Count: not attached to the tracker
+    MemoryKind kind = MemoryKind::Cpu;
+    size_t bytes = 0;
+};
+
+class MemoryTracker {
+public:
+    static MemoryTracker& getInstance();
+
+    /**
+     * @brief Add a signed amount to a scope/tag/kind (used by MemoryCharge).
+     */
+    void adjust(const std::string& scope, MemoryTag tag, MemoryKind kind, long long delta);
+
+    /**
+     * @brief Count one texture upload to the GPU (cumulative, never given back).
+     *
+     * @param bytes Uploaded bytes (see textureBytes).
+     */
+    void countUpload(size_t bytes);
+
+    /**
+     * @brief Bytes currently held by every charge.
+     */
+    size_t getTotal(MemoryKind kind) const;
+
+    /**
+     * @brief Report lines: totals, change since the last logged report, then one
+     *        line per scope and tag with live and peak bytes.
+     *
+     * @return Lines for the log or the memory overlay.
+     */
+    std::vector<std::string> reportLines() const;
+
+    /**
+     * @brief Write the report to the log.
+     *
+     * @param reason What triggered the report (e.g. "entered campus").
+     */
+    void logReport(const std::string& reason);
+
+    static const char* tagName(MemoryTag tag);
+
+    // Size helpers for owners computing their charges
+
+    static size_t textureBytes(const sf::Texture& texture) {
+        const sf::Vector2u size = texture.getSize();
+        return static_cast<size_t>(size.x) * size.y * 4;
+    }
+
+    static size_t imageBytes(const sf::Image& image) {
+        const sf::Vector2u size = image.getSize();
+        return static_cast<size_t>(size.x) * size.y * 4;
+    }
+
+    template <typename T>
+    static size_t vectorBytes(const std::vector<T>& values) {
+        return values.capacity() * sizeof(T);
+    }
+
+    /**
+     * @brief Heap (or arena) bytes of a string (0 while it fits in the small-string buffer).
+     */
+    template <typename Alloc>
+    static size_t stringBytes(const std::basic_string<char, std::char_traits<char>, Alloc>& value) {
+        return value.capacity() > std::string().capacity() ? value.capacity() + 1 : 0;
+    }
+
+private:
+    MemoryTracker() = default;
+
+    struct Usage {
+        size_t bytes = 0;
+        size_t peak = 0;
+    };
+
+    using Key = std::pair<std::string, int>;   // Scope, tag * 2 + kind
+
+    mutable std::mutex mutex;
+    std::map<Key, Usage> usage;
+    size_t loggedCpu = 0;   // Totals at the last logReport
+    size_t loggedGpu = 0;
+    size_t uploads = 0;
+    size_t uploadedBytes = 0;
+};
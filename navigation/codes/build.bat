@@ -31,6 +31,8 @@ for %%f in (QuizGame\*.cpp) do set "SRC_FILES=!SRC_FILES! %%f"
 for %%f in (Renderer\*.cpp) do set "SRC_FILES=!SRC_FILES! %%f"
 for %%f in (Utils\*.cpp) do set "SRC_FILES=!SRC_FILES! %%f"
 for %%f in (Login\*.cpp) do set "SRC_FILES=!SRC_FILES! %%f"
+for %%f in (Jobs\*.cpp) do set "SRC_FILES=!SRC_FILES! %%f"
+for %%f in (UI\*.cpp) do set "SRC_FILES=!SRC_FILES! %%f"
 
 echo Compiling...
 
@@ -11,6 +11,7 @@
 #include <filesystem>
 #include "App.h"
 #include "Login/LoginScreen.h"
+#include "Jobs/JobSystem.h"
 
 /**
  * @file main.cpp
@@ -85,6 +86,10 @@ int main() {
         return -1;
     }
 
+    // Start the job system used by loading and per-frame work
+    auto& jobSystem = JobSystem::getInstance();
+    jobSystem.initialize(configManager.getAppConfig().performance.workerThreads);
+
     // Initialize character configuration
     auto& characterConfigManager = CharacterConfigManager::getInstance();
     characterConfigManager.loadConfig();
@@ -214,5 +219,6 @@ int main() {
 
     // Final renderer cleanup
     renderer.cleanup();
+    jobSystem.shutdown();
     return 0;
 }